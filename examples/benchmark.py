@@ -55,6 +55,12 @@ parser.add_argument(
     default=0,
     help="Index the objects to spawn if enable_physics is true. -1 indicates random.",
 )
+parser.add_argument(
+    "--collision_hull_vertex_budget",
+    type=int,
+    default=0,
+    help="If > 0 and enable_physics is true, also benchmark physics with object collision hulls simplified to this many vertices.",
+)
 parser.add_argument(
     "--disable_frustum_culling",
     action="store_true",
@@ -91,6 +97,11 @@ if args.enable_physics:
     # benchmark_items["enable_physics_no_obs"] = {"color_sensor": False, "enable_physics": True}
     benchmark_items["phys_rgb"] = {"enable_physics": True}
     benchmark_items["phys_rgbd"] = {"depth_sensor": True, "enable_physics": True}
+    if args.collision_hull_vertex_budget > 0:
+        benchmark_items["phys_rgb_simple_hulls"] = {
+            "enable_physics": True,
+            "collision_hull_vertex_budget": args.collision_hull_vertex_budget,
+        }
     default_settings["num_objects"] = args.num_objects
     default_settings["test_object_index"] = args.test_object_index
 
@@ -165,6 +165,14 @@ class DemoRunner:
             object_lib_size > 0
         ), "!!!No objects loaded in library, aborting object instancing example!!!"
 
+        # simplify the collision hulls of all objects to the vertex budget
+        hull_vertex_budget = self._sim_settings.get("collision_hull_vertex_budget", 0)
+        if hull_vertex_budget > 0:
+            for template_id in range(object_lib_size):
+                object_template = object_library.get_template_by_ID(template_id)
+                object_template.collision_hull_vertex_budget = hull_vertex_budget
+                object_library.register_template(object_template)
+
         # clear the objects if we are re-running this initializer
         for old_obj_id in self._sim.get_existing_object_ids():
             self._sim.remove_object(old_obj_id)
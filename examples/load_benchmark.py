@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+
+# Copyright (c) Facebook, Inc. and its affiliates.
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+# Measures how long the simulator takes to load a stage, i.e. the fixed cost of
+# switching scenes between episodes, for different numbers of asset import
+# threads, when loading the stage from the file baked next to it by
+# `datatool bake_asset <stage> <stage>.baked <basis_format>`, and when the
+# decoded stage is already in the process-wide asset cache.
+#
+# Cold loads clear the asset cache but not the OS page cache, so run the
+# benchmark once to warm the latter before comparing numbers.
+
+import argparse
+import time
+
+from settings import default_sim_settings, make_cfg
+
+import habitat_sim
+from habitat_sim import bindings as hsim
+
+parser = argparse.ArgumentParser("Running scene load time benchmarks")
+parser.add_argument(
+    "--scenes",
+    type=str,
+    nargs="+",
+    default=[default_sim_settings["scene"]],
+    help="Stage files to load, e.g. .glb or .ply meshes.",
+)
+parser.add_argument(
+    "--import_threads",
+    type=int,
+    nargs="+",
+    default=[0, -1],
+    help="Numbers of asset import worker threads to compare. 0 loads serially, "
+    "-1 uses the hardware concurrency.",
+)
+parser.add_argument(
+    "--repeats",
+    type=int,
+    default=3,
+    help="Number of loads per configuration, the fastest is reported.",
+)
+args = parser.parse_args()
+
+settings = default_sim_settings.copy()
+settings["silent"] = True
+# a minimal sensor setup, the stage load dominates construction
+settings["width"] = settings["height"] = 64
+
+asset_cache = hsim.AssetCache.instance()
+
+
+def time_load(clear_cache):
+    best_time = None
+    for _ in range(args.repeats):
+        if clear_cache:
+            asset_cache.clear()
+        # a new simulator each time, so nothing is reused but the asset cache
+        start_time = time.time()
+        sim = habitat_sim.Simulator(make_cfg(settings))
+        load_time = time.time() - start_time
+        sim.close()
+        del sim
+        if best_time is None or load_time < best_time:
+            best_time = load_time
+    return best_time
+
+
+thread_columns = [
+    "%d threads" % num_threads for num_threads in args.import_threads
+]
+columns = thread_columns + ["baked", "cached"]
+load_times = {}
+for scene in args.scenes:
+    settings["scene"] = scene
+    settings["use_baked_assets"] = False
+    for num_threads, column in zip(args.import_threads, thread_columns):
+        settings["asset_import_threads"] = num_threads
+        load_times[(scene, column)] = time_load(clear_cache=True)
+    # falls back to decoding the stage if it has not been baked
+    settings["use_baked_assets"] = True
+    load_times[(scene, "baked")] = time_load(clear_cache=True)
+    # the last load left the stage in the cache
+    load_times[(scene, "cached")] = time_load(clear_cache=False)
+    for column in columns:
+        print(
+            " ====== Load time (%s, %s): %0.3f s ======"
+            % (scene, column, load_times[(scene, column)])
+        )
+
+print(" ================ Scene load time (seconds) ================")
+title = "Scene"
+for column in columns:
+    title += "\t%-10s" % column
+print(title)
+for scene in args.scenes:
+    row = scene
+    for column in columns:
+        row += "\t%-10.3f" % load_times[(scene, column)]
+    print(row)
+print(" ===========================================================")
@@ -31,7 +31,15 @@ default_sim_settings = {
     "physics_config_file": "./data/default.phys_scene_config.json",
     "num_objects": 10,
     "test_object_index": 0,
+    "collision_hull_vertex_budget": 0,
     "frustum_culling": True,
+    "asset_import_threads": 0,
+    "use_baked_assets": True,
+    "optimize_meshes": False,
+    "lod_pixel_error": 0.0,
+    "max_mesh_chunk_triangles": 0,
+    "texture_memory_budget": 0,
+    "cache_semantic_scenes": False,
 }
 
 # build SimulatorConfiguration
@@ -41,6 +49,20 @@ def make_cfg(settings):
         sim_cfg.frustum_culling = settings["frustum_culling"]
     else:
         sim_cfg.frustum_culling = False
+    if "asset_import_threads" in settings:
+        sim_cfg.asset_import_threads = settings["asset_import_threads"]
+    if "use_baked_assets" in settings:
+        sim_cfg.use_baked_assets = settings["use_baked_assets"]
+    if "optimize_meshes" in settings:
+        sim_cfg.optimize_meshes = settings["optimize_meshes"]
+    if "lod_pixel_error" in settings:
+        sim_cfg.lod_pixel_error = settings["lod_pixel_error"]
+    if "max_mesh_chunk_triangles" in settings:
+        sim_cfg.max_mesh_chunk_triangles = settings["max_mesh_chunk_triangles"]
+    if "texture_memory_budget" in settings:
+        sim_cfg.texture_memory_budget = settings["texture_memory_budget"]
+    if "cache_semantic_scenes" in settings:
+        sim_cfg.cache_semantic_scenes = settings["cache_semantic_scenes"]
     if "enable_physics" in settings:
         sim_cfg.enable_physics = settings["enable_physics"]
     if "physics_config_file" in settings:
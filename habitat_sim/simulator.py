@@ -144,6 +144,27 @@ class Simulator(SimulatorBackend):
             for cfg in config.agents
         ]
 
+    def _reconfigure_agents(self, config: Configuration):
+        r"""Reuse the existing agents, which are still part of the kept scene
+        graph, and only recreate the sensors of agents whose configuration
+        changed"""
+        if len(self.agents) != len(config.agents):
+            # the old agent nodes would stay in the kept scene graph, so
+            # detach them, which hands them to python to be deleted
+            for sensor in self._sensors.values():
+                sensor.close()
+            self._sensors = {}
+            for agent in self.agents:
+                agent.scene_node.parent = None
+                agent.close()
+            self.agents = []
+            self._default_agent = None
+            self._config_agents(config)
+            return
+        for agent, cfg in zip(self.agents, config.agents):
+            if agent.agent_config != cfg:
+                agent.reconfigure(cfg)
+
     def _config_pathfinder(self, config: Configuration):
         if "navmesh" in config.sim_cfg.scene.filepaths:
             navmesh_filenname = config.sim_cfg.scene.filepaths["navmesh"]
@@ -188,6 +209,16 @@ class Simulator(SimulatorBackend):
 
         self.pathfinder.seed(config.sim_cfg.random_seed)
 
+    @staticmethod
+    def _same_navmesh_agent(a: Configuration, b: Configuration) -> bool:
+        r"""Whether the navmesh built for the default agent of one
+        configuration also fits the default agent of the other"""
+        agent_a = a.agents[a.sim_cfg.default_agent_id]
+        agent_b = b.agents[b.sim_cfg.default_agent_id]
+        return np.isclose(agent_a.radius, agent_b.radius) and np.isclose(
+            agent_a.height, agent_b.height
+        )
+
     def reconfigure(self, config: Configuration):
         self._sanitize_config(config)
 
@@ -196,9 +227,24 @@ class Simulator(SimulatorBackend):
             self.config = config
 
     def __set_from_config(self, config: Configuration):
+        # the backend keeps the loaded stage if it is unchanged, and so can the
+        # agents and the navmesh
+        keep_stage = (
+            self._initialized
+            and self.config is not None
+            and self.config.sim_cfg.loads_same_stage(config.sim_cfg)
+        )
+        keep_navmesh = keep_stage and self._same_navmesh_agent(self.config, config)
+
         self._config_backend(config)
-        self._config_agents(config)
-        self._config_pathfinder(config)
+        if keep_stage:
+            self._reconfigure_agents(config)
+        else:
+            self._config_agents(config)
+        if keep_navmesh:
+            self.pathfinder.seed(config.sim_cfg.random_seed)
+        else:
+            self._config_pathfinder(config)
         self.frustum_culling = config.sim_cfg.frustum_culling
 
         for i in range(len(self.agents)):
@@ -234,6 +280,7 @@ class Simulator(SimulatorBackend):
         return agent
 
     def get_sensor_observations(self):
+        self.begin_frame()
         for _, sensor in self._sensors.items():
             sensor.draw_observation()
 
@@ -521,6 +568,11 @@ class Sensor:
 
             obs = np.flip(self._buffer, axis=0)
 
+            if self._spec.sensor_type == SensorType.SEMANTIC:
+                processor = getattr(self._sensor_object, "semantic_processor", None)
+                if processor is not None:
+                    processor.process(obs)
+
         return self._noise_model(obs)
 
     def close(self):
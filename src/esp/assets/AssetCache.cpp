@@ -0,0 +1,81 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "AssetCache.h"
+
+namespace esp {
+namespace assets {
+
+AssetCache& AssetCache::instance() {
+  static AssetCache cache;
+  return cache;
+}
+
+ImportedAsset::cptr AssetCache::get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto entry = entriesByKey_.find(key);
+  if (entry == entriesByKey_.end()) {
+    return nullptr;
+  }
+  // move to the front of the recently used list
+  entries_.splice(entries_.begin(), entries_, entry->second);
+  return entry->second->asset;
+}  // AssetCache::get
+
+void AssetCache::insert(const std::string& key, ImportedAsset::cptr asset) {
+  const std::size_t byteSize = asset->getByteSize();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto existing = entriesByKey_.find(key);
+  if (existing != entriesByKey_.end()) {
+    memoryUsage_ -= existing->second->byteSize;
+    entries_.erase(existing->second);
+    entriesByKey_.erase(existing);
+  }
+  if (byteSize > memoryBudget_) {
+    return;
+  }
+  entries_.push_front(Entry{key, std::move(asset), byteSize});
+  entriesByKey_[key] = entries_.begin();
+  memoryUsage_ += byteSize;
+  evict();
+}  // AssetCache::insert
+
+void AssetCache::setMemoryBudget(std::size_t memoryBudget) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  memoryBudget_ = memoryBudget;
+  evict();
+}
+
+std::size_t AssetCache::getMemoryBudget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return memoryBudget_;
+}
+
+std::size_t AssetCache::getMemoryUsage() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return memoryUsage_;
+}
+
+int AssetCache::getNumCachedAssets() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+void AssetCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  entriesByKey_.clear();
+  memoryUsage_ = 0;
+}
+
+void AssetCache::evict() {
+  while (memoryUsage_ > memoryBudget_ && !entries_.empty()) {
+    memoryUsage_ -= entries_.back().byteSize;
+    entriesByKey_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}  // AssetCache::evict
+
+}  // namespace assets
+}  // namespace esp
@@ -0,0 +1,117 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_ASSETS_ASSETCACHE_H_
+#define ESP_ASSETS_ASSETCACHE_H_
+
+/** @file
+ * @brief Class @ref esp::assets::AssetCache
+ */
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "ImportedAsset.h"
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace assets {
+
+/**
+ * @brief A process-wide cache of @ref ImportedAsset, shared by every @ref
+ * ResourceManager so that loading a scene a second time, or in a second
+ * simulator, skips reading and decoding its files.
+ *
+ * Entries are evicted least recently used first once the total size exceeds
+ * the memory budget, which is 0 until set with @ref setMemoryBudget, so
+ * caching is opt-in. Since entries are reference counted, an evicted asset
+ * stays alive until the last loader using it is done. Thread safe.
+ */
+class AssetCache {
+ public:
+  /**
+   * @brief The cache shared by the whole process.
+   */
+  static AssetCache& instance();
+
+  /**
+   * @brief Get a cached asset and mark it as most recently used.
+   * @param key The file path and load options the asset was decoded with.
+   * @return The asset, or nullptr if it is not cached.
+   */
+  ImportedAsset::cptr get(const std::string& key);
+
+  /**
+   * @brief Add an asset to the cache, replacing any asset with the same key,
+   * and evict least recently used assets to stay within the memory budget.
+   * Assets larger than the whole budget are not cached.
+   * @param key The file path and load options the asset was decoded with.
+   * @param asset The asset.
+   */
+  void insert(const std::string& key, ImportedAsset::cptr asset);
+
+  /**
+   * @brief Set the maximum number of bytes of cached image and mesh data,
+   * evicting assets as needed. 0 disables caching.
+   */
+  void setMemoryBudget(std::size_t memoryBudget);
+
+  /**
+   * @brief Get the maximum number of bytes of cached image and mesh data.
+   */
+  std::size_t getMemoryBudget() const;
+
+  /**
+   * @brief Get the number of bytes of image and mesh data currently cached.
+   */
+  std::size_t getMemoryUsage() const;
+
+  /**
+   * @brief Get the number of cached assets.
+   */
+  int getNumCachedAssets() const;
+
+  /**
+   * @brief Evict all assets.
+   */
+  void clear();
+
+ private:
+  AssetCache() = default;
+
+  //! Evict least recently used assets until the budget is met. Expects
+  //! @ref mutex_ to be held.
+  void evict();
+
+  //! A cached asset and its size.
+  struct Entry {
+    std::string key;
+    ImportedAsset::cptr asset;
+    std::size_t byteSize;
+  };
+
+  //! Guards all other members.
+  mutable std::mutex mutex_;
+
+  //! Cached assets, most recently used first.
+  std::list<Entry> entries_;
+
+  //! Lookup of @ref entries_ by key.
+  std::unordered_map<std::string, std::list<Entry>::iterator> entriesByKey_;
+
+  //! Maximum number of bytes cached, 0 (caching disabled) by default.
+  std::size_t memoryBudget_ = 0;
+
+  //! Number of bytes cached.
+  std::size_t memoryUsage_ = 0;
+};
+
+}  // namespace assets
+}  // namespace esp
+
+#endif  // ESP_ASSETS_ASSETCACHE_H_
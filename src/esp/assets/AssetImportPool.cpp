@@ -0,0 +1,124 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "AssetImportPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <Corrade/PluginManager/PluginMetadata.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+namespace Cr = Corrade;
+
+namespace esp {
+namespace assets {
+
+AssetImportPool::AssetImportPool(int numThreads) {
+  for (int iThread = 0; iThread < numThreads; ++iThread) {
+    Worker worker;
+#ifdef MAGNUM_BUILD_STATIC
+    // avoid using plugins that might depend on different library versions
+    worker.manager = Cr::Containers::pointer<ImporterManager>("nonexistent");
+#else
+    worker.manager = Cr::Containers::pointer<ImporterManager>();
+#endif
+    worker.importer = worker.manager->loadAndInstantiate("AnySceneImporter");
+    if (!worker.importer) {
+      LOG(ERROR) << "AssetImportPool : Unable to instantiate an importer for "
+                    "worker "
+                 << iThread << ", using " << iThread << " workers.";
+      break;
+    }
+    workers_.emplace_back(std::move(worker));
+  }
+}  // AssetImportPool::AssetImportPool
+
+void AssetImportPool::configureImporterManager(
+    ImporterManager& manager,
+    const std::string& basisFormat) {
+  manager.setPreferredPlugins("GltfImporter", {"TinyGltfImporter"});
+#ifdef ESP_BUILD_ASSIMP_SUPPORT
+  manager.setPreferredPlugins("ObjImporter", {"AssimpImporter"});
+#endif
+  manager.metadata("BasisImporter")
+      ->configuration()
+      .setValue("format", basisFormat);
+}  // AssetImportPool::configureImporterManager
+
+void AssetImportPool::run(Importer& importer,
+                          const std::string& filename,
+                          int numJobs,
+                          const DecodeFunction& decode,
+                          const FinishFunction& finish) {
+  std::atomic<int> nextJob{0};
+  std::mutex decodedMutex;
+  std::condition_variable decodedCondition;
+  std::deque<int> decodedJobs;
+
+  auto work = [&](Worker& worker) {
+    if (!worker.importer->openFile(filename)) {
+      // the remaining workers and the calling thread take over
+      LOG(WARNING) << "AssetImportPool::run : Worker cannot open file "
+                   << filename;
+      return;
+    }
+    for (int jobID = nextJob++; jobID < numJobs; jobID = nextJob++) {
+      decode(*worker.importer, jobID);
+      {
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        decodedJobs.push_back(jobID);
+      }
+      decodedCondition.notify_one();
+    }
+    worker.importer->close();
+  };
+
+  // the calling thread decodes too, so one job needs no workers at all
+  const int numThreads =
+      std::min(static_cast<int>(workers_.size()), std::max(numJobs - 1, 0));
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (int iThread = 0; iThread < numThreads; ++iThread) {
+    threads.emplace_back(work, std::ref(workers_[iThread]));
+  }
+
+  int numFinished = 0;
+  while (numFinished < numJobs) {
+    int jobID = ID_UNDEFINED;
+    {
+      std::unique_lock<std::mutex> lock(decodedMutex);
+      if (decodedJobs.empty() && nextJob >= numJobs) {
+        // every job has been started, so wait for the workers
+        decodedCondition.wait(lock, [&] { return !decodedJobs.empty(); });
+      }
+      if (!decodedJobs.empty()) {
+        jobID = decodedJobs.front();
+        decodedJobs.pop_front();
+      }
+    }
+    if (jobID == ID_UNDEFINED) {
+      // nothing to finish yet, so decode a job here rather than idle
+      jobID = nextJob++;
+      if (jobID >= numJobs) {
+        // the workers started the last jobs in the meantime
+        continue;
+      }
+      decode(importer, jobID);
+    }
+    finish(jobID);
+    ++numFinished;
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}  // AssetImportPool::run
+
+}  // namespace assets
+}  // namespace esp
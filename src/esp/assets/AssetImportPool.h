@@ -0,0 +1,121 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_ASSETS_ASSETIMPORTPOOL_H_
+#define ESP_ASSETS_ASSETIMPORTPOOL_H_
+
+/** @file
+ * @brief Class @ref esp::assets::AssetImportPool
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Magnum/Trade/AbstractImporter.h>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace assets {
+
+/**
+ * @brief Worker threads that parse and decode the components (images, meshes)
+ * of an asset file in parallel, handing each decoded component back to the
+ * calling thread as soon as it is ready, e.g. for upload to the GPU.
+ *
+ * Magnum importers and plugin managers are not thread safe, so every worker
+ * owns its own plugin manager and importer and opens the asset file itself.
+ * Decode jobs must therefore only touch the importer they are given and
+ * job-local storage.
+ */
+class AssetImportPool {
+ public:
+  /** @brief Convenience typedef for Importer class */
+  using Importer = Magnum::Trade::AbstractImporter;
+
+  /** @brief Convenience typedef for the importer plugin manager */
+  using ImporterManager = Corrade::PluginManager::Manager<Importer>;
+
+  /**
+   * @brief Decodes a single job, called from any thread with an importer that
+   * has the asset file opened.
+   */
+  using DecodeFunction = std::function<void(Importer& importer, int jobID)>;
+
+  /**
+   * @brief Consumes a single decoded job, always called from the thread that
+   * called @ref run.
+   */
+  using FinishFunction = std::function<void(int jobID)>;
+
+  /**
+   * @brief Constructor. Loads the scene importer plugins of every worker, so
+   * must be called from the thread which owns the other plugin managers.
+   * @param numThreads The number of worker threads. 0 does all work on the
+   * thread calling @ref run.
+   */
+  explicit AssetImportPool(int numThreads);
+
+  /**
+   * @brief Set the preferred scene importers and the Basis target GPU format
+   * of a plugin manager used to load general meshes, so that every plugin
+   * manager importing an asset decodes it the same way.
+   * @param manager The plugin manager.
+   * @param basisFormat The format Basis images are transcoded to, e.g.
+   * "Bc7RGBA".
+   */
+  static void configureImporterManager(ImporterManager& manager,
+                                       const std::string& basisFormat);
+
+  /** @brief The number of worker threads. */
+  int getNumThreads() const { return workers_.size(); }
+
+  /**
+   * @brief Get the plugin manager of a worker, e.g. to configure its plugins
+   * the same way as the main plugin manager. Not safe to call during @ref run.
+   * @param threadID The worker index, less than @ref getNumThreads.
+   */
+  ImporterManager& getImporterManager(int threadID) {
+    return *workers_[threadID].manager;
+  }
+
+  /**
+   * @brief Decode numJobs jobs on the worker threads and the calling thread,
+   * finishing each on the calling thread as soon as it has been decoded. Jobs
+   * are started in order of jobID. Returns once every job has been finished.
+   *
+   * @param importer An importer owned by the calling thread with filename
+   * already opened, used whenever the calling thread has nothing to finish.
+   * @param filename The asset file each worker opens for decoding.
+   * @param numJobs The number of jobs, identified by 0 to numJobs - 1.
+   * @param decode Decodes a job into storage owned by the caller.
+   * @param finish Consumes a decoded job on the calling thread.
+   */
+  void run(Importer& importer,
+           const std::string& filename,
+           int numJobs,
+           const DecodeFunction& decode,
+           const FinishFunction& finish);
+
+ private:
+  //! The plugin manager and importer owned by a worker thread.
+  struct Worker {
+    Corrade::Containers::Pointer<ImporterManager> manager;
+    Corrade::Containers::Pointer<Importer> importer;
+  };
+
+  //! The workers. Only as many as there are jobs are started per @ref run.
+  std::vector<Worker> workers_;
+
+ public:
+  ESP_SMART_POINTERS(AssetImportPool)
+};
+
+}  // namespace assets
+}  // namespace esp
+
+#endif  // ESP_ASSETS_ASSETIMPORTPOOL_H_
@@ -25,7 +25,7 @@ struct CollisionMeshData {
   /**
    * @brief Primitive type (has to be triangle for Bullet to work).
    *
-   * See @ref BulletRigidObject::constructBulletCompoundFromMeshes.
+   * See @ref BulletCollisionShapeCache::getConvexShapes.
    */
   Magnum::MeshPrimitive primitive;
 
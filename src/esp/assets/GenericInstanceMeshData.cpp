@@ -18,6 +18,7 @@
 #include <Magnum/Shaders/Generic.h>
 #include <Magnum/Trade/AbstractImporter.h>
 
+#include "MeshOptimizer.h"
 #include "esp/core/esp.h"
 #include "esp/geo/geo.h"
 #include "esp/io/io.h"
@@ -163,6 +164,16 @@ std::unique_ptr<GenericInstanceMeshData> GenericInstanceMeshData::fromPLY(
   return data;
 }
 
+void GenericInstanceMeshData::optimizeForRendering() {
+  optimizeTriangleOrder(Cr::Containers::arrayView(cpu_ibo_), cpu_vbo_.size());
+  const std::vector<uint32_t> remap =
+      optimizeVertexOrder(Cr::Containers::arrayView(cpu_ibo_), cpu_vbo_.size());
+  remapVertices(cpu_vbo_, remap);
+  remapVertices(cpu_cbo_, remap);
+  remapVertices(objectIds_, remap);
+  updateCollisionMeshData();
+}
+
 void GenericInstanceMeshData::uploadBuffersToGPU(bool forceReload) {
   if (forceReload) {
     buffersOnGPU_ = false;
@@ -49,6 +49,13 @@ class GenericInstanceMeshData : public BaseMesh {
       Magnum::Trade::AbstractImporter& importer,
       const std::string& plyFile);
 
+  /**
+   * @brief Reorder triangles and vertices for vertex cache and fetch
+   * locality, see @ref optimizeMesh. Must be called before @ref
+   * uploadBuffersToGPU.
+   */
+  void optimizeForRendering();
+
   // ==== rendering ====
   virtual void uploadBuffersToGPU(bool forceReload = false) override;
   RenderingBuffer* getRenderingBuffer() { return renderingBuffer_.get(); }
@@ -7,8 +7,14 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Magnum/Math/Constants.h>
+#include <Magnum/Math/FunctionsBatch.h>
+#include <Magnum/Math/Range.h>
 #include <Magnum/MeshTools/Compile.h>
 #include <Magnum/MeshTools/Interleave.h>
+
+#include "MeshOptimizer.h"
+
 namespace Cr = Corrade;
 namespace Mn = Magnum;
 
@@ -24,6 +30,14 @@ void GenericMeshData::uploadBuffersToGPU(bool forceReload) {
   }
 
   renderingBuffer_.reset();
+  if (!chunks_.empty()) {
+    // only the chunks are drawn
+    for (auto& chunk : chunks_) {
+      chunk->uploadBuffersToGPU(forceReload);
+    }
+    buffersOnGPU_ = true;
+    return;
+  }
   renderingBuffer_ = std::make_unique<GenericMeshData::RenderingBuffer>();
   Magnum::MeshTools::CompileFlags compileFlags{};
   if (needsNormals_ &&
@@ -32,6 +46,10 @@ void GenericMeshData::uploadBuffersToGPU(bool forceReload) {
   }
   // position, normals, uv, colors are bound to corresponding attributes
   renderingBuffer_->mesh = Magnum::MeshTools::compile(*meshData_, compileFlags);
+  for (const Mn::Trade::MeshData& lodMeshData : lodMeshData_) {
+    renderingBuffer_->lodMeshes.emplace_back(
+        Magnum::MeshTools::compile(lodMeshData, compileFlags));
+  }
 
   buffersOnGPU_ = true;
 }
@@ -44,6 +62,69 @@ Magnum::GL::Mesh* GenericMeshData::getMagnumGLMesh() {
   return &(renderingBuffer_->mesh);
 }
 
+Magnum::GL::Mesh* GenericMeshData::getLodMagnumGLMesh(int lod) {
+  if (renderingBuffer_ == nullptr) {
+    return nullptr;
+  }
+
+  return &(renderingBuffer_->lodMeshes[lod]);
+}
+
+void GenericMeshData::splitIntoChunks(uint32_t maxChunkTriangles) {
+  chunks_.clear();
+  if (!meshData_) {
+    return;
+  }
+  for (Mn::Trade::MeshData& chunkMeshData :
+       splitMeshIntoChunks(*meshData_, maxChunkTriangles)) {
+    auto chunk = std::make_unique<GenericMeshData>(needsNormals_);
+    chunk->setMeshData(std::move(chunkMeshData));
+    chunk->BB = Mn::Math::minmax(chunk->collisionMeshData_.positions);
+    chunks_.emplace_back(std::move(chunk));
+  }
+}  // splitIntoChunks
+
+void GenericMeshData::generateLods(int maxNumLods) {
+  lodMeshData_.clear();
+  lodErrors_.clear();
+  if (!meshData_ || collisionMeshData_.positions.empty()) {
+    return;
+  }
+  // chunks share the cell sizes of the whole mesh so that their levels meet
+  const Mn::Range3D bounds{Mn::Math::minmax(collisionMeshData_.positions)};
+  const float cellSize = bounds.size().length() / 256.0f;
+  for (auto& chunk : chunks_) {
+    chunk->generateLods(maxNumLods, cellSize, false);
+  }
+  if (chunks_.empty()) {
+    generateLods(maxNumLods, cellSize, true);
+  }
+}  // generateLods
+
+void GenericMeshData::generateLods(int maxNumLods,
+                                   float cellSize,
+                                   bool skipSmallReductions) {
+  lodMeshData_.clear();
+  lodErrors_.clear();
+  if (!meshData_ || !meshData_->isIndexed()) {
+    return;
+  }
+  Mn::UnsignedInt triangleCount = meshData_->indexCount() / 3;
+  while (getNumLods() < maxNumLods) {
+    Cr::Containers::Optional<Mn::Trade::MeshData> lod =
+        simplifyMesh(*meshData_, cellSize);
+    // stop once a level would save less than a quarter of the triangles
+    if (!lod || (skipSmallReductions &&
+                 lod->indexCount() / 3 > triangleCount * 3 / 4)) {
+      break;
+    }
+    triangleCount = lod->indexCount() / 3;
+    lodMeshData_.emplace_back(*std::move(lod));
+    lodErrors_.push_back(cellSize * Mn::Constants::sqrt3());
+    cellSize *= 2.0f;
+  }
+}  // generateLods
+
 void GenericMeshData::setMeshData(Magnum::Trade::MeshData&& meshData) {
   /* Interleave the mesh, if not already. This makes the GPU happier (better
      cache locality for vertex fetching) and is a no-op if the source data is
@@ -53,7 +134,17 @@ void GenericMeshData::setMeshData(Magnum::Trade::MeshData&& meshData) {
    * incorrectly calculated */
 
   meshData_ = Mn::MeshTools::interleave(std::move(meshData));
+  setCollisionMeshData();
+}  // setMeshData
 
+void GenericMeshData::setMeshData(const Magnum::Trade::MeshData& meshData) {
+  /* Copies the vertex and index data, interleaving the copy if the source
+     isn't interleaved yet */
+  meshData_ = Mn::MeshTools::interleave(meshData);
+  setCollisionMeshData();
+}  // setMeshData
+
+void GenericMeshData::setCollisionMeshData() {
   collisionMeshData_.primitive = meshData_->primitive();
 
   /* For collision data we need positions as Vector3 in a contiguous array.
@@ -69,7 +160,7 @@ void GenericMeshData::setMeshData(Magnum::Trade::MeshData&& meshData) {
     collisionMeshData_.indices = meshData_->mutableIndices<Mn::UnsignedInt>();
   else
     collisionMeshData_.indices = indexData_ = meshData_->indicesAsArray();
-}  // setMeshData
+}  // setCollisionMeshData
 
 void GenericMeshData::importAndSetMeshData(
     Magnum::Trade::AbstractImporter& importer,
@@ -12,6 +12,9 @@
 #include <Corrade/Containers/Optional.h>
 #include <Magnum/GL/Mesh.h>
 #include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/MeshData.h>
+#include <memory>
+#include <vector>
 
 #include "BaseMesh.h"
 #include "esp/core/esp.h"
@@ -33,6 +36,12 @@ class GenericMeshData : public BaseMesh {
      * @brief Compiled openGL render data for the mesh.
      */
     Magnum::GL::Mesh mesh;
+
+    /**
+     * @brief Compiled openGL render data for each level of detail, see @ref
+     * generateLods.
+     */
+    std::vector<Magnum::GL::Mesh> lodMeshes;
   };
 
   /** @brief Constructor. Sets @ref SupportedMeshType::GENERIC_MESH to identify
@@ -60,6 +69,14 @@ class GenericMeshData : public BaseMesh {
    */
   void setMeshData(Magnum::Trade::MeshData&& meshData);
 
+  /**
+   * @brief Set mesh data from a copy of shared mesh data, e.g. from an @ref
+   * ImportedAsset, so this mesh can be modified independently. Sets the @ref
+   * collisionMesh_ references.
+   * @param meshData the meshData to be copied.
+   */
+  void setMeshData(const Magnum::Trade::MeshData& meshData);
+
   /**
    * @brief Load mesh data from a pre-parsed importer for a specific mesh
    * component ID. Sets the @ref collisionMeshData_ references.
@@ -81,6 +98,60 @@ class GenericMeshData : public BaseMesh {
   void importAndSetMeshData(Magnum::Trade::AbstractImporter& importer,
                             const std::string& meshName);
 
+  /**
+   * @brief Split the mesh into spatially compact chunks with @ref
+   * splitMeshIntoChunks, each its own @ref GenericMeshData with its own
+   * bounding box, so that they can be drawn and culled separately. The full
+   * mesh is kept for collisions but no longer uploaded to the GPU, the chunks
+   * are instead. Does nothing for meshes small enough already. Must be called
+   * before @ref generateLods and @ref uploadBuffersToGPU.
+   * @param maxChunkTriangles The maximum number of triangles per chunk.
+   */
+  void splitIntoChunks(uint32_t maxChunkTriangles);
+
+  /**
+   * @brief Get the number of chunks, 0 if the mesh is not split. See @ref
+   * splitIntoChunks.
+   */
+  int getNumChunks() const { return chunks_.size(); }
+
+  /**
+   * @brief Get a chunk of the mesh. See @ref splitIntoChunks.
+   * @param chunk The chunk, from 0 to @ref getNumChunks - 1.
+   */
+  GenericMeshData& getChunk(int chunk) { return *chunks_[chunk]; }
+
+  /**
+   * @brief Generate simplified versions of the mesh for rendering at a
+   * distance with @ref simplifyMesh, each halving the resolution of the
+   * previous one, starting from a grid of 256 cells along the bounding box
+   * diagonal. Levels that would barely reduce the triangle count are not
+   * generated. For a mesh split into chunks, each chunk gets its own levels,
+   * all of them, on the grids of the whole mesh so that neighboring chunks
+   * meet. Must be called before @ref uploadBuffersToGPU.
+   * @param maxNumLods The maximum number of levels to generate.
+   */
+  void generateLods(int maxNumLods);
+
+  /**
+   * @brief Get the number of levels of detail, see @ref generateLods.
+   */
+  int getNumLods() const { return lodMeshData_.size(); }
+
+  /**
+   * @brief Get the largest distance, in mesh units, of the surface of a level
+   * of detail to the full resolution mesh.
+   * @param lod The level of detail, from 0 (finest) to @ref getNumLods - 1.
+   */
+  float getLodError(int lod) const { return lodErrors_[lod]; }
+
+  /**
+   * @brief Returns a pointer to the compiled render mesh data of a level of
+   * detail, nullptr if not uploaded yet.
+   * @param lod The level of detail, from 0 (finest) to @ref getNumLods - 1.
+   */
+  Magnum::GL::Mesh* getLodMagnumGLMesh(int lod);
+
   /**
    * @brief Returns a pointer to the compiled render data storage structure.
    * @return Pointer to the @ref renderingBuffer_.
@@ -106,7 +177,36 @@ class GenericMeshData : public BaseMesh {
 
   bool needsNormals_ = true;
 
+  /**
+   * @brief Simplified meshes, from finest to coarsest, see @ref generateLods.
+   */
+  std::vector<Magnum::Trade::MeshData> lodMeshData_;
+
+  /**
+   * @brief Error bound of each of @ref lodMeshData_, see @ref getLodError.
+   */
+  std::vector<float> lodErrors_;
+
+  /**
+   * @brief Spatial chunks of the mesh, see @ref splitIntoChunks.
+   */
+  std::vector<std::unique_ptr<GenericMeshData>> chunks_;
+
  private:
+  /**
+   * @brief Generate the levels of detail with the given finest cell size, see
+   * @ref generateLods().
+   * @param skipSmallReductions Whether to stop at the first level that would
+   * barely reduce the triangle count.
+   */
+  void generateLods(int maxNumLods, float cellSize, bool skipSmallReductions);
+
+  /**
+   * @brief Point the @ref collisionMeshData_ at the positions and indices of
+   * @ref meshData_.
+   */
+  void setCollisionMeshData();
+
   /* Internal; can store data referenced by positions / indices if the original
      MeshData doesn't have them in desired type */
   Corrade::Containers::Array<Magnum::Vector3> positionData_;
@@ -0,0 +1,854 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "ImportedAsset.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/Array.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/MeshTools/Interleave.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Trade/MeshObjectData3D.h>
+#include <Magnum/Trade/SceneData.h>
+#include <Magnum/VertexFormat.h>
+
+#include "MeshOptimizer.h"
+#include "esp/io/io.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+namespace esp {
+namespace assets {
+
+namespace {
+
+//! Identifies a baked asset file and the version of its layout. Bump the
+//! version whenever the layout below changes, stale files are then rejected.
+constexpr char BakedMagic[8] = {'E', 'S', 'P', 'A', 'S', 'T', '0', '3'};
+
+//! Size of the zero padded Basis target format name in the header
+constexpr std::size_t BakedBasisFormatSize = 32;
+
+//! Largest image dimension read back, which keeps the image data size
+//! computation from overflowing
+constexpr std::int32_t BakedMaxImageSize = 1 << 16;
+
+//! Minimum baked sizes of repeated items, used to reject counts which can't
+//! possibly fit in the rest of the file before allocating for them
+constexpr std::size_t BakedMinHierarchyNodeSize =
+    3 * sizeof(std::int32_t) + sizeof(Mn::Matrix4) + sizeof(std::uint32_t);
+constexpr std::size_t BakedMinImageLevelSize = sizeof(std::uint8_t) +
+                                               sizeof(std::uint32_t) +
+                                               sizeof(Mn::Vector2i) +
+                                               sizeof(std::uint64_t);
+constexpr std::size_t BakedMeshAttributeSize =
+    2 * sizeof(std::uint32_t) + sizeof(std::uint64_t) + sizeof(std::int32_t) +
+    sizeof(std::uint32_t);
+constexpr std::size_t BakedMinMaterialAttributeSize =
+    2 * sizeof(std::uint64_t) + sizeof(std::uint32_t);
+
+//! Last known values of the enums read back, anything past them is corrupt.
+//! Update these when Magnum adds new values.
+constexpr Mn::MeshIndexType BakedLastMeshIndexType =
+    Mn::MeshIndexType::UnsignedInt;
+constexpr Mn::VertexFormat BakedLastVertexFormat =
+    Mn::VertexFormat::Matrix4x4sNormalized;
+constexpr Mn::Trade::MeshAttribute BakedLastMeshAttribute =
+    Mn::Trade::MeshAttribute::ObjectId;
+constexpr Mn::PixelFormat BakedLastPixelFormat =
+    Mn::PixelFormat::Depth32FStencil8UI;
+constexpr Mn::Trade::MaterialAttributeType BakedLastMaterialAttributeType =
+    Mn::Trade::MaterialAttributeType::String;
+
+/**
+ * @brief Appends plain values and length prefixed blobs to a buffer.
+ */
+class BakedWriter {
+ public:
+  template <class T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only plain values can be baked");
+    writeBytes(&value, sizeof(T));
+  }
+
+  void writeBytes(const void* data, std::size_t size) {
+    data_.append(static_cast<const char*>(data), size);
+  }
+
+  void writeBlob(Cr::Containers::ArrayView<const char> blob) {
+    write<std::uint64_t>(blob.size());
+    writeBytes(blob.data(), blob.size());
+  }
+
+  const std::string& data() const { return data_; }
+
+ private:
+  std::string data_;
+};
+
+/**
+ * @brief Reads back what @ref BakedWriter wrote, failing instead of reading
+ * past the end of the data.
+ */
+class BakedReader {
+ public:
+  explicit BakedReader(Cr::Containers::ArrayView<const char> data)
+      : data_{data} {}
+
+  template <class T>
+  bool read(T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only plain values can be baked");
+    if (!has(sizeof(T))) {
+      return false;
+    }
+    std::memcpy(&value, data_.data() + position_, sizeof(T));
+    position_ += sizeof(T);
+    return true;
+  }
+
+  //! Read a blob without copying it, valid as long as the data is
+  bool readView(Cr::Containers::ArrayView<const char>& view) {
+    std::uint64_t size = 0;
+    if (!read(size) || !has(size)) {
+      return false;
+    }
+    view = data_.slice(position_, position_ + size);
+    position_ += size;
+    return true;
+  }
+
+  //! Read a blob into an owned array
+  bool readBlob(Cr::Containers::Array<char>& blob) {
+    Cr::Containers::ArrayView<const char> view;
+    if (!readView(view)) {
+      return false;
+    }
+    blob = Cr::Containers::Array<char>{Cr::Containers::NoInit, view.size()};
+    std::memcpy(blob.data(), view.data(), view.size());
+    return true;
+  }
+
+  //! Whether @p count items of at least @p minSize bytes each can still be
+  //! read
+  bool canHold(std::uint64_t count, std::size_t minSize) const {
+    return count <= (data_.size() - position_) / minSize;
+  }
+
+  bool atEnd() const { return position_ == data_.size(); }
+
+ private:
+  bool has(std::uint64_t size) const {
+    return size <= data_.size() - position_;
+  }
+
+  Cr::Containers::ArrayView<const char> data_;
+  std::size_t position_ = 0;
+};
+
+//! Size of a file in bytes, 0 if it can't be opened
+std::uint64_t fileSize(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return 0;
+  }
+  return static_cast<std::uint64_t>(file.tellg());
+}
+
+void writeHierarchy(BakedWriter& writer, const MeshTransformNode& node) {
+  writer.write<std::int32_t>(node.componentID);
+  writer.write<std::int32_t>(node.meshIDLocal);
+  writer.write<std::int32_t>(node.materialIDLocal);
+  writer.write(node.transformFromLocalToParent);
+  writer.write<std::uint32_t>(node.children.size());
+  for (const MeshTransformNode& child : node.children) {
+    writeHierarchy(writer, child);
+  }
+}
+
+bool readHierarchy(BakedReader& reader, MeshTransformNode& node) {
+  std::int32_t componentID = 0, meshIDLocal = 0, materialIDLocal = 0;
+  std::uint32_t numChildren = 0;
+  if (!reader.read(componentID) || !reader.read(meshIDLocal) ||
+      !reader.read(materialIDLocal) ||
+      !reader.read(node.transformFromLocalToParent) ||
+      !reader.read(numChildren) ||
+      !reader.canHold(numChildren, BakedMinHierarchyNodeSize)) {
+    return false;
+  }
+  node.componentID = componentID;
+  node.meshIDLocal = meshIDLocal;
+  node.materialIDLocal = materialIDLocal;
+  node.children.resize(numChildren);
+  for (MeshTransformNode& child : node.children) {
+    if (!readHierarchy(reader, child)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool writeTexture(BakedWriter& writer, const ImportedTexture& texture) {
+  writer.write<std::uint8_t>(bool(texture.textureData));
+  if (!texture.textureData) {
+    return true;
+  }
+  const Mn::Trade::TextureData& textureData = *texture.textureData;
+  writer.write<std::uint32_t>(Mn::UnsignedInt(textureData.type()));
+  writer.write<std::uint32_t>(
+      Mn::UnsignedInt(textureData.minificationFilter()));
+  writer.write<std::uint32_t>(
+      Mn::UnsignedInt(textureData.magnificationFilter()));
+  writer.write<std::uint32_t>(Mn::UnsignedInt(textureData.mipmapFilter()));
+  for (int iAxis = 0; iAxis != 3; ++iAxis) {
+    writer.write<std::uint32_t>(
+        Mn::UnsignedInt(textureData.wrapping()[iAxis]));
+  }
+  writer.write<std::uint32_t>(textureData.image());
+
+  writer.write<std::uint32_t>(texture.levels.size());
+  for (const Mn::Trade::ImageData2D& image : texture.levels) {
+    writer.write<std::uint8_t>(image.isCompressed());
+    if (image.isCompressed()) {
+      writer.write<std::uint32_t>(Mn::UnsignedInt(image.compressedFormat()));
+    } else {
+      // the pixel size of these is only known to the importer
+      if (Mn::isPixelFormatImplementationSpecific(image.format())) {
+        LOG(ERROR) << "ImportedAsset::save : Cannot bake images with an "
+                      "implementation-specific pixel format";
+        return false;
+      }
+      writer.write<std::uint32_t>(Mn::UnsignedInt(image.format()));
+      writer.write<std::int32_t>(image.storage().alignment());
+      writer.write<std::int32_t>(image.storage().rowLength());
+      writer.write<std::int32_t>(image.storage().imageHeight());
+      writer.write(image.storage().skip());
+    }
+    writer.write(image.size());
+    writer.writeBlob(image.data());
+  }
+  return true;
+}
+
+bool readTexture(BakedReader& reader, ImportedTexture& texture) {
+  std::uint8_t isValid = 0;
+  if (!reader.read(isValid)) {
+    return false;
+  }
+  if (!isValid) {
+    return true;
+  }
+  std::uint32_t type = 0, minificationFilter = 0, magnificationFilter = 0,
+                mipmapFilter = 0, image = 0;
+  std::uint32_t wrapping[3]{};
+  if (!reader.read(type) || !reader.read(minificationFilter) ||
+      !reader.read(magnificationFilter) || !reader.read(mipmapFilter) ||
+      !reader.read(wrapping) || !reader.read(image)) {
+    return false;
+  }
+
+  std::uint32_t numLevels = 0;
+  if (!reader.read(numLevels) ||
+      !reader.canHold(numLevels, BakedMinImageLevelSize)) {
+    return false;
+  }
+  texture.levels.reserve(numLevels);
+  for (std::uint32_t level = 0; level != numLevels; ++level) {
+    std::uint8_t isCompressed = 0;
+    std::uint32_t format = 0;
+    if (!reader.read(isCompressed) || !reader.read(format)) {
+      return false;
+    }
+    Mn::PixelStorage storage;
+    if (!isCompressed) {
+      std::int32_t alignment = 0, rowLength = 0, imageHeight = 0;
+      Mn::Vector3i skip;
+      if (!reader.read(alignment) || !reader.read(rowLength) ||
+          !reader.read(imageHeight) || !reader.read(skip)) {
+        return false;
+      }
+      // only these are valid, and the data size computation divides by it
+      if (alignment != 1 && alignment != 2 && alignment != 4 &&
+          alignment != 8) {
+        return false;
+      }
+      if (rowLength < 0 || rowLength > BakedMaxImageSize || imageHeight < 0 ||
+          imageHeight > BakedMaxImageSize ||
+          (skip < Mn::Vector3i{0}).any() ||
+          (skip > Mn::Vector3i{BakedMaxImageSize}).any()) {
+        return false;
+      }
+      storage.setAlignment(alignment)
+          .setRowLength(rowLength)
+          .setImageHeight(imageHeight)
+          .setSkip(skip);
+    }
+    Mn::Vector2i size;
+    Cr::Containers::Array<char> data;
+    if (!reader.read(size) || !reader.readBlob(data)) {
+      return false;
+    }
+    if (isCompressed) {
+      texture.levels.emplace_back(Mn::CompressedPixelFormat(format), size,
+                                  std::move(data));
+    } else {
+      // the image constructor asserts on a size mismatch, and the pixel size
+      // of unknown and implementation-specific formats is unknown
+      if (format == 0 ||
+          format > Mn::UnsignedInt(BakedLastPixelFormat) ||
+          (size < Mn::Vector2i{0}).any() ||
+          (size > Mn::Vector2i{BakedMaxImageSize}).any()) {
+        return false;
+      }
+      const auto properties = storage.dataProperties(
+          Mn::pixelSize(Mn::PixelFormat(format)), Mn::Vector3i{size, 1});
+      if (properties.first.sum() + properties.second.product() >
+          data.size()) {
+        return false;
+      }
+      texture.levels.emplace_back(storage, Mn::PixelFormat(format), size,
+                                  std::move(data));
+    }
+  }
+
+  texture.textureData.emplace(
+      Mn::Trade::TextureData::Type(type),
+      Mn::SamplerFilter(minificationFilter),
+      Mn::SamplerFilter(magnificationFilter),
+      Mn::SamplerMipmap(mipmapFilter),
+      Mn::Array3D<Mn::SamplerWrapping>{Mn::SamplerWrapping(wrapping[0]),
+                                       Mn::SamplerWrapping(wrapping[1]),
+                                       Mn::SamplerWrapping(wrapping[2])},
+      image);
+  return true;
+}
+
+void writeMesh(BakedWriter& writer,
+               const Cr::Containers::Optional<Mn::Trade::MeshData>& mesh) {
+  writer.write<std::uint8_t>(bool(mesh));
+  if (!mesh) {
+    return;
+  }
+  writer.write<std::uint32_t>(Mn::UnsignedInt(mesh->primitive()));
+
+  writer.write<std::uint8_t>(mesh->isIndexed());
+  if (mesh->isIndexed()) {
+    writer.write<std::uint32_t>(Mn::UnsignedInt(mesh->indexType()));
+    writer.write<std::uint64_t>(mesh->indexOffset());
+    writer.write<std::uint32_t>(mesh->indexCount());
+    writer.writeBlob(mesh->indexData());
+  }
+
+  writer.write<std::uint32_t>(mesh->vertexCount());
+  writer.write<std::uint32_t>(mesh->attributeCount());
+  for (Mn::UnsignedInt iAttribute = 0; iAttribute != mesh->attributeCount();
+       ++iAttribute) {
+    writer.write<std::uint32_t>(
+        Mn::UnsignedInt(mesh->attributeName(iAttribute)));
+    writer.write<std::uint32_t>(
+        Mn::UnsignedInt(mesh->attributeFormat(iAttribute)));
+    writer.write<std::uint64_t>(mesh->attributeOffset(iAttribute));
+    writer.write<std::int32_t>(mesh->attributeStride(iAttribute));
+    writer.write<std::uint32_t>(mesh->attributeArraySize(iAttribute));
+  }
+  writer.writeBlob(mesh->vertexData());
+}
+
+bool readMesh(BakedReader& reader,
+              Cr::Containers::Optional<Mn::Trade::MeshData>& mesh) {
+  std::uint8_t isValid = 0;
+  std::uint32_t primitive = 0;
+  if (!reader.read(isValid)) {
+    return false;
+  }
+  if (!isValid) {
+    return true;
+  }
+
+  std::uint8_t isIndexed = 0;
+  if (!reader.read(primitive) || !reader.read(isIndexed)) {
+    return false;
+  }
+  std::uint32_t indexType = 0, indexCount = 0;
+  std::uint64_t indexOffset = 0;
+  Cr::Containers::Array<char> indexData;
+  if (isIndexed &&
+      (!reader.read(indexType) || !reader.read(indexOffset) ||
+       !reader.read(indexCount) || !reader.readBlob(indexData) ||
+       indexType == 0 ||
+       indexType > Mn::UnsignedInt(BakedLastMeshIndexType) ||
+       indexOffset > indexData.size() ||
+       indexCount > (indexData.size() - indexOffset) /
+                        Mn::meshIndexTypeSize(Mn::MeshIndexType(indexType)))) {
+    return false;
+  }
+
+  struct Attribute {
+    std::uint32_t name, format;
+    std::uint64_t offset;
+    std::int32_t stride;
+    std::uint32_t arraySize;
+  };
+  std::uint32_t vertexCount = 0, numAttributes = 0;
+  if (!reader.read(vertexCount) || !reader.read(numAttributes) ||
+      !reader.canHold(numAttributes, BakedMeshAttributeSize)) {
+    return false;
+  }
+  std::vector<Attribute> attributes(numAttributes);
+  for (Attribute& attribute : attributes) {
+    if (!reader.read(attribute.name) || !reader.read(attribute.format) ||
+        !reader.read(attribute.offset) || !reader.read(attribute.stride) ||
+        !reader.read(attribute.arraySize)) {
+      return false;
+    }
+  }
+  Cr::Containers::Array<char> vertexData;
+  if (!reader.readBlob(vertexData)) {
+    return false;
+  }
+
+  // point the attributes into the owned vertex data
+  Cr::Containers::Array<Mn::Trade::MeshAttributeData> attributeData{
+      numAttributes};
+  for (std::uint32_t iAttribute = 0; iAttribute != numAttributes;
+       ++iAttribute) {
+    const Attribute& attribute = attributes[iAttribute];
+    const Mn::VertexFormat format{attribute.format};
+    // the size of unknown and implementation-specific formats is unknown, so
+    // they can't be bounds checked
+    if (attribute.format == 0 ||
+        attribute.format > Mn::UnsignedInt(BakedLastVertexFormat)) {
+      return false;
+    }
+    // only custom attributes can be arrays
+    const Mn::Trade::MeshAttribute name{attribute.name};
+    if (Mn::Trade::isMeshAttributeCustom(name)
+            ? attribute.arraySize > 0xffff
+            : attribute.name == 0 ||
+                  attribute.name > Mn::UnsignedInt(BakedLastMeshAttribute) ||
+                  attribute.arraySize != 0) {
+      return false;
+    }
+    // the last vertex must fit entirely, not just start inside the data
+    const std::uint64_t dataSize = vertexData.size();
+    const std::uint64_t attributeSize =
+        std::uint64_t(Mn::vertexFormatSize(format)) *
+        std::max(attribute.arraySize, std::uint32_t{1});
+    if (vertexCount &&
+        (attribute.stride < 0 || attribute.offset > dataSize ||
+         attributeSize > dataSize - attribute.offset ||
+         (attribute.stride != 0 &&
+          vertexCount - 1 > (dataSize - attribute.offset - attributeSize) /
+                                std::uint64_t(attribute.stride)))) {
+      return false;
+    }
+    attributeData[iAttribute] = Mn::Trade::MeshAttributeData{
+        name,
+        format,
+        Cr::Containers::StridedArrayView1D<const void>{
+            vertexData, vertexData.data() + attribute.offset, vertexCount,
+            attribute.stride},
+        Mn::UnsignedShort(attribute.arraySize)};
+  }
+
+  if (isIndexed) {
+    Mn::Trade::MeshIndexData indices{
+        Mn::MeshIndexType(indexType),
+        indexData.slice(indexOffset,
+                        indexOffset +
+                            std::size_t{indexCount} *
+                                Mn::meshIndexTypeSize(
+                                    Mn::MeshIndexType(indexType)))};
+    mesh.emplace(Mn::MeshPrimitive(primitive), std::move(indexData), indices,
+                 std::move(vertexData), std::move(attributeData), vertexCount);
+  } else {
+    mesh.emplace(Mn::MeshPrimitive(primitive), std::move(vertexData),
+                 std::move(attributeData), vertexCount);
+  }
+  return true;
+}
+
+void writeMaterial(
+    BakedWriter& writer,
+    const Cr::Containers::Optional<Mn::Trade::MaterialData>& material) {
+  writer.write<std::uint8_t>(bool(material));
+  if (!material) {
+    return;
+  }
+  writer.write<std::uint32_t>(Mn::UnsignedInt(material->types()));
+
+  // pointers are only meaningful within the importer that produced them
+  std::vector<Mn::UnsignedInt> bakedAttributes;
+  for (Mn::UnsignedInt iAttribute = 0;
+       iAttribute != material->attributeCount(); ++iAttribute) {
+    const Mn::Trade::MaterialAttributeType type =
+        material->attributeType(iAttribute);
+    if (type != Mn::Trade::MaterialAttributeType::Pointer &&
+        type != Mn::Trade::MaterialAttributeType::MutablePointer) {
+      bakedAttributes.push_back(iAttribute);
+    }
+  }
+  writer.write<std::uint32_t>(bakedAttributes.size());
+  for (Mn::UnsignedInt iAttribute : bakedAttributes) {
+    const Mn::Trade::MaterialAttributeType type =
+        material->attributeType(iAttribute);
+    const Cr::Containers::StringView name =
+        material->attributeName(iAttribute);
+    writer.writeBlob({name.data(), name.size()});
+    writer.write<std::uint32_t>(Mn::UnsignedInt(type));
+    if (type == Mn::Trade::MaterialAttributeType::String) {
+      const auto value =
+          material->attribute<Cr::Containers::StringView>(iAttribute);
+      writer.writeBlob({value.data(), value.size()});
+    } else {
+      writer.writeBlob({static_cast<const char*>(
+                            material->attribute(iAttribute)),
+                        Mn::Trade::materialAttributeTypeSize(type)});
+    }
+  }
+}
+
+bool readMaterial(
+    BakedReader& reader,
+    Cr::Containers::Optional<Mn::Trade::MaterialData>& material) {
+  std::uint8_t isValid = 0;
+  if (!reader.read(isValid)) {
+    return false;
+  }
+  if (!isValid) {
+    return true;
+  }
+  std::uint32_t types = 0, numAttributes = 0;
+  if (!reader.read(types) || !reader.read(numAttributes) ||
+      !reader.canHold(numAttributes, BakedMinMaterialAttributeSize)) {
+    return false;
+  }
+  Cr::Containers::Array<Mn::Trade::MaterialAttributeData> attributes{
+      numAttributes};
+  for (auto& attribute : attributes) {
+    Cr::Containers::ArrayView<const char> name, value;
+    std::uint32_t type = 0;
+    if (!reader.readView(name) || !reader.read(type) ||
+        !reader.readView(value) || name.empty() || type == 0 ||
+        type > Mn::UnsignedInt(BakedLastMaterialAttributeType)) {
+      return false;
+    }
+    const auto attributeType = Mn::Trade::MaterialAttributeType(type);
+    // the name, value and their terminators have to fit in the attribute
+    const std::size_t terminatorsSize =
+        attributeType == Mn::Trade::MaterialAttributeType::String ? 4 : 2;
+    if (name.size() + value.size() + terminatorsSize >
+        sizeof(Mn::Trade::MaterialAttributeData)) {
+      return false;
+    }
+    if (attributeType == Mn::Trade::MaterialAttributeType::String) {
+      // the attribute copies the string, so a view into the file is enough
+      const Cr::Containers::StringView string{value.data(), value.size()};
+      attribute = Mn::Trade::MaterialAttributeData{
+          Cr::Containers::StringView{name.data(), name.size()}, attributeType,
+          &string};
+    } else {
+      if (value.size() != Mn::Trade::materialAttributeTypeSize(attributeType)) {
+        return false;
+      }
+      attribute = Mn::Trade::MaterialAttributeData{
+          Cr::Containers::StringView{name.data(), name.size()}, attributeType,
+          value.data()};
+    }
+  }
+  Mn::Trade::MaterialTypes materialTypes;
+  for (std::uint32_t bit = 0; bit != 32; ++bit) {
+    if (types & (1u << bit)) {
+      materialTypes |= Mn::Trade::MaterialType(1u << bit);
+    }
+  }
+  material.emplace(materialTypes, std::move(attributes));
+  return true;
+}
+
+}  // namespace
+
+ImportedAsset::ptr ImportedAsset::createFromImporter(Importer& importer,
+                                                     bool optimizeMeshes) {
+  auto importedAsset = ImportedAsset::create();
+  importedAsset->meshesOptimized = optimizeMeshes;
+
+  // Register magnum mesh
+  if (importer.defaultScene() != -1) {
+    Cr::Containers::Optional<Mn::Trade::SceneData> sceneData =
+        importer.scene(importer.defaultScene());
+    if (!sceneData) {
+      LOG(ERROR) << "Cannot load scene, exiting";
+      return nullptr;
+    }
+    for (unsigned int sceneDataID : sceneData->children3D()) {
+      importMeshHierarchy(importer, importedAsset->root, sceneDataID);
+    }
+  } else if (importer.meshCount()) {
+    // no default scene --- standalone OBJ/PLY files, for example
+    // take a wild guess and load the first mesh with the first material
+    importMeshHierarchy(importer, importedAsset->root, 0);
+  } else {
+    LOG(ERROR) << "No default scene available and no meshes found, exiting";
+    return nullptr;
+  }
+
+  for (int iMaterial = 0; iMaterial < importer.materialCount(); ++iMaterial) {
+    importedAsset->materials.emplace_back(importer.material(iMaterial));
+  }
+
+  importedAsset->textures.resize(importer.textureCount());
+  importedAsset->meshes.resize(importer.meshCount());
+  return importedAsset;
+}  // ImportedAsset::createFromImporter
+
+void ImportedAsset::decodeComponent(Importer& importer, int componentID) {
+  const int numTextures = textures.size();
+  if (componentID < numTextures) {
+    textures[componentID] = importTexture(importer, componentID);
+  } else {
+    const int iMesh = componentID - numTextures;
+    meshes[iMesh] = importMesh(importer, iMesh);
+    if (meshesOptimized && meshes[iMesh]) {
+      optimizeMesh(*meshes[iMesh]);
+    }
+  }
+}  // ImportedAsset::decodeComponent
+
+void ImportedAsset::optimizeMeshes() {
+  if (meshesOptimized) {
+    return;
+  }
+  for (auto& mesh : meshes) {
+    if (mesh) {
+      optimizeMesh(*mesh);
+    }
+  }
+  meshesOptimized = true;
+}  // ImportedAsset::optimizeMeshes
+
+std::size_t ImportedAsset::getByteSize() const {
+  std::size_t byteSize = 0;
+  for (const ImportedTexture& texture : textures) {
+    for (const Mn::Trade::ImageData2D& image : texture.levels) {
+      byteSize += image.data().size();
+    }
+  }
+  for (const auto& mesh : meshes) {
+    if (mesh) {
+      byteSize += mesh->indexData().size() + mesh->vertexData().size();
+    }
+  }
+  return byteSize;
+}  // ImportedAsset::getByteSize
+
+bool ImportedAsset::save(const std::string& filename,
+                         const std::string& sourceFilename,
+                         const std::string& basisFormat) const {
+  if (basisFormat.size() >= BakedBasisFormatSize) {
+    LOG(ERROR) << "ImportedAsset::save : Invalid Basis format " << basisFormat;
+    return false;
+  }
+  BakedWriter writer;
+  writer.writeBytes(BakedMagic, sizeof(BakedMagic));
+  writer.write<std::uint64_t>(fileSize(sourceFilename));
+  writer.write<std::int64_t>(io::modificationTime(sourceFilename));
+  char basisFormatField[BakedBasisFormatSize]{};
+  std::memcpy(basisFormatField, basisFormat.data(), basisFormat.size());
+  writer.write(basisFormatField);
+  writer.write<std::uint8_t>(meshesOptimized);
+
+  writer.write<std::uint32_t>(textures.size());
+  writer.write<std::uint32_t>(meshes.size());
+  writer.write<std::uint32_t>(materials.size());
+  for (const ImportedTexture& texture : textures) {
+    if (!writeTexture(writer, texture)) {
+      return false;
+    }
+  }
+  for (const auto& mesh : meshes) {
+    writeMesh(writer, mesh);
+  }
+  for (const auto& material : materials) {
+    writeMaterial(writer, material);
+  }
+  writeHierarchy(writer, root);
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.write(writer.data().data(), writer.data().size())) {
+    LOG(ERROR) << "ImportedAsset::save : Cannot write " << filename;
+    return false;
+  }
+  return true;
+}  // ImportedAsset::save
+
+ImportedAsset::ptr ImportedAsset::load(const std::string& filename,
+                                       const std::string& sourceFilename,
+                                       const std::string& basisFormat) {
+  if (!Cr::Utility::Directory::exists(filename)) {
+    return nullptr;
+  }
+#if defined(CORRADE_TARGET_UNIX) || \
+    (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+  // only the pages actually read are loaded, and stay in the page cache for
+  // the next process loading the same scene
+  const auto data = Cr::Utility::Directory::mapRead(filename);
+#else
+  const auto data = Cr::Utility::Directory::read(filename);
+#endif
+  BakedReader reader{data};
+
+  char magic[sizeof(BakedMagic)]{};
+  std::uint64_t sourceSize = 0;
+  std::int64_t sourceModificationTime = 0;
+  char basisFormatField[BakedBasisFormatSize]{};
+  if (!reader.read(magic) || !reader.read(sourceSize) ||
+      !reader.read(sourceModificationTime) || !reader.read(basisFormatField) ||
+      std::memcmp(magic, BakedMagic, sizeof(BakedMagic)) != 0) {
+    LOG(WARNING) << "ImportedAsset::load : " << filename
+                 << " is not a baked asset of this version, ignoring";
+    return nullptr;
+  }
+  if (sourceSize != fileSize(sourceFilename) ||
+      sourceModificationTime != io::modificationTime(sourceFilename)) {
+    LOG(WARNING) << "ImportedAsset::load : " << filename
+                 << " is out of date with " << sourceFilename << ", ignoring";
+    return nullptr;
+  }
+  if (basisFormat != std::string{basisFormatField,
+                                 strnlen(basisFormatField,
+                                         BakedBasisFormatSize)}) {
+    LOG(WARNING) << "ImportedAsset::load : " << filename
+                 << " was baked for Basis format " << basisFormatField
+                 << " instead of " << basisFormat << ", ignoring";
+    return nullptr;
+  }
+
+  auto importedAsset = ImportedAsset::create();
+  std::uint8_t meshesOptimized = 0;
+  std::uint32_t numTextures = 0, numMeshes = 0, numMaterials = 0;
+  // every texture, mesh and material takes at least a byte
+  bool success = reader.read(meshesOptimized) && reader.read(numTextures) &&
+                 reader.read(numMeshes) && reader.read(numMaterials) &&
+                 reader.canHold(std::uint64_t{numTextures} + numMeshes +
+                                    numMaterials,
+                                sizeof(std::uint8_t));
+  importedAsset->meshesOptimized = meshesOptimized;
+  if (success) {
+    importedAsset->textures.resize(numTextures);
+    importedAsset->meshes.resize(numMeshes);
+    importedAsset->materials.resize(numMaterials);
+  }
+  for (ImportedTexture& texture : importedAsset->textures) {
+    success = success && readTexture(reader, texture);
+  }
+  for (auto& mesh : importedAsset->meshes) {
+    success = success && readMesh(reader, mesh);
+  }
+  for (auto& material : importedAsset->materials) {
+    success = success && readMaterial(reader, material);
+  }
+  success = success && readHierarchy(reader, importedAsset->root) &&
+            reader.atEnd();
+  if (!success) {
+    LOG(ERROR) << "ImportedAsset::load : " << filename
+               << " is corrupt, ignoring";
+    return nullptr;
+  }
+  return importedAsset;
+}  // ImportedAsset::load
+
+//! Recursively load the transformation chain specified by the mesh file
+void ImportedAsset::importMeshHierarchy(Importer& importer,
+                                        MeshTransformNode& parent,
+                                        int componentID) {
+  std::unique_ptr<Mn::Trade::ObjectData3D> objectData =
+      importer.object3D(componentID);
+  if (!objectData) {
+    LOG(ERROR) << "Cannot import object " << importer.object3DName(componentID)
+               << ", skipping";
+    return;
+  }
+
+  // Add the new node to the hierarchy and set its transformation
+  parent.children.push_back(MeshTransformNode());
+  parent.children.back().transformFromLocalToParent =
+      objectData->transformation();
+  parent.children.back().componentID = componentID;
+
+  const int meshIDLocal = objectData->instance();
+
+  // Add a mesh index
+  if (objectData->instanceType() == Mn::Trade::ObjectInstanceType3D::Mesh &&
+      meshIDLocal != ID_UNDEFINED) {
+    parent.children.back().meshIDLocal = meshIDLocal;
+    parent.children.back().materialIDLocal =
+        static_cast<Mn::Trade::MeshObjectData3D*>(objectData.get())
+            ->material();
+  }
+
+  // Recursively add children
+  for (auto childObjectID : objectData->children()) {
+    importMeshHierarchy(importer, parent.children.back(), childObjectID);
+  }
+}  // ImportedAsset::importMeshHierarchy
+
+ImportedTexture ImportedAsset::importTexture(Importer& importer,
+                                             int textureID) {
+  ImportedTexture importedTexture;
+  auto textureData = importer.texture(textureID);
+  if (!textureData ||
+      textureData->type() != Mn::Trade::TextureData::Type::Texture2D) {
+    LOG(ERROR) << "Cannot load texture " << textureID << " skipping";
+    return importedTexture;
+  }
+
+  // Load all mip levels
+  const std::uint32_t levelCount =
+      importer.image2DLevelCount(textureData->image());
+  importedTexture.levels.reserve(levelCount);
+  for (std::uint32_t level = 0; level != levelCount; ++level) {
+    // TODO:
+    // it seems we have a way to just load the image once in this case,
+    // as long as the image2DName include the full path to the image
+    Cr::Containers::Optional<Mn::Trade::ImageData2D> image =
+        importer.image2D(textureData->image(), level);
+    if (!image) {
+      // Mip level loading failed, fail the whole texture
+      LOG(ERROR) << "Cannot load texture image, skipping";
+      importedTexture.levels.clear();
+      return importedTexture;
+    }
+    importedTexture.levels.emplace_back(*std::move(image));
+  }
+
+  importedTexture.textureData = std::move(textureData);
+  return importedTexture;
+}  // ImportedAsset::importTexture
+
+Cr::Containers::Optional<Mn::Trade::MeshData> ImportedAsset::importMesh(
+    Importer& importer,
+    int meshID) {
+  /* Guarantee mesh instance success */
+  Cr::Containers::Optional<Mn::Trade::MeshData> mesh = importer.mesh(meshID);
+  CORRADE_INTERNAL_ASSERT(mesh);
+  // interleave once here, so copies made from it are interleaved already
+  return Mn::MeshTools::interleave(*std::move(mesh));
+}  // ImportedAsset::importMesh
+
+}  // namespace assets
+}  // namespace esp
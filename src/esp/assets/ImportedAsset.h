@@ -0,0 +1,180 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_ASSETS_IMPORTEDASSET_H_
+#define ESP_ASSETS_IMPORTEDASSET_H_
+
+/** @file
+ * @brief Struct @ref esp::assets::ImportedTexture, struct @ref
+ * esp::assets::ImportedAsset
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <Corrade/Containers/Optional.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ImageData.h>
+#include <Magnum/Trade/MaterialData.h>
+#include <Magnum/Trade/MeshData.h>
+#include <Magnum/Trade/TextureData.h>
+
+#include "MeshMetaData.h"
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace assets {
+
+/**
+ * @brief A decoded texture of an asset, ready for upload to the GPU.
+ */
+struct ImportedTexture {
+  //! Sampler parameters, unset if the texture could not be decoded
+  Corrade::Containers::Optional<Magnum::Trade::TextureData> textureData;
+  //! Decoded images of all mip levels
+  std::vector<Magnum::Trade::ImageData2D> levels;
+};
+
+/**
+ * @brief The decoded CPU side data of an asset file: everything needed to
+ * create its GPU resources without touching the file again. Immutable once
+ * built, so it can be shared between @ref ResourceManager instances, which
+ * each create their own GPU resources and mesh copies from it.
+ *
+ * An asset can be baked into a single binary file with @ref save, e.g. by
+ * `datatool bake_asset`, and read back with @ref load without running any
+ * importer, image decoder or Basis transcoder.
+ */
+struct ImportedAsset {
+  /** @brief Convenience typedef for Importer class */
+  using Importer = Magnum::Trade::AbstractImporter;
+
+  //! Decoded textures, indexed by their ID in the file
+  std::vector<ImportedTexture> textures;
+
+  //! Interleaved meshes, indexed by their ID in the file
+  std::vector<Corrade::Containers::Optional<Magnum::Trade::MeshData>> meshes;
+
+  //! Materials, indexed by their ID in the file, unset if they failed to load
+  std::vector<Corrade::Containers::Optional<Magnum::Trade::MaterialData>>
+      materials;
+
+  //! The component transformation hierarchy, in the frame of the file
+  MeshTransformNode root;
+
+  //! Whether the meshes are reordered for rendering by @ref optimizeMesh
+  bool meshesOptimized = false;
+
+  /**
+   * @brief Create an asset with the component hierarchy and materials of the
+   * file opened by importer, and an empty slot for each texture and mesh to
+   * be filled by @ref decodeComponent.
+   * @param importer The importer already loaded with the asset file.
+   * @param optimizeMeshes Whether @ref decodeComponent optimizes meshes for
+   * rendering, see @ref optimizeMesh.
+   * @return The asset, or nullptr if its component hierarchy could not be
+   * loaded.
+   */
+  static ImportedAsset::ptr createFromImporter(Importer& importer,
+                                               bool optimizeMeshes = false);
+
+  /**
+   * @brief Get the number of textures and meshes, see @ref decodeComponent.
+   */
+  int getNumComponents() const { return textures.size() + meshes.size(); }
+
+  /**
+   * @brief Decode a texture or a mesh into its slot. Only accesses importer
+   * and the slot, so different components can be decoded from different
+   * threads, each with its own importer.
+   * @param importer An importer loaded with the asset file.
+   * @param componentID The index of a texture, or the number of textures plus
+   * the index of a mesh.
+   */
+  void decodeComponent(Importer& importer, int componentID);
+
+  /**
+   * @brief Optimize all meshes for rendering with @ref optimizeMesh, if not
+   * already done, e.g. for an asset baked without optimization.
+   */
+  void optimizeMeshes();
+
+  /**
+   * @brief Get the number of bytes of image and mesh data held.
+   */
+  std::size_t getByteSize() const;
+
+  /**
+   * @brief Bake the asset into a binary file.
+   * @param filename The file to write.
+   * @param sourceFilename The asset file the data was decoded from. Its size
+   * and modification time are recorded to detect stale baked files.
+   * @param basisFormat The Basis target format compressed images were
+   * transcoded to.
+   * @return Whether the file was written.
+   */
+  bool save(const std::string& filename,
+            const std::string& sourceFilename,
+            const std::string& basisFormat) const;
+
+  /**
+   * @brief Load an asset baked by @ref save. The file is memory mapped, so
+   * loading amounts to copying its image and mesh data out.
+   * @param filename The baked file.
+   * @param sourceFilename The asset file the baked file must match.
+   * @param basisFormat The Basis target format the baked file must match.
+   * @return The asset, or nullptr if the file can't be read, is corrupt, or
+   * does not match sourceFilename or basisFormat.
+   */
+  static ImportedAsset::ptr load(const std::string& filename,
+                                 const std::string& sourceFilename,
+                                 const std::string& basisFormat);
+
+ private:
+  /**
+   * @brief Recursively parse the mesh component transformation heirarchy for
+   * the imported asset.
+   *
+   * @param importer The importer already loaded with information for the
+   * asset.
+   * @param parent The root of the mesh transform heirarchy for the remaining
+   * sub-tree. The generated @ref MeshTransformNode will be added as a child.
+   * @param componentID The next component to add to the heirarchy. Identifies
+   * the component in the @ref Importer.
+   */
+  static void importMeshHierarchy(Importer& importer,
+                                  MeshTransformNode& parent,
+                                  int componentID);
+
+  /**
+   * @brief Decode a texture and all of its mip levels.
+   *
+   * @param importer The importer already loaded with information for the
+   * asset.
+   * @param textureID The local identifier of the texture in the asset.
+   * @return The decoded texture, without textureData if decoding failed.
+   */
+  static ImportedTexture importTexture(Importer& importer, int textureID);
+
+  /**
+   * @brief Import and interleave a mesh.
+   *
+   * @param importer The importer already loaded with information for the
+   * asset.
+   * @param meshID The local identifier of the mesh in the asset.
+   * @return The mesh data.
+   */
+  static Corrade::Containers::Optional<Magnum::Trade::MeshData> importMesh(
+      Importer& importer,
+      int meshID);
+
+ public:
+  ESP_SMART_POINTERS(ImportedAsset)
+};
+
+}  // namespace assets
+}  // namespace esp
+
+#endif  // ESP_ASSETS_IMPORTEDASSET_H_
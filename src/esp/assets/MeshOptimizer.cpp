@@ -0,0 +1,307 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/Math/FunctionsBatch.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/MeshTools/Interleave.h>
+#include <Magnum/MeshTools/Tipsify.h>
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+namespace esp {
+namespace assets {
+
+namespace {
+
+//! Post-transform vertex cache size assumed by Tipsify, typical for desktop
+//! GPUs and harmless for smaller caches
+constexpr std::size_t VertexCacheSize = 24;
+
+template <class T>
+void writeIndices(Mn::Trade::MeshData& mesh,
+                  Cr::Containers::ArrayView<const uint32_t> indices) {
+  Cr::Containers::StridedArrayView1D<T> meshIndices =
+      mesh.mutableIndices<T>();
+  for (std::size_t iIndex = 0; iIndex < indices.size(); ++iIndex) {
+    meshIndices[iIndex] = T(indices[iIndex]);
+  }
+}
+
+/**
+ * @brief Build the mesh made of the given triangles of an interleaved mesh,
+ * with only the vertices they reference, numbered in first-use order for
+ * fetch locality, and the same, tightly packed, attribute layout.
+ */
+Mn::Trade::MeshData extractSubMesh(const Mn::Trade::MeshData& mesh,
+                                   const std::vector<uint32_t>& indices) {
+  constexpr uint32_t Unassigned = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> newVertexIndex(mesh.vertexCount(), Unassigned);
+  std::vector<uint32_t> keptVertices;
+  Cr::Containers::Array<char> indexData{Cr::Containers::NoInit,
+                                        indices.size() * sizeof(uint32_t)};
+  auto newIndices = Cr::Containers::arrayCast<uint32_t>(indexData);
+  for (std::size_t iIndex = 0; iIndex < indices.size(); ++iIndex) {
+    const uint32_t vertex = indices[iIndex];
+    if (newVertexIndex[vertex] == Unassigned) {
+      newVertexIndex[vertex] = keptVertices.size();
+      keptVertices.push_back(vertex);
+    }
+    newIndices[iIndex] = newVertexIndex[vertex];
+  }
+
+  const Cr::Containers::StridedArrayView2D<const char> vertices =
+      Mn::MeshTools::interleavedData(mesh);
+  const std::size_t vertexSize = vertices.size()[1];
+  const std::size_t vertexBase =
+      static_cast<const char*>(vertices.data()) -
+      static_cast<const char*>(mesh.vertexData().data());
+  Cr::Containers::Array<char> vertexData{Cr::Containers::NoInit,
+                                         keptVertices.size() * vertexSize};
+  for (std::size_t iVertex = 0; iVertex < keptVertices.size(); ++iVertex) {
+    std::memcpy(vertexData.data() + iVertex * vertexSize,
+                vertices[keptVertices[iVertex]].data(), vertexSize);
+  }
+  Cr::Containers::Array<Mn::Trade::MeshAttributeData> attributeData{
+      mesh.attributeCount()};
+  for (Mn::UnsignedInt iAttribute = 0; iAttribute != mesh.attributeCount();
+       ++iAttribute) {
+    attributeData[iAttribute] = Mn::Trade::MeshAttributeData{
+        mesh.attributeName(iAttribute), mesh.attributeFormat(iAttribute),
+        Cr::Containers::StridedArrayView1D<const void>{
+            vertexData,
+            vertexData.data() + mesh.attributeOffset(iAttribute) - vertexBase,
+            keptVertices.size(), std::ptrdiff_t(vertexSize)},
+        mesh.attributeArraySize(iAttribute)};
+  }
+
+  const Mn::Trade::MeshIndexData indexView{newIndices};
+  return Mn::Trade::MeshData{Mn::MeshPrimitive::Triangles,
+                             std::move(indexData),
+                             indexView,
+                             std::move(vertexData),
+                             std::move(attributeData),
+                             Mn::UnsignedInt(keptVertices.size())};
+}
+
+}  // namespace
+
+void optimizeTriangleOrder(Cr::Containers::ArrayView<uint32_t> indices,
+                           uint32_t vertexCount) {
+  if (indices.size() < 6 || indices.size() % 3 != 0) {
+    return;
+  }
+  Mn::MeshTools::tipsifyInPlace(Cr::Containers::stridedArrayView(indices),
+                                vertexCount, VertexCacheSize);
+}
+
+std::vector<uint32_t> optimizeVertexOrder(
+    Cr::Containers::ArrayView<uint32_t> indices,
+    uint32_t vertexCount) {
+  constexpr uint32_t Unassigned = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> remap(vertexCount, Unassigned);
+  uint32_t nextVertex = 0;
+  for (uint32_t& index : indices) {
+    if (remap[index] == Unassigned) {
+      remap[index] = nextVertex++;
+    }
+    index = remap[index];
+  }
+  for (uint32_t& newIndex : remap) {
+    if (newIndex == Unassigned) {
+      newIndex = nextVertex++;
+    }
+  }
+  return remap;
+}
+
+bool optimizeMesh(Mn::Trade::MeshData& mesh) {
+  if (mesh.primitive() != Mn::MeshPrimitive::Triangles || !mesh.isIndexed() ||
+      !(mesh.indexDataFlags() & Mn::Trade::DataFlag::Mutable) ||
+      !(mesh.vertexDataFlags() & Mn::Trade::DataFlag::Mutable) ||
+      !Mn::MeshTools::isInterleaved(mesh)) {
+    return false;
+  }
+
+  Cr::Containers::Array<Mn::UnsignedInt> indices = mesh.indicesAsArray();
+  const uint32_t vertexCount = mesh.vertexCount();
+  optimizeTriangleOrder(indices, vertexCount);
+  const std::vector<uint32_t> remap = optimizeVertexOrder(indices, vertexCount);
+
+  // write back in the original index type, the vertex count is unchanged so
+  // every index still fits
+  switch (mesh.indexType()) {
+    case Mn::MeshIndexType::UnsignedByte:
+      writeIndices<Mn::UnsignedByte>(mesh, indices);
+      break;
+    case Mn::MeshIndexType::UnsignedShort:
+      writeIndices<Mn::UnsignedShort>(mesh, indices);
+      break;
+    case Mn::MeshIndexType::UnsignedInt:
+      writeIndices<Mn::UnsignedInt>(mesh, indices);
+      break;
+  }
+
+  // move every interleaved vertex to its new row
+  Cr::Containers::StridedArrayView2D<char> vertices =
+      Mn::MeshTools::interleavedMutableData(mesh);
+  const std::size_t vertexSize = vertices.size()[1];
+  Cr::Containers::Array<char> original{Cr::Containers::NoInit,
+                                       vertexCount * vertexSize};
+  for (uint32_t iVertex = 0; iVertex < vertexCount; ++iVertex) {
+    std::memcpy(original.data() + iVertex * vertexSize,
+                vertices[iVertex].data(), vertexSize);
+  }
+  for (uint32_t iVertex = 0; iVertex < vertexCount; ++iVertex) {
+    std::memcpy(vertices[remap[iVertex]].data(),
+                original.data() + iVertex * vertexSize, vertexSize);
+  }
+  return true;
+}
+
+Cr::Containers::Optional<Mn::Trade::MeshData> simplifyMesh(
+    const Mn::Trade::MeshData& mesh,
+    float cellSize) {
+  if (mesh.primitive() != Mn::MeshPrimitive::Triangles || !mesh.isIndexed() ||
+      !mesh.hasAttribute(Mn::Trade::MeshAttribute::Position) ||
+      mesh.attributeFormat(Mn::Trade::MeshAttribute::Position) !=
+          Mn::VertexFormat::Vector3 ||
+      !Mn::MeshTools::isInterleaved(mesh) || !(cellSize > 0.0f)) {
+    return Cr::Containers::NullOpt;
+  }
+
+  const Cr::Containers::Array<Mn::Vector3> positions =
+      mesh.positions3DAsArray();
+  const Cr::Containers::Array<Mn::UnsignedInt> indices = mesh.indicesAsArray();
+  if (positions.empty()) {
+    return Cr::Containers::NullOpt;
+  }
+
+  // the first vertex found in each cell represents it, packing the cell
+  // coordinates, biased to be positive, into 21 bits each
+  constexpr float CellBias = 1 << 20;
+  constexpr float MaxCell = (1 << 21) - 1;
+  std::unordered_map<uint64_t, uint32_t> cellVertices;
+  std::vector<uint32_t> representatives(positions.size());
+  std::vector<Mn::Vector3> cellCenters(positions.size());
+  for (uint32_t iVertex = 0; iVertex < positions.size(); ++iVertex) {
+    const Mn::Vector3 cell = Mn::Math::clamp(
+        Mn::Math::floor(positions[iVertex] / cellSize) + Mn::Vector3{CellBias},
+        0.0f, MaxCell);
+    uint64_t key = 0;
+    for (int iAxis = 0; iAxis != 3; ++iAxis) {
+      key = (key << 21) | uint64_t(cell[iAxis]);
+    }
+    const auto inserted = cellVertices.emplace(key, iVertex);
+    if (inserted.second) {
+      cellCenters[iVertex] = (cell - Mn::Vector3{CellBias - 0.5f}) * cellSize;
+    }
+    representatives[iVertex] = inserted.first->second;
+  }
+
+  // keep non-degenerate triangles
+  std::vector<uint32_t> keptIndices;
+  for (std::size_t iIndex = 0; iIndex + 2 < indices.size(); iIndex += 3) {
+    const uint32_t a = representatives[indices[iIndex]];
+    const uint32_t b = representatives[indices[iIndex + 1]];
+    const uint32_t c = representatives[indices[iIndex + 2]];
+    if (a != b && b != c && c != a) {
+      keptIndices.insert(keptIndices.end(), {a, b, c});
+    }
+  }
+  Mn::Trade::MeshData simplified = extractSubMesh(mesh, keptIndices);
+
+  // move the representatives to the centers of their cells, so that meshes
+  // simplified separately, such as neighboring chunks, meet at the same
+  // points
+  Cr::Containers::StridedArrayView1D<Mn::Vector3> simplifiedPositions =
+      simplified.mutableAttribute<Mn::Vector3>(
+          Mn::Trade::MeshAttribute::Position);
+  const Cr::Containers::Array<Mn::UnsignedInt> simplifiedIndices =
+      simplified.indicesAsArray();
+  for (std::size_t iIndex = 0; iIndex < keptIndices.size(); ++iIndex) {
+    simplifiedPositions[simplifiedIndices[iIndex]] =
+        cellCenters[keptIndices[iIndex]];
+  }
+  return simplified;
+}
+
+std::vector<Mn::Trade::MeshData> splitMeshIntoChunks(
+    const Mn::Trade::MeshData& mesh,
+    uint32_t maxChunkTriangles) {
+  std::vector<Mn::Trade::MeshData> chunks;
+  if (mesh.primitive() != Mn::MeshPrimitive::Triangles || !mesh.isIndexed() ||
+      !mesh.hasAttribute(Mn::Trade::MeshAttribute::Position) ||
+      !Mn::MeshTools::isInterleaved(mesh) || maxChunkTriangles == 0 ||
+      mesh.indexCount() / 3 <= maxChunkTriangles) {
+    return chunks;
+  }
+
+  const Cr::Containers::Array<Mn::Vector3> positions =
+      mesh.positions3DAsArray();
+  const Cr::Containers::Array<Mn::UnsignedInt> indices = mesh.indicesAsArray();
+  const uint32_t numTriangles = indices.size() / 3;
+  std::vector<Mn::Vector3> centroids(numTriangles);
+  std::vector<uint32_t> triangles(numTriangles);
+  for (uint32_t iTriangle = 0; iTriangle < numTriangles; ++iTriangle) {
+    centroids[iTriangle] = (positions[indices[3 * iTriangle]] +
+                            positions[indices[3 * iTriangle + 1]] +
+                            positions[indices[3 * iTriangle + 2]]) /
+                           3.0f;
+    triangles[iTriangle] = iTriangle;
+  }
+
+  // split the triangles at the median centroid along the longest axis of their
+  // bounds, like building a BVH, until every leaf is small enough
+  std::vector<std::pair<uint32_t, uint32_t>> ranges{{0, numTriangles}};
+  while (!ranges.empty()) {
+    const std::pair<uint32_t, uint32_t> range = ranges.back();
+    ranges.pop_back();
+    const auto begin = triangles.begin() + range.first;
+    const auto end = triangles.begin() + range.second;
+    if (range.second - range.first > maxChunkTriangles) {
+      Mn::Range3D bounds{centroids[*begin], centroids[*begin]};
+      for (auto triangle = begin; triangle != end; ++triangle) {
+        bounds = Mn::Math::join(
+            bounds, Mn::Range3D{centroids[*triangle], centroids[*triangle]});
+      }
+      const Mn::Vector3 size = bounds.size();
+      const int axis =
+          size.x() >= size.y() ? (size.x() >= size.z() ? 0 : 2)
+                               : (size.y() >= size.z() ? 1 : 2);
+      const uint32_t middle = range.first + (range.second - range.first) / 2;
+      std::nth_element(begin, triangles.begin() + middle, end,
+                       [&](uint32_t a, uint32_t b) {
+                         return centroids[a][axis] < centroids[b][axis];
+                       });
+      ranges.emplace_back(middle, range.second);
+      ranges.emplace_back(range.first, middle);
+      continue;
+    }
+
+    std::vector<uint32_t> chunkIndices;
+    chunkIndices.reserve(3 * (range.second - range.first));
+    for (auto triangle = begin; triangle != end; ++triangle) {
+      chunkIndices.insert(chunkIndices.end(),
+                          indices.begin() + 3 * *triangle,
+                          indices.begin() + 3 * *triangle + 3);
+    }
+    chunks.emplace_back(extractSubMesh(mesh, chunkIndices));
+  }
+  return chunks;
+}
+
+}  // namespace assets
+}  // namespace esp
@@ -0,0 +1,119 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_ASSETS_MESHOPTIMIZER_H_
+#define ESP_ASSETS_MESHOPTIMIZER_H_
+
+/** @file
+ * @brief Import time reordering of mesh indices and vertices for rendering
+ * performance, see @ref esp::assets::optimizeMesh, mesh simplification for
+ * levels of detail, see @ref esp::assets::simplifyMesh, and spatial splitting
+ * for culling, see @ref esp::assets::splitMeshIntoChunks
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Magnum/Trade/MeshData.h>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace assets {
+
+/**
+ * @brief Reorder the triangles of a triangle list so that consecutive
+ * triangles share vertices, making better use of the post-transform vertex
+ * cache. The triangles themselves, including their winding, are unchanged.
+ * @param indices The triangle list indices, reordered in place.
+ * @param vertexCount The number of vertices the indices refer to.
+ */
+void optimizeTriangleOrder(Corrade::Containers::ArrayView<uint32_t> indices,
+                           uint32_t vertexCount);
+
+/**
+ * @brief Renumber vertices in the order they are first referenced by the
+ * indices, so that vertex fetches walk the vertex buffer mostly linearly.
+ * Unreferenced vertices are moved to the end.
+ * @param indices The indices, rewritten in place to the new numbering.
+ * @param vertexCount The number of vertices the indices refer to.
+ * @return The new index of each old vertex, to be applied to every vertex
+ * attribute with @ref remapVertices.
+ */
+std::vector<uint32_t> optimizeVertexOrder(
+    Corrade::Containers::ArrayView<uint32_t> indices,
+    uint32_t vertexCount);
+
+/**
+ * @brief Move every vertex attribute value to its new index.
+ * @param vertices The attribute values, one per vertex.
+ * @param remap The new index of each vertex, as returned by @ref
+ * optimizeVertexOrder.
+ */
+template <class T>
+void remapVertices(std::vector<T>& vertices,
+                   const std::vector<uint32_t>& remap) {
+  std::vector<T> remapped(vertices.size());
+  for (size_t iVertex = 0; iVertex < vertices.size(); ++iVertex) {
+    remapped[remap[iVertex]] = vertices[iVertex];
+  }
+  vertices.swap(remapped);
+}
+
+/**
+ * @brief Optimize an indexed triangle mesh for rendering with @ref
+ * optimizeTriangleOrder and @ref optimizeVertexOrder. Positions and other
+ * attributes keep their format.
+ * @param mesh An interleaved mesh with mutable index and vertex data, as
+ * produced by @ref Magnum::MeshTools::interleave.
+ * @return Whether the mesh was optimized. Meshes that are not indexed
+ * triangle lists or whose data is not mutable are left untouched.
+ */
+bool optimizeMesh(Magnum::Trade::MeshData& mesh);
+
+/**
+ * @brief Simplify an indexed triangle mesh by vertex clustering: vertices are
+ * snapped to the center of their cell in a grid of cubic cells, each cell
+ * keeping the attributes of one of its vertices, and triangles collapsing to a
+ * line or a point are dropped. Robust for the unstructured triangle soups of
+ * scanned scenes and linear in the mesh size, at the cost of topology, which
+ * is not preserved. The grid has a corner at the origin whatever the mesh, so
+ * pieces of a mesh simplified with the same cell size still meet.
+ * @param mesh An interleaved mesh with @ref Magnum::VertexFormat::Vector3
+ * positions, as produced by @ref Magnum::MeshTools::interleave.
+ * @param cellSize The edge length of the grid cells, in mesh units. No vertex
+ * moves by more than half the cell diagonal, i.e. `cellSize*sqrt(3)/2`.
+ * @return The simplified mesh, interleaved with the same attribute layout and
+ * with @ref Magnum::MeshIndexType::UnsignedInt indices, or
+ * @ref Corrade::Containers::NullOpt if the mesh is not an indexed triangle
+ * list.
+ */
+Corrade::Containers::Optional<Magnum::Trade::MeshData> simplifyMesh(
+    const Magnum::Trade::MeshData& mesh,
+    float cellSize);
+
+/**
+ * @brief Split a large indexed triangle mesh into spatially compact chunks,
+ * so that each can be culled on its own. Triangles are recursively split at
+ * the median of their centroids along the longest axis, like the leaves of a
+ * bounding volume hierarchy, so chunks have about the same triangle count
+ * however unevenly the mesh is tessellated. Vertices shared by triangles of
+ * different chunks are duplicated.
+ * @param mesh An interleaved mesh, as produced by @ref
+ * Magnum::MeshTools::interleave.
+ * @param maxChunkTriangles The maximum number of triangles per chunk.
+ * @return The chunks, interleaved with the same attribute layout and with
+ * @ref Magnum::MeshIndexType::UnsignedInt indices. Empty if the mesh is small
+ * enough already or is not an indexed triangle list.
+ */
+std::vector<Magnum::Trade::MeshData> splitMeshIntoChunks(
+    const Magnum::Trade::MeshData& mesh,
+    uint32_t maxChunkTriangles);
+
+}  // namespace assets
+}  // namespace esp
+
+#endif  // ESP_ASSETS_MESHOPTIMIZER_H_
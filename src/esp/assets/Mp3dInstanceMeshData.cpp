@@ -5,7 +5,6 @@
 #include "Mp3dInstanceMeshData.h"
 
 #include <fstream>
-#include <sstream>
 #include <vector>
 
 #include <sophus/so3.hpp>
@@ -22,99 +21,59 @@
 
 #include "esp/core/esp.h"
 #include "esp/geo/geo.h"
+#include "esp/io/PlyFile.h"
 #include "esp/io/io.h"
 
 namespace esp {
 namespace assets {
 
 bool Mp3dInstanceMeshData::loadMp3dPLY(const std::string& plyFile) {
-  std::ifstream ifs(plyFile);
-  if (!ifs.good()) {
+  io::PlyFile ply;
+  if (!ply.open(plyFile)) {
     LOG(ERROR) << "Cannot open file at " << plyFile;
     return false;
   }
 
-  std::string line, token;
-  std::istringstream iss;
-  std::getline(ifs, line);
-  if (line != "ply") {
-    LOG(ERROR) << "Invalid ply file header";
-    return false;
-  }
-  std::getline(ifs, line);
-  if (line != "format binary_little_endian 1.0") {
-    LOG(ERROR) << "Invalid ply file header";
+  auto x = ply.view<float>("vertex", "x");
+  auto y = ply.view<float>("vertex", "y");
+  auto z = ply.view<float>("vertex", "z");
+  auto red = ply.view<uint8_t>("vertex", "red");
+  auto green = ply.view<uint8_t>("vertex", "green");
+  auto blue = ply.view<uint8_t>("vertex", "blue");
+  if (!x || !y || !z || !red || !green || !blue) {
+    LOG(ERROR) << "Invalid element vertex header lines";
     return false;
   }
 
-  // element vertex nVertex
-  std::getline(ifs, line);
-  iss.str(line);
-  iss >> token;
-  if (token != "element") {
-    LOG(ERROR) << "Invalid element vertex header line";
+  auto indices = ply.listView<uint32_t>("face", "vertex_indices");
+  auto materialIds = ply.view<int32_t>("face", "material_id");
+  auto segmentIds = ply.view<int32_t>("face", "segment_id");
+  auto categoryIds = ply.view<int32_t>("face", "category_id");
+  if (!indices || indices->size()[1] != 3 || !materialIds || !segmentIds ||
+      !categoryIds) {
+    LOG(ERROR) << "Invalid element face header lines";
     return false;
   }
-  int nVertex;
-  iss >> token >> nVertex;
-
-  // we know the header is fixed so skip until face count
-  do {
-    std::getline(ifs, line);
-  } while ((line.substr(0, 12) != "element face") && !ifs.eof());
-  std::stringstream iss2;
-  iss2.str(line);
-  iss2 >> token;
-  if (token != "element") {
-    LOG(ERROR) << "Invalid element face header line";
-    return false;
-  }
-  int nFace;
-  iss2 >> token >> nFace;
-
-  // ignore rest of header
-  do {
-    std::getline(ifs, line);
-  } while ((line != "end_header") && !ifs.eof());
-
-  cpu_cbo_.clear();
-  cpu_cbo_.reserve(nVertex);
-  cpu_vbo_.clear();
-  cpu_vbo_.reserve(nVertex);
-  cpu_ibo_.clear();
-  cpu_ibo_.reserve(nFace);
-
-  for (int i = 0; i < nVertex; ++i) {
-    vec3f position;
-    vec3f normal;
-    vec2f texCoords;
-    vec3uc rgb;
-
-    ifs.read(reinterpret_cast<char*>(position.data()), 3 * sizeof(float));
-    ifs.read(reinterpret_cast<char*>(normal.data()), 3 * sizeof(float));
-    ifs.read(reinterpret_cast<char*>(texCoords.data()), 2 * sizeof(float));
-    ifs.read(reinterpret_cast<char*>(rgb.data()), 3 * sizeof(uint8_t));
-    cpu_vbo_.emplace_back(position);
-    cpu_cbo_.emplace_back(rgb);
+
+  const size_t nVertex = x->size();
+  cpu_vbo_.resize(nVertex);
+  cpu_cbo_.resize(nVertex);
+  for (size_t i = 0; i < nVertex; ++i) {
+    cpu_vbo_[i] = vec3f((*x)[i], (*y)[i], (*z)[i]);
+    cpu_cbo_[i] = vec3uc((*red)[i], (*green)[i], (*blue)[i]);
   }
 
-  for (int i = 0; i < nFace; ++i) {
-    uint8_t nIndices;
-    vec3ui indices;
-    int32_t materialId;
-    int32_t segmentId;
-    int32_t categoryId;
-
-    ifs.read(reinterpret_cast<char*>(&nIndices), sizeof(nIndices));
-    ASSERT(nIndices == 3);
-    ifs.read(reinterpret_cast<char*>(indices.data()), 3 * sizeof(int));
-    ifs.read(reinterpret_cast<char*>(&materialId), sizeof(materialId));
-    ifs.read(reinterpret_cast<char*>(&segmentId), sizeof(segmentId));
-    ifs.read(reinterpret_cast<char*>(&categoryId), sizeof(categoryId));
-    cpu_ibo_.emplace_back(indices);
-    materialIds_.emplace_back(materialId);
-    segmentIds_.emplace_back(segmentId);
-    categoryIds_.emplace_back(categoryId);
+  const size_t nFace = indices->size()[0];
+  cpu_ibo_.resize(nFace);
+  materialIds_.resize(nFace);
+  segmentIds_.resize(nFace);
+  categoryIds_.resize(nFace);
+  for (size_t i = 0; i < nFace; ++i) {
+    cpu_ibo_[i] =
+        vec3ui((*indices)[i][0], (*indices)[i][1], (*indices)[i][2]);
+    materialIds_[i] = (*materialIds)[i];
+    segmentIds_[i] = (*segmentIds)[i];
+    categoryIds_[i] = (*categoryIds)[i];
   }
 
   // Construct vertices for meshData
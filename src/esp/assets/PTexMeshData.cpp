@@ -4,14 +4,16 @@
 
 #include "PTexMeshData.h"
 
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <cstring>
 #include <unordered_map>
 #include <vector>
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -23,6 +25,7 @@
 
 #include "esp/core/esp.h"
 #include "esp/gfx/PTexMeshShader.h"
+#include "esp/io/PlyFile.h"
 #include "esp/io/io.h"
 #include "esp/io/json.h"
 
@@ -293,91 +296,112 @@ std::vector<PTexMeshData::MeshData> loadSubMeshes(
   // sanity checks
   CORRADE_ASSERT(!filename.empty(),
                  "PTexMeshData::loadSubMeshes: filename cannot be empty.", {});
-  std::ifstream file;
-  file.open(filename, std::ios::in | std::ios::binary);
+  const Cr::Containers::Array<const char, Cr::Utility::Directory::MapDeleter>
+      data = Cr::Utility::Directory::mapRead(filename);
   CORRADE_ASSERT(
-      file.good(),
-      "PTexMeshData::loadSubMeshes: cannot open the file " << filename, {});
+      data, "PTexMeshData::loadSubMeshes: cannot open the file " << filename,
+      {});
 
   uint64_t numSubMeshes = 0;
-  file.read(reinterpret_cast<char*>(&numSubMeshes), sizeof(uint64_t));
-
-  std::vector<PTexMeshData::MeshData> subMeshes(numSubMeshes);
-
+  CORRADE_ASSERT(data.size() >= sizeof(uint64_t),
+                 "PTexMeshData::loadSubMeshes: the file " << filename
+                                                          << " is truncated",
+                 {});
+  std::memcpy(&numSubMeshes, data.data(), sizeof(uint64_t));
+
+  // the face indices in the *original* mesh of each sub-mesh, viewed in the
+  // mapped file. Only the sizes are read here, so that the sub-meshes can
+  // then be built in parallel.
+  std::vector<Cr::Containers::ArrayView<const uint32_t>> originalFaces;
+  originalFaces.reserve(numSubMeshes);
+  size_t offset = sizeof(uint64_t);
   size_t totalFaces = 0;  // used in sanity check
   for (uint64_t iMesh = 0; iMesh < numSubMeshes; ++iMesh) {
     uint64_t numFaces = 0;
-    file.read(reinterpret_cast<char*>(&numFaces), sizeof(uint64_t));
-
-    std::vector<uint32_t> originalFaces(numFaces);
-    // load the face indices in the *original* mesh
-    file.read(reinterpret_cast<char*>(originalFaces.data()),
-              sizeof(uint32_t) * numFaces);
-    // a *vertex* lookup table:
-    // global index of the original mesh --> local index in sub-meshes
-    // (note: this table cannot be defined outside of the for loop, as a vertex
-    // in original mesh may appear in different sub-meshes.)
-    std::unordered_map<uint32_t, uint32_t> globalToLocal;
-
-    // Another *vertex* lookup table:
-    // local index of current sub-mesh --> global index of the original mesh
-    std::vector<uint32_t> localToGlobal;
-
-    // compute the two lookup tables
-    for (size_t jFace = 0; jFace < numFaces; ++jFace) {
-      uint32_t f = originalFaces[jFace];  // face index in original mesh
-      for (size_t v = 0; v < 4; ++v) {
-        uint32_t global = mesh.ibo[f * 4 + v];
-        if (globalToLocal.find(global) == globalToLocal.end()) {
-          globalToLocal[global] = localToGlobal.size();
-          localToGlobal.push_back(global);
-        }
-      }
-    }
-
-    // compute the ibo for the current sub-mesh
-    auto& ibo = subMeshes[iMesh].ibo;
-    ibo.resize(numFaces * 4);
-    uint64_t idx = 0;
-    for (size_t jFace = 0; jFace < numFaces; ++jFace) {
-      uint32_t f = originalFaces[jFace];
-      for (size_t v = 0; v < 4; ++v) {
-        uint32_t global = mesh.ibo[f * 4 + v];
-        uint32_t local = globalToLocal[global];
-        CORRADE_ASSERT(local >= 0,
-                       "PTexMeshData::loadSubMeshes: vertex "
-                           << global << " is not in the sub-mesh " << iMesh,
-                       {});
-        ibo[idx++] = local;
-      }
-    }  // for jFace
-
-    // this is to break the quad into 2 triangles
-    // we need this triangle mesh to do object picking
-    computeTriangleMeshIndices(numFaces, subMeshes[iMesh]);
-
-    // compute the vbo, nbo for the current sub-mesh
-    uint64_t numVertices = localToGlobal.size();
-    subMeshes[iMesh].vbo.resize(numVertices);
-    subMeshes[iMesh].nbo.resize(numVertices);
-    for (size_t jLocal = 0; jLocal < numVertices; ++jLocal) {
-      uint32_t global = localToGlobal[jLocal];
-      subMeshes[iMesh].vbo[jLocal] = mesh.vbo[global];
-      subMeshes[iMesh].nbo[jLocal] = mesh.nbo[global];
-    }
-
-    // Careful:
-    // for Ptex mesh we never ever set the "cbo"
-
+    CORRADE_ASSERT(offset + sizeof(uint64_t) <= data.size(),
+                   "PTexMeshData::loadSubMeshes: the file " << filename
+                                                            << " is truncated",
+                   {});
+    std::memcpy(&numFaces, data.data() + offset, sizeof(uint64_t));
+    offset += sizeof(uint64_t);
+    CORRADE_ASSERT(offset + numFaces * sizeof(uint32_t) <= data.size(),
+                   "PTexMeshData::loadSubMeshes: the file " << filename
+                                                            << " is truncated",
+                   {});
+    // 4-byte aligned, as everything before is a multiple of 4 bytes
+    originalFaces.emplace_back(
+        reinterpret_cast<const uint32_t*>(data.data() + offset), numFaces);
+    offset += numFaces * sizeof(uint32_t);
     totalFaces += numFaces;
-  }  // for iMesh
-  file.close();
+  }
   CORRADE_ASSERT(totalFaces == mesh.ibo.size() / 4,
                  "PTexMeshData::loadSubMeshes: the number of faces loaded from "
                  "the file does not "
                  "match it from the ptex mesh.",
                  {});
 
+  std::vector<PTexMeshData::MeshData> subMeshes(numSubMeshes);
+  const size_t numOriginalFaces = totalFaces;
+  const size_t numOriginalVertices = mesh.vbo.size();
+  constexpr uint32_t UNASSIGNED = 0xFFFFFFFF;
+
+#pragma omp parallel
+  {
+    // a *vertex* lookup table:
+    // global index of the original mesh --> local index in sub-meshes
+    // A flat array over all vertices instead of a hash map, one per thread
+    // and reset after each sub-mesh by walking the vertices it touched, as a
+    // vertex in the original mesh may appear in different sub-meshes.
+    std::vector<uint32_t> globalToLocal(numOriginalVertices, UNASSIGNED);
+
+#pragma omp for schedule(dynamic)
+    for (size_t iMesh = 0; iMesh < numSubMeshes; ++iMesh) {
+      const Cr::Containers::ArrayView<const uint32_t> faces =
+          originalFaces[iMesh];
+      const size_t numFaces = faces.size();
+
+      // Another *vertex* lookup table:
+      // local index of current sub-mesh --> global index of the original mesh
+      std::vector<uint32_t> localToGlobal;
+
+      // compute the two lookup tables and the ibo for the current sub-mesh
+      auto& ibo = subMeshes[iMesh].ibo;
+      ibo.resize(numFaces * 4);
+      for (size_t jFace = 0; jFace < numFaces; ++jFace) {
+        uint32_t f = faces[jFace];  // face index in original mesh
+        CORRADE_INTERNAL_ASSERT(f < numOriginalFaces);
+        for (size_t v = 0; v < 4; ++v) {
+          uint32_t global = mesh.ibo[f * 4 + v];
+          CORRADE_INTERNAL_ASSERT(global < numOriginalVertices);
+          uint32_t& local = globalToLocal[global];
+          if (local == UNASSIGNED) {
+            local = localToGlobal.size();
+            localToGlobal.push_back(global);
+          }
+          ibo[jFace * 4 + v] = local;
+        }
+      }  // for jFace
+
+      // this is to break the quad into 2 triangles
+      // we need this triangle mesh to do object picking
+      computeTriangleMeshIndices(numFaces, subMeshes[iMesh]);
+
+      // compute the vbo, nbo for the current sub-mesh
+      uint64_t numVertices = localToGlobal.size();
+      subMeshes[iMesh].vbo.resize(numVertices);
+      subMeshes[iMesh].nbo.resize(numVertices);
+      for (size_t jLocal = 0; jLocal < numVertices; ++jLocal) {
+        uint32_t global = localToGlobal[jLocal];
+        subMeshes[iMesh].vbo[jLocal] = mesh.vbo[global];
+        subMeshes[iMesh].nbo[jLocal] = mesh.nbo[global];
+        globalToLocal[global] = UNASSIGNED;
+      }
+
+      // Careful:
+      // for Ptex mesh we never ever set the "cbo"
+    }  // for iMesh
+  }
+
   LOG(INFO) << "The number of quads: " << totalFaces << ", which equals to "
             << totalFaces * 2 << " triangles.";
 
@@ -490,313 +514,89 @@ void PTexMeshData::loadMeshData(const std::string& meshFile) {
 
 void PTexMeshData::parsePLY(const std::string& filename,
                             PTexMeshData::MeshData& meshData) {
-  std::vector<std::string> comments;
-  std::vector<std::string> objInfo;
-
-  std::string lastElement;
-  std::string lastProperty;
-
-  enum Properties { POSITION = 0, NORMAL, COLOR, NUM_PROPERTIES };
-
-  size_t numVertices = 0;
-
-  size_t positionDimensions = 0;
-  size_t normalDimensions = 0;
-  size_t colorDimensions = 0;
-
-  std::vector<Properties> vertexLayout;
-
-  size_t numFaces = 0;
-
-  std::ifstream file(filename, std::ios::binary);
-
-  // Header parsing
-  {
-    std::string line;
-
-    while (std::getline(file, line)) {
-      std::istringstream ls(line);
-      std::string token;
-      ls >> token;
-
-      if (token == "ply" || token == "PLY" || token == "") {
-        // Skip preamble line
-        continue;
-      } else if (token == "comment") {
-        // Just store these incase
-        comments.push_back(line.erase(0, 8));
-      } else if (token == "format") {
-        // We can only parse binary data, so check that's what it is
-        std::string s;
-        ls >> s;
-        CORRADE_ASSERT(s == "binary_little_endian",
-                       "PTexMeshData::parsePLY: the file is not a binary file "
-                       "in little endian byte order", );
-      } else if (token == "element") {
-        std::string name;
-        size_t size;
-        ls >> name >> size;
-
-        if (name == "vertex") {
-          // Pull out the number of vertices
-          numVertices = size;
-        } else if (name == "face") {
-          // Pull out number of faces
-          numFaces = size;
-          CORRADE_ASSERT(numFaces > 0,
-                         "PTexMeshData::parsePLY: number of faces is not "
-                         "greater than 0.", );
-        } else {
-          CORRADE_ASSERT(
-              false, "PTexMeshData::parsePLY: Cannot parse element" << name, );
-        }
-
-        // Keep track of what element we parsed last to associate the
-        // properties that follow
-        lastElement = name;
-      } else if (token == "property") {
-        std::string type, name;
-        ls >> type;
-
-        // Special parsing for list properties (e.g. faces)
-        bool isList = false;
-
-        if (type == "list") {
-          isList = true;
-
-          std::string countType;
-          ls >> countType >> type;
-
-          CORRADE_ASSERT(countType == "uchar" || countType == "uint8",
-                         "PTexMeshData::parsePLY: Don't understand count type"
-                             << countType, );
-
-          CORRADE_ASSERT(
-              type == "int",
-              "PTexMeshData::parsePLY: Don't understand index type" << type, );
-
-          CORRADE_ASSERT(lastElement == "face",
-                         "PTexMeshData::parsePLY: Only expecting list after "
-                         "face element, not after"
-                             << lastElement, );
-        }
-
-        CORRADE_ASSERT(
-            type == "float" || type == "int" || type == "uchar" ||
-                type == "uint8",
-            "PTexMeshData::parsePLY: Don't understand type" << type, );
-
-        ls >> name;
-
-        // Collecting vertex property information
-        if (lastElement == "vertex") {
-          CORRADE_ASSERT(type != "int",
-                         "PTexMeshData::parsePLY: Don't support 32-bit integer "
-                         "properties", );
-
-          // Position information
-          if (name == "x") {
-            positionDimensions = 1;
-            vertexLayout.push_back(Properties::POSITION);
-            CORRADE_ASSERT(type == "float",
-                           "PTexMeshData::parsePLY: Don't support 8-bit "
-                           "integer positions", );
-          } else if (name == "y") {
-            CORRADE_ASSERT(lastProperty == "x",
-                           "PTexMeshData::parsePLY: Properties should follow "
-                           "x, y, z, (w) order", );
-            positionDimensions = 2;
-          } else if (name == "z") {
-            CORRADE_ASSERT(lastProperty == "y",
-                           "PTexMeshData::parsePLY: Properties should follow "
-                           "x, y, z, (w) order", );
-            positionDimensions = 3;
-          } else if (name == "w") {
-            CORRADE_ASSERT(lastProperty == "z",
-                           "PTexMeshData::parsePLY: Properties should follow "
-                           "x, y, z, (w) order", );
-            positionDimensions = 4;
-          }
-
-          // Normal information
-          if (name == "nx") {
-            normalDimensions = 1;
-            vertexLayout.push_back(Properties::NORMAL);
-            CORRADE_ASSERT(type == "float",
-                           "PTexMeshData::parsePLY: Don't support 8-bit "
-                           "integer normals", );
-          } else if (name == "ny") {
-            CORRADE_ASSERT(lastProperty == "nx",
-                           "PTexMeshData::parsePLY: Properties should follow "
-                           "nx, ny, nz order", );
-            normalDimensions = 2;
-          } else if (name == "nz") {
-            CORRADE_ASSERT(lastProperty == "ny",
-                           "PTexMeshData::parsePLY: Properties should follow "
-                           "nx, ny, nz order", );
-            normalDimensions = 3;
-          }
-
-          // Color information
-          if (name == "red") {
-            colorDimensions = 1;
-            vertexLayout.push_back(Properties::COLOR);
-            CORRADE_ASSERT(type == "uchar" || type == "uint8",
-                           "PTexMeshData::parsePLY: Don't support non-8-bit "
-                           "integer colors", );
-          } else if (name == "green") {
-            CORRADE_ASSERT(lastProperty == "red",
-                           "PTexMeshData::parsePLY: Properties should follow "
-                           "red, green, blue, (alpha) order", );
-            colorDimensions = 2;
-          } else if (name == "blue") {
-            CORRADE_ASSERT(lastProperty == "green",
-                           "PTexMeshData::parsePLY: Properties should follow "
-                           "red, green, blue, (alpha) order", );
-            colorDimensions = 3;
-          } else if (name == "alpha") {
-            CORRADE_ASSERT(lastProperty == "blue",
-                           "PTexMeshData::parsePLY: Properties should follow "
-                           "red, green, blue, (alpha) order", );
-            colorDimensions = 4;
-          }
-        } else if (lastElement == "face") {
-          CORRADE_ASSERT(isList,
-                         "PTexMeshData::parsePLY: No idea what to do with "
-                         "properties following faces", );
-        } else {
-          // No idea what to do with properties before elements
-          CORRADE_INTERNAL_ASSERT_UNREACHABLE();
-        }
-
-        lastProperty = name;
-      } else if (token == "obj_info") {
-        // Just store these incase
-        objInfo.push_back(line.erase(0, 9));
-      } else if (token == "end_header") {
-        // Done reading!
-        break;
-      } else {
-        // Something unrecognised
-        CORRADE_INTERNAL_ASSERT_UNREACHABLE();
-      }
-    }
-
-    // Check things make sense.
-    CORRADE_ASSERT(
-        numVertices > 0,
-        "PTexMeshData::parsePLY: number of vertices is not greater than 0", );
-    CORRADE_ASSERT(positionDimensions > 0,
-                   "PTexMeshData::parsePLY: the dimensions of the position is "
-                   "not greater than 0", );
-    CORRADE_ASSERT(
-        positionDimensions == 3,
-        "PTexMeshData::parsePLY: the dimensions of the position must be 3.", );
+  io::PlyFile ply;
+  if (!ply.open(filename)) {
+    Cr::Utility::Fatal{-1} << "PTexMeshData::parsePLY: cannot parse"
+                           << filename;
   }
 
-  meshData.vbo.resize(numVertices, vec3f(0, 0, 0));
-
-  if (normalDimensions) {
-    meshData.nbo.resize(numVertices, vec4f(0, 0, 0, 1));
-  }
-
-  if (colorDimensions) {
-    meshData.cbo.resize(numVertices, vec4uc(0, 0, 0, 255));
+  const io::PlyFile::Element* vertices = ply.element("vertex");
+  CORRADE_ASSERT(vertices && vertices->count > 0,
+                 "PTexMeshData::parsePLY: number of vertices is not greater "
+                 "than 0", );
+  const size_t numVertices = vertices->count;
+
+  // the views point straight into the mapped file, only the unpacking into
+  // the aligned buffers the renderer needs is left, split across threads
+  auto x = ply.view<float>("vertex", "x");
+  auto y = ply.view<float>("vertex", "y");
+  auto z = ply.view<float>("vertex", "z");
+  CORRADE_ASSERT(x && y && z,
+                 "PTexMeshData::parsePLY: the position must have float x, y "
+                 "and z.", );
+  meshData.vbo.resize(numVertices);
+#pragma omp parallel for
+  for (size_t i = 0; i < numVertices; i++) {
+    meshData.vbo[i] = vec3f((*x)[i], (*y)[i], (*z)[i]);
   }
 
-  // Can only be FLOAT32 or UINT8
-  const size_t positionBytes = positionDimensions * sizeof(float);  // floats
-  const size_t normalBytes = normalDimensions * sizeof(float);      // floats
-  const size_t colorBytes = colorDimensions * sizeof(uint8_t);      // bytes
-
-  const size_t vertexPacketSizeBytes = positionBytes + normalBytes + colorBytes;
-
-  size_t positionOffsetBytes = 0;
-  size_t normalOffsetBytes = 0;
-  size_t colorOffsetBytes = 0;
-
-  size_t offsetSoFarBytes = 0;
-
-  for (size_t i = 0; i < vertexLayout.size(); i++) {
-    if (vertexLayout[i] == Properties::POSITION) {
-      positionOffsetBytes = offsetSoFarBytes;
-      offsetSoFarBytes += positionBytes;
-    } else if (vertexLayout[i] == Properties::NORMAL) {
-      normalOffsetBytes = offsetSoFarBytes;
-      offsetSoFarBytes += normalBytes;
-    } else if (vertexLayout[i] == Properties::COLOR) {
-      colorOffsetBytes = offsetSoFarBytes;
-      offsetSoFarBytes += colorBytes;
-    } else {
-      CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+  if (ply.property("vertex", "nx")) {
+    auto nx = ply.view<float>("vertex", "nx");
+    auto ny = ply.view<float>("vertex", "ny");
+    auto nz = ply.view<float>("vertex", "nz");
+    CORRADE_ASSERT(nx && ny && nz,
+                   "PTexMeshData::parsePLY: the normal must have float nx, "
+                   "ny and nz.", );
+    meshData.nbo.resize(numVertices);
+#pragma omp parallel for
+    for (size_t i = 0; i < numVertices; i++) {
+      meshData.nbo[i] = vec4f((*nx)[i], (*ny)[i], (*nz)[i], 1);
     }
   }
 
-  // Close after parsing header and re-open memory mapped
-  const size_t postHeader = file.tellg();
-
-  file.close();
-
-  Cr::Containers::Array<const char, Cr::Utility::Directory::MapDeleter>
-      mmappedData = Cr::Utility::Directory::mapRead(filename);
-
-  const size_t fileSize = io::fileSize(filename);
-
-  // Parse each vertex packet and unpack
-  const char* bytes = mmappedData + postHeader;
-
-  for (size_t i = 0; i < numVertices; i++) {
-    const char* nextBytes = bytes + vertexPacketSizeBytes * i;
-
-    memcpy(meshData.vbo[i].data(), &nextBytes[positionOffsetBytes],
-           positionBytes);
-
-    if (normalDimensions)
-      memcpy(meshData.nbo[i].data(), &nextBytes[normalOffsetBytes],
-             normalBytes);
-
-    if (colorDimensions)
-      memcpy(meshData.cbo[i].data(), &nextBytes[colorOffsetBytes], colorBytes);
+  if (ply.property("vertex", "red")) {
+    auto red = ply.view<uint8_t>("vertex", "red");
+    auto green = ply.view<uint8_t>("vertex", "green");
+    auto blue = ply.view<uint8_t>("vertex", "blue");
+    CORRADE_ASSERT(red && green && blue,
+                   "PTexMeshData::parsePLY: Don't support non-8-bit "
+                   "integer colors", );
+    Cr::Containers::Optional<io::PlyFile::View<uint8_t>> alpha;
+    if (ply.property("vertex", "alpha")) {
+      alpha = ply.view<uint8_t>("vertex", "alpha");
+    }
+    meshData.cbo.resize(numVertices);
+#pragma omp parallel for
+    for (size_t i = 0; i < numVertices; i++) {
+      meshData.cbo[i] = vec4uc((*red)[i], (*green)[i], (*blue)[i],
+                               alpha ? (*alpha)[i] : 255);
+    }
   }
 
-  const size_t bytesSoFar = postHeader + vertexPacketSizeBytes * numVertices;
-
-  bytes = mmappedData + postHeader + vertexPacketSizeBytes * numVertices;
-
-  // Read first face to get number of indices;
-  const uint8_t faceDimensions = *bytes;
-
+  const io::PlyFile::Element* faces = ply.element("face");
+  CORRADE_ASSERT(faces && faces->count > 0,
+                 "PTexMeshData::parsePLY: number of faces is not greater "
+                 "than 0.", );
+  auto indexList =
+      std::find_if(faces->properties.begin(), faces->properties.end(),
+                   [](const io::PlyFile::Property& p) { return p.isList; });
+  CORRADE_ASSERT(indexList != faces->properties.end(),
+                 "PTexMeshData::parsePLY: faces have no index list.", );
+  auto indices = ply.listView<uint32_t>("face", indexList->name);
+  CORRADE_ASSERT(indices, "PTexMeshData::parsePLY: Don't understand index type",
+                 );
+  const size_t faceDimensions = indices->size()[1];
   CORRADE_ASSERT(faceDimensions == 3 || faceDimensions == 4,
                  "PTexMeshData::parsePLY: the dimension of a face is neither "
                  "3 nor 4.", );
 
-  const size_t countBytes = 1;
-  const size_t faceBytes = faceDimensions * sizeof(uint32_t);  // uint32_t
-  const size_t facePacketSizeBytes = countBytes + faceBytes;
-
-  const size_t predictedFaces = (fileSize - bytesSoFar) / facePacketSizeBytes;
-
-  // Not sure what to do here
-  //    if(predictedFaces < numFaces)
-  //    {
-  //        LOG(INFO) << "Skipping " << numFaces - predictedFaces << " missing
-  //        faces" << std::endl;
-  //    }
-  //    else if(numFaces < predictedFaces)
-  //    {
-  //        LOG(INFO) << "Ignoring " << predictedFaces - numFaces << " extra
-  //        faces" << std::endl;
-  //    }
-
-  numFaces = std::min(numFaces, predictedFaces);
-
+  const size_t numFaces = faces->count;
   meshData.ibo.resize(numFaces * faceDimensions);
-
+#pragma omp parallel for
   for (size_t i = 0; i < numFaces; i++) {
-    const char* nextBytes = bytes + facePacketSizeBytes * i;
-
-    memcpy(&meshData.ibo[i * faceDimensions], &nextBytes[countBytes],
-           faceBytes);
+    for (size_t j = 0; j < faceDimensions; j++) {
+      meshData.ibo[i * faceDimensions + j] = (*indices)[i][j];
+    }
   }
 }
 
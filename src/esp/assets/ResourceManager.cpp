@@ -4,8 +4,14 @@
 
 #include "ResourceManager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Containers/PointerStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/PluginManager/PluginMetadata.h>
 #include <Corrade/Utility/Assert.h>
@@ -19,11 +25,14 @@
 #include <Magnum/GL/Context.h>
 #include <Magnum/GL/Extensions.h>
 #include <Magnum/ImageView.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/Math/FunctionsBatch.h>
 #include <Magnum/Math/Range.h>
 #include <Magnum/Math/Tags.h>
 #include <Magnum/MeshTools/Compile.h>
+#include <Magnum/MeshTools/Interleave.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/PixelStorage.h>
 #include <Magnum/SceneGraph/Object.h>
 #include <Magnum/Shaders/Flat.h>
 #include <Magnum/Trade/AbstractImporter.h>
@@ -32,6 +41,7 @@
 #include <Magnum/Trade/PhongMaterialData.h>
 #include <Magnum/Trade/SceneData.h>
 #include <Magnum/Trade/TextureData.h>
+#include <Magnum/VertexFormat.h>
 
 #include "esp/geo/geo.h"
 #include "esp/gfx/GenericDrawable.h"
@@ -75,6 +85,82 @@ constexpr char ResourceManager::DEFAULT_LIGHTING_KEY[];
 constexpr char ResourceManager::DEFAULT_MATERIAL_KEY[];
 constexpr char ResourceManager::WHITE_MATERIAL_KEY[];
 constexpr char ResourceManager::PER_VERTEX_OBJECT_ID_MATERIAL_KEY[];
+
+namespace {
+
+/**
+ * @brief Generate the mip levels of an 8-bit per channel image down to 1x1,
+ * halving each time with a box filter like the GPU does.
+ * @return The levels below @p image, or none if its format is not supported.
+ */
+std::vector<Mn::Trade::ImageData2D> generateMipLevels(
+    const Mn::Trade::ImageData2D& image) {
+  std::vector<Mn::Trade::ImageData2D> levels;
+  switch (image.format()) {
+    case Mn::PixelFormat::R8Unorm:
+    case Mn::PixelFormat::RG8Unorm:
+    case Mn::PixelFormat::RGB8Unorm:
+    case Mn::PixelFormat::RGBA8Unorm:
+    case Mn::PixelFormat::RGB8Srgb:
+    case Mn::PixelFormat::RGBA8Srgb:
+      break;
+    default:
+      return levels;
+  }
+
+  const std::size_t pixelSize = Mn::pixelSize(image.format());
+  Mn::Vector2i size = image.size();
+  levels.reserve(Mn::Math::log2(size.max()));
+  Cr::Containers::StridedArrayView3D<const char> pixels = image.pixels();
+  while (size.max() > 1) {
+    const Mn::Vector2i nextSize = Mn::Math::max(size / 2, Mn::Vector2i{1});
+    Cr::Containers::Array<char> data{Cr::Containers::NoInit,
+                                     std::size_t(nextSize.product()) *
+                                         pixelSize};
+    for (int y = 0; y < nextSize.y(); ++y) {
+      const int y0 = 2 * y;
+      const int y1 = std::min(y0 + 1, size.y() - 1);
+      for (int x = 0; x < nextSize.x(); ++x) {
+        const int x0 = 2 * x;
+        const int x1 = std::min(x0 + 1, size.x() - 1);
+        char* out = data + (std::size_t(y) * nextSize.x() + x) * pixelSize;
+        for (std::size_t c = 0; c < pixelSize; ++c) {
+          const unsigned sum = std::uint8_t(pixels[y0][x0][c]) +
+                               std::uint8_t(pixels[y0][x1][c]) +
+                               std::uint8_t(pixels[y1][x0][c]) +
+                               std::uint8_t(pixels[y1][x1][c]);
+          out[c] = char((sum + 2) / 4);
+        }
+      }
+    }
+    levels.emplace_back(Mn::PixelStorage{}.setAlignment(1), image.format(),
+                        nextSize, std::move(data));
+    pixels = levels.back().pixels();
+    size = nextSize;
+  }
+  return levels;
+}
+
+/**
+ * @brief Resolve a requested number of worker threads, negative values
+ * picking one less than the number of hardware threads, since the calling
+ * thread works as well.
+ */
+int resolveNumWorkerThreads(int numThreads) {
+  if (numThreads >= 0) {
+    return numThreads;
+  }
+#ifdef CORRADE_TARGET_EMSCRIPTEN
+  // no worker threads without pthreads support
+  return 0;
+#else
+  return std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1,
+                  0);
+#endif
+}
+
+}  // namespace
+
 ResourceManager::ResourceManager()
     :
 #ifdef MAGNUM_BUILD_STATIC
@@ -86,6 +172,7 @@ ResourceManager::ResourceManager()
   initDefaultLightSetups();
   initDefaultMaterials();
   buildImportersAndAttributesManagers();
+  setNumAbsoluteAABBThreads(-1);
 }  // namespace assets
 
 void ResourceManager::buildImportersAndAttributesManagers() {
@@ -109,6 +196,30 @@ void ResourceManager::buildImportersAndAttributesManagers() {
 
 }  // buildImportersAndAttributesManagers
 
+void ResourceManager::setNumImportThreads(int numImportThreads) {
+  numImportThreads = resolveNumWorkerThreads(numImportThreads);
+  if (numImportThreads != numImportThreads_) {
+    numImportThreads_ = numImportThreads;
+    importPool_ = nullptr;
+  }
+}  // setNumImportThreads
+
+void ResourceManager::setNumAbsoluteAABBThreads(int numAbsoluteAABBThreads) {
+  numAbsoluteAABBThreads_ = resolveNumWorkerThreads(numAbsoluteAABBThreads);
+}  // setNumAbsoluteAABBThreads
+
+void ResourceManager::unloadFileAssets() {
+  for (auto assetItr = resourceDict_.begin();
+       assetItr != resourceDict_.end();) {
+    if (assetItr->second.assetInfo.type == AssetType::PRIMITIVE) {
+      ++assetItr;
+      continue;
+    }
+    collisionMeshGroups_.erase(assetItr->first);
+    assetItr = resourceDict_.erase(assetItr);
+  }
+}  // unloadFileAssets
+
 void ResourceManager::initDefaultPrimAttributes() {
   // by this point, we should have a GL::Context so load the bb primitive.
   // TODO: replace this completely with standard mesh (i.e. treat the bb
@@ -526,6 +637,15 @@ void ResourceManager::computePTexMeshAbsoluteAABBs(
 }  // ResourceManager::computePTexMeshAbsoluteAABBs
 #endif
 
+BaseMesh& ResourceManager::getStaticDrawableMesh(
+    const StaticDrawableInfo& info) {
+  BaseMesh& mesh = *meshes_[info.meshID];
+  if (info.chunkID == ID_UNDEFINED) {
+    return mesh;
+  }
+  return static_cast<GenericMeshData&>(mesh).getChunk(info.chunkID);
+}
+
 void ResourceManager::computeGeneralMeshAbsoluteAABBs(
     const std::vector<StaticDrawableInfo>& staticDrawableInfo) {
   std::vector<Mn::Matrix4> absTransforms =
@@ -535,40 +655,101 @@ void ResourceManager::computeGeneralMeshAbsoluteAABBs(
                  "ResourceManager::computeGeneralMeshAbsoluteAABBs: number of "
                  "transforms does not match number of drawables.", );
 
+  if (useConservativeAbsoluteAABBs_) {
+    // transform the local bounding box computed when the mesh was loaded
+    for (uint32_t iEntry = 0; iEntry < absTransforms.size(); ++iEntry) {
+      staticDrawableInfo[iEntry].node.setAbsoluteAABB(geo::getTransformedBB(
+          getStaticDrawableMesh(staticDrawableInfo[iEntry]).BB,
+          absTransforms[iEntry]));
+    }
+    return;
+  }
+
+  // split the positions of every drawable into chunks of at most
+  // AABBChunkSize, so that a stage made of a single large mesh is split
+  // across threads as well as one made of many small ones
+  constexpr std::size_t AABBChunkSize = 1 << 16;
+  struct AABBChunk {
+    uint32_t iEntry;
+    Cr::Containers::StridedArrayView1D<const Mn::Vector3> positions;
+  };
+  std::vector<AABBChunk> chunks;
+  // positions not stored as Vector3 are unpacked, everything else is viewed
+  std::vector<Cr::Containers::Array<Mn::Vector3>> unpackedPositions;
+  std::size_t numPositions = 0;
   for (uint32_t iEntry = 0; iEntry < absTransforms.size(); ++iEntry) {
     const uint32_t meshID = staticDrawableInfo[iEntry].meshID;
 
-    Cr::Containers::Optional<Magnum::Trade::MeshData>& meshData =
-        meshes_[meshID]->getMeshData();
+    const Cr::Containers::Optional<Magnum::Trade::MeshData>& meshData =
+        getStaticDrawableMesh(staticDrawableInfo[iEntry]).getMeshData();
     CORRADE_ASSERT(meshData,
                    "ResourceManager::computeGeneralMeshAbsoluteAABBs: The mesh "
                    "data specified at ID:"
                        << meshID << "is empty/undefined. Aborting", );
 
-    // a vector to store the min, max pos for the aabb of every position array
-    std::vector<Mn::Vector3> bbPos;
-
-    // transform the vertex positions to the world space, compute the aabb for
-    // each position array
     for (uint32_t jArray = 0;
          jArray < meshData->attributeCount(Mn::Trade::MeshAttribute::Position);
          ++jArray) {
-      Cr::Containers::Array<Mn::Vector3> pos =
-          meshData->positions3DAsArray(jArray);
-      Mn::MeshTools::transformPointsInPlace(absTransforms[iEntry], pos);
-
-      std::pair<Mn::Vector3, Mn::Vector3> bb = Mn::Math::minmax(pos);
-      bbPos.push_back(std::move(bb.first));
-      bbPos.push_back(std::move(bb.second));
+      Cr::Containers::StridedArrayView1D<const Mn::Vector3> positions;
+      if (meshData->attributeFormat(Mn::Trade::MeshAttribute::Position,
+                                    jArray) == Mn::VertexFormat::Vector3) {
+        positions = meshData->attribute<Mn::Vector3>(
+            Mn::Trade::MeshAttribute::Position, jArray);
+      } else {
+        unpackedPositions.emplace_back(meshData->positions3DAsArray(jArray));
+        positions = Cr::Containers::arrayView(unpackedPositions.back());
+      }
+      numPositions += positions.size();
+      for (std::size_t start = 0; start < positions.size();
+           start += AABBChunkSize) {
+        chunks.push_back(
+            {iEntry, positions.slice(start, std::min(start + AABBChunkSize,
+                                                     positions.size()))});
+      }
     }
+  }
 
-    // locate the scene node which contains the current drawable
-    scene::SceneNode& node = staticDrawableInfo[iEntry].node;
+  // transform and reduce every chunk, in parallel if there is enough work
+  std::vector<Mn::Range3D> chunkBBs(chunks.size());
+  auto computeChunkBB = [&](std::size_t iChunk) {
+    chunkBBs[iChunk] = geo::getTransformedPointsBB(
+        chunks[iChunk].positions, absTransforms[chunks[iChunk].iEntry]);
+  };
+  const std::size_t numThreads =
+      numPositions < AABBChunkSize
+          ? 0
+          : std::min<std::size_t>(numAbsoluteAABBThreads_,
+                                  chunks.size() - 1);
+  std::atomic<std::size_t> nextChunk{0};
+  auto work = [&]() {
+    for (std::size_t iChunk = nextChunk++; iChunk < chunks.size();
+         iChunk = nextChunk++) {
+      computeChunkBB(iChunk);
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (std::size_t iThread = 0; iThread < numThreads; ++iThread) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
 
-    // set the absolute axis aligned bounding box
-    node.setAbsoluteAABB(Mn::Math::minmax(bbPos));
+  // join the chunks of each drawable, chunks of a drawable are consecutive
+  for (std::size_t iChunk = 0; iChunk < chunks.size();) {
+    const uint32_t iEntry = chunks[iChunk].iEntry;
+    Mn::Range3D absoluteAABB = chunkBBs[iChunk];
+    for (++iChunk; iChunk < chunks.size() && chunks[iChunk].iEntry == iEntry;
+         ++iChunk) {
+      absoluteAABB = Mn::Math::join(absoluteAABB, chunkBBs[iChunk]);
+    }
 
-  }  // iEntry
+    // set the absolute axis aligned bounding box of the scene node which
+    // contains the drawable
+    staticDrawableInfo[iEntry].node.setAbsoluteAABB(absoluteAABB);
+  }
 }  // ResourceManager::computeGeneralMeshAbsoluteAABBs
 
 void ResourceManager::computeInstanceMeshAbsoluteAABBs(
@@ -584,18 +765,19 @@ void ResourceManager::computeInstanceMeshAbsoluteAABBs(
   for (size_t iEntry = 0; iEntry < absTransforms.size(); ++iEntry) {
     const uint32_t meshID = staticDrawableInfo[iEntry].meshID;
 
-    // convert std::vector<vec3f> to std::vector<Mn::Vector3>
+    // view the std::vector<vec3f> as Mn::Vector3 without copying
     const std::vector<vec3f>& vertexPositions =
         dynamic_cast<GenericInstanceMeshData&>(*meshes_[meshID])
             .getVertexBufferObjectCPU();
-    std::vector<Mn::Vector3> transformedPositions{vertexPositions.begin(),
-                                                  vertexPositions.end()};
-
-    Mn::MeshTools::transformPointsInPlace(absTransforms[iEntry],
-                                          transformedPositions);
+    static_assert(sizeof(vec3f) == sizeof(Mn::Vector3),
+                  "vec3f must have the layout of Mn::Vector3");
+    Cr::Containers::ArrayView<const Mn::Vector3> positions{
+        reinterpret_cast<const Mn::Vector3*>(vertexPositions.data()),
+        vertexPositions.size()};
 
     scene::SceneNode& node = staticDrawableInfo[iEntry].node;
-    node.setAbsoluteAABB(Mn::Math::minmax(transformedPositions));
+    node.setAbsoluteAABB(
+        geo::getTransformedPointsBB(positions, absTransforms[iEntry]));
   }  // iEntry
 }
 
@@ -841,6 +1023,9 @@ bool ResourceManager::loadInstanceMeshData(
 
     for (int meshIDLocal = 0; meshIDLocal < instanceMeshes.size();
          ++meshIDLocal) {
+      if (optimizeMeshes_) {
+        instanceMeshes[meshIDLocal]->optimizeForRendering();
+      }
       instanceMeshes[meshIDLocal]->uploadBuffersToGPU(false);
       meshes_.emplace_back(std::move(instanceMeshes[meshIDLocal]));
 
@@ -889,14 +1074,13 @@ bool ResourceManager::loadGeneralMeshData(
   const bool fileIsLoaded = resourceDict_.count(filename) > 0;
   const bool drawData = parent != nullptr && drawables != nullptr;
 
+  if (!importPool_) {
+    importPool_ = AssetImportPool::create_unique(numImportThreads_);
+  }
+
   // Preferred plugins, Basis target GPU format
-  importerManager_.setPreferredPlugins("GltfImporter", {"TinyGltfImporter"});
-#ifdef ESP_BUILD_ASSIMP_SUPPORT
-  importerManager_.setPreferredPlugins("ObjImporter", {"AssimpImporter"});
-#endif
+  const char* basisFormat = "RGBA8";
   {
-    Cr::PluginManager::PluginMetadata* const metadata =
-        importerManager_.metadata("BasisImporter");
     Mn::GL::Context& context = Mn::GL::Context::current();
 #ifdef MAGNUM_TARGET_WEBGL
     if (context.isExtensionSupported<
@@ -907,7 +1091,7 @@ bool ResourceManager::loadGeneralMeshData(
 #endif
     {
       LOG(INFO) << "Importing Basis files as ASTC 4x4";
-      metadata->configuration().setValue("format", "Astc4x4RGBA");
+      basisFormat = "Astc4x4RGBA";
     }
 #ifdef MAGNUM_TARGET_GLES
     else if (context.isExtensionSupported<
@@ -918,7 +1102,7 @@ bool ResourceManager::loadGeneralMeshData(
 #endif
     {
       LOG(INFO) << "Importing Basis files as BC7";
-      metadata->configuration().setValue("format", "Bc7RGBA");
+      basisFormat = "Bc7RGBA";
     }
 #ifdef MAGNUM_TARGET_WEBGL
     else if (context.isExtensionSupported<
@@ -934,7 +1118,7 @@ bool ResourceManager::loadGeneralMeshData(
 #endif
     {
       LOG(INFO) << "Importing Basis files as BC3";
-      metadata->configuration().setValue("format", "Bc3RGBA");
+      basisFormat = "Bc3RGBA";
     }
 #ifndef MAGNUM_TARGET_GLES2
     else
@@ -944,7 +1128,7 @@ bool ResourceManager::loadGeneralMeshData(
 #endif
     {
       LOG(INFO) << "Importing Basis files as ETC2";
-      metadata->configuration().setValue("format", "Etc2RGBA");
+      basisFormat = "Etc2RGBA";
     }
 #else /* For ES2, fall back to PVRTC as ETC2 is not available */
     else
@@ -955,7 +1139,7 @@ bool ResourceManager::loadGeneralMeshData(
 #endif
     {
       LOG(INFO) << "Importing Basis files as PVRTC 4bpp";
-      metadata->configuration().setValue("format", "PvrtcRGBA4bpp");
+      basisFormat = "PvrtcRGBA4bpp";
     }
 #endif
 #if defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_GLES)
@@ -963,47 +1147,68 @@ bool ResourceManager::loadGeneralMeshData(
     {
       LOG(WARNING) << "No supported GPU compressed texture format detected, "
                       "Basis images will get imported as RGBA8";
-      metadata->configuration().setValue("format", "RGBA8");
+      basisFormat = "RGBA8";
     }
 #endif
+
+    // every worker imports with its own plugin manager
+    AssetImportPool::configureImporterManager(importerManager_, basisFormat);
+    for (int iThread = 0; iThread < importPool_->getNumThreads(); ++iThread) {
+      AssetImportPool::configureImporterManager(
+          importPool_->getImporterManager(iThread), basisFormat);
+    }
   }
 
   // Optional File loading
   if (!fileIsLoaded) {
-    if (!fileImporter_->openFile(filename)) {
-      LOG(ERROR) << "Cannot open file " << filename;
-      return false;
-    }
+    // the decoded data only depends on the file, the Basis target format and
+    // mesh optimization, so it is shared with every other resource manager
+    // in the process. The file's size and modification time are part of the
+    // key so an edited file is decoded again.
+    const std::string cacheKey =
+        filename + "?size=" + std::to_string(io::fileSize(filename)) +
+        "&mtime=" + std::to_string(io::modificationTime(filename)) +
+        "&basis=" + basisFormat + (optimizeMeshes_ ? "&optimize=1" : "");
+    AssetCache& assetCache = AssetCache::instance();
 
     // if this is a new file, load it and add it to the dictionary
     LoadedAssetData loadedAssetData{info};
-    loadTextures(*fileImporter_, loadedAssetData);
-    loadMaterials(*fileImporter_, loadedAssetData);
-    loadMeshes(*fileImporter_, loadedAssetData);
-    auto inserted = resourceDict_.emplace(filename, std::move(loadedAssetData));
-    MeshMetaData& meshMetaData = inserted.first->second.meshMetaData;
-
-    // Register magnum mesh
-    if (fileImporter_->defaultScene() != -1) {
-      Cr::Containers::Optional<Magnum::Trade::SceneData> sceneData =
-          fileImporter_->scene(fileImporter_->defaultScene());
-      if (!sceneData) {
-        LOG(ERROR) << "Cannot load scene, exiting";
-        return false;
+    ImportedAsset::cptr importedAsset = assetCache.get(cacheKey);
+    if (importedAsset == nullptr && useBakedAssets_) {
+      // baked by `datatool bake_asset`, so nothing needs to be decoded
+      ImportedAsset::ptr bakedAsset =
+          ImportedAsset::load(filename + ".baked", filename, basisFormat);
+      if (bakedAsset != nullptr) {
+        if (optimizeMeshes_) {
+          bakedAsset->optimizeMeshes();
+        }
+        assetCache.insert(cacheKey, bakedAsset);
+        importedAsset = std::move(bakedAsset);
       }
-      for (unsigned int sceneDataID : sceneData->children3D()) {
-        loadMeshHierarchy(*fileImporter_, meshMetaData.root, sceneDataID);
+    }
+    if (importedAsset != nullptr) {
+      // decoded before, so only create GPU resources
+      reserveTexturesAndMeshes(*importedAsset, loadedAssetData);
+      const int numComponents = importedAsset->getNumComponents();
+      for (int componentID = 0; componentID < numComponents; ++componentID) {
+        uploadImportedComponent(importedAsset, componentID, loadedAssetData);
       }
-    } else if (fileImporter_->meshCount() &&
-               meshes_[meshMetaData.meshIndex.first]) {
-      // no default scene --- standalone OBJ/PLY files, for example
-      // take a wild guess and load the first mesh with the first material
-      // addMeshToDrawables(metaData, *parent, drawables, 0, 0);
-      loadMeshHierarchy(*fileImporter_, meshMetaData.root, 0);
     } else {
-      LOG(ERROR) << "No default scene available and no meshes found, exiting";
-      return false;
+      if (!fileImporter_->openFile(filename)) {
+        LOG(ERROR) << "Cannot open file " << filename;
+        return false;
+      }
+      ImportedAsset::ptr newAsset = importAsset(filename, loadedAssetData);
+      if (newAsset == nullptr) {
+        return false;
+      }
+      assetCache.insert(cacheKey, newAsset);
+      importedAsset = std::move(newAsset);
     }
+    loadMaterials(*importedAsset, loadedAssetData);
+    auto inserted = resourceDict_.emplace(filename, std::move(loadedAssetData));
+    MeshMetaData& meshMetaData = inserted.first->second.meshMetaData;
+    meshMetaData.root = importedAsset->root;
 
     const quatf transform = info.frame.rotationFrameToWorld();
     Magnum::Matrix4 R = Magnum::Matrix4::from(
@@ -1119,20 +1324,18 @@ int ResourceManager::loadNavMeshVisualization(esp::nav::PathFinder& pathFinder,
   return navMeshPrimitiveID;
 }  // loadNavMeshVisualization
 
-void ResourceManager::loadMaterials(Importer& importer,
+void ResourceManager::loadMaterials(const ImportedAsset& importedAsset,
                                     LoadedAssetData& loadedAssetData) {
+  const int numMaterials = importedAsset.materials.size();
   int materialStart = nextMaterialID_;
-  int materialEnd = materialStart + importer.materialCount() - 1;
+  int materialEnd = materialStart + numMaterials - 1;
   loadedAssetData.meshMetaData.setMaterialIndices(materialStart, materialEnd);
 
-  for (int iMaterial = 0; iMaterial < importer.materialCount(); ++iMaterial) {
+  for (int iMaterial = 0; iMaterial < numMaterials; ++iMaterial) {
     int currentMaterialID = nextMaterialID_++;
 
-    // TODO:
-    // it seems we have a way to just load the material once in this case,
-    // as long as the materialName includes the full path to the material
-    Cr::Containers::Optional<Mn::Trade::MaterialData> materialData =
-        importer.material(iMaterial);
+    const Cr::Containers::Optional<Mn::Trade::MaterialData>& materialData =
+        importedAsset.materials[iMaterial];
     if (!materialData ||
         !(materialData->types() & Magnum::Trade::MaterialType::Phong)) {
       LOG(ERROR) << "Cannot load material, skipping";
@@ -1140,7 +1343,7 @@ void ResourceManager::loadMaterials(Importer& importer,
     }
 
     const auto& phongMaterialData =
-        static_cast<Mn::Trade::PhongMaterialData&>(*materialData);
+        static_cast<const Mn::Trade::PhongMaterialData&>(*materialData);
     std::unique_ptr<gfx::MaterialData> finalMaterial;
     int textureBaseIndex = loadedAssetData.meshMetaData.textureIndex.first;
     if (loadedAssetData.assetInfo.requiresLighting) {
@@ -1225,142 +1428,202 @@ gfx::PhongMaterialData::uptr ResourceManager::buildPhongShadedMaterialData(
   return finalMaterial;
 }
 
-void ResourceManager::loadMeshes(Importer& importer,
-                                 LoadedAssetData& loadedAssetData) {
-  int meshStart = meshes_.size();
-  int meshEnd = meshStart + importer.meshCount() - 1;
-  loadedAssetData.meshMetaData.setMeshIndices(meshStart, meshEnd);
-
-  for (int iMesh = 0; iMesh < importer.meshCount(); ++iMesh) {
-    // don't need normals if we aren't using lighting
-    auto gltfMeshData = std::make_unique<GenericMeshData>(
-        loadedAssetData.assetInfo.requiresLighting);
-    gltfMeshData->importAndSetMeshData(importer, iMesh);
-
-    // compute the mesh bounding box
-    gltfMeshData->BB = computeMeshBB(gltfMeshData.get());
-
-    gltfMeshData->uploadBuffersToGPU(false);
-    meshes_.emplace_back(std::move(gltfMeshData));
+ImportedAsset::ptr ResourceManager::importAsset(
+    const std::string& filename,
+    LoadedAssetData& loadedAssetData) {
+  ImportedAsset::ptr importedAsset =
+      ImportedAsset::createFromImporter(*fileImporter_, optimizeMeshes_);
+  if (importedAsset == nullptr) {
+    return nullptr;
   }
-}
+  reserveTexturesAndMeshes(*importedAsset, loadedAssetData);
 
-//! Recursively load the transformation chain specified by the mesh file
-void ResourceManager::loadMeshHierarchy(Importer& importer,
-                                        MeshTransformNode& parent,
-                                        int componentID) {
-  std::unique_ptr<Magnum::Trade::ObjectData3D> objectData =
-      importer.object3D(componentID);
-  if (!objectData) {
-    LOG(ERROR) << "Cannot import object " << importer.object3DName(componentID)
-               << ", skipping";
+  // images and meshes are decoded in parallel, textures first since images
+  // are usually the slowest to decode, and uploaded as each becomes ready
+  ImportedAsset& asset = *importedAsset;
+  auto decode = [&](Importer& importer, int componentID) {
+    asset.decodeComponent(importer, componentID);
+  };
+  auto upload = [&](int componentID) {
+    uploadImportedComponent(importedAsset, componentID, loadedAssetData);
+  };
+  importPool_->run(*fileImporter_, filename, asset.getNumComponents(), decode,
+                   upload);
+  return importedAsset;
+}  // ResourceManager::importAsset
+
+void ResourceManager::reserveTexturesAndMeshes(
+    const ImportedAsset& importedAsset,
+    LoadedAssetData& loadedAssetData) {
+  const int numTextures = importedAsset.textures.size();
+  const int textureStart = textures_.size();
+  loadedAssetData.meshMetaData.setTextureIndices(
+      textureStart, textureStart + numTextures - 1);
+  textures_.resize(textureStart + numTextures);
+
+  const int numMeshes = importedAsset.meshes.size();
+  const int meshStart = meshes_.size();
+  loadedAssetData.meshMetaData.setMeshIndices(meshStart,
+                                              meshStart + numMeshes - 1);
+  meshes_.resize(meshStart + numMeshes);
+}  // ResourceManager::reserveTexturesAndMeshes
+
+void ResourceManager::uploadImportedComponent(
+    const ImportedAsset::cptr& importedAsset,
+    int componentID,
+    const LoadedAssetData& loadedAssetData) {
+  const int numTextures = importedAsset->textures.size();
+  const MeshMetaData& meshMetaData = loadedAssetData.meshMetaData;
+  if (componentID < numTextures) {
+    textures_[meshMetaData.textureIndex.first + componentID] =
+        textureStreamer_.getMemoryBudget() > 0
+            ? streamTexture(importedAsset, componentID)
+            : uploadTexture(importedAsset->textures[componentID]);
     return;
   }
 
-  // Add the new node to the hierarchy and set its transformation
-  parent.children.push_back(MeshTransformNode());
-  parent.children.back().transformFromLocalToParent =
-      objectData->transformation();
-  parent.children.back().componentID = componentID;
+  const int iMesh = componentID - numTextures;
+  // don't need normals if we aren't using lighting
+  auto gltfMeshData = std::make_unique<GenericMeshData>(
+      loadedAssetData.assetInfo.requiresLighting);
+  // the shared data is copied, since meshes may be modified after loading
+  gltfMeshData->setMeshData(*importedAsset->meshes[iMesh]);
 
-  const int meshIDLocal = objectData->instance();
+  // compute the mesh bounding box
+  gltfMeshData->BB = computeMeshBB(gltfMeshData.get());
 
-  // Add a mesh index
-  if (objectData->instanceType() == Magnum::Trade::ObjectInstanceType3D::Mesh &&
-      meshIDLocal != ID_UNDEFINED) {
-    parent.children.back().meshIDLocal = meshIDLocal;
-    parent.children.back().materialIDLocal =
-        static_cast<Magnum::Trade::MeshObjectData3D*>(objectData.get())
-            ->material();
+  if (maxChunkTriangles_ > 0) {
+    gltfMeshData->splitIntoChunks(maxChunkTriangles_);
+  }
+  if (maxNumLods_ > 0) {
+    gltfMeshData->generateLods(maxNumLods_);
+  }
+  gltfMeshData->uploadBuffersToGPU(false);
+  meshes_[meshMetaData.meshIndex.first + iMesh] = std::move(gltfMeshData);
+}  // ResourceManager::uploadImportedComponent
+
+std::shared_ptr<Mn::GL::Texture2D> ResourceManager::uploadTexture(
+    const ImportedTexture& importedTexture) {
+  if (!importedTexture.textureData || importedTexture.levels.empty()) {
+    return nullptr;
+  }
+  std::vector<const Mn::Trade::ImageData2D*> levels;
+  for (const Mn::Trade::ImageData2D& image : importedTexture.levels) {
+    levels.push_back(&image);
+  }
+  auto texture = std::make_shared<Magnum::GL::Texture2D>();
+  uploadTextureLevels(*texture, *importedTexture.textureData, levels, 0);
+  return texture;
+}  // ResourceManager::uploadTexture
+
+std::shared_ptr<Mn::GL::Texture2D> ResourceManager::streamTexture(
+    const ImportedAsset::cptr& importedAsset,
+    int textureID) {
+  const ImportedTexture& importedTexture = importedAsset->textures[textureID];
+  if (!importedTexture.textureData || importedTexture.levels.empty()) {
+    return nullptr;
   }
 
-  // Recursively add children
-  for (auto childObjectID : objectData->children()) {
-    loadMeshHierarchy(importer, parent.children.back(), childObjectID);
+  // the GPU can only generate mip levels from the full resolution one
+  auto generatedLevels = std::make_shared<std::vector<Mn::Trade::ImageData2D>>();
+  if (importedTexture.levels.size() == 1 &&
+      !importedTexture.levels[0].isCompressed()) {
+    *generatedLevels = generateMipLevels(importedTexture.levels[0]);
+  }
+  std::vector<const Mn::Trade::ImageData2D*> levels;
+  for (const Mn::Trade::ImageData2D& image : importedTexture.levels) {
+    levels.push_back(&image);
+  }
+  for (const Mn::Trade::ImageData2D& image : *generatedLevels) {
+    levels.push_back(&image);
+  }
+  if (levels.size() == 1) {
+    return uploadTexture(importedTexture);
   }
-}
 
-void ResourceManager::loadTextures(Importer& importer,
-                                   LoadedAssetData& loadedAssetData) {
-  int textureStart = textures_.size();
-  int textureEnd = textureStart + importer.textureCount() - 1;
-  loadedAssetData.meshMetaData.setTextureIndices(textureStart, textureEnd);
-
-  for (int iTexture = 0; iTexture < importer.textureCount(); ++iTexture) {
-    textures_.emplace_back(std::make_shared<Magnum::GL::Texture2D>());
-    auto& currentTexture = textures_.back();
-
-    auto textureData = importer.texture(iTexture);
-    if (!textureData ||
-        textureData->type() != Magnum::Trade::TextureData::Type::Texture2D) {
-      LOG(ERROR) << "Cannot load texture " << iTexture << " skipping";
-      currentTexture = nullptr;
-      continue;
+  std::vector<Mn::Vector2i> levelSizes;
+  std::vector<std::size_t> levelBytes;
+  for (const Mn::Trade::ImageData2D* image : levels) {
+    const Mn::Vector2i size = image->size();
+    levelSizes.push_back(size);
+    if (image->isCompressed()) {
+      levelBytes.push_back(image->data().size());
+    } else if (compressTextures_ &&
+               (image->format() == Mn::PixelFormat::RGBA8Unorm ||
+                image->format() == Mn::PixelFormat::RGB8Unorm)) {
+      // DXT1, 8 bytes per 4x4 block
+      levelBytes.push_back(std::size_t((size.x() + 3) / 4) *
+                           ((size.y() + 3) / 4) * 8);
+    } else {
+      levelBytes.push_back(std::size_t(size.product()) *
+                           Mn::pixelSize(image->format()));
     }
+  }
 
-    // Configure the texture
-    Mn::GL::Texture2D& texture = *(textures_[textureStart + iTexture].get());
-    texture.setMagnificationFilter(textureData->magnificationFilter())
-        .setMinificationFilter(textureData->minificationFilter(),
-                               textureData->mipmapFilter())
-        .setWrapping(textureData->wrapping().xy());
-
-    // Load all mip levels
-    const std::uint32_t levelCount =
-        importer.image2DLevelCount(textureData->image());
-    bool generateMipmap = false;
-    for (std::uint32_t level = 0; level != levelCount; ++level) {
-      // TODO:
-      // it seems we have a way to just load the image once in this case,
-      // as long as the image2DName include the full path to the image
-      Cr::Containers::Optional<Mn::Trade::ImageData2D> image =
-          importer.image2D(textureData->image(), level);
-      if (!image) {
-        LOG(ERROR) << "Cannot load texture image, skipping";
-        currentTexture = nullptr;
-        break;
-      }
-
-      Mn::GL::TextureFormat format;
-      if (image->isCompressed()) {
-        format = Mn::GL::textureFormat(image->compressedFormat());
-      } else if (compressTextures_ &&
-                 image->format() == Mn::PixelFormat::RGBA8Unorm) {
-        format = Mn::GL::TextureFormat::CompressedRGBAS3tcDxt1;
-      } else if (compressTextures_ &&
-                 image->format() == Mn::PixelFormat::RGB8Unorm) {
-        format = Mn::GL::TextureFormat::CompressedRGBS3tcDxt1;
-      } else {
-        format = Mn::GL::textureFormat(image->format());
-      }
-
-      // For the very first level, allocate the texture
-      if (level == 0) {
-        // If there is just one level and the image is not compressed, we'll
-        // generate mips ourselves
-        if (levelCount == 1 && !image->isCompressed()) {
-          texture.setStorage(Mn::Math::log2(image->size().max()) + 1, format,
-                             image->size());
-          generateMipmap = true;
-        } else
-          texture.setStorage(levelCount, format, image->size());
-      }
-
-      if (image->isCompressed())
-        texture.setCompressedSubImage(level, {}, *image);
-      else
-        texture.setSubImage(level, {}, *image);
+  // the loader keeps the decoded images alive, even once evicted from the
+  // asset cache, to upload finer levels later
+  auto texture = std::make_shared<Magnum::GL::Texture2D>();
+  const Mn::Trade::TextureData& textureData = *importedTexture.textureData;
+  textureStreamer_.addTexture(
+      *texture, std::move(levelSizes), std::move(levelBytes),
+      [this, importedAsset, generatedLevels, &textureData, levels](
+          Mn::GL::Texture2D& texture, int firstLevel) {
+        uploadTextureLevels(texture, textureData, levels, firstLevel);
+      });
+  return texture;
+}  // ResourceManager::streamTexture
+
+void ResourceManager::uploadTextureLevels(
+    Mn::GL::Texture2D& texture,
+    const Mn::Trade::TextureData& textureData,
+    const std::vector<const Mn::Trade::ImageData2D*>& levels,
+    int firstLevel) {
+  // Configure the texture
+  texture.setMagnificationFilter(textureData.magnificationFilter())
+      .setMinificationFilter(textureData.minificationFilter(),
+                             textureData.mipmapFilter())
+      .setWrapping(textureData.wrapping().xy());
+
+  const std::uint32_t levelCount = levels.size() - firstLevel;
+  bool generateMipmap = false;
+  for (std::uint32_t level = 0; level != levelCount; ++level) {
+    const Mn::Trade::ImageData2D& image = *levels[firstLevel + level];
+
+    Mn::GL::TextureFormat format;
+    if (image.isCompressed()) {
+      format = Mn::GL::textureFormat(image.compressedFormat());
+    } else if (compressTextures_ &&
+               image.format() == Mn::PixelFormat::RGBA8Unorm) {
+      format = Mn::GL::TextureFormat::CompressedRGBAS3tcDxt1;
+    } else if (compressTextures_ &&
+               image.format() == Mn::PixelFormat::RGB8Unorm) {
+      format = Mn::GL::TextureFormat::CompressedRGBS3tcDxt1;
+    } else {
+      format = Mn::GL::textureFormat(image.format());
     }
 
-    // Mip level loading failed, fail the whole texture
-    if (currentTexture == nullptr)
-      continue;
+    // For the very first level, allocate the texture
+    if (level == 0) {
+      // If there is just one level and the image is not compressed, we'll
+      // generate mips ourselves
+      if (levelCount == 1 && !image.isCompressed()) {
+        texture.setStorage(Mn::Math::log2(image.size().max()) + 1, format,
+                           image.size());
+        generateMipmap = true;
+      } else
+        texture.setStorage(levelCount, format, image.size());
+    }
 
-    // Generate a mipmap if requested
-    if (generateMipmap)
-      texture.generateMipmap();
+    if (image.isCompressed())
+      texture.setCompressedSubImage(level, {}, image);
+    else
+      texture.setSubImage(level, {}, image);
   }
-}  // ResourceManager::loadTextures
+
+  // Generate a mipmap if requested
+  if (generateMipmap)
+    texture.generateMipmap();
+}  // ResourceManager::uploadTextureLevels
 
 bool ResourceManager::instantiateAssetsOnDemand(
     const std::string& objectTemplateHandle) {
@@ -1519,7 +1782,6 @@ void ResourceManager::addComponent(
   if (meshIDLocal != ID_UNDEFINED) {
     const int materialIDLocal = meshTransformNode.materialIDLocal;
     const uint32_t meshID = metaData.meshIndex.first + meshIDLocal;
-    Magnum::GL::Mesh& mesh = *meshes_[meshID]->getMagnumGLMesh();
     Mn::ResourceKey materialKey;
     if (materialIDLocal == ID_UNDEFINED ||
         metaData.materialIndex.second == ID_UNDEFINED) {
@@ -1529,10 +1791,32 @@ void ResourceManager::addComponent(
           std::to_string(metaData.materialIndex.first + materialIDLocal);
     }
 
-    createGenericDrawable(mesh, node, lightSetup, materialKey, drawables);
+    auto* genericMesh = dynamic_cast<GenericMeshData*>(meshes_[meshID].get());
+    if (genericMesh != nullptr && genericMesh->getNumChunks() > 0) {
+      // each chunk gets its own node, so it is culled on its own
+      for (int iChunk = 0; iChunk < genericMesh->getNumChunks(); ++iChunk) {
+        GenericMeshData& chunk = genericMesh->getChunk(iChunk);
+        scene::SceneNode& chunkNode = node.createChild();
+        visNodeCache.push_back(&chunkNode);
+        createGenericMeshDrawable(chunk, chunkNode, lightSetup, materialKey,
+                                  drawables);
+        if (computeAbsoluteAABBs) {
+          staticDrawableInfo.emplace_back(
+              StaticDrawableInfo{chunkNode, meshID, iChunk});
+        }
+        chunkNode.setMeshBB(chunk.BB);
+      }
+    } else if (genericMesh != nullptr) {
+      createGenericMeshDrawable(*genericMesh, node, lightSetup, materialKey,
+                                drawables);
+    } else {
+      createGenericDrawable(*meshes_[meshID]->getMagnumGLMesh(), node,
+                            lightSetup, materialKey, drawables);
+    }
 
     // compute the bounding box for the mesh we are adding
-    if (computeAbsoluteAABBs) {
+    if (computeAbsoluteAABBs && (genericMesh == nullptr ||
+                                 genericMesh->getNumChunks() == 0)) {
       staticDrawableInfo.emplace_back(StaticDrawableInfo{node, meshID});
     }
     BaseMesh* meshBB = meshes_[meshID].get();
@@ -1546,6 +1830,21 @@ void ResourceManager::addComponent(
   }
 }  // addComponent
 
+void ResourceManager::createGenericMeshDrawable(
+    GenericMeshData& mesh,
+    scene::SceneNode& node,
+    const Mn::ResourceKey& lightSetup,
+    const Mn::ResourceKey& material,
+    DrawableGroup* group) {
+  gfx::GenericDrawable& drawable = createGenericDrawable(
+      *mesh.getMagnumGLMesh(), node, lightSetup, material, group);
+  std::vector<gfx::GenericDrawable::Lod> lods;
+  for (int iLod = 0; iLod < mesh.getNumLods(); ++iLod) {
+    lods.push_back({mesh.getLodMagnumGLMesh(iLod), mesh.getLodError(iLod)});
+  }
+  drawable.setLods(std::move(lods));
+}
+
 void ResourceManager::addPrimitiveToDrawables(int primitiveID,
                                               scene::SceneNode& node,
                                               DrawableGroup* drawables) {
@@ -1559,14 +1858,18 @@ void ResourceManager::removePrimitiveMesh(int primitiveID) {
   primitive_meshes_.erase(primitiveID);
 }
 
-void ResourceManager::createGenericDrawable(
+gfx::GenericDrawable& ResourceManager::createGenericDrawable(
     Mn::GL::Mesh& mesh,
     scene::SceneNode& node,
     const Mn::ResourceKey& lightSetup,
     const Mn::ResourceKey& material,
     DrawableGroup* group /* = nullptr */) {
-  node.addFeature<gfx::GenericDrawable>(mesh, shaderManager_, lightSetup,
-                                        material, group);
+  gfx::GenericDrawable& drawable = node.addFeature<gfx::GenericDrawable>(
+      mesh, shaderManager_, lightSetup, material, group);
+  if (textureStreamer_.getMemoryBudget() > 0) {
+    drawable.setTextureStreamer(&textureStreamer_);
+  }
+  return drawable;
 }
 
 bool ResourceManager::loadSUNCGHouseFile(const AssetInfo& houseInfo,
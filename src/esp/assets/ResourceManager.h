@@ -24,6 +24,8 @@
 #include <Magnum/SceneGraph/MatrixTransformation3D.h>
 
 #include "Asset.h"
+#include "AssetCache.h"
+#include "AssetImportPool.h"
 #include "BaseMesh.h"
 #include "CollisionMeshData.h"
 #include "GenericMeshData.h"
@@ -33,6 +35,7 @@
 #include "esp/gfx/DrawableGroup.h"
 #include "esp/gfx/MaterialData.h"
 #include "esp/gfx/ShaderManager.h"
+#include "esp/gfx/TextureStreamer.h"
 #include "esp/physics/configure.h"
 #include "esp/scene/SceneManager.h"
 #include "esp/scene/SceneNode.h"
@@ -58,7 +61,8 @@ namespace Attrs = esp::assets::attributes;
 namespace esp {
 namespace gfx {
 class Drawable;
-}
+class GenericDrawable;
+}  // namespace gfx
 namespace scene {
 struct SceneConfiguration;
 }
@@ -332,7 +336,7 @@ class ResourceManager {
                             const Mn::ResourceKey& lightSetup = Mn::ResourceKey{
                                 DEFAULT_LIGHTING_KEY}) {
     if (objTemplateLibID != ID_UNDEFINED) {
-      const std::string& objTemplateHandleName =
+      const std::string objTemplateHandleName =
           objectAttributesManager_->getTemplateHandleByID(objTemplateLibID);
 
       addObjectToDrawables(objTemplateHandleName, parent, drawables,
@@ -424,6 +428,163 @@ class ResourceManager {
    */
   inline void compressTextures(bool newVal) { compressTextures_ = newVal; };
 
+  /**
+   * @brief Set the number of worker threads which parse and decode asset
+   * textures and meshes alongside the loading thread. GPU uploads always
+   * happen on the loading thread. Every worker opens and parses the asset
+   * file with its own importer, holding e.g. the glTF buffers once per
+   * worker, so only enable this when loading time matters more than peak
+   * memory.
+   * @param numImportThreads The number of worker threads. 0, the default,
+   * loads serially, negative values use one less than the number of hardware
+   * threads.
+   */
+  void setNumImportThreads(int numImportThreads);
+
+  /**
+   * @brief Get the number of worker threads used to import assets. See @ref
+   * setNumImportThreads.
+   */
+  int getNumImportThreads() const { return numImportThreads_; }
+
+  /**
+   * @brief Set whether general mesh assets are loaded from the baked file
+   * written next to them by `datatool bake_asset`, when it exists and matches
+   * the asset and the Basis target format. Enabled by default.
+   * @param useBakedAssets Whether to look for baked assets.
+   */
+  void setUseBakedAssets(bool useBakedAssets) {
+    useBakedAssets_ = useBakedAssets;
+  }
+
+  /**
+   * @brief Get whether baked assets are used. See @ref setUseBakedAssets.
+   */
+  bool getUseBakedAssets() const { return useBakedAssets_; }
+
+  /**
+   * @brief Set whether general and instance meshes are reordered at import
+   * for post-transform vertex cache and vertex fetch locality, see @ref
+   * optimizeMesh. Costs some import time for faster rendering. PTex meshes
+   * are never reordered since their triangle order matches the face order of
+   * the ptex textures. Disabled by default.
+   * @param optimizeMeshes Whether to optimize meshes.
+   */
+  void setOptimizeMeshes(bool optimizeMeshes) {
+    optimizeMeshes_ = optimizeMeshes;
+  }
+
+  /**
+   * @brief Get whether meshes are optimized at import. See @ref
+   * setOptimizeMeshes.
+   */
+  bool getOptimizeMeshes() const { return optimizeMeshes_; }
+
+  /**
+   * @brief Set the maximum number of simplified levels of detail generated
+   * for each general mesh as it is loaded, see @ref
+   * GenericMeshData::generateLods. Drawables switch to them based on @ref
+   * gfx::RenderCamera::getLodPixelError. 0, the default, generates none.
+   * @param maxNumLods The maximum number of levels of detail per mesh.
+   */
+  void setMaxNumLods(int maxNumLods) { maxNumLods_ = maxNumLods; }
+
+  /**
+   * @brief Get the maximum number of levels of detail generated per mesh. See
+   * @ref setMaxNumLods.
+   */
+  int getMaxNumLods() const { return maxNumLods_; }
+
+  /**
+   * @brief Set the GPU memory budget, in bytes, of the textures loaded from
+   * now on, which are then streamed: uploaded at a low resolution and
+   * refined as they are drawn, see @ref gfx::TextureStreamer. 0, the default,
+   * uploads every texture at full resolution, and reloads the textures
+   * already streamed at full resolution too.
+   * @param textureMemoryBudget The budget in bytes.
+   */
+  void setTextureMemoryBudget(std::size_t textureMemoryBudget) {
+    textureStreamer_.setMemoryBudget(textureMemoryBudget);
+  }
+
+  /**
+   * @brief Get the GPU memory budget of the textures streamed. See @ref
+   * setTextureMemoryBudget.
+   */
+  std::size_t getTextureMemoryBudget() const {
+    return textureStreamer_.getMemoryBudget();
+  }
+
+  /**
+   * @brief Get the streamer of the textures loaded with a memory budget, see
+   * @ref setTextureMemoryBudget. Its @ref gfx::TextureStreamer::update is
+   * expected to be called once per frame.
+   */
+  gfx::TextureStreamer& getTextureStreamer() { return textureStreamer_; }
+
+  /**
+   * @brief Set the number of triangles above which general meshes are split
+   * into spatially compact chunks as they are loaded, so that frustum culling
+   * can skip the parts of a large scan out of view, see @ref
+   * GenericMeshData::splitIntoChunks. 0, the default, never splits.
+   * @param maxChunkTriangles The maximum number of triangles per chunk.
+   */
+  void setMaxChunkTriangles(int maxChunkTriangles) {
+    maxChunkTriangles_ = maxChunkTriangles;
+  }
+
+  /**
+   * @brief Get the maximum number of triangles per mesh chunk. See @ref
+   * setMaxChunkTriangles.
+   */
+  int getMaxChunkTriangles() const { return maxChunkTriangles_; }
+
+  /**
+   * @brief Forget every file-based asset loaded so far, so that the next load
+   * of each file imports it again with the current loader settings, e.g.
+   * after @ref setOptimizeMeshes or @ref setMaxNumLods. Primitive assets don't
+   * depend on these settings and are kept. GPU resources still drawn by
+   * existing scene graphs stay alive until those are destroyed.
+   */
+  void unloadFileAssets();
+
+  /**
+   * @brief Set whether the absolute bounding boxes of static general mesh
+   * drawables are computed by transforming the local bounding box of their
+   * mesh rather than every vertex. Independent of the vertex count, but the
+   * boxes are only conservative, i.e. may be larger than the tight ones when
+   * the drawable is rotated. Disabled by default.
+   * @param useConservativeAbsoluteAABBs Whether to use conservative bounds.
+   */
+  void setUseConservativeAbsoluteAABBs(bool useConservativeAbsoluteAABBs) {
+    useConservativeAbsoluteAABBs_ = useConservativeAbsoluteAABBs;
+  }
+
+  /**
+   * @brief Get whether the absolute bounding boxes of static general mesh
+   * drawables are conservative. See @ref setUseConservativeAbsoluteAABBs.
+   */
+  bool getUseConservativeAbsoluteAABBs() const {
+    return useConservativeAbsoluteAABBs_;
+  }
+
+  /**
+   * @brief Set the number of worker threads computing the absolute bounding
+   * boxes of static general mesh drawables alongside the loading thread. They
+   * only read the loaded mesh data, so unlike @ref setNumImportThreads this
+   * costs no extra memory.
+   * @param numAbsoluteAABBThreads The number of worker threads. 0 computes
+   * them serially, negative values, the default, use one less than the
+   * number of hardware threads.
+   */
+  void setNumAbsoluteAABBThreads(int numAbsoluteAABBThreads);
+
+  /**
+   * @brief Get the number of worker threads computing absolute bounding
+   * boxes. See @ref setNumAbsoluteAABBThreads.
+   */
+  int getNumAbsoluteAABBThreads() const { return numAbsoluteAABBThreads_; }
+
  private:
   /**
    * @brief Load the requested mesh info into @ref meshInfo corresponding to
@@ -473,12 +634,21 @@ class ResourceManager {
    *
    * -) for ptex mesh:
    * meshID is the index of the submesh corresponding to the drawable;
+   *
+   * chunkID: for a general mesh split into chunks, the chunk of meshes_[meshID]
+   * corresponding to the drawable, see @ref GenericMeshData::splitIntoChunks.
    */
   struct StaticDrawableInfo {
     esp::scene::SceneNode& node;
     uint32_t meshID;
+    int chunkID = ID_UNDEFINED;
   };
 
+  /**
+   * @brief Get the mesh, or mesh chunk, drawn by a static drawable.
+   */
+  BaseMesh& getStaticDrawableMesh(const StaticDrawableInfo& info);
+
   /**
    * @brief Define a map type referencing function pointers to @ref
    * createPrimitiveAttributes() keyed by string names of classes being
@@ -522,41 +692,87 @@ class ResourceManager {
                     std::vector<StaticDrawableInfo>& staticDrawableInfo);
 
   /**
-   * @brief Load textures from importer into assets, and update metaData for
-   * an asset to link textures to that asset.
+   * @brief Decode an asset file into an @ref ImportedAsset, loading its
+   * textures and meshes into assets along the way, and update metaData for
+   * the asset to link textures and meshes to that asset.
    *
-   * @param importer The importer already loaded with information for the
-   * asset.
+   * Images and meshes are decoded in parallel by @ref importPool_ and
+   * uploaded to the GPU on the calling thread as each becomes ready.
+   * @param filename The asset file, already opened by @ref fileImporter_.
    * @param loadedAssetData The asset's @ref LoadedAssetData object.
+   * @return The decoded asset, or nullptr if its component hierarchy could
+   * not be loaded.
    */
-  void loadTextures(Importer& importer, LoadedAssetData& loadedAssetData);
+  ImportedAsset::ptr importAsset(const std::string& filename,
+                                 LoadedAssetData& loadedAssetData);
 
   /**
-   * @brief Load meshes from importer into assets.
+   * @brief Allocate texture and mesh slots for an asset, and update metaData
+   * for the asset to link them to that asset.
    *
-   * Compute bounding boxes, upload mesh data to GPU, and update metaData for
-   * an asset to link meshes to that asset.
-   * @param importer The importer already loaded with information for the
-   * asset.
+   * @param importedAsset The decoded asset.
    * @param loadedAssetData The asset's @ref LoadedAssetData object.
    */
-  void loadMeshes(Importer& importer, LoadedAssetData& loadedAssetData);
+  void reserveTexturesAndMeshes(const ImportedAsset& importedAsset,
+                                LoadedAssetData& loadedAssetData);
 
   /**
-   * @brief Recursively parse the mesh component transformation heirarchy for
-   * the imported asset.
+   * @brief Create the GPU texture or the mesh of a decoded asset component in
+   * the slot allocated by @ref reserveTexturesAndMeshes. Meshes are copied,
+   * so importedAsset can be shared.
    *
-   * @param importer The importer already loaded with information for the
-   * asset.
-   * @param parent The root of the mesh transform heirarchy for the remaining
-   * sub-tree. The generated @ref MeshTransformNode will be added as a child.
-   * Typically the @ref MeshMetaData::root to begin recursion.
-   * @param componentID The next component to add to the heirarchy. Identifies
-   * the component in the @ref Importer.
+   * @param importedAsset The decoded asset.
+   * @param componentID The index of a texture, or the number of textures
+   * plus the index of a mesh.
+   * @param loadedAssetData The asset's @ref LoadedAssetData object.
    */
-  void loadMeshHierarchy(Importer& importer,
-                         MeshTransformNode& parent,
-                         int componentID);
+  void uploadImportedComponent(const ImportedAsset::cptr& importedAsset,
+                               int componentID,
+                               const LoadedAssetData& loadedAssetData);
+
+  /**
+   * @brief Create a GL texture from a decoded texture. Must be called on the
+   * GL context thread.
+   *
+   * @param importedTexture The decoded texture.
+   * @return The texture, or nullptr if it could not be decoded.
+   */
+  std::shared_ptr<Mn::GL::Texture2D> uploadTexture(
+      const ImportedTexture& importedTexture);
+
+  /**
+   * @brief Create a GL texture from a decoded texture and hand it to @ref
+   * textureStreamer_, which uploads its coarse levels. Single level textures
+   * get their mip levels generated on the CPU first, so that they can be
+   * uploaded without the full resolution one. Textures with a single level
+   * that cannot be generated are uploaded whole with @ref uploadTexture.
+   * Must be called on the GL context thread.
+   *
+   * @param importedAsset The decoded asset, kept alive by the streamer to
+   * upload finer levels later.
+   * @param textureID The local identifier of the texture in the asset.
+   * @return The texture, or nullptr if it could not be decoded.
+   */
+  std::shared_ptr<Mn::GL::Texture2D> streamTexture(
+      const ImportedAsset::cptr& importedAsset,
+      int textureID);
+
+  /**
+   * @brief Configure the sampler of a new GL texture and upload mip levels
+   * into it.
+   *
+   * @param texture The texture, without storage yet.
+   * @param textureData The sampler parameters.
+   * @param levels The images of all mip levels, finest first. A single
+   * uncompressed level gets its mip levels generated on the GPU.
+   * @param firstLevel The first of @p levels to upload, which becomes level
+   * 0 of the texture.
+   */
+  void uploadTextureLevels(
+      Mn::GL::Texture2D& texture,
+      const Mn::Trade::TextureData& textureData,
+      const std::vector<const Mn::Trade::ImageData2D*>& levels,
+      int firstLevel);
 
   /**
    * @brief Recursively build a unified @ref MeshData from loaded assets via a
@@ -575,14 +791,15 @@ class ResourceManager {
                      const Mn::Matrix4& transformFromParentToWorld);
 
   /**
-   * @brief Load materials from importer into assets, and update metaData for
-   * an asset to link materials to that asset.
+   * @brief Load materials from a decoded asset into assets, and update
+   * metaData for an asset to link materials to that asset. Textures must
+   * already be loaded.
    *
-   * @param importer The importer already loaded with information for the
-   * asset.
+   * @param importedAsset The decoded asset.
    * @param loadedAssetData The asset's @ref LoadedAssetData object.
    */
-  void loadMaterials(Importer& importer, LoadedAssetData& loadedAssetData);
+  void loadMaterials(const ImportedAsset& importedAsset,
+                     LoadedAssetData& loadedAssetData);
 
   /**
    * @brief Build a @ref PhongMaterialData for use with flat shading
@@ -757,7 +974,7 @@ class ResourceManager {
    * @param meshDataGL The mesh data.
    * @return The mesh bounding box.
    */
-  Mn::Range3D computeMeshBB(BaseMesh* meshDataGL);
+  static Mn::Range3D computeMeshBB(BaseMesh* meshDataGL);
 
   /**
    * @brief Compute the absolute AABBs for drawables in PTex mesh in world
@@ -772,7 +989,10 @@ class ResourceManager {
 
   /**
    * @brief Compute the absolute AABBs for drawables in general mesh (e.g.,
-   * MP3D) world space
+   * MP3D) world space. Vertex positions are transformed straight from the
+   * mesh data without copies, split into chunks across @ref
+   * numAbsoluteAABBThreads_ worker threads. See also @ref
+   * setUseConservativeAbsoluteAABBs.
    */
   void computeGeneralMeshAbsoluteAABBs(
       const std::vector<StaticDrawableInfo>& staticDrawableInfo);
@@ -815,12 +1035,25 @@ class ResourceManager {
    * @param texture Optional texture for the mesh.
    * @param color Optional color parameter for the shader program. Defaults to
    * white.
+   * @return The created drawable.
+   */
+  gfx::GenericDrawable& createGenericDrawable(
+      Mn::GL::Mesh& mesh,
+      scene::SceneNode& node,
+      const Mn::ResourceKey& lightSetup,
+      const Mn::ResourceKey& material,
+      DrawableGroup* group = nullptr);
+
+  /**
+   * @brief Create a @ref gfx::GenericDrawable for a general mesh, drawing its
+   * levels of detail when available, see @ref GenericMeshData::generateLods.
+   * Parameters are as for @ref createGenericDrawable.
    */
-  void createGenericDrawable(Mn::GL::Mesh& mesh,
-                             scene::SceneNode& node,
-                             const Mn::ResourceKey& lightSetup,
-                             const Mn::ResourceKey& material,
-                             DrawableGroup* group = nullptr);
+  void createGenericMeshDrawable(GenericMeshData& mesh,
+                                 scene::SceneNode& node,
+                                 const Mn::ResourceKey& lightSetup,
+                                 const Mn::ResourceKey& material,
+                                 DrawableGroup* group);
 
   // ======== General geometry data ========
   // shared_ptr is used here, instead of Corrade::Containers::Optional, or
@@ -875,6 +1108,59 @@ class ResourceManager {
    */
   Corrade::Containers::Pointer<Importer> fileImporter_;
 
+  /**
+   * @brief Worker threads decoding textures and meshes for @ref
+   * importAsset. Created on demand from @ref numImportThreads_.
+   */
+  AssetImportPool::uptr importPool_ = nullptr;
+
+  /**
+   * @brief The number of worker threads in @ref importPool_.
+   */
+  int numImportThreads_ = 0;
+
+  /**
+   * @brief Whether to load general meshes from their baked file when
+   * available, see @ref setUseBakedAssets.
+   */
+  bool useBakedAssets_ = true;
+
+  /**
+   * @brief Whether meshes are optimized for rendering at import, see @ref
+   * setOptimizeMeshes.
+   */
+  bool optimizeMeshes_ = false;
+
+  /**
+   * @brief Maximum number of levels of detail generated per general mesh, see
+   * @ref setMaxNumLods.
+   */
+  int maxNumLods_ = 0;
+
+  /**
+   * @brief Maximum number of triangles per chunk of a general mesh, see @ref
+   * setMaxChunkTriangles.
+   */
+  int maxChunkTriangles_ = 0;
+
+  /**
+   * @brief Streams the textures loaded with a memory budget, see @ref
+   * setTextureMemoryBudget.
+   */
+  gfx::TextureStreamer textureStreamer_;
+
+  /**
+   * @brief Whether absolute bounding boxes of general meshes are computed
+   * from their local bounding box, see @ref setUseConservativeAbsoluteAABBs.
+   */
+  bool useConservativeAbsoluteAABBs_ = false;
+
+  /**
+   * @brief The number of worker threads computing absolute bounding boxes,
+   * see @ref setNumAbsoluteAABBThreads.
+   */
+  int numAbsoluteAABBThreads_ = 0;
+
   // ======== Physical parameter data ========
 
   /**
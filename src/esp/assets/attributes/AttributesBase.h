@@ -18,9 +18,40 @@ namespace attributes {
  */
 class AbstractAttributes : public esp::core::Configuration {
  public:
+  /**
+   * @brief Slots of the keys of @ref schema(), continued by the slots of
+   * derived classes.
+   */
+  struct Slots {
+    enum : int { AttributesClassKey, Handle, FileDirectory, ID, Count };
+  };
+
+  /**
+   * @brief The keys stored in slots.
+   */
+  static const esp::core::ConfigurationSchema& schema() {
+    using Type = esp::core::ConfigurationValueType;
+    static constexpr esp::core::ConfigurationKey Keys[]{
+        {"attributesClassKey", Type::String},
+        {"handle", Type::String},
+        {"fileDirectory", Type::String},
+        {"ID", Type::Int}};
+    static_assert(sizeof(Keys) / sizeof(Keys[0]) == Slots::Count,
+                  "keys do not match slots");
+    static const esp::core::ConfigurationSchema schema{Keys};
+    return schema;
+  }
+
+  /**
+   * @brief Constructor.
+   * @param schema The keys stored in slots, the schema of the derived class
+   * extending this one.
+   */
   AbstractAttributes(const std::string& attributesClassKey,
-                     const std::string& handle)
-      : Configuration() {
+                     const std::string& handle,
+                     const esp::core::ConfigurationSchema& schema =
+                         AbstractAttributes::schema())
+      : Configuration(schema) {
     setAttributesClassKey(attributesClassKey);
     AbstractAttributes::setHandle(handle);
   }
@@ -30,7 +61,9 @@ class AbstractAttributes : public esp::core::Configuration {
    * @brief Get this attributes' class.  Should only be set from constructor.
    * Used as key in constructor function pointer maps in AttributesManagers.
    */
-  std::string getClassKey() const { return getString("attributesClassKey"); }
+  std::string getClassKey() const {
+    return getSlot<std::string>(Slots::AttributesClassKey);
+  }
 
   /**
    * @brief Set this attributes name/origin.  Some attributes derive their own
@@ -39,31 +72,33 @@ class AbstractAttributes : public esp::core::Configuration {
    * @param handle the handle to set.
    */
   virtual void setHandle(const std::string& handle) {
-    setString("handle", handle);
+    setSlot(Slots::Handle, handle);
   }
-  std::string getHandle() const { return getString("handle"); }
+  std::string getHandle() const { return getSlot<std::string>(Slots::Handle); }
 
   /**
    * @brief directory where files used to construct attributes can be found.
    */
   virtual void setFileDirectory(const std::string& fileDirectory) {
-    setString("fileDirectory", fileDirectory);
+    setSlot(Slots::FileDirectory, fileDirectory);
+  }
+  std::string getFileDirectory() const {
+    return getSlot<std::string>(Slots::FileDirectory);
   }
-  std::string getFileDirectory() const { return getString("fileDirectory"); }
 
-  void setID(int ID) { setInt("ID", ID); }
-  int getID() const { return getInt("ID"); }
+  void setID(int ID) { setSlot(Slots::ID, ID); }
+  int getID() const { return getSlot<int>(Slots::ID); }
 
   /**
    * @brief Returns configuration to be used with PrimitiveImporter to
    * instantiate Primitives.  Names in getter/setters chosen to match parameter
    * name expectations in PrimitiveImporter.
    *
-   * @return a reference to the underlying configuration group for this
-   * attributes object
+   * @return a configuration group holding all values of this attributes
+   * object
    */
-  const Corrade::Utility::ConfigurationGroup& getConfigGroup() const {
-    return cfg;
+  Corrade::Utility::ConfigurationGroup getConfigGroup() const {
+    return getConfigurationGroup();
   }
 
  protected:
@@ -74,7 +109,7 @@ class AbstractAttributes : public esp::core::Configuration {
    * constructors used to make copies of this object in copy constructor map.
    */
   void setAttributesClassKey(const std::string& attributesClassKey) {
-    setString("attributesClassKey", attributesClassKey);
+    setSlot(Slots::AttributesClassKey, attributesClassKey);
   }
 
  public:
@@ -36,6 +36,7 @@ const std::string ObjectAttributes::JSONConfigTestString =
       "mass": 9,
       "use bounding box for collision": true,
       "join collision meshes":true,
+      "collision hull vertex budget":32,
       "inertia": [1.1, 0.9, 0.3],
       "COM": [0.1,0.2,0.3]
     })";
@@ -47,12 +48,41 @@ const std::string StageAttributes::JSONConfigTestString =
       "origin":[1,2,3],
       "semantic mesh":"testJSONSemanticAsset.glb",
       "nav mesh":"testJSONNavMeshAsset.glb",
-      "house filename":"testJSONHouseFileName.glb"
+      "house filename":"testJSONHouseFileName.glb",
+      "collision bvh cache":"testJSONCollisionBvhCache.bvh"
     })";
+const esp::core::ConfigurationSchema& AbstractObjectAttributes::schema() {
+  using Type = esp::core::ConfigurationValueType;
+  static constexpr esp::core::ConfigurationKey Keys[]{
+      {"scale", Type::Vec3},
+      {"margin", Type::Double},
+      {"orientUp", Type::Vec3},
+      {"orientFront", Type::Vec3},
+      {"unitsToMeters", Type::Double},
+      {"frictionCoefficient", Type::Double},
+      {"restitutionCoefficient", Type::Double},
+      {"renderAssetType", Type::Int},
+      {"renderAssetHandle", Type::String},
+      {"renderAssetIsPrimitive", Type::Bool},
+      {"collisionAssetType", Type::Int},
+      {"collisionAssetHandle", Type::String},
+      {"collisionAssetIsPrimitive", Type::Bool},
+      {"useMeshCollision", Type::Bool},
+      {"requiresLighting", Type::Bool},
+      {"__isDirty", Type::Bool}};
+  static_assert(sizeof(Keys) / sizeof(Keys[0]) ==
+                    Slots::Count - AbstractAttributes::Slots::Count,
+                "keys do not match slots");
+  static const esp::core::ConfigurationSchema schema{
+      AbstractAttributes::schema(), Keys};
+  return schema;
+}
+
 AbstractObjectAttributes::AbstractObjectAttributes(
     const std::string& attributesClassKey,
-    const std::string& handle)
-    : AbstractAttributes(attributesClassKey, handle) {
+    const std::string& handle,
+    const esp::core::ConfigurationSchema& schema)
+    : AbstractAttributes(attributesClassKey, handle, schema) {
   setFrictionCoefficient(0.5);
   setRestitutionCoefficient(0.1);
   setScale({1.0, 1.0, 1.0});
@@ -71,8 +101,31 @@ AbstractObjectAttributes::AbstractObjectAttributes(
   setCollisionAssetHandle("");
 }  // AbstractObjectAttributes ctor
 
+const esp::core::ConfigurationSchema& ObjectAttributes::schema() {
+  using Type = esp::core::ConfigurationValueType;
+  static constexpr esp::core::ConfigurationKey Keys[]{
+      {"COM", Type::Vec3},
+      {"computeCOMFromShape", Type::Bool},
+      {"mass", Type::Double},
+      {"inertia", Type::Vec3},
+      {"linearDamping", Type::Double},
+      {"angularDamping", Type::Double},
+      {"useBoundingBoxForCollision", Type::Bool},
+      {"joinCollisionMeshes", Type::Bool},
+      {"collisionHullVertexBudget", Type::Int},
+      {"isVisible", Type::Bool},
+      {"semanticId", Type::Int},
+      {"isCollidable", Type::Bool}};
+  static_assert(sizeof(Keys) / sizeof(Keys[0]) ==
+                    Slots::Count - AbstractObjectAttributes::Slots::Count,
+                "keys do not match slots");
+  static const esp::core::ConfigurationSchema schema{
+      AbstractObjectAttributes::schema(), Keys};
+  return schema;
+}
+
 ObjectAttributes::ObjectAttributes(const std::string& handle)
-    : AbstractObjectAttributes("ObjectAttributes", handle) {
+    : AbstractObjectAttributes("ObjectAttributes", handle, schema()) {
   // fill necessary attribute defaults
   setMass(1.0);
   setCOM({0, 0, 0});
@@ -84,14 +137,36 @@ ObjectAttributes::ObjectAttributes(const std::string& handle)
 
   setBoundingBoxCollisions(false);
   setJoinCollisionMeshes(true);
+  setCollisionHullVertexBudget(0);
   setRequiresLighting(true);
   setIsVisible(true);
   setSemanticId(0);
   setIsCollidable(true);
 }  // ObjectAttributes ctor
 
+const esp::core::ConfigurationSchema& StageAttributes::schema() {
+  using Type = esp::core::ConfigurationValueType;
+  static constexpr esp::core::ConfigurationKey Keys[]{
+      {"origin", Type::Vec3},
+      {"gravity", Type::Vec3},
+      {"houseFilename", Type::String},
+      {"semanticAssetHandle", Type::String},
+      {"semanticAssetType", Type::Int},
+      {"loadSemanticMesh", Type::Bool},
+      {"navmeshAssetHandle", Type::String},
+      {"lightSetup", Type::String},
+      {"frustrumCulling", Type::Bool},
+      {"collisionBvhCacheFilename", Type::String}};
+  static_assert(sizeof(Keys) / sizeof(Keys[0]) ==
+                    Slots::Count - AbstractObjectAttributes::Slots::Count,
+                "keys do not match slots");
+  static const esp::core::ConfigurationSchema schema{
+      AbstractObjectAttributes::schema(), Keys};
+  return schema;
+}
+
 StageAttributes::StageAttributes(const std::string& handle)
-    : AbstractObjectAttributes("StageAttributes", handle) {
+    : AbstractObjectAttributes("StageAttributes", handle, schema()) {
   setGravity({0, -9.8, 0});
   setOrigin({0, 0, 0});
 
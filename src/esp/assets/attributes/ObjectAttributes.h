@@ -34,70 +34,112 @@ class AbstractObjectAttributes : public AbstractAttributes {
    * type to @ref AssetTypes.  Keys must be lowercase.
    */
   static const std::map<std::string, esp::assets::AssetType> AssetTypeNamesMap;
+
+  /**
+   * @brief Slots of the keys of @ref schema(), following those of @ref
+   * AbstractAttributes.
+   */
+  struct Slots : AbstractAttributes::Slots {
+    enum : int {
+      Scale = AbstractAttributes::Slots::Count,
+      Margin,
+      OrientUp,
+      OrientFront,
+      UnitsToMeters,
+      FrictionCoefficient,
+      RestitutionCoefficient,
+      RenderAssetType,
+      RenderAssetHandle,
+      RenderAssetIsPrimitive,
+      CollisionAssetType,
+      CollisionAssetHandle,
+      CollisionAssetIsPrimitive,
+      UseMeshCollision,
+      RequiresLighting,
+      IsDirty,
+      Count
+    };
+  };
+
+  /**
+   * @brief The keys stored in slots.
+   */
+  static const esp::core::ConfigurationSchema& schema();
+
   AbstractObjectAttributes(const std::string& classKey,
-                           const std::string& handle);
+                           const std::string& handle,
+                           const esp::core::ConfigurationSchema& schema =
+                               AbstractObjectAttributes::schema());
 
   virtual ~AbstractObjectAttributes() = default;
-  void setScale(const Magnum::Vector3& scale) { setVec3("scale", scale); }
-  Magnum::Vector3 getScale() const { return getVec3("scale"); }
+  void setScale(const Magnum::Vector3& scale) { setSlot(Slots::Scale, scale); }
+  Magnum::Vector3 getScale() const {
+    return getSlot<Magnum::Vector3>(Slots::Scale);
+  }
 
   /**
    * @brief collision shape inflation margin
    */
-  void setMargin(double margin) { setDouble("margin", margin); }
-  double getMargin() const { return getDouble("margin"); }
+  void setMargin(double margin) { setSlot(Slots::Margin, margin); }
+  double getMargin() const { return getSlot<double>(Slots::Margin); }
 
   /**
    * @brief set default up orientation for object/stage mesh
    */
   void setOrientUp(const Magnum::Vector3& orientUp) {
-    setVec3("orientUp", orientUp);
+    setSlot(Slots::OrientUp, orientUp);
   }
   /**
    * @brief get default up orientation for object/stage mesh
    */
-  Magnum::Vector3 getOrientUp() const { return getVec3("orientUp"); }
+  Magnum::Vector3 getOrientUp() const {
+    return getSlot<Magnum::Vector3>(Slots::OrientUp);
+  }
   /**
    * @brief set default forwardd orientation for object/stage mesh
    */
   void setOrientFront(const Magnum::Vector3& orientFront) {
-    setVec3("orientFront", orientFront);
+    setSlot(Slots::OrientFront, orientFront);
   }
   /**
    * @brief get default forwardd orientation for object/stage mesh
    */
-  Magnum::Vector3 getOrientFront() const { return getVec3("orientFront"); }
+  Magnum::Vector3 getOrientFront() const {
+    return getSlot<Magnum::Vector3>(Slots::OrientFront);
+  }
 
   // units to meters mapping
   void setUnitsToMeters(double unitsToMeters) {
-    setDouble("unitsToMeters", unitsToMeters);
+    setSlot(Slots::UnitsToMeters, unitsToMeters);
+  }
+  double getUnitsToMeters() const {
+    return getSlot<double>(Slots::UnitsToMeters);
   }
-  double getUnitsToMeters() const { return getDouble("unitsToMeters"); }
 
   void setFrictionCoefficient(double frictionCoefficient) {
-    setDouble("frictionCoefficient", frictionCoefficient);
+    setSlot(Slots::FrictionCoefficient, frictionCoefficient);
   }
   double getFrictionCoefficient() const {
-    return getDouble("frictionCoefficient");
+    return getSlot<double>(Slots::FrictionCoefficient);
   }
 
   void setRestitutionCoefficient(double restitutionCoefficient) {
-    setDouble("restitutionCoefficient", restitutionCoefficient);
+    setSlot(Slots::RestitutionCoefficient, restitutionCoefficient);
   }
   double getRestitutionCoefficient() const {
-    return getDouble("restitutionCoefficient");
+    return getSlot<double>(Slots::RestitutionCoefficient);
   }
   void setRenderAssetType(int renderAssetType) {
-    setInt("renderAssetType", renderAssetType);
+    setSlot(Slots::RenderAssetType, renderAssetType);
   }
-  int getRenderAssetType() { return getInt("renderAssetType"); }
+  int getRenderAssetType() { return getSlot<int>(Slots::RenderAssetType); }
 
   void setRenderAssetHandle(const std::string& renderAssetHandle) {
-    setString("renderAssetHandle", renderAssetHandle);
+    setSlot(Slots::RenderAssetHandle, renderAssetHandle);
     setIsDirty();
   }
   std::string getRenderAssetHandle() const {
-    return getString("renderAssetHandle");
+    return getSlot<std::string>(Slots::RenderAssetHandle);
   }
 
   /**
@@ -107,24 +149,26 @@ class AbstractObjectAttributes : public AbstractAttributes {
    * primitive or not
    */
   void setRenderAssetIsPrimitive(bool renderAssetIsPrimitive) {
-    setBool("renderAssetIsPrimitive", renderAssetIsPrimitive);
+    setSlot(Slots::RenderAssetIsPrimitive, renderAssetIsPrimitive);
   }
 
   void setCollisionAssetType(int collisionAssetType) {
-    setInt("collisionAssetType", collisionAssetType);
+    setSlot(Slots::CollisionAssetType, collisionAssetType);
+  }
+  int getCollisionAssetType() {
+    return getSlot<int>(Slots::CollisionAssetType);
   }
-  int getCollisionAssetType() { return getInt("collisionAssetType"); }
 
   bool getRenderAssetIsPrimitive() const {
-    return getBool("renderAssetIsPrimitive");
+    return getSlot<bool>(Slots::RenderAssetIsPrimitive);
   }
 
   void setCollisionAssetHandle(const std::string& collisionAssetHandle) {
-    setString("collisionAssetHandle", collisionAssetHandle);
+    setSlot(Slots::CollisionAssetHandle, collisionAssetHandle);
     setIsDirty();
   }
   std::string getCollisionAssetHandle() const {
-    return getString("collisionAssetHandle");
+    return getSlot<std::string>(Slots::CollisionAssetHandle);
   }
 
   /**
@@ -134,11 +178,11 @@ class AbstractObjectAttributes : public AbstractAttributes {
    * primitive (implicitly calculated) or a mesh
    */
   void setCollisionAssetIsPrimitive(bool collisionAssetIsPrimitive) {
-    setBool("collisionAssetIsPrimitive", collisionAssetIsPrimitive);
+    setSlot(Slots::CollisionAssetIsPrimitive, collisionAssetIsPrimitive);
   }
 
   bool getCollisionAssetIsPrimitive() const {
-    return getBool("collisionAssetIsPrimitive");
+    return getSlot<bool>(Slots::CollisionAssetIsPrimitive);
   }
 
   /**
@@ -146,22 +190,26 @@ class AbstractObjectAttributes : public AbstractAttributes {
    * collision calculation.
    */
   void setUseMeshCollision(bool useMeshCollision) {
-    setBool("useMeshCollision", useMeshCollision);
+    setSlot(Slots::UseMeshCollision, useMeshCollision);
   }
 
-  bool getUseMeshCollision() const { return getBool("useMeshCollision"); }
+  bool getUseMeshCollision() const {
+    return getSlot<bool>(Slots::UseMeshCollision);
+  }
 
   // if true use phong illumination model instead of flat shading
   void setRequiresLighting(bool requiresLighting) {
-    setBool("requiresLighting", requiresLighting);
+    setSlot(Slots::RequiresLighting, requiresLighting);
+  }
+  bool getRequiresLighting() const {
+    return getSlot<bool>(Slots::RequiresLighting);
   }
-  bool getRequiresLighting() const { return getBool("requiresLighting"); }
 
-  bool getIsDirty() const { return getBool("__isDirty"); }
-  void setIsClean() { setBool("__isDirty", false); }
+  bool getIsDirty() const { return getSlot<bool>(Slots::IsDirty); }
+  void setIsClean() { setSlot(Slots::IsDirty, false); }
 
  protected:
-  void setIsDirty() { setBool("__isDirty", true); }
+  void setIsDirty() { setSlot(Slots::IsDirty, true); }
 
  public:
   ESP_SMART_POINTERS(AbstractObjectAttributes)
@@ -182,69 +230,120 @@ class ObjectAttributes : public AbstractObjectAttributes {
    */
   static const std::string JSONConfigTestString;
 
+
+  /**
+   * @brief Slots of the keys of @ref schema(), following those of @ref
+   * AbstractObjectAttributes.
+   */
+  struct Slots : AbstractObjectAttributes::Slots {
+    enum : int {
+      COM = AbstractObjectAttributes::Slots::Count,
+      ComputeCOMFromShape,
+      Mass,
+      Inertia,
+      LinearDamping,
+      AngularDamping,
+      UseBoundingBoxForCollision,
+      JoinCollisionMeshes,
+      CollisionHullVertexBudget,
+      IsVisible,
+      SemanticId,
+      IsCollidable,
+      Count
+    };
+  };
+
+  /**
+   * @brief The keys stored in slots.
+   */
+  static const esp::core::ConfigurationSchema& schema();
+
   ObjectAttributes(const std::string& handle = "");
   // center of mass (COM)
-  void setCOM(const Magnum::Vector3& com) { setVec3("COM", com); }
-  Magnum::Vector3 getCOM() const { return getVec3("COM"); }
+  void setCOM(const Magnum::Vector3& com) { setSlot(Slots::COM, com); }
+  Magnum::Vector3 getCOM() const {
+    return getSlot<Magnum::Vector3>(Slots::COM);
+  }
 
   // whether com is provided or not
   void setComputeCOMFromShape(bool computeCOMFromShape) {
-    setBool("computeCOMFromShape", computeCOMFromShape);
+    setSlot(Slots::ComputeCOMFromShape, computeCOMFromShape);
+  }
+  bool getComputeCOMFromShape() const {
+    return getSlot<bool>(Slots::ComputeCOMFromShape);
   }
-  bool getComputeCOMFromShape() const { return getBool("computeCOMFromShape"); }
 
-  void setMass(double mass) { setDouble("mass", mass); }
-  double getMass() const { return getDouble("mass"); }
+  void setMass(double mass) { setSlot(Slots::Mass, mass); }
+  double getMass() const { return getSlot<double>(Slots::Mass); }
 
   // inertia diagonal
   void setInertia(const Magnum::Vector3& inertia) {
-    setVec3("inertia", inertia);
+    setSlot(Slots::Inertia, inertia);
+  }
+  Magnum::Vector3 getInertia() const {
+    return getSlot<Magnum::Vector3>(Slots::Inertia);
   }
-  Magnum::Vector3 getInertia() const { return getVec3("inertia"); }
 
   void setLinearDamping(double linearDamping) {
-    setDouble("linearDamping", linearDamping);
+    setSlot(Slots::LinearDamping, linearDamping);
+  }
+  double getLinearDamping() const {
+    return getSlot<double>(Slots::LinearDamping);
   }
-  double getLinearDamping() const { return getDouble("linearDamping"); }
 
   void setAngularDamping(double angularDamping) {
-    setDouble("angularDamping", angularDamping);
+    setSlot(Slots::AngularDamping, angularDamping);
+  }
+  double getAngularDamping() const {
+    return getSlot<double>(Slots::AngularDamping);
   }
-  double getAngularDamping() const { return getDouble("angularDamping"); }
 
   // if true override other settings and use render mesh bounding box as
   // collision object
   void setBoundingBoxCollisions(bool useBoundingBoxForCollision) {
-    setBool("useBoundingBoxForCollision", useBoundingBoxForCollision);
+    setSlot(Slots::UseBoundingBoxForCollision, useBoundingBoxForCollision);
   }
   bool getBoundingBoxCollisions() const {
-    return getBool("useBoundingBoxForCollision");
+    return getSlot<bool>(Slots::UseBoundingBoxForCollision);
   }
 
   // if true join all mesh components of an asset into a unified collision
   // object
   void setJoinCollisionMeshes(bool joinCollisionMeshes) {
-    setBool("joinCollisionMeshes", joinCollisionMeshes);
+    setSlot(Slots::JoinCollisionMeshes, joinCollisionMeshes);
+  }
+  bool getJoinCollisionMeshes() const {
+    return getSlot<bool>(Slots::JoinCollisionMeshes);
+  }
+
+  // maximum number of vertices kept in each convex collision hull built from
+  // the collision mesh. 0 keeps every vertex.
+  void setCollisionHullVertexBudget(int collisionHullVertexBudget) {
+    setSlot(Slots::CollisionHullVertexBudget, collisionHullVertexBudget);
+  }
+  int getCollisionHullVertexBudget() const {
+    return getSlot<int>(Slots::CollisionHullVertexBudget);
   }
-  bool getJoinCollisionMeshes() const { return getBool("joinCollisionMeshes"); }
 
   /**
    * @brief If not visible can add dynamic non-rendered object into a scene
    * object.  If is not visible then should not add object to drawables.
    */
-  void setIsVisible(bool isVisible) { setBool("isVisible", isVisible); }
-  bool getIsVisible() const { return getBool("isVisible"); }
+  void setIsVisible(bool isVisible) { setSlot(Slots::IsVisible, isVisible); }
+  bool getIsVisible() const { return getSlot<bool>(Slots::IsVisible); }
 
-  void setSemanticId(uint32_t semanticId) { setInt("semanticId", semanticId); }
+  void setSemanticId(uint32_t semanticId) {
+    setSlot<int>(Slots::SemanticId, semanticId);
+  }
 
-  uint32_t getSemanticId() const { return getInt("semanticId"); }
+  uint32_t getSemanticId() const { return getSlot<int>(Slots::SemanticId); }
 
   // if object should be checked for collisions - if other objects can collide
   // with this object
   void setIsCollidable(bool isCollidable) {
-    setBool("isCollidable", isCollidable);
+    setSlot(Slots::IsCollidable, isCollidable);
   }
-  bool getIsCollidable() { return getBool("isCollidable"); }
+  bool getIsCollidable() { return getSlot<bool>(Slots::IsCollidable); }
 
  public:
   ESP_SMART_POINTERS(ObjectAttributes)
@@ -264,43 +363,77 @@ class StageAttributes : public AbstractObjectAttributes {
    * purposes, and so should not be used.
    */
   static const std::string JSONConfigTestString;
+
+  /**
+   * @brief Slots of the keys of @ref schema(), following those of @ref
+   * AbstractObjectAttributes.
+   */
+  struct Slots : AbstractObjectAttributes::Slots {
+    enum : int {
+      Origin = AbstractObjectAttributes::Slots::Count,
+      Gravity,
+      HouseFilename,
+      SemanticAssetHandle,
+      SemanticAssetType,
+      LoadSemanticMesh,
+      NavmeshAssetHandle,
+      LightSetup,
+      FrustrumCulling,
+      CollisionBvhCacheFilename,
+      Count
+    };
+  };
+
+  /**
+   * @brief The keys stored in slots.
+   */
+  static const esp::core::ConfigurationSchema& schema();
+
   StageAttributes(const std::string& handle = "");
 
-  void setOrigin(const Magnum::Vector3& origin) { setVec3("origin", origin); }
-  Magnum::Vector3 getOrigin() const { return getVec3("origin"); }
+  void setOrigin(const Magnum::Vector3& origin) {
+    setSlot(Slots::Origin, origin);
+  }
+  Magnum::Vector3 getOrigin() const {
+    return getSlot<Magnum::Vector3>(Slots::Origin);
+  }
 
   void setGravity(const Magnum::Vector3& gravity) {
-    setVec3("gravity", gravity);
+    setSlot(Slots::Gravity, gravity);
+  }
+  Magnum::Vector3 getGravity() const {
+    return getSlot<Magnum::Vector3>(Slots::Gravity);
   }
-  Magnum::Vector3 getGravity() const { return getVec3("gravity"); }
   void setHouseFilename(const std::string& houseFilename) {
-    setString("houseFilename", houseFilename);
+    setSlot(Slots::HouseFilename, houseFilename);
     setIsDirty();
   }
-  std::string getHouseFilename() const { return getString("houseFilename"); }
+  std::string getHouseFilename() const {
+    return getSlot<std::string>(Slots::HouseFilename);
+  }
   void setSemanticAssetHandle(const std::string& semanticAssetHandle) {
-    setString("semanticAssetHandle", semanticAssetHandle);
+    setSlot(Slots::SemanticAssetHandle, semanticAssetHandle);
     setIsDirty();
   }
   std::string getSemanticAssetHandle() const {
-    return getString("semanticAssetHandle");
+    return getSlot<std::string>(Slots::SemanticAssetHandle);
   }
   void setSemanticAssetType(int semanticAssetType) {
-    setInt("semanticAssetType", semanticAssetType);
+    setSlot(Slots::SemanticAssetType, semanticAssetType);
   }
-  int getSemanticAssetType() { return getInt("semanticAssetType"); }
+  int getSemanticAssetType() { return getSlot<int>(Slots::SemanticAssetType); }
 
   void setLoadSemanticMesh(bool loadSemanticMesh) {
-    setBool("loadSemanticMesh", loadSemanticMesh);
+    setSlot(Slots::LoadSemanticMesh, loadSemanticMesh);
   }
-  bool getLoadSemanticMesh() { return getBool("loadSemanticMesh"); }
+  bool getLoadSemanticMesh() { return getSlot<bool>(Slots::LoadSemanticMesh); }
 
   void setNavmeshAssetHandle(const std::string& navmeshAssetHandle) {
-    setString("navmeshAssetHandle", navmeshAssetHandle);
+    setSlot(Slots::NavmeshAssetHandle, navmeshAssetHandle);
     setIsDirty();
   }
   std::string getNavmeshAssetHandle() const {
-    return getString("navmeshAssetHandle");
+    return getSlot<std::string>(Slots::NavmeshAssetHandle);
   }
 
   /**
@@ -309,14 +442,30 @@ class StageAttributes : public AbstractObjectAttributes {
    * exists.
    */
   void setLightSetup(const std::string& lightSetup) {
-    setString("lightSetup", lightSetup);
+    setSlot(Slots::LightSetup, lightSetup);
+  }
+  std::string getLightSetup() {
+    return getSlot<std::string>(Slots::LightSetup);
   }
-  std::string getLightSetup() { return getString("lightSetup"); }
 
   void setFrustrumCulling(bool frustrumCulling) {
-    setBool("frustrumCulling", frustrumCulling);
+    setSlot(Slots::FrustrumCulling, frustrumCulling);
+  }
+  bool getFrustrumCulling() const {
+    return getSlot<bool>(Slots::FrustrumCulling);
+  }
+
+  /**
+   * @brief set the file the stage's collision BVHs are cached in. If set, the
+   * BVHs are loaded from this file instead of being rebuilt, and the file is
+   * (re)written whenever they have to be rebuilt. Empty disables the cache.
+   */
+  void setCollisionBvhCacheFilename(const std::string& bvhCacheFilename) {
+    setSlot(Slots::CollisionBvhCacheFilename, bvhCacheFilename);
+  }
+  std::string getCollisionBvhCacheFilename() const {
+    return getSlot<std::string>(Slots::CollisionBvhCacheFilename);
   }
-  bool getFrustrumCulling() const { return getBool("frustrumCulling"); }
 
  public:
   ESP_SMART_POINTERS(StageAttributes)
@@ -17,11 +17,29 @@ const std::string PhysicsManagerAttributes::JSONConfigTestString =
       "restitution coefficient": 1.1
     })";
 
+const esp::core::ConfigurationSchema& PhysicsManagerAttributes::schema() {
+  using Type = esp::core::ConfigurationValueType;
+  static constexpr esp::core::ConfigurationKey Keys[]{
+      {"simulator", Type::String},
+      {"timestep", Type::Double},
+      {"maxSubsteps", Type::Int},
+      {"gravity", Type::Vec3},
+      {"frictionCoefficient", Type::Double},
+      {"restitutionCoefficient", Type::Double}};
+  static_assert(sizeof(Keys) / sizeof(Keys[0]) ==
+                    Slots::Count - AbstractAttributes::Slots::Count,
+                "keys do not match slots");
+  static const esp::core::ConfigurationSchema schema{
+      AbstractAttributes::schema(), Keys};
+  return schema;
+}
+
 PhysicsManagerAttributes::PhysicsManagerAttributes(const std::string& handle)
-    : AbstractAttributes("PhysicsManagerAttributes", handle) {
+    : AbstractAttributes("PhysicsManagerAttributes", handle, schema()) {
   setSimulator("none");
   setTimestep(0.01);
-  setMaxSubsteps(10);
+  // 0 : stepping is unbounded
+  setMaxSubsteps(0);
 }  // PhysicsManagerAttributes ctor
 
 }  // namespace attributes
@@ -21,36 +21,68 @@ class PhysicsManagerAttributes : public AbstractAttributes {
    * purposefully invalid, for testing purposes, and so should not be used.
    */
   static const std::string JSONConfigTestString;
+
+  /**
+   * @brief Slots of the keys of @ref schema(), following those of @ref
+   * AbstractAttributes.
+   */
+  struct Slots : AbstractAttributes::Slots {
+    enum : int {
+      Simulator = AbstractAttributes::Slots::Count,
+      Timestep,
+      MaxSubsteps,
+      Gravity,
+      FrictionCoefficient,
+      RestitutionCoefficient,
+      Count
+    };
+  };
+
+  /**
+   * @brief The keys stored in slots.
+   */
+  static const esp::core::ConfigurationSchema& schema();
+
   PhysicsManagerAttributes(const std::string& handle = "");
 
   void setSimulator(const std::string& simulator) {
-    setString("simulator", simulator);
+    setSlot(Slots::Simulator, simulator);
+  }
+  std::string getSimulator() const {
+    return getSlot<std::string>(Slots::Simulator);
   }
-  std::string getSimulator() const { return getString("simulator"); }
 
-  void setTimestep(double timestep) { setDouble("timestep", timestep); }
-  double getTimestep() const { return getDouble("timestep"); }
+  void setTimestep(double timestep) { setSlot(Slots::Timestep, timestep); }
+  double getTimestep() const { return getSlot<double>(Slots::Timestep); }
 
-  void setMaxSubsteps(int maxSubsteps) { setInt("maxSubsteps", maxSubsteps); }
-  int getMaxSubsteps() const { return getInt("maxSubsteps"); }
+  // maximum number of timesteps a single physics step may take. 0 for no limit.
+  // The rest of a longer step is dropped, with a warning on the first overrun.
+  // NOTE: the "max substeps" JSON key used to be ignored, so configs which set
+  // it now bound their steps
+  void setMaxSubsteps(int maxSubsteps) {
+    setSlot(Slots::MaxSubsteps, maxSubsteps);
+  }
+  int getMaxSubsteps() const { return getSlot<int>(Slots::MaxSubsteps); }
 
   void setGravity(const Magnum::Vector3& gravity) {
-    setVec3("gravity", gravity);
+    setSlot(Slots::Gravity, gravity);
+  }
+  Magnum::Vector3 getGravity() const {
+    return getSlot<Magnum::Vector3>(Slots::Gravity);
   }
-  Magnum::Vector3 getGravity() const { return getVec3("gravity"); }
 
   void setFrictionCoefficient(double frictionCoefficient) {
-    setDouble("frictionCoefficient", frictionCoefficient);
+    setSlot(Slots::FrictionCoefficient, frictionCoefficient);
   }
   double getFrictionCoefficient() const {
-    return getDouble("frictionCoefficient");
+    return getSlot<double>(Slots::FrictionCoefficient);
   }
 
   void setRestitutionCoefficient(double restitutionCoefficient) {
-    setDouble("restitutionCoefficient", restitutionCoefficient);
+    setSlot(Slots::RestitutionCoefficient, restitutionCoefficient);
   }
   double getRestitutionCoefficient() const {
-    return getDouble("restitutionCoefficient");
+    return getSlot<double>(Slots::RestitutionCoefficient);
   }
 
  public:
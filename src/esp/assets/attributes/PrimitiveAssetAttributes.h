@@ -110,7 +110,7 @@ class AbstractPrimitiveAttributes : public AbstractAttributes {
   void buildHandle() {
     std::ostringstream oHndlStrm;
     oHndlStrm << getPrimObjClassName() << buildHandleDetail();
-    setString("handle", oHndlStrm.str());
+    setSlot(Slots::Handle, oHndlStrm.str());
   }
 
  protected:
@@ -9,10 +9,13 @@
  * @brief Class Template @ref esp::assets::managers::AttributesManager
  */
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <map>
 #include <set>
+#include <thread>
 
 #include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
@@ -23,6 +26,8 @@
 
 #include "esp/io/json.h"
 
+#include "TemplateHandleIndex.h"
+
 namespace Cr = Corrade;
 
 namespace esp {
@@ -121,6 +126,29 @@ class AttributesManager {
     return this->postCreateRegister(attr, registerTemplate);
   }  // AttributesManager::createFileBasedAttributesTemplate
 
+  /**
+   * @brief Creates instances of templates from many JSON files at once. The
+   * files are parsed in situ, and the templates built, on several threads,
+   * then registered together in the order of @ref filenames, so that they get
+   * the same IDs as if created one after the other with @ref
+   * createFileBasedAttributesTemplate.
+   *
+   * @ref loadAttributesFromJSONDoc is called concurrently, so it may only
+   * read the state of this manager.
+   *
+   * @param filenames the names of the files describing the attributes.
+   * @param registerTemplates whether to add these templates to the library.
+   * Defaults to true.
+   * @param numThreads the number of threads to parse with, 0 to use one per
+   * hardware thread. Defaults to 0.
+   * @return the templates in the order of @ref filenames, nullptr for those
+   * that failed.
+   */
+  std::vector<AttribsPtr> createFileBasedAttributesTemplates(
+      const std::vector<std::string>& filenames,
+      bool registerTemplates = true,
+      int numThreads = 0);
+
   /**
    * @brief Parse passed JSON Document specifically for @ref AttribsPtr object.
    * It always returns a @ref AttribsPtr object.
@@ -380,15 +408,14 @@ class AttributesManager {
    *
    * @param templateID The unique ID of the desired template.
    * @return The key referencing the template in @ref
-   * templateLibrary_, or nullptr if does not exist.
+   * templateLibrary_, or the empty string if does not exist.
    */
   std::string getTemplateHandleByID(const int templateID) const {
-    if (templateLibKeyByID_.count(templateID) == 0) {
+    if (!templateLibKeyByID_.has(templateID)) {
       LOG(ERROR) << "AttributesManager::getTemplateHandleByID : Unknown "
                  << attrType_ << " template ID:" << templateID << ". Aborting";
-      return nullptr;
     }
-    return templateLibKeyByID_.at(templateID);
+    return templateLibKeyByID_.getHandle(templateID);
   }  // AttributesManager::getTemplateHandleByID
 
   /**
@@ -431,6 +458,24 @@ class AttributesManager {
     return getRandomTemplateHandlePerType(templateLibKeyByID_, "");
   }  // AttributesManager::getRandomTemplateHandle
 
+  /**
+   * @brief Get the handle for a random attributes template among those whose
+   * origin handles contain, or do not contain, @ref subStr, ignoring case.
+   * The matching handles are cached, so sampling repeatedly from the same
+   * subset does no string operations.
+   *
+   * @param subStr substring to search for within existing templates.
+   * @param contains whether to sample among handles containing, or excluding,
+   * passed @ref subStr
+   * @return a randomly selected matching handle, or empty string if none
+   * found
+   */
+  std::string getRandomTemplateHandleBySubstring(const std::string& subStr,
+                                                 bool contains = true) const {
+    return getRandomTemplateHandlePerType(templateLibKeyByID_, "", subStr,
+                                          contains);
+  }  // AttributesManager::getRandomTemplateHandleBySubstring
+
   /**
    * @brief Get a copy of the attributes template identified by the
    * attributesTemplateID.
@@ -454,7 +499,8 @@ class AttributesManager {
   /**
    * @brief Return a reference to a copy of the object specified
    * by passed handle. This is the version that should be accessed by the
-   * user.
+   * user. The copy shares the values of the template until either is
+   * modified, so copies made per instantiated object do not allocate them.
    * @param templateHandle the string key of the attributes desired.
    * @return a copy of the desired attributes, or nullptr if does
    * not exist
@@ -804,31 +850,38 @@ class AttributesManager {
     int attributesTemplateID =
         getTemplateIDByHandleOrNew(attributesHandle, true);
     attributesTemplate->setID(attributesTemplateID);
-    // make a copy of this attributes so that user can continue to edit original
+    // make a copy of this attributes so that user can continue to edit original,
+    // the values are only copied by whichever is edited first
     AttribsPtr attributesTemplateCopy = copyAttributes(attributesTemplate);
     // add to libraries
     templateLibrary_[attributesHandle] = attributesTemplateCopy;
-    templateLibKeyByID_.emplace(attributesTemplateID, attributesHandle);
+    templateLibKeyByID_.add(attributesTemplateID, attributesHandle);
     return attributesTemplateID;
   }  // AttributesManager::addTemplateToLibrary
 
   /**
-   * @brief Return a random handle selected from the passed map
+   * @brief Return a random handle selected from the passed index
    *
-   * @param mapOfHandles map containing the desired attribute-type template
+   * @param mapOfHandles index containing the desired attribute-type template
    * handles
    * @param type the type of attributes being retrieved, for debug message
+   * @param subStr only select among handles containing, or not containing,
+   * this substring, ignoring case
+   * @param contains Whether to select among handles containing, or not
+   * containing, @ref subStr
    * @return a random template handle of the chosen type, or the empty
    * string if none loaded
    */
   std::string getRandomTemplateHandlePerType(
-      const std::map<int, std::string>& mapOfHandles,
-      const std::string& type) const;
+      const TemplateHandleIndex& mapOfHandles,
+      const std::string& type,
+      const std::string& subStr = "",
+      bool contains = true) const;
 
   /**
    * @brief Get a list of all templates of passed type whose origin handles
    * contain @ref subStr, ignoring subStr's case
-   * @param mapOfHandles map containing the desired object-type template
+   * @param mapOfHandles index containing the desired object-type template
    * handles
    * @param subStr substring to search for within existing primitive object
    * templates
@@ -838,7 +891,7 @@ class AttributesManager {
    * the passed substring
    */
   std::vector<std::string> getTemplateHandlesBySubStringPerType(
-      const std::map<int, std::string>& mapOfHandles,
+      const TemplateHandleIndex& mapOfHandles,
       const std::string& subStr,
       bool contains) const;
 
@@ -877,9 +930,9 @@ class AttributesManager {
 
   /**
    * @brief Maps all object attribute IDs to the appropriate handles used
-   * by lib
+   * by lib, indexed for substring queries
    */
-  std::map<int, std::string> templateLibKeyByID_;
+  TemplateHandleIndex templateLibKeyByID_;
 
   /**
    * @brief Deque holding all IDs of deleted objects. These ID's should be
@@ -994,6 +1047,53 @@ AttribsPtr AttributesManager<AttribsPtr>::createObjectAttributesFromJson(
   return attributes;
 }  // AttributesManager<AttribsPtr>::createObjectAttributesFromJson
 
+template <class AttribsPtr>
+std::vector<AttribsPtr>
+AttributesManager<AttribsPtr>::createFileBasedAttributesTemplates(
+    const std::vector<std::string>& filenames,
+    bool registerTemplates,
+    int numThreads) {
+  std::vector<AttribsPtr> attributes(filenames.size(), nullptr);
+  if (numThreads <= 0) {
+    numThreads = std::max<int>(std::thread::hardware_concurrency(), 1);
+  }
+  numThreads = std::min<int>(numThreads, filenames.size());
+
+  // files are handed out one at a time, as their sizes vary
+  std::atomic<size_t> nextFile{0};
+  auto parseFiles = [&]() {
+    for (size_t i = nextFile++; i < filenames.size(); i = nextFile++) {
+      // the document references the buffer, so is destroyed first
+      io::JsonBuffer buffer;
+      io::JsonDocument jsonConfig;
+      if (!io::parseJsonFileInSitu(filenames[i], buffer, jsonConfig)) {
+        LOG(ERROR) << attrType_
+                   << "AttributesManager::createFileBasedAttributesTemplates "
+                      ": Failure reading json : "
+                   << filenames[i] << ". Skipping.";
+        continue;
+      }
+      attributes[i] = this->loadAttributesFromJSONDoc(filenames[i], jsonConfig);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int iThread = 1; iThread < numThreads; ++iThread) {
+    threads.emplace_back(parseFiles);
+  }
+  parseFiles();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // the library is only modified from this thread
+  for (AttribsPtr& attr : attributes) {
+    if (nullptr != attr) {
+      attr = this->postCreateRegister(attr, registerTemplates);
+    }
+  }
+  return attributes;
+}  // AttributesManager::createFileBasedAttributesTemplates
+
 template <class T>
 bool AttributesManager<T>::setJSONAssetHandleAndType(
     T attributes,
@@ -1112,7 +1212,7 @@ T AttributesManager<T>::removeTemplateInternal(
     return nullptr;
   }
   int templateID = attribsTemplate->getID();
-  templateLibKeyByID_.erase(templateID);
+  templateLibKeyByID_.remove(templateID);
   templateLibrary_.erase(templateHandle);
   availableTemplateIDs_.emplace_front(templateID);
   // call instance-specific update to remove template handle from any local
@@ -1123,65 +1223,26 @@ T AttributesManager<T>::removeTemplateInternal(
 
 template <class T>
 std::string AttributesManager<T>::getRandomTemplateHandlePerType(
-    const std::map<int, std::string>& mapOfHandles,
-    const std::string& type) const {
-  std::size_t numVals = mapOfHandles.size();
-  if (numVals == 0) {
+    const TemplateHandleIndex& mapOfHandles,
+    const std::string& type,
+    const std::string& subStr,
+    bool contains) const {
+  if (mapOfHandles.size() == 0) {
     LOG(ERROR) << "Attempting to get a random " << type << attrType_
                << " template handle but none are loaded; Aboring";
     return "";
   }
-  int randIDX = rand() % numVals;
-
-  std::string res;
-  for (std::pair<std::map<int, std::string>::const_iterator, int> iter(
-           mapOfHandles.begin(), 0);
-       (iter.first != mapOfHandles.end() && iter.second <= randIDX);
-       ++iter.first, ++iter.second) {
-    res = iter.first->second;
-  }
-  return res;
+  return mapOfHandles.getRandomHandle(subStr, contains);
 }  // AttributesManager::getRandomTemplateHandlePerType
 
 template <class T>
 std::vector<std::string>
 AttributesManager<T>::getTemplateHandlesBySubStringPerType(
-    const std::map<int, std::string>& mapOfHandles,
+    const TemplateHandleIndex& mapOfHandles,
     const std::string& subStr,
     bool contains) const {
-  std::vector<std::string> res;
-  // if empty return empty vector
-  if (mapOfHandles.size() == 0) {
-    return res;
-  }
-  // if search string is empty, return all values
-  if (subStr.length() == 0) {
-    for (auto elem : mapOfHandles) {
-      res.push_back(elem.second);
-    }
-    return res;
-  }
-  // build search criteria
-  std::string strToLookFor = Cr::Utility::String::lowercase(subStr);
-
-  std::size_t strSize = strToLookFor.length();
-
-  for (std::map<int, std::string>::const_iterator iter = mapOfHandles.begin();
-       iter != mapOfHandles.end(); ++iter) {
-    std::string key = Cr::Utility::String::lowercase(iter->second);
-    // be sure that key is big enough to search in (otherwise find has undefined
-    // behavior)
-    if (key.length() < strSize) {
-      continue;
-    }
-    bool found = (std::string::npos != key.find(strToLookFor));
-    if (found == contains) {
-      // if found and searching for contains, or not found and searching for not
-      // contains
-      res.push_back(iter->second);
-    }
-  }
-  return res;
+  // only the handles sharing the trigrams of subStr are searched
+  return mapOfHandles.getHandlesBySubstring(subStr, contains);
 }  // AttributesManager::getTemplateHandlesBySubStringPerType
 
 }  // namespace managers
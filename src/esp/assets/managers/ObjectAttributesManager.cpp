@@ -127,6 +127,12 @@ ObjectAttributes::ptr ObjectAttributesManager::loadAttributesFromJSONDoc(
       jsonConfig, "join collision meshes",
       std::bind(&ObjectAttributes::setJoinCollisionMeshes, objAttributes, _1));
 
+  // Simplify collision hulls to a vertex budget if specified
+  io::jsonIntoSetter<int>(
+      jsonConfig, "collision hull vertex budget",
+      std::bind(&ObjectAttributes::setCollisionHullVertexBudget, objAttributes,
+                _1));
+
   // The object's interia matrix diagonal
   io::jsonIntoConstSetter<Magnum::Vector3>(
       jsonConfig, "inertia",
@@ -203,7 +209,7 @@ int ObjectAttributesManager::registerAttributesTemplateFinalize(
     return ID_UNDEFINED;
   }
 
-  std::map<int, std::string>* mapToUse;
+  TemplateHandleIndex* mapToUse;
   // Handles for rendering and collision assets
   std::string renderAssetHandle = objectTemplate->getRenderAssetHandle();
   std::string collisionAssetHandle = objectTemplate->getCollisionAssetHandle();
@@ -266,7 +272,7 @@ int ObjectAttributesManager::registerAttributesTemplateFinalize(
   int objectTemplateID =
       this->addTemplateToLibrary(objectTemplate, objectTemplateHandle);
 
-  mapToUse->emplace(objectTemplateID, objectTemplateHandle);
+  mapToUse->add(objectTemplateID, objectTemplateHandle);
 
   return objectTemplateID;
 }  // ObjectAttributesManager::registerAttributesTemplateFinalize
@@ -275,12 +281,16 @@ std::vector<int> ObjectAttributesManager::loadAllFileBasedTemplates(
     const std::vector<std::string>& tmpltFilenames,
     bool saveAsDefaults) {
   std::vector<int> resIDs(tmpltFilenames.size(), ID_UNDEFINED);
+  LOG(INFO) << "Loading " << tmpltFilenames.size()
+            << " file-based object templates";
+  // parsed concurrently, registered in order
+  std::vector<ObjectAttributes::ptr> tmplts =
+      this->createFileBasedAttributesTemplates(tmpltFilenames, true);
   for (int i = 0; i < tmpltFilenames.size(); ++i) {
-    auto objPhysPropertiesFilename = tmpltFilenames[i];
-    LOG(INFO) << "Loading file-based object template: "
-              << objPhysPropertiesFilename;
-    auto tmplt =
-        createFileBasedAttributesTemplate(objPhysPropertiesFilename, true);
+    const ObjectAttributes::ptr& tmplt = tmplts[i];
+    if (nullptr == tmplt) {
+      continue;
+    }
 
     // save handles in list of defaults, so they are not removed, if desired.
     if (saveAsDefaults) {
@@ -135,7 +135,9 @@ class ObjectAttributesManager
    * template file locations.
    *
    * This will take the list of file names currently specified in
-   * physicsManagerAttributes and load the referenced object templates.
+   * physicsManagerAttributes and load the referenced object templates. The
+   * files are parsed concurrently, see @ref
+   * createFileBasedAttributesTemplates.
    * @param tmpltFilenames list of file names of object templates
    * @param saveAsDefaults Set these templates as un-deletable from library.
    * @return vector holding IDs of templates that have been added
@@ -286,8 +288,8 @@ class ObjectAttributesManager
   void updateTemplateHandleLists(
       int templateID,
       CORRADE_UNUSED const std::string& templateHandle) override {
-    physicsFileObjTmpltLibByID_.erase(templateID);
-    physicsSynthObjTmpltLibByID_.erase(templateID);
+    physicsFileObjTmpltLibByID_.remove(templateID);
+    physicsSynthObjTmpltLibByID_.remove(templateID);
   }
 
   /**
@@ -335,15 +337,15 @@ class ObjectAttributesManager
 
   /**
    * @brief Maps loaded object template IDs to the appropriate template
-   * handles
+   * handles, indexed for substring queries
    */
-  std::map<int, std::string> physicsFileObjTmpltLibByID_;
+  TemplateHandleIndex physicsFileObjTmpltLibByID_;
 
   /**
    * @brief Maps synthesized, primitive-based object template IDs to the
-   * appropriate template handles
+   * appropriate template handles, indexed for substring queries
    */
-  std::map<int, std::string> physicsSynthObjTmpltLibByID_;
+  TemplateHandleIndex physicsSynthObjTmpltLibByID_;
 
  public:
   ESP_SMART_POINTERS(ObjectAttributesManager)
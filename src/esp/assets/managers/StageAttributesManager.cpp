@@ -363,6 +363,7 @@ StageAttributes::ptr StageAttributesManager::loadAttributesFromJSONDoc(
   std::string navmeshFName = "";
   std::string houseFName = "";
   std::string lightSetup = "";
+  std::string bvhCacheFName = "";
 
   // populate semantic mesh type if present
   std::string semanticFName = stageAttributes->getSemanticAssetHandle();
@@ -392,6 +393,14 @@ StageAttributes::ptr StageAttributesManager::loadAttributesFromJSONDoc(
     stageAttributes->setHouseFilename(houseFName);
   }
 
+  if (io::jsonIntoVal<std::string>(jsonConfig, "collision bvh cache",
+                                   bvhCacheFName)) {
+    bvhCacheFName =
+        Cr::Utility::Directory::join(stageLocFileDir, bvhCacheFName);
+    // if "collision bvh cache" is specified in stage json, set value
+    stageAttributes->setCollisionBvhCacheFilename(bvhCacheFName);
+  }
+
   if (io::jsonIntoVal<std::string>(jsonConfig, "lighting setup", lightSetup)) {
     // if lighting is specified in stage json to non-empty value, set value
     // (override default).
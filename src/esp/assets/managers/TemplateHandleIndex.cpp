@@ -0,0 +1,211 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "TemplateHandleIndex.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+#include <Corrade/Utility/String.h>
+
+namespace Cr = Corrade;
+
+namespace esp {
+namespace assets {
+namespace managers {
+
+namespace {
+//! Queries kept before the cache is dropped, task samplers only use a few
+constexpr std::size_t MaxCachedQueries = 64;
+
+void insertSorted(std::vector<int>& ids, int id) {
+  ids.insert(std::lower_bound(ids.begin(), ids.end(), id), id);
+}
+
+void eraseSorted(std::vector<int>& ids, int id) {
+  auto it = std::lower_bound(ids.begin(), ids.end(), id);
+  if (it != ids.end() && *it == id) {
+    ids.erase(it);
+  }
+}
+}  // namespace
+
+std::vector<TemplateHandleIndex::Trigram> TemplateHandleIndex::trigrams(
+    const std::string& lowercase) {
+  std::vector<Trigram> result;
+  for (std::size_t i = 0; i + 3 <= lowercase.size(); ++i) {
+    result.push_back(Trigram(static_cast<unsigned char>(lowercase[i])) << 16 |
+                     Trigram(static_cast<unsigned char>(lowercase[i + 1]))
+                         << 8 |
+                     Trigram(static_cast<unsigned char>(lowercase[i + 2])));
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+void TemplateHandleIndex::add(int id, std::string handle) {
+  if (id < 0) {
+    return;
+  }
+  remove(id);
+  if (std::size_t(id) >= entries_.size()) {
+    entries_.resize(id + 1);
+  }
+  Entry& entry = entries_[id];
+  entry.lowercase = Cr::Utility::String::lowercase(handle);
+  entry.handle = std::move(handle);
+  entry.valid = true;
+  insertSorted(ids_, id);
+  for (Trigram trigram : trigrams(entry.lowercase)) {
+    insertSorted(trigramIDs_[trigram], id);
+  }
+  queryCache_.clear();
+}
+
+void TemplateHandleIndex::remove(int id) {
+  if (!has(id)) {
+    return;
+  }
+  Entry& entry = entries_[id];
+  for (Trigram trigram : trigrams(entry.lowercase)) {
+    auto found = trigramIDs_.find(trigram);
+    eraseSorted(found->second, id);
+    if (found->second.empty()) {
+      trigramIDs_.erase(found);
+    }
+  }
+  eraseSorted(ids_, id);
+  entry = Entry{};
+  queryCache_.clear();
+}
+
+void TemplateHandleIndex::clear() {
+  entries_.clear();
+  ids_.clear();
+  trigramIDs_.clear();
+  queryCache_.clear();
+}
+
+std::string TemplateHandleIndex::getHandle(int id) const {
+  return has(id) ? entries_[id].handle : std::string{};
+}
+
+std::vector<int> TemplateHandleIndex::queryLowercase(
+    const std::string& lowercase) const {
+  std::vector<int> result;
+  if (lowercase.size() < 3) {
+    // too short to have trigrams, check every handle
+    for (int id : ids_) {
+      if (entries_[id].lowercase.find(lowercase) != std::string::npos) {
+        result.push_back(id);
+      }
+    }
+    return result;
+  }
+
+  // handles containing the substring contain all of its trigrams
+  std::vector<const std::vector<int>*> lists;
+  for (Trigram trigram : trigrams(lowercase)) {
+    auto found = trigramIDs_.find(trigram);
+    if (found == trigramIDs_.end()) {
+      return result;
+    }
+    lists.push_back(&found->second);
+  }
+  std::sort(lists.begin(), lists.end(),
+            [](const std::vector<int>* a, const std::vector<int>* b) {
+              return a->size() < b->size();
+            });
+  for (int id : *lists[0]) {
+    bool inAll = true;
+    for (std::size_t i = 1; i < lists.size() && inAll; ++i) {
+      inAll = std::binary_search(lists[i]->begin(), lists[i]->end(), id);
+    }
+    // the trigrams may be in the wrong order, or apart
+    if (inAll &&
+        entries_[id].lowercase.find(lowercase) != std::string::npos) {
+      result.push_back(id);
+    }
+  }
+  return result;
+}  // TemplateHandleIndex::queryLowercase
+
+const std::vector<int>& TemplateHandleIndex::getIDsBySubstring(
+    const std::string& subStr) const {
+  if (subStr.empty()) {
+    return ids_;
+  }
+  std::string lowercase = Cr::Utility::String::lowercase(subStr);
+  auto found = queryCache_.find(lowercase);
+  if (found != queryCache_.end()) {
+    return found->second;
+  }
+  if (queryCache_.size() >= MaxCachedQueries) {
+    queryCache_.clear();
+  }
+  std::vector<int> result = queryLowercase(lowercase);
+  return queryCache_.emplace(std::move(lowercase), std::move(result))
+      .first->second;
+}
+
+std::vector<std::string> TemplateHandleIndex::getHandlesBySubstring(
+    const std::string& subStr,
+    bool contains) const {
+  std::vector<std::string> result;
+  const std::vector<int>& matches = getIDsBySubstring(subStr);
+  if (contains || subStr.empty()) {
+    result.reserve(matches.size());
+    for (int id : matches) {
+      result.push_back(entries_[id].handle);
+    }
+    return result;
+  }
+  // both are sorted
+  auto match = matches.begin();
+  for (int id : ids_) {
+    if (match != matches.end() && *match == id) {
+      ++match;
+    } else {
+      result.push_back(entries_[id].handle);
+    }
+  }
+  return result;
+}
+
+std::string TemplateHandleIndex::getRandomHandle(const std::string& subStr,
+                                                 bool contains) const {
+  const std::vector<int>& matches = getIDsBySubstring(subStr);
+  if (contains || subStr.empty()) {
+    return matches.empty() ? std::string{}
+                           : entries_[matches[rand() % matches.size()]].handle;
+  }
+
+  const std::size_t numNonMatches = ids_.size() - matches.size();
+  if (numNonMatches == 0) {
+    return {};
+  }
+  // find the first position in ids_ preceded by more than rank non-matching
+  // ids, the number of which grows with the position
+  const std::size_t rank = rand() % numNonMatches;
+  std::size_t begin = 0;
+  std::size_t end = ids_.size();
+  while (begin < end) {
+    const std::size_t middle = (begin + end) / 2;
+    const std::size_t numMatchesUpTo =
+        std::upper_bound(matches.begin(), matches.end(), ids_[middle]) -
+        matches.begin();
+    if (middle + 1 - numMatchesUpTo > rank) {
+      end = middle;
+    } else {
+      begin = middle + 1;
+    }
+  }
+  return entries_[ids_[begin]].handle;
+}  // TemplateHandleIndex::getRandomHandle
+
+}  // namespace managers
+}  // namespace assets
+}  // namespace esp
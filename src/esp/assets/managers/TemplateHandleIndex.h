@@ -0,0 +1,134 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_ASSETS_MANAGERS_TEMPLATEHANDLEINDEX_H_
+#define ESP_ASSETS_MANAGERS_TEMPLATEHANDLEINDEX_H_
+
+/** @file
+ * @brief Class @ref esp::assets::managers::TemplateHandleIndex
+ */
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace assets {
+namespace managers {
+
+/**
+ * @brief Template handles keyed by template ID, indexed for case-insensitive
+ * substring queries.
+ *
+ * IDs index a flat array holding each handle and its lowercase form, so
+ * looking a handle up by ID does no hashing. Handles are still copied in
+ * from, and out to, the template library rather than shared with it. The
+ * lowercase handles are indexed by their trigrams, the three character
+ * substrings, each mapped to the sorted IDs of the handles containing it. A
+ * query of at least three characters only checks the handles in the
+ * intersection of the lists of its trigrams. Query results are cached until
+ * the next change, so sampling a random handle from a filtered subset does no
+ * string operations when repeated.
+ */
+class TemplateHandleIndex {
+ public:
+  /**
+   * @brief Add a handle, replacing the one with the same ID if any.
+   * @param id The template ID, non-negative.
+   * @param handle The template handle, taken by value so that it may be the
+   * handle being replaced.
+   */
+  void add(int id, std::string handle);
+
+  /**
+   * @brief Remove the handle with an ID, if any.
+   */
+  void remove(int id);
+
+  /**
+   * @brief Remove all handles.
+   */
+  void clear();
+
+  /**
+   * @brief Get the number of handles.
+   */
+  int size() const { return ids_.size(); }
+
+  /**
+   * @brief Whether there is a handle with an ID.
+   */
+  bool has(int id) const {
+    return id >= 0 && std::size_t(id) < entries_.size() && entries_[id].valid;
+  }
+
+  /**
+   * @brief Get the handle with an ID, the empty string if none. Returned by
+   * value, as any change may move or clear the stored handles.
+   */
+  std::string getHandle(int id) const;
+
+  /**
+   * @brief Get the IDs of all handles, in increasing order.
+   */
+  const std::vector<int>& getIDs() const { return ids_; }
+
+  /**
+   * @brief Get the IDs of the handles containing a substring, ignoring case,
+   * in increasing order. All IDs for an empty substring.
+   */
+  const std::vector<int>& getIDsBySubstring(const std::string& subStr) const;
+
+  /**
+   * @brief Get the handles containing, or not containing, a substring,
+   * ignoring case, in increasing order of IDs. All handles for an empty
+   * substring.
+   */
+  std::vector<std::string> getHandlesBySubstring(const std::string& subStr,
+                                                 bool contains) const;
+
+  /**
+   * @brief Get a random handle among those containing, or not containing, a
+   * substring, ignoring case. Once the query is cached, this takes constant
+   * time when containing and logarithmic time when not containing.
+   * @return The handle, or the empty string if none matches.
+   */
+  std::string getRandomHandle(const std::string& subStr = "",
+                              bool contains = true) const;
+
+ private:
+  struct Entry {
+    std::string handle;
+    std::string lowercase;
+    bool valid = false;
+  };
+
+  typedef uint32_t Trigram;
+
+  //! The distinct trigrams of a lowercase string
+  static std::vector<Trigram> trigrams(const std::string& lowercase);
+
+  //! Query a lowercase substring, without the cache
+  std::vector<int> queryLowercase(const std::string& lowercase) const;
+
+  //! Handles by ID, with holes for IDs not in use
+  std::vector<Entry> entries_;
+  //! IDs in use, sorted
+  std::vector<int> ids_;
+  //! Sorted IDs of the handles containing each trigram
+  std::unordered_map<Trigram, std::vector<int>> trigramIDs_;
+
+  //! Results of recent queries, keyed by lowercase substring, cleared on
+  //! every change
+  mutable std::unordered_map<std::string, std::vector<int>> queryCache_;
+};
+
+}  // namespace managers
+}  // namespace assets
+}  // namespace esp
+
+#endif  // ESP_ASSETS_MANAGERS_TEMPLATEHANDLEINDEX_H_
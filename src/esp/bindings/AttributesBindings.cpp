@@ -177,6 +177,12 @@ void initAttributesBindings(py::module& m) {
           &ObjectAttributes::setJoinCollisionMeshes,
           R"(Whether collision meshes for objects constructed from this
           template should be joined into a convex hull or kept separate.)")
+      .def_property("collision_hull_vertex_budget",
+                    &ObjectAttributes::getCollisionHullVertexBudget,
+                    &ObjectAttributes::setCollisionHullVertexBudget,
+                    R"(The maximum number of vertices kept in each convex
+          collision hull of objects constructed from this template. 0 keeps
+          every vertex.)")
       .def_property(
           "is_visibile", &ObjectAttributes::getIsVisible,
           &ObjectAttributes::setIsVisible,
@@ -246,8 +252,9 @@ void initAttributesBindings(py::module& m) {
                     R"(The timestep to use for forward simulation.)")
       .def_property("max_substeps", &PhysicsManagerAttributes::getMaxSubsteps,
                     &PhysicsManagerAttributes::setMaxSubsteps,
-                    R"(Maximum simulation steps between each rendering step.
-                    (Not currently implemented).)")
+                    R"(Maximum number of timesteps a single physics step may
+                    simulate. Any remaining time is dropped and counted as an
+                    overrun. 0 for no limit.)")
       .def_property(
           "gravity", &PhysicsManagerAttributes::getGravity,
           &PhysicsManagerAttributes::setGravity,
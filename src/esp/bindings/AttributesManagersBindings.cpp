@@ -83,6 +83,12 @@ void declareBaseAttributesManager(py::module& m, std::string classStrPrefix) {
       .def("get_random_template_handle", &AttrClass::getRandomTemplateHandle,
            R"(Returns the handle for a random template chosen from the
              existing templates being managed.)")
+      .def("get_random_template_handle_by_substring",
+           &AttrClass::getRandomTemplateHandleBySubstring,
+           R"(Returns the handle for a random template chosen from the
+             existing templates whose handles either contain or explicitly do
+             not contain the passed search_str.)",
+           "search_str"_a, "contains"_a = true)
       .def(
           "get_undeletable_handles", &AttrClass::getUndeletableTemplateHandles,
           R"(Returns a list of template handles for templates that have been marked
@@ -42,6 +42,12 @@ void initPhysicsBindings(py::module& m) {
       .def_readonly("normal", &RayHitInfo::normal)
       .def_readonly("ray_distance", &RayHitInfo::rayDistance);
 
+  // ==== struct object PhysicsWorldSnapshot ====
+  py::class_<PhysicsWorldSnapshot, PhysicsWorldSnapshot::ptr>(
+      m, "PhysicsWorldSnapshot")
+      .def(py::init(&PhysicsWorldSnapshot::create<>))
+      .def_readonly("world_time", &PhysicsWorldSnapshot::worldTime);
+
   // ==== struct object RaycastResults ====
   py::class_<RaycastResults, RaycastResults::ptr>(m, "RaycastResults")
       .def(py::init(&RaycastResults::create<>))
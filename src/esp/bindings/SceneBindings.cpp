@@ -5,10 +5,12 @@
 #include "esp/bindings/bindings.h"
 
 #include <Magnum/Magnum.h>
+#include <Magnum/Math/Frustum.h>
 #include <Magnum/SceneGraph/SceneGraph.h>
 
 #include <Magnum/PythonBindings.h>
 #include <Magnum/SceneGraph/PythonBindings.h>
+#include <pybind11/numpy.h>
 
 #include "esp/scene/Mp3dSemanticScene.h"
 #include "esp/scene/ObjectControls.h"
@@ -25,6 +27,21 @@ using py::literals::operator""_a;
 namespace esp {
 namespace scene {
 
+namespace {
+// the elements of a spatial query result
+template <class T>
+std::vector<std::shared_ptr<T>> gather(
+    const std::vector<std::shared_ptr<T>>& elements,
+    const std::vector<int>& indices) {
+  std::vector<std::shared_ptr<T>> gathered;
+  gathered.reserve(indices.size());
+  for (int index : indices) {
+    gathered.push_back(elements[index]);
+  }
+  return gathered;
+}
+}  // namespace
+
 void initSceneBindings(py::module& m) {
   // ==== SceneConfiguration ====
   py::class_<SceneConfiguration, SceneConfiguration::ptr>(m,
@@ -63,12 +80,14 @@ void initSceneBindings(py::module& m) {
 
   // ==== SceneNode ====
   py::class_<SceneNode, Magnum::SceneGraph::PyObject<SceneNode>, MagnumObject,
-             Magnum::SceneGraph::PyObjectHolder<SceneNode>>(m, "SceneNode", R"(
+             Magnum::SceneGraph::PyObjectHolder<SceneNode>>
+      sceneNode(m, "SceneNode", R"(
       SceneNode: a node in the scene graph.
 
       Cannot apply a smart pointer to a SceneNode object.
       You can "create it and forget it".
-      Simulator backend will handle the memory.)")
+      Simulator backend will handle the memory.)");
+  sceneNode
       .def(py::init_alias<std::reference_wrapper<SceneNode>>(),
            R"(Constructor: creates a scene node, and sets its parent.)")
       .def_property("type", &SceneNode::getType, &SceneNode::setType)
@@ -89,6 +108,21 @@ void initSceneBindings(py::module& m) {
       .def_property_readonly("absolute_translation",
                              &SceneNode::absoluteTranslation);
 
+  // Magnum only tells a node it was reparented if its transformation was
+  // clean, so the parent setter of the Magnum bindings, which also manages
+  // the Python reference, is followed by an explicit update
+  py::object magnumParent = sceneNode.attr("parent");
+  sceneNode.def_property(
+      "parent",
+      [magnumParent](py::object self) {
+        return magnumParent.attr("__get__")(self);
+      },
+      [magnumParent](py::object self, py::object parent) {
+        magnumParent.attr("__set__")(self, parent);
+        self.cast<SceneNode&>().updateParent();
+      },
+      R"(Parent object or scene)");
+
   py::class_<SceneGraph>(m, "SceneGraph")
       .def(py::init())
       .def("get_root_node",
@@ -232,17 +266,19 @@ void initSceneBindings(py::module& m) {
       .def_static(
           "load_mp3d_house",
           [](const std::string& filename, SemanticScene& scene,
-             const vec4f& rotation) {
+             const vec4f& rotation, bool useCache) {
             // numpy doesn't have a quaternion equivalent, use vec4
             // instead
             return SemanticScene::loadMp3dHouse(
-                filename, scene, Eigen::Map<const quatf>(rotation.data()));
+                filename, scene, Eigen::Map<const quatf>(rotation.data()),
+                useCache);
           },
           R"(
         Loads a SemanticScene from a Matterport3D House format file into passed
-        `SemanticScene`.
+        `SemanticScene`. With `use_cache`, a binary cache of the file is kept
+        next to it and loaded instead while the file is unchanged.
       )",
-          "file"_a, "scene"_a, "rotation"_a)
+          "file"_a, "scene"_a, "rotation"_a, "use_cache"_a = false)
       .def_property_readonly("aabb", &SemanticScene::aabb)
       .def_property_readonly("categories", &SemanticScene::categories,
                              "All semantic categories in the house")
@@ -255,7 +291,81 @@ void initSceneBindings(py::module& m) {
       .def_property_readonly("semantic_index_map",
                              &SemanticScene::getSemanticIndexMap)
       .def("semantic_index_to_object_index",
-           &SemanticScene::semanticIndexToObjectIndex);
+           &SemanticScene::semanticIndexToObjectIndex)
+      .def_property_readonly(
+          "object_to_category_index", &SemanticScene::getObjectToCategoryIndex,
+          R"(Category index of each object under the default mapping, -1 if none.)")
+      .def(
+          "semantic_indices_to_object_indices",
+          [](const SemanticScene& self, const py::array_t<uint32_t,
+                                                          py::array::c_style |
+                                                              py::array::forcecast>&
+                                              maskIndices) {
+            py::array_t<int32_t> objectIndices{maskIndices.request().shape};
+            self.semanticIndicesToObjectIndices(
+                {maskIndices.data(), std::size_t(maskIndices.size())},
+                {objectIndices.mutable_data(),
+                 std::size_t(objectIndices.size())});
+            return objectIndices;
+          },
+          R"(Convert an array of semantic mesh mask indices, such as a semantic observation, to object indices, -1 where not mapped.)",
+          "mask_indices"_a)
+      .def(
+          "object_indices_to_category_indices",
+          [](const SemanticScene& self, const py::array_t<int32_t,
+                                                          py::array::c_style |
+                                                              py::array::forcecast>&
+                                              objectIndices) {
+            py::array_t<int32_t> categoryIndices{
+                objectIndices.request().shape};
+            self.objectIndicesToCategoryIndices(
+                {objectIndices.data(), std::size_t(objectIndices.size())},
+                {categoryIndices.mutable_data(),
+                 std::size_t(categoryIndices.size())});
+            return categoryIndices;
+          },
+          R"(Convert an array of object indices to category indices under the default mapping, -1 where there is none.)",
+          "object_indices"_a)
+      .def(
+          "regions_containing",
+          [](const SemanticScene& self, const vec3f& point) {
+            return gather(self.regions(),
+                          self.spatialIndex().regionsContaining(point));
+          },
+          R"(Regions whose bounding box contains the point.)", "point"_a)
+      .def(
+          "objects_containing",
+          [](const SemanticScene& self, const vec3f& point) {
+            return gather(self.objects(),
+                          self.spatialIndex().objectsContaining(point));
+          },
+          R"(Objects whose oriented bounding box contains the point.)",
+          "point"_a)
+      .def(
+          "objects_within_radius",
+          [](const SemanticScene& self, const vec3f& point, float radius) {
+            return gather(self.objects(), self.spatialIndex().objectsWithinRadius(
+                                              point, radius));
+          },
+          R"(Objects whose oriented bounding box is at most radius away from the point.)",
+          "point"_a, "radius"_a)
+      .def(
+          "nearest_objects",
+          [](const SemanticScene& self, const vec3f& point, int k) {
+            return gather(self.objects(),
+                          self.spatialIndex().nearestObjects(point, k));
+          },
+          R"(The k objects whose oriented bounding box is closest to the point, closest first.)",
+          "point"_a, "k"_a)
+      .def(
+          "objects_in_frustum",
+          [](const SemanticScene& self, const Magnum::Matrix4& projectionView) {
+            return gather(self.objects(),
+                          self.spatialIndex().objectsInFrustum(
+                              Magnum::Frustum::fromMatrix(projectionView)));
+          },
+          R"(Objects whose oriented bounding box intersects the frustum of a projection times camera matrix.)",
+          "projection_view"_a);
 
   // ==== ObjectControls ====
   py::class_<ObjectControls, ObjectControls::ptr>(m, "ObjectControls")
@@ -9,7 +9,11 @@
 
 #include <Magnum/PythonBindings.h>
 #include <Magnum/SceneGraph/PythonBindings.h>
+#include <pybind11/numpy.h>
 
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "esp/scene/SemanticScene.h"
 #include "esp/sensor/PinholeCamera.h"
 #ifdef ESP_BUILD_WITH_CUDA
 #include "esp/sensor/RedwoodNoiseModel.h"
@@ -29,6 +33,37 @@ esp::scene::SceneNode* nodeGetter(T& self) {
     throw py::value_error{"feature not valid"};
   return &self.node();
 };
+
+// a view on a 2D numpy array without copying it, also when flipped
+Corrade::Containers::StridedArrayView2D<const uint32_t> idsView(
+    const py::array_t<uint32_t>& ids) {
+  if (ids.ndim() != 2)
+    throw py::value_error{"expected a 2D array of ids"};
+  const auto* data = static_cast<const char*>(ids.data());
+  const std::size_t size[]{std::size_t(ids.shape(0)),
+                           std::size_t(ids.shape(1))};
+  if (!size[0] || !size[1])
+    return {};
+  std::ptrdiff_t stride[]{ids.strides(0), ids.strides(1)};
+  std::size_t span = sizeof(uint32_t);
+  for (int i : {0, 1}) {
+    if (stride[i] < 0) {
+      stride[i] = -stride[i];
+      data -= (size[i] - 1) * stride[i];
+    }
+    span += (size[i] - 1) * stride[i];
+  }
+  Corrade::Containers::StridedArrayView2D<const uint32_t> view{
+      {data, span},
+      reinterpret_cast<const uint32_t*>(data),
+      {size[0], size[1]},
+      {stride[0], stride[1]}};
+  if (ids.strides(0) < 0)
+    view = view.flipped<0>();
+  if (ids.strides(1) < 0)
+    view = view.flipped<1>();
+  return view;
+}
 }  // namespace
 
 namespace esp {
@@ -107,7 +142,58 @@ void initSensorBindings(py::module& m) {
       m, "PinholeCamera")
       // initialized, attached to pinholeCameraNode, status: "valid"
       .def(py::init_alias<std::reference_wrapper<scene::SceneNode>,
-                          const SensorSpec::ptr&>());
+                          const SensorSpec::ptr&>())
+      .def_property(
+          "semantic_processor", &PinholeCamera::getSemanticProcessor,
+          &PinholeCamera::setSemanticProcessor,
+          R"(Processor run on each observation of a semantic sensor, or None.)");
+
+  // ==== SemanticProcessor ====
+  py::class_<SemanticProcessor, SemanticProcessor::ptr>(m, "SemanticProcessor")
+      .def(py::init(&SemanticProcessor::create<std::vector<int>, int>),
+           "id_to_class"_a, "num_threads"_a = 1)
+      .def_static("build_id_to_class_table",
+                  &SemanticProcessor::buildIdToClassTable, "semantic_scene"_a,
+                  "mapping"_a = "",
+                  R"(The class index of each object id of a semantic scene.)")
+      .def(
+          "process",
+          [](SemanticProcessor& self, const py::array_t<uint32_t>& ids) {
+            self.process(idsView(ids));
+          },
+          "ids"_a,
+          R"(Remap an image of object ids to classes, count the pixels of each class and bound each instance.)")
+      .def_property_readonly("num_classes", &SemanticProcessor::getNumClasses)
+      .def_property_readonly("num_threads", &SemanticProcessor::getNumThreads)
+      .def_property_readonly("id_to_class", &SemanticProcessor::getIdToClass)
+      .def_property_readonly(
+          "class_image",
+          [](const SemanticProcessor& self) {
+            const Magnum::Vector2i size = self.getImageSize();
+            return py::array_t<int>({size.y(), size.x()},
+                                    self.getClassImage().data());
+          },
+          R"(Class index of each pixel of the last image, -1 if none.)")
+      .def_property_readonly(
+          "class_pixel_counts",
+          [](const SemanticProcessor& self) {
+            const std::vector<int>& counts = self.getClassPixelCounts();
+            return py::array_t<int>(counts.size(), counts.data());
+          })
+      .def_property_readonly(
+          "instances",
+          [](const SemanticProcessor& self) {
+            py::list instances;
+            for (const SemanticProcessor::Instance& instance :
+                 self.getInstances()) {
+              instances.append(py::dict(
+                  "id"_a = instance.id, "class_index"_a = instance.classIndex,
+                  "min"_a = instance.min, "max"_a = instance.max,
+                  "pixel_count"_a = instance.pixelCount));
+            }
+            return instances;
+          },
+          R"(Objects in the last image, as dicts of id, class_index, inclusive min and max (column, row) corners and pixel_count.)");
 
   // ==== SensorSuite ====
   py::class_<SensorSuite, SensorSuite::ptr>(m, "SensorSuite")
@@ -23,6 +23,27 @@ namespace esp {
 namespace sim {
 
 void initSimBindings(py::module& m) {
+  // ==== AssetCache ====
+  py::class_<assets::AssetCache,
+             std::unique_ptr<assets::AssetCache, py::nodelete>>(
+      m, "AssetCache",
+      R"(Process-wide cache of decoded scene and object assets, shared by all
+      simulators. Use AssetCache.instance() to access it.)")
+      .def_static("instance", &assets::AssetCache::instance,
+                  R"(PYTHON DOES NOT GET OWNERSHIP)",
+                  py::return_value_policy::reference)
+      .def_property(
+          "memory_budget", &assets::AssetCache::getMemoryBudget,
+          &assets::AssetCache::setMemoryBudget,
+          R"(Maximum number of bytes of decoded image and mesh data kept. Least
+          recently used assets are evicted first. 0, the default, disables
+          caching.)")
+      .def_property_readonly("memory_usage",
+                             &assets::AssetCache::getMemoryUsage)
+      .def_property_readonly("num_cached_assets",
+                             &assets::AssetCache::getNumCachedAssets)
+      .def("clear", &assets::AssetCache::clear);
+
   // ==== SimulatorConfiguration ====
   py::class_<SimulatorConfiguration, SimulatorConfiguration::ptr>(
       m, "SimulatorConfiguration")
@@ -36,6 +57,26 @@ void initSimBindings(py::module& m) {
       .def_readwrite("gpu_device_id", &SimulatorConfiguration::gpuDeviceId)
       .def_readwrite("compress_textures",
                      &SimulatorConfiguration::compressTextures)
+      .def("loads_same_stage", &loadsSameStage, "other"_a,
+           R"(Whether the other configuration loads the same stage, so that
+           reconfiguring between the two keeps the loaded scene, physics world,
+           navmesh and semantic scene.)")
+      .def_readwrite("asset_import_threads",
+                     &SimulatorConfiguration::assetImportThreads)
+      .def_readwrite("use_baked_assets",
+                     &SimulatorConfiguration::useBakedAssets)
+      .def_readwrite("optimize_meshes",
+                     &SimulatorConfiguration::optimizeMeshes)
+      .def_readwrite("lod_pixel_error",
+                     &SimulatorConfiguration::lodPixelError)
+      .def_readwrite("max_mesh_chunk_triangles",
+                     &SimulatorConfiguration::maxMeshChunkTriangles)
+      .def_readwrite("texture_memory_budget",
+                     &SimulatorConfiguration::textureMemoryBudget)
+      .def_readwrite("conservative_absolute_aabbs",
+                     &SimulatorConfiguration::conservativeAbsoluteAABBs)
+      .def_readwrite("cache_semantic_scenes",
+                     &SimulatorConfiguration::cacheSemanticScenes)
       .def_readwrite("allow_sliding", &SimulatorConfiguration::allowSliding)
       .def_readwrite("create_renderer", &SimulatorConfiguration::createRenderer)
       .def_readwrite("frustum_culling", &SimulatorConfiguration::frustumCulling)
@@ -59,6 +100,10 @@ void initSimBindings(py::module& m) {
            &Simulator::getActiveSemanticSceneGraph,
            R"(PYTHON DOES NOT GET OWNERSHIP)",
            py::return_value_policy::reference)
+      .def("begin_frame", &Simulator::beginFrame, R"(
+        Prepare the active scene graphs for drawing a frame. Call once before
+        drawing them directly.
+        )")
       .def_property_readonly("semantic_scene", &Simulator::getSemanticScene, R"(
         The semantic scene graph
 
@@ -122,6 +167,23 @@ void initSimBindings(py::module& m) {
       /* --- Kinematics and dynamics --- */
       .def("step_world", &Simulator::stepWorld, "dt"_a = 1.0 / 60.0)
       .def("get_world_time", &Simulator::getWorldTime)
+      .def("start_async_physics", &Simulator::startAsyncPhysics,
+           "real_time_factor"_a = 1.0, "scene_id"_a = 0,
+           R"(Step physics from a worker thread at a fixed wall-clock rate
+           until stop_async_physics. step_world does not step meanwhile.)")
+      .def("stop_async_physics", &Simulator::stopAsyncPhysics)
+      .def("is_async_physics_running", &Simulator::isAsyncPhysicsRunning)
+      .def("get_num_physics_substep_overruns",
+           &Simulator::getNumPhysicsSubstepOverruns, "scene_id"_a = 0)
+      .def("save_physics_snapshot",
+           py::overload_cast<const int>(&Simulator::savePhysicsSnapshot),
+           "scene_id"_a = 0)
+      .def("save_physics_snapshot",
+           py::overload_cast<physics::PhysicsWorldSnapshot&, const int>(
+               &Simulator::savePhysicsSnapshot),
+           "snapshot"_a, "scene_id"_a = 0)
+      .def("restore_physics_snapshot", &Simulator::restorePhysicsSnapshot,
+           "snapshot"_a, "scene_id"_a = 0)
       .def("get_gravity", &Simulator::getGravity, "scene_id"_a = 0)
       .def("set_gravity", &Simulator::setGravity, "gravity"_a, "scene_id"_a = 0)
       .def("get_object_scene_node", &Simulator::getObjectSceneNode,
@@ -0,0 +1,130 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "Configuration.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+namespace esp {
+namespace core {
+
+ConfigurationSchema::ConfigurationSchema(const ConfigurationSchema* base,
+                                         const ConfigurationKey* keys,
+                                         std::size_t count) {
+  if (base != nullptr) {
+    keys_ = base->keys_;
+    slotsByName_ = base->slotsByName_;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    slotsByName_.emplace(keys[i].name, static_cast<int>(keys_.size()));
+    keys_.push_back(keys[i]);
+  }
+}
+
+int ConfigurationSchema::getSlot(const std::string& name) const {
+  if (slotsByName_.empty()) {
+    return ID_UNDEFINED;
+  }
+  auto found = slotsByName_.find(name);
+  return found == slotsByName_.end() ? ID_UNDEFINED : found->second;
+}
+
+const ConfigurationSchema& ConfigurationSchema::empty() {
+  static const ConfigurationSchema schema{};
+  return schema;
+}
+
+Configuration::Configuration(const ConfigurationSchema& schema)
+    : schema_{&schema}, values_{std::make_shared<Values>()} {
+  values_->slots.resize(schema.size());
+}
+
+bool Configuration::hasValue(const std::string& key) const {
+  const int slot = schema_->getSlot(key);
+  if (slot == ID_UNDEFINED) {
+    return values_->cfg.hasValue(key);
+  }
+  return values_->slots[slot].isSet;
+}
+
+bool Configuration::removeValue(const std::string& key) {
+  if (!hasValue(key)) {
+    return false;
+  }
+  const int slot = schema_->getSlot(key);
+  if (slot == ID_UNDEFINED) {
+    return writableValues().cfg.removeValue(key);
+  }
+  writableValues().slots[slot] = Slot{};
+  return true;
+}
+
+Configuration::Values& Configuration::writableValues() {
+  if (values_.use_count() > 1) {
+    values_ = std::make_shared<Values>(*values_);
+  }
+  return *values_;
+}
+
+std::string Configuration::slotToString(int slot) const {
+  const Slot& value = values_->slots[slot];
+  if (!value.isSet) {
+    return {};
+  }
+  switch (schema_->getKey(slot).type) {
+    case ConfigurationValueType::Bool:
+      return Cr::Utility::ConfigurationValue<bool>::toString(
+          value.number != 0.0, {});
+    case ConfigurationValueType::Int:
+      return Cr::Utility::ConfigurationValue<int>::toString(
+          static_cast<int>(value.number), {});
+    case ConfigurationValueType::Double:
+      return Cr::Utility::ConfigurationValue<double>::toString(value.number,
+                                                               {});
+    case ConfigurationValueType::Vec3:
+      return Cr::Utility::ConfigurationValue<Mn::Vector3>::toString(value.vec3,
+                                                                    {});
+    case ConfigurationValueType::String:
+      return value.string;
+  }
+  return {};
+}
+
+void Configuration::setSlotFromString(int slot, const std::string& value) {
+  switch (schema_->getKey(slot).type) {
+    case ConfigurationValueType::Bool:
+      setSlot(slot,
+              Cr::Utility::ConfigurationValue<bool>::fromString(value, {}));
+      break;
+    case ConfigurationValueType::Int:
+      setSlot(slot,
+              Cr::Utility::ConfigurationValue<int>::fromString(value, {}));
+      break;
+    case ConfigurationValueType::Double:
+      setSlot(slot,
+              Cr::Utility::ConfigurationValue<double>::fromString(value, {}));
+      break;
+    case ConfigurationValueType::Vec3:
+      setSlot(slot, Cr::Utility::ConfigurationValue<Mn::Vector3>::fromString(
+                        value, {}));
+      break;
+    case ConfigurationValueType::String:
+      setSlot(slot, value);
+      break;
+  }
+}
+
+Cr::Utility::ConfigurationGroup Configuration::getConfigurationGroup() const {
+  Cr::Utility::ConfigurationGroup group = values_->cfg;
+  for (int slot = 0; slot < schema_->size(); ++slot) {
+    if (values_->slots[slot].isSet) {
+      group.setValue(schema_->getKey(slot).name, slotToString(slot));
+    }
+  }
+  return group;
+}
+
+}  // namespace core
+}  // namespace esp
@@ -4,25 +4,115 @@
 
 #pragma once
 
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Magnum/Magnum.h>
 #include <Magnum/Math/ConfigurationValue.h>
+#include <Magnum/Math/Vector3.h>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "esp/core/esp.h"
 
 namespace esp {
 namespace core {
 
+//! Type of the value of a key stored in a fixed slot
+enum class ConfigurationValueType : uint8_t { Bool, Int, Double, Vec3, String };
+
+//! Name and type of a key stored in a fixed slot
+struct ConfigurationKey {
+  const char* name;
+  ConfigurationValueType type;
+};
+
+/**
+ * @brief The keys a class of configurations stores in fixed slots, in order,
+ * following those of the schema of its base class.
+ *
+ * Classes declare their keys in a constexpr table and their slots as
+ * enumerators continuing the slots of their base class, so code knowing a key
+ * at compile time accesses its value by offset, without hashing its name.
+ */
+class ConfigurationSchema {
+ public:
+  //! A schema without keys
+  ConfigurationSchema() = default;
+
+  template <std::size_t N>
+  explicit ConfigurationSchema(const ConfigurationKey (&keys)[N])
+      : ConfigurationSchema{nullptr, keys, N} {}
+
+  template <std::size_t N>
+  ConfigurationSchema(const ConfigurationSchema& base,
+                      const ConfigurationKey (&keys)[N])
+      : ConfigurationSchema{&base, keys, N} {}
+
+  //! The number of slots
+  int size() const { return keys_.size(); }
+
+  const ConfigurationKey& getKey(int slot) const { return keys_[slot]; }
+
+  //! The slot of a key, or ID_UNDEFINED if it is not in the schema
+  int getSlot(const std::string& name) const;
+
+  //! The schema without keys of plain configurations
+  static const ConfigurationSchema& empty();
+
+ private:
+  ConfigurationSchema(const ConfigurationSchema* base,
+                      const ConfigurationKey* keys,
+                      std::size_t count);
+
+  std::vector<ConfigurationKey> keys_;
+  std::unordered_map<std::string, int> slotsByName_;
+};
+
+/**
+ * @brief Key-value store shared by copies until one of them is modified.
+ *
+ * The keys of the @ref ConfigurationSchema of the configuration are stored in
+ * typed slots, read and written by derived classes by slot without looking
+ * the key up, other keys are stored in a string-keyed group. Accessing a key
+ * of the schema by name converts its value through its string representation,
+ * as the group does.
+ *
+ * Copying a configuration only shares its values, the first modification of a
+ * shared configuration copies them. Copies of a template used to instantiate
+ * objects thus cost a single reference count until they are edited. Sharing
+ * is not synchronized, copies used from different threads must not be
+ * modified concurrently with being copied.
+ */
 class Configuration {
  public:
+  Configuration() : Configuration{ConfigurationSchema::empty()} {}
+
+  /**
+   * @brief Constructor.
+   * @param schema The keys stored in slots, must outlive the configuration
+   * and its copies.
+   */
+  explicit Configuration(const ConfigurationSchema& schema);
+
   // virtual destructor set to that pybind11 recognizes attributes inheritance
   // from configuration to be polymorphic
   virtual ~Configuration() = default;
 
   template <typename T>
   bool set(const std::string& key, const T& value) {
-    return cfg.setValue(key, value);
+    const int slot = schema_->getSlot(key);
+    if (slot == ID_UNDEFINED) {
+      return writableValues().cfg.setValue(key, value);
+    }
+    setSlotFromString(
+        slot, Corrade::Utility::ConfigurationValue<T>::toString(value, {}));
+    return true;
+  }
+  bool set(const std::string& key, const char* value) {
+    return set(key, std::string{value});
   }
   bool setBool(const std::string& key, bool value) { return set(key, value); }
   bool setFloat(const std::string& key, float value) { return set(key, value); }
@@ -39,7 +129,12 @@ class Configuration {
 
   template <typename T>
   T get(const std::string& key) const {
-    return cfg.value<T>(key);
+    const int slot = schema_->getSlot(key);
+    if (slot == ID_UNDEFINED) {
+      return values_->cfg.value<T>(key);
+    }
+    return Corrade::Utility::ConfigurationValue<T>::fromString(
+        slotToString(slot), {});
   }
   bool getBool(const std::string& key) const { return get<bool>(key); }
   float getFloat(const std::string& key) const { return get<float>(key); }
@@ -52,8 +147,10 @@ class Configuration {
     return get<Magnum::Vector3>(key);
   }
 
-  /**@brief Add a string to a group and return the resulting group size. */
+  /**@brief Add a string to a group and return the resulting group size. Keys
+   * of the schema cannot hold groups. */
   int addStringToGroup(const std::string& key, const std::string& value) {
+    Corrade::Utility::ConfigurationGroup& cfg = writableValues().cfg;
     cfg.addValue(key, value);
     return cfg.valueCount(key);
   }
@@ -61,22 +158,131 @@ class Configuration {
   /**@brief Collect and return strings in a key group. */
   std::vector<std::string> getStringGroup(const std::string& key) const {
     std::vector<std::string> strings;
-    for (size_t v = 0; v < cfg.valueCount(key); ++v) {
-      strings.push_back(cfg.value<std::string>(key, v));
+    for (size_t v = 0; v < values_->cfg.valueCount(key); ++v) {
+      strings.push_back(values_->cfg.value<std::string>(key, v));
     }
     return strings;
   }
 
-  bool hasValue(const std::string& key) const { return cfg.hasValue(key); }
+  bool hasValue(const std::string& key) const;
 
-  bool removeValue(const std::string& key) { return cfg.removeValue(key); }
+  bool removeValue(const std::string& key);
+
+  /**
+   * @brief Whether this configuration shares its values with another, as
+   * copies do until either is modified.
+   */
+  bool sharesValuesWith(const Configuration& other) const {
+    return values_ == other.values_;
+  }
 
  protected:
-  Corrade::Utility::ConfigurationGroup cfg;
+  /**
+   * @brief Get the value of a slot of the schema, the default value if unset.
+   * @tparam T The type of the key, bool, int, double, Magnum::Vector3 or
+   * std::string.
+   */
+  template <typename T>
+  T getSlot(int slot) const;
+
+  /**
+   * @brief Set the value of a slot of the schema.
+   * @tparam T The type of the key, bool, int, double, Magnum::Vector3 or
+   * std::string.
+   */
+  template <typename T>
+  void setSlot(int slot, const T& value);
+
+  //! All values in a group, those in slots included
+  Corrade::Utility::ConfigurationGroup getConfigurationGroup() const;
+
+ private:
+  struct Slot {
+    //! Value of booleans, integers and doubles
+    double number = 0.0;
+    Magnum::Vector3 vec3;
+    std::string string;
+    bool isSet = false;
+  };
+
+  struct Values {
+    std::vector<Slot> slots;
+    //! Keys not in the schema
+    Corrade::Utility::ConfigurationGroup cfg;
+  };
+
+  const Slot& readSlot(int slot, ConfigurationValueType type) const {
+    CORRADE_INTERNAL_ASSERT(schema_->getKey(slot).type == type);
+    return values_->slots[slot];
+  }
+
+  Slot& writeSlot(int slot, ConfigurationValueType type) {
+    CORRADE_INTERNAL_ASSERT(schema_->getKey(slot).type == type);
+    Slot& result = writableValues().slots[slot];
+    result.isSet = true;
+    return result;
+  }
+
+  //! The values, copied first if shared
+  Values& writableValues();
+
+  //! Empty for an unset slot, as for a missing key in a group
+  std::string slotToString(int slot) const;
+
+  void setSlotFromString(int slot, const std::string& value);
+
+  const ConfigurationSchema* schema_;
+  std::shared_ptr<Values> values_;
 
   ESP_SMART_POINTERS(Configuration)
 };
 
+template <>
+inline bool Configuration::getSlot<bool>(int slot) const {
+  return readSlot(slot, ConfigurationValueType::Bool).number != 0.0;
+}
+template <>
+inline int Configuration::getSlot<int>(int slot) const {
+  return static_cast<int>(readSlot(slot, ConfigurationValueType::Int).number);
+}
+template <>
+inline double Configuration::getSlot<double>(int slot) const {
+  return readSlot(slot, ConfigurationValueType::Double).number;
+}
+template <>
+inline Magnum::Vector3 Configuration::getSlot<Magnum::Vector3>(
+    int slot) const {
+  return readSlot(slot, ConfigurationValueType::Vec3).vec3;
+}
+template <>
+inline std::string Configuration::getSlot<std::string>(int slot) const {
+  return readSlot(slot, ConfigurationValueType::String).string;
+}
+
+template <>
+inline void Configuration::setSlot<bool>(int slot, const bool& value) {
+  writeSlot(slot, ConfigurationValueType::Bool).number = value;
+}
+template <>
+inline void Configuration::setSlot<int>(int slot, const int& value) {
+  writeSlot(slot, ConfigurationValueType::Int).number = value;
+}
+template <>
+inline void Configuration::setSlot<double>(int slot, const double& value) {
+  writeSlot(slot, ConfigurationValueType::Double).number = value;
+}
+template <>
+inline void Configuration::setSlot<Magnum::Vector3>(
+    int slot,
+    const Magnum::Vector3& value) {
+  writeSlot(slot, ConfigurationValueType::Vec3).vec3 = value;
+}
+template <>
+inline void Configuration::setSlot<std::string>(int slot,
+                                                const std::string& value) {
+  writeSlot(slot, ConfigurationValueType::String).string = value;
+}
+
 // Below uses std::variant; not yet available in clang c++17
 /*
 #include <std/variant>
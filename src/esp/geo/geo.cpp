@@ -4,7 +4,9 @@
 
 #include "esp/geo/geo.h"
 
+#include <Magnum/Math/Constants.h>
 #include <Magnum/Math/FunctionsBatch.h>
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
@@ -118,5 +120,47 @@ Mn::Range3D getTransformedBB(const Mn::Range3D& range,
   return Mn::Range3D::fromCenter(newCenter, newExtent);
 }
 
+Mn::Range3D getTransformedPointsBB(
+    const Corrade::Containers::StridedArrayView1D<const Mn::Vector3>& points,
+    const Mn::Matrix4& xform) {
+  if (points.empty()) {
+    return {};
+  }
+
+  // structure-of-arrays blocks, small enough to stay in L1
+  constexpr std::size_t BlockSize = 256;
+  float x[BlockSize], y[BlockSize], z[BlockSize];
+
+  Mn::Vector3 min{Mn::Constants::inf()};
+  Mn::Vector3 max{-Mn::Constants::inf()};
+  for (std::size_t start = 0; start < points.size(); start += BlockSize) {
+    const std::size_t count = std::min(BlockSize, points.size() - start);
+    for (std::size_t i = 0; i < count; ++i) {
+      const Mn::Vector3& point = points[start + i];
+      x[i] = point.x();
+      y[i] = point.y();
+      z[i] = point.z();
+    }
+    // one row of the transform at a time, so each loop is a plain
+    // multiply-add followed by a min/max reduction
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      const float a = xform[0][axis];
+      const float b = xform[1][axis];
+      const float c = xform[2][axis];
+      const float t = xform[3][axis];
+      float lo = min[axis];
+      float hi = max[axis];
+      for (std::size_t i = 0; i < count; ++i) {
+        const float value = a * x[i] + b * y[i] + c * z[i] + t;
+        lo = value < lo ? value : lo;
+        hi = value > hi ? value : hi;
+      }
+      min[axis] = lo;
+      max[axis] = hi;
+    }
+  }
+  return {min, max};
+}
+
 }  // namespace geo
 }  // namespace esp
@@ -8,6 +8,7 @@
 
 #include "esp/core/esp.h"
 
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Magnum/Math/Range.h>
 #include "esp/gfx/magnum.h"
 namespace Mn = Magnum;
@@ -40,6 +41,24 @@ std::vector<vec2f> convexHull2D(const std::vector<vec2f>& points);
 Magnum::Range3D getTransformedBB(const Magnum::Range3D& range,
                                  const Magnum::Matrix4& xform);
 
+/**
+ * @brief Compute the axis-aligned bounding box of a set of points after
+ * applying an affine transform, without copying or modifying the points.
+ *
+ * Points are gathered into small blocks of coordinates first, so that the
+ * transform and min/max reduction run as vectorizable loops even for strided
+ * vertex data.
+ *
+ * @param points The points, e.g. a view on the positions of a mesh.
+ * @param xform The affine transform to apply.
+ * @return The tight axis-aligned bounding box of the transformed points, or a
+ * default constructed range if there are none.
+ */
+Magnum::Range3D getTransformedPointsBB(
+    const Corrade::Containers::StridedArrayView1D<const Magnum::Vector3>&
+        points,
+    const Magnum::Matrix4& xform);
+
 template <typename T>
 T clamp(const T& n, const T& low, const T& high) {
   return std::max(low, std::min(n, high));
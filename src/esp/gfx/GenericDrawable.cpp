@@ -7,7 +7,12 @@
 #include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Magnum/Math/Color.h>
+#include <Magnum/Math/Constants.h>
 #include <Magnum/Math/Matrix3.h>
+#include <Magnum/Math/Range.h>
+
+#include "esp/gfx/RenderCamera.h"
+#include "esp/gfx/TextureStreamer.h"
 
 #include "esp/scene/SceneNode.h"
 
@@ -42,6 +47,9 @@ void GenericDrawable::draw(const Mn::Matrix4& transformationMatrix,
                            Mn::SceneGraph::Camera3D& camera) {
   updateShader();
 
+  // drawables may also be drawn with a plain Magnum camera, which has no
+  // render settings
+  RenderCamera* renderCamera = dynamic_cast<RenderCamera*>(&camera);
   const Mn::Matrix4 cameraMatrix = camera.cameraMatrix();
 
   std::vector<Mn::Vector3> lightPositions;
@@ -67,7 +75,7 @@ void GenericDrawable::draw(const Mn::Matrix4& transformationMatrix,
       // uploaded to GPU so simply pass 0 to the uniform "objectId" in the
       // fragment shader
       .setObjectId(
-          static_cast<RenderCamera&>(camera).useDrawableIds()
+          renderCamera && renderCamera->useDrawableIds()
               ? drawableId_
               : (materialData_->perVertexObjectId ? 0 : node_.getSemanticId()))
       .setTransformationMatrix(transformationMatrix)
@@ -86,7 +94,61 @@ void GenericDrawable::draw(const Mn::Matrix4& transformationMatrix,
   if (materialData_->normalTexture)
     shader_->bindNormalTexture(*(materialData_->normalTexture));
 
-  shader_->draw(mesh_);
+  if (textureStreamer_) {
+    const float projectedSize = getProjectedSize(transformationMatrix, camera);
+    for (Mn::GL::Texture2D* texture :
+         {materialData_->ambientTexture, materialData_->diffuseTexture,
+          materialData_->specularTexture, materialData_->normalTexture}) {
+      if (texture) {
+        textureStreamer_->reportUsage(*texture, projectedSize);
+      }
+    }
+  }
+
+  shader_->draw(renderCamera ? selectLod(transformationMatrix, *renderCamera)
+                             : mesh_);
+}
+
+Mn::GL::Mesh& GenericDrawable::selectLod(
+    const Mn::Matrix4& transformationMatrix,
+    RenderCamera& camera) const {
+  const float lodPixelError = camera.getLodPixelError();
+  if (lods_.empty() || lodPixelError <= 0.0f) {
+    return mesh_;
+  }
+
+  // the errors scale with the mesh on screen
+  const float projectedSize = getProjectedSize(transformationMatrix, camera);
+  const float diameter = node_.getMeshBB().size().length();
+  Mn::GL::Mesh* mesh = &mesh_;
+  for (const Lod& lod : lods_) {
+    if (lod.error * projectedSize > lodPixelError * diameter) {
+      break;
+    }
+    mesh = lod.mesh;
+  }
+  return *mesh;
+}
+
+float GenericDrawable::getProjectedSize(
+    const Mn::Matrix4& transformationMatrix,
+    Mn::SceneGraph::Camera3D& camera) const {
+  // distance from the camera to the bounding sphere of the mesh
+  const Mn::Range3D& meshBB = node_.getMeshBB();
+  const float scale =
+      Mn::Math::sqrt(transformationMatrix.scalingSquared().max());
+  const float diameter = meshBB.size().length() * scale;
+  const float distance =
+      transformationMatrix.transformPoint(meshBB.center()).length() -
+      0.5f * diameter;
+  if (distance <= 0.0f) {
+    return Mn::Constants::inf();
+  }
+
+  // size in pixels of a unit length at unit distance
+  const float pixelsPerUnit =
+      0.5f * camera.projectionMatrix()[1][1] * camera.viewport().y();
+  return diameter * pixelsPerUnit / distance;
 }
 
 void GenericDrawable::updateShader() {
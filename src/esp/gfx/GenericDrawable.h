@@ -5,6 +5,7 @@
 #pragma once
 
 #include <Magnum/Shaders/Phong.h>
+#include <vector>
 
 #include "esp/gfx/Drawable.h"
 #include "esp/gfx/ShaderManager.h"
@@ -12,8 +13,21 @@
 namespace esp {
 namespace gfx {
 
+class RenderCamera;
+class TextureStreamer;
+
 class GenericDrawable : public Drawable {
  public:
+  /**
+   * @brief A simplified version of the drawn mesh, see @ref setLods.
+   */
+  struct Lod {
+    //! The simplified mesh
+    Magnum::GL::Mesh* mesh;
+    //! Largest distance of its surface to the full mesh, in mesh units
+    float error;
+  };
+
   //! Create a GenericDrawable for the given object using shader and mesh.
   //! Adds drawable to given group and uses provided texture, and
   //! color for textured buffer and color shader output respectively
@@ -25,6 +39,24 @@ class GenericDrawable : public Drawable {
                            DrawableGroup* group = nullptr);
 
   void setLightSetup(const Magnum::ResourceKey& lightSetup) override;
+
+  /**
+   * @brief Set the levels of detail to draw instead of the full mesh when
+   * their error projects to fewer pixels than @ref
+   * RenderCamera::getLodPixelError. The mesh bounding box of the node is used
+   * to find the distance to the camera.
+   * @param lods The levels of detail, from finest to coarsest.
+   */
+  void setLods(std::vector<Lod> lods) { lods_ = std::move(lods); }
+
+  /**
+   * @brief Set the streamer to report the size on screen of the material
+   * textures to as they are drawn, see @ref TextureStreamer::reportUsage.
+   * @param textureStreamer The streamer, or nullptr to report to none.
+   */
+  void setTextureStreamer(TextureStreamer* textureStreamer) {
+    textureStreamer_ = textureStreamer;
+  }
   static constexpr const char* SHADER_KEY_TEMPLATE = "Phong-lights={}-flags={}";
 
  protected:
@@ -33,6 +65,21 @@ class GenericDrawable : public Drawable {
 
   void updateShader();
 
+  /**
+   * @brief Select the coarsest level of detail whose error is within the
+   * pixel error of the camera, or the full mesh.
+   */
+  Magnum::GL::Mesh& selectLod(const Magnum::Matrix4& transformationMatrix,
+                              RenderCamera& camera) const;
+
+  /**
+   * @brief Get the diameter in pixels of the mesh bounding sphere on screen,
+   * or infinity if the camera is inside it. The mesh bounding box of the node
+   * is used.
+   */
+  float getProjectedSize(const Magnum::Matrix4& transformationMatrix,
+                         Magnum::SceneGraph::Camera3D& camera) const;
+
   Magnum::ResourceKey getShaderKey(Magnum::UnsignedInt lightCount,
                                    Magnum::Shaders::Phong::Flags flags) const;
 
@@ -45,6 +92,12 @@ class GenericDrawable : public Drawable {
       shader_;
   Magnum::Resource<MaterialData, PhongMaterialData> materialData_;
   Magnum::Resource<LightSetup> lightSetup_;
+
+  // levels of detail, from finest to coarsest
+  std::vector<Lod> lods_;
+
+  // the streamer the material textures are reported to, if any
+  TextureStreamer* textureStreamer_ = nullptr;
 };
 
 }  // namespace gfx
@@ -11,6 +11,7 @@
 #include <Magnum/SceneGraph/Drawable.h>
 #include "esp/gfx/Drawable.h"
 #include "esp/gfx/DrawableGroup.h"
+#include "esp/scene/TransformHierarchy.h"
 
 namespace Mn = Magnum;
 namespace Cr = Corrade;
@@ -92,7 +93,8 @@ size_t RenderCamera::cull(
         Corrade::Containers::Optional<Mn::Range3D> aabb =
             node.getAbsoluteAABB();
         if (aabb) {
-          // if it has an absolute aabb, it is a static mesh
+          // static meshes have a precomputed one, meshes that move get theirs
+          // updated when they do
           Cr::Containers::Optional<int> culledPlane =
               rangeFrustum(*aabb, frustum, node.getFrustumPlaneIndex());
           if (culledPlane) {
@@ -101,7 +103,7 @@ size_t RenderCamera::cull(
           // if it has value, it means the aabb is culled
           return (culledPlane != Cr::Containers::NullOpt);
         } else {
-          // keep the drawable if its node does not have an absolute AABB
+          // keep the drawable if its node does not have a mesh bounding box
           return false;
         }
       });
@@ -127,7 +129,10 @@ size_t RenderCamera::removeNonObjects(
 }
 
 uint32_t RenderCamera::draw(MagnumDrawableGroup& drawables, Flags flags) {
-  if (flags == Flags()) {  // empty set
+  // the flattened hierarchy of the tree of the camera, if any, computes the
+  // absolute transformations of all drawables in one pass
+  scene::TransformHierarchy* hierarchy = node().getTransformHierarchy();
+  if (flags == Flags() && hierarchy == nullptr) {  // empty set
     MagnumCamera::draw(drawables);
     return drawables.size();
   }
@@ -138,7 +143,10 @@ uint32_t RenderCamera::draw(MagnumDrawableGroup& drawables, Flags flags) {
 
   std::vector<std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
                         Mn::Matrix4>>
-      drawableTransforms = drawableTransformations(drawables);
+      drawableTransforms =
+          hierarchy != nullptr
+              ? hierarchy->drawableTransformations(drawables, cameraMatrix())
+              : drawableTransformations(drawables);
 
   if (flags & Flag::ObjectsOnly) {
     // draw just the OBJECTS
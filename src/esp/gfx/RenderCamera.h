@@ -74,6 +74,9 @@ class RenderCamera : public MagnumCamera {
    * @param drawables, a drawable group containing all the drawables
    * @param frustumCulling, whether do frustum culling or not, default: false
    * @return the number of drawables that are drawn
+   *
+   * When the camera node is in a tree with a @ref scene::TransformHierarchy,
+   * it brings the absolute transformations of the drawables up to date.
    */
   uint32_t draw(MagnumDrawableGroup& drawables, Flags flags = {});
 
@@ -112,6 +115,20 @@ class RenderCamera : public MagnumCamera {
    * following rendering pass, otherwise false
    */
   bool useDrawableIds() { return useDrawableIds_; }
+
+  /**
+   * @brief Set the largest error, in pixels, allowed when drawables draw a
+   * simplified level of detail of their mesh instead of the full one. Larger
+   * values render faster at lower quality.
+   * @param lodPixelError The error in pixels, 0 always draws full meshes.
+   */
+  void setLodPixelError(float lodPixelError) { lodPixelError_ = lodPixelError; }
+
+  /**
+   * @brief Get the largest error allowed when drawing levels of detail, see
+   * @ref setLodPixelError.
+   */
+  float getLodPixelError() const { return lodPixelError_; }
   /**
    * @brief Unproject a 2D viewport point to a 3D ray with origin at camera
    * position.
@@ -125,6 +142,7 @@ class RenderCamera : public MagnumCamera {
 
  protected:
   bool useDrawableIds_ = false;
+  float lodPixelError_ = 0.0f;
   ESP_SMART_POINTERS(RenderCamera)
 };
 
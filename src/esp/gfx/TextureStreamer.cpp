@@ -0,0 +1,184 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "TextureStreamer.h"
+
+#include <algorithm>
+
+namespace Mn = Magnum;
+
+namespace esp {
+namespace gfx {
+
+void TextureStreamer::addTexture(Mn::GL::Texture2D& texture,
+                                 std::vector<Mn::Vector2i> levelSizes,
+                                 std::vector<std::size_t> levelBytes,
+                                 Loader loader) {
+  CORRADE_ASSERT(!levelSizes.empty() && levelSizes.size() == levelBytes.size(),
+                 "TextureStreamer::addTexture: expected the size and bytes of "
+                 "at least one level", );
+  CORRADE_ASSERT(!hasTexture(texture),
+                 "TextureStreamer::addTexture: texture added twice", );
+  const int levelCount = levelSizes.size();
+
+  Entry entry;
+  entry.texture = &texture;
+  entry.residentBytes.resize(levelCount + 1, 0);
+  for (int level = levelCount - 1; level >= 0; --level) {
+    entry.residentBytes[level] =
+        entry.residentBytes[level + 1] + levelBytes[level];
+  }
+  entry.initialLevel = 0;
+  while (entry.initialLevel + 1 < levelCount &&
+         levelSizes[entry.initialLevel].max() > InitialSize) {
+    ++entry.initialLevel;
+  }
+  entry.levelSizes = std::move(levelSizes);
+  entry.loader = std::move(loader);
+  entry.residentLevel = entry.initialLevel;
+  entry.requestedLevel = levelCount;
+
+  entry.loader(texture, entry.initialLevel);
+  memoryUsage_ += entry.residentBytes[entry.initialLevel];
+
+  entryIndices_[&texture] = entries_.size();
+  entries_.emplace_back(std::move(entry));
+}  // TextureStreamer::addTexture
+
+void TextureStreamer::reportUsage(const Mn::GL::Texture2D& texture,
+                                  float projectedSize) {
+  auto found = entryIndices_.find(&texture);
+  if (found == entryIndices_.end()) {
+    return;
+  }
+  Entry& entry = entries_[found->second];
+
+  // the coarsest level with at least as many texels as pixels covered
+  int level = entry.levelSizes.size() - 1;
+  while (level > 0 && entry.levelSizes[level].max() < projectedSize) {
+    --level;
+  }
+  entry.requestedLevel = std::min(entry.requestedLevel, level);
+  entry.lastUsedFrame = frame_;
+}  // TextureStreamer::reportUsage
+
+void TextureStreamer::update() {
+  // a reduced budget
+  if (memoryUsage_ > memoryBudget_) {
+    evict(0);
+  }
+
+  // textures missing the most levels first, they look the blurriest
+  std::vector<Entry*> promotions;
+  for (Entry& entry : entries_) {
+    if (entry.lastUsedFrame == frame_ &&
+        entry.requestedLevel < entry.residentLevel) {
+      promotions.push_back(&entry);
+    }
+  }
+  std::sort(promotions.begin(), promotions.end(),
+            [](const Entry* a, const Entry* b) {
+              return a->residentLevel - a->requestedLevel >
+                     b->residentLevel - b->requestedLevel;
+            });
+
+  for (Entry* entry : promotions) {
+    // the finest level that fits once everything possible is evicted, if not
+    // the one asked for, so that nothing is evicted for a level that then
+    // does not fit
+    const std::size_t room = memoryBudget_ + evictableBytes();
+    const std::size_t available = room > memoryUsage_ ? room - memoryUsage_ : 0;
+    int level = entry->requestedLevel;
+    while (level < entry->residentLevel &&
+           entry->residentBytes[level] -
+                   entry->residentBytes[entry->residentLevel] >
+               available) {
+      ++level;
+    }
+    if (level < entry->residentLevel &&
+        evict(entry->residentBytes[level] -
+              entry->residentBytes[entry->residentLevel])) {
+      load(*entry, level);
+    }
+  }
+
+  for (Entry& entry : entries_) {
+    entry.requestedLevel = entry.levelSizes.size();
+  }
+  ++frame_;
+}  // TextureStreamer::update
+
+void TextureStreamer::setMemoryBudget(std::size_t memoryBudget) {
+  memoryBudget_ = memoryBudget;
+  if (memoryBudget_ > 0) {
+    return;
+  }
+  for (Entry& entry : entries_) {
+    if (entry.residentLevel > 0) {
+      load(entry, 0);
+    }
+  }
+  entries_.clear();
+  entryIndices_.clear();
+  memoryUsage_ = 0;
+}  // TextureStreamer::setMemoryBudget
+
+int TextureStreamer::getResidentLevel(const Mn::GL::Texture2D& texture) const {
+  auto found = entryIndices_.find(&texture);
+  if (found == entryIndices_.end()) {
+    return ID_UNDEFINED;
+  }
+  return entries_[found->second].residentLevel;
+}
+
+void TextureStreamer::load(Entry& entry, int level) {
+  // replacing the object keeps its address, so materials see the new texture
+  *entry.texture = Mn::GL::Texture2D{};
+  entry.loader(*entry.texture, level);
+  memoryUsage_ = memoryUsage_ - entry.residentBytes[entry.residentLevel] +
+                 entry.residentBytes[level];
+  entry.residentLevel = level;
+}  // TextureStreamer::load
+
+int TextureStreamer::evictionLevel(const Entry& entry) const {
+  return entry.lastUsedFrame == frame_
+             ? std::min(entry.requestedLevel, entry.initialLevel)
+             : entry.initialLevel;
+}
+
+std::size_t TextureStreamer::evictableBytes() const {
+  std::size_t bytes = 0;
+  for (const Entry& entry : entries_) {
+    const int level = evictionLevel(entry);
+    if (entry.residentLevel < level) {
+      bytes +=
+          entry.residentBytes[entry.residentLevel] - entry.residentBytes[level];
+    }
+  }
+  return bytes;
+}
+
+bool TextureStreamer::evict(std::size_t bytes) {
+  std::vector<Entry*> candidates;
+  for (Entry& entry : entries_) {
+    if (entry.residentLevel < evictionLevel(entry)) {
+      candidates.push_back(&entry);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Entry* a, const Entry* b) {
+              return a->lastUsedFrame < b->lastUsedFrame;
+            });
+
+  for (Entry* entry : candidates) {
+    if (memoryUsage_ + bytes <= memoryBudget_) {
+      break;
+    }
+    load(*entry, evictionLevel(*entry));
+  }
+  return memoryUsage_ + bytes <= memoryBudget_;
+}  // TextureStreamer::evict
+
+}  // namespace gfx
+}  // namespace esp
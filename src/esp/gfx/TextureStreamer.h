@@ -0,0 +1,173 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_GFX_TEXTURESTREAMER_H_
+#define ESP_GFX_TEXTURESTREAMER_H_
+
+/** @file
+ * @brief Class @ref esp::gfx::TextureStreamer
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <Magnum/GL/Texture.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Vector2.h>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace gfx {
+
+/**
+ * @brief Keeps textures resident on the GPU only at the resolution they are
+ * drawn at, within a memory budget.
+ *
+ * Textures start with only their coarse mip levels uploaded, see @ref
+ * InitialSize. While drawing, drawables report the size on screen of the
+ * meshes using each texture with @ref reportUsage, and @ref update, called
+ * once per frame, uploads the finer levels that were asked for. When that
+ * exceeds the memory budget, the textures drawn least recently are first
+ * brought back to their coarse levels.
+ *
+ * A texture changes resolution by being recreated in place, so the
+ * @ref Magnum::GL::Texture2D objects that materials point to stay valid.
+ */
+class TextureStreamer {
+ public:
+  /**
+   * @brief Create a texture with the mip levels from @p firstLevel down to
+   * the coarsest one, @p firstLevel becoming its level 0, and upload them.
+   */
+  using Loader =
+      std::function<void(Magnum::GL::Texture2D& texture, int firstLevel)>;
+
+  /**
+   * @brief Largest edge length, in pixels, of the levels a texture starts
+   * with and is brought back to when evicted.
+   */
+  static constexpr int InitialSize = 64;
+
+  /**
+   * @brief Manage a texture and upload its initial levels.
+   * @param texture The texture, recreated in place by @p loader whenever its
+   * resident levels change. Must outlive the streamer.
+   * @param levelSizes The size of each mip level, finest first.
+   * @param levelBytes The GPU memory used by each mip level.
+   * @param loader Creates the texture from a given level.
+   */
+  void addTexture(Magnum::GL::Texture2D& texture,
+                  std::vector<Magnum::Vector2i> levelSizes,
+                  std::vector<std::size_t> levelBytes,
+                  Loader loader);
+
+  /**
+   * @brief Whether a texture is managed by this streamer.
+   */
+  bool hasTexture(const Magnum::GL::Texture2D& texture) const {
+    return entryIndices_.count(&texture) > 0;
+  }
+
+  /**
+   * @brief Report that a texture is drawn this frame on a mesh covering
+   * about @p projectedSize pixels across. The mesh is assumed to use the
+   * whole texture once, so the level needed is the one with about as many
+   * texels across. Textures not managed by this streamer are ignored.
+   */
+  void reportUsage(const Magnum::GL::Texture2D& texture, float projectedSize);
+
+  /**
+   * @brief Upload the levels reported since the last update, evicting within
+   * the memory budget as needed, and start a new frame. Must be called on
+   * the GL context thread.
+   */
+  void update();
+
+  /**
+   * @brief Get the finest mip level of a texture currently on the GPU.
+   * @return The level, or @ref ID_UNDEFINED if the texture is not managed by
+   * this streamer.
+   */
+  int getResidentLevel(const Magnum::GL::Texture2D& texture) const;
+
+  /**
+   * @brief Set the maximum number of bytes of GPU memory used by the
+   * textures streamed. Reducing it evicts on the next @ref update. The
+   * initial levels of textures are always kept, so usage can exceed a budget
+   * too small for them. A budget of 0 turns streaming off: every texture is
+   * reloaded at full resolution right away and no longer managed. Must be
+   * called on the GL context thread.
+   */
+  void setMemoryBudget(std::size_t memoryBudget);
+
+  /**
+   * @brief Get the maximum number of bytes of GPU memory used by the
+   * textures streamed. See @ref setMemoryBudget.
+   */
+  std::size_t getMemoryBudget() const { return memoryBudget_; }
+
+  /**
+   * @brief Get the number of bytes of GPU memory currently used by the
+   * textures streamed.
+   */
+  std::size_t getMemoryUsage() const { return memoryUsage_; }
+
+ private:
+  //! A managed texture
+  struct Entry {
+    Magnum::GL::Texture2D* texture;
+    std::vector<Magnum::Vector2i> levelSizes;
+    //! Bytes of all levels from each level to the coarsest, i.e. the memory
+    //! used when that level is the finest resident one
+    std::vector<std::size_t> residentBytes;
+    Loader loader;
+    //! Coarsest level ever resident, uploaded when the texture is added
+    int initialLevel;
+    //! Finest level on the GPU
+    int residentLevel;
+    //! Finest level reported since the last update
+    int requestedLevel;
+    //! Frame the texture was last drawn in, 0 if never
+    std::uint64_t lastUsedFrame = 0;
+  };
+
+  //! Recreate the texture of an entry from the given level.
+  void load(Entry& entry, int level);
+
+  //! The level an entry can be evicted to: the one it was drawn at this
+  //! frame, or its initial one
+  int evictionLevel(const Entry& entry) const;
+
+  //! Bytes @ref evict can free at most
+  std::size_t evictableBytes() const;
+
+  //! Bring textures not drawn this frame back to their initial level, and
+  //! textures drawn this frame to the level they were drawn at, least
+  //! recently drawn first, until @p bytes more fit within the budget. Check
+  //! with @ref evictableBytes first to avoid evicting in vain.
+  //! @return Whether they fit.
+  bool evict(std::size_t bytes);
+
+  std::vector<Entry> entries_;
+
+  //! Lookup of @ref entries_ by texture
+  std::unordered_map<const Magnum::GL::Texture2D*, std::size_t> entryIndices_;
+
+  std::size_t memoryBudget_ = 0;
+  std::size_t memoryUsage_ = 0;
+
+  //! Current frame, incremented by each update
+  std::uint64_t frame_ = 1;
+
+  ESP_SMART_POINTERS(TextureStreamer)
+};
+
+}  // namespace gfx
+}  // namespace esp
+
+#endif  // ESP_GFX_TEXTURESTREAMER_H_
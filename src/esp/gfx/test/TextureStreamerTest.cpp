@@ -0,0 +1,202 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <vector>
+
+#include <Corrade/Utility/DebugStl.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/Math/Constants.h>
+#include <Magnum/Math/Vector2.h>
+
+#include "esp/gfx/TextureStreamer.h"
+
+namespace Mn = Magnum;
+
+namespace esp {
+namespace gfx {
+namespace test {
+namespace {
+
+struct TextureStreamerTest : Mn::GL::OpenGLTester {
+  explicit TextureStreamerTest();
+
+  void initialLevel();
+  void promote();
+  void evict();
+  void evictOnlyIfEnough();
+  void disable();
+};
+
+TextureStreamerTest::TextureStreamerTest() {
+  addTests({&TextureStreamerTest::initialLevel, &TextureStreamerTest::promote,
+            &TextureStreamerTest::evict,
+            &TextureStreamerTest::evictOnlyIfEnough,
+            &TextureStreamerTest::disable});
+}
+
+// a 256x256 RGBA8 texture, 9 levels, whose loader records the levels asked
+struct StreamedTexture {
+  explicit StreamedTexture(TextureStreamer& streamer) {
+    std::vector<Mn::Vector2i> levelSizes;
+    std::vector<std::size_t> levelBytes;
+    for (int size = 256; size >= 1; size /= 2) {
+      levelSizes.emplace_back(size);
+      levelBytes.push_back(size * size * 4);
+    }
+    streamer.addTexture(
+        texture, levelSizes, levelBytes,
+        [this, levelSizes](Mn::GL::Texture2D& texture, int firstLevel) {
+          texture.setStorage(levelSizes.size() - firstLevel,
+                             Mn::GL::TextureFormat::RGBA8,
+                             levelSizes[firstLevel]);
+          loadedLevels.push_back(firstLevel);
+        });
+  }
+
+  Mn::GL::Texture2D texture;
+  std::vector<int> loadedLevels;
+};
+
+// bytes of all levels from a level of a StreamedTexture down
+std::size_t residentBytes(int level) {
+  std::size_t bytes = 0;
+  for (int size = 256 >> level; size >= 1; size /= 2) {
+    bytes += size * size * 4;
+  }
+  return bytes;
+}
+
+void TextureStreamerTest::initialLevel() {
+  TextureStreamer streamer;
+  streamer.setMemoryBudget(1 << 20);
+  StreamedTexture streamed{streamer};
+  MAGNUM_VERIFY_NO_GL_ERROR();
+
+  // 64x64 is the largest level within the initial size
+  CORRADE_COMPARE(streamer.getResidentLevel(streamed.texture), 2);
+  CORRADE_COMPARE(streamed.loadedLevels, std::vector<int>{2});
+  CORRADE_COMPARE(streamed.texture.imageSize(0), Mn::Vector2i{64});
+  CORRADE_COMPARE(streamer.getMemoryUsage(), residentBytes(2));
+
+  // not drawn, so nothing changes
+  streamer.update();
+  CORRADE_COMPARE(streamed.loadedLevels, std::vector<int>{2});
+}
+
+void TextureStreamerTest::promote() {
+  TextureStreamer streamer;
+  streamer.setMemoryBudget(1 << 20);
+  StreamedTexture streamed{streamer};
+
+  // drawn 100 pixels across, so the 128x128 level is enough
+  streamer.reportUsage(streamed.texture, 30.0f);
+  streamer.reportUsage(streamed.texture, 100.0f);
+  streamer.update();
+  MAGNUM_VERIFY_NO_GL_ERROR();
+  CORRADE_COMPARE(streamer.getResidentLevel(streamed.texture), 1);
+  CORRADE_COMPARE(streamed.texture.imageSize(0), Mn::Vector2i{128});
+  CORRADE_COMPARE(streamer.getMemoryUsage(), residentBytes(1));
+
+  // drawn smaller later on, the finer level stays within budget
+  streamer.reportUsage(streamed.texture, 10.0f);
+  streamer.update();
+  CORRADE_COMPARE(streamer.getResidentLevel(streamed.texture), 1);
+
+  // the camera inside the mesh needs the full resolution
+  streamer.reportUsage(streamed.texture, Mn::Constants::inf());
+  streamer.update();
+  CORRADE_COMPARE(streamer.getResidentLevel(streamed.texture), 0);
+  CORRADE_COMPARE(streamed.loadedLevels, (std::vector<int>{2, 1, 0}));
+}
+
+void TextureStreamerTest::evict() {
+  TextureStreamer streamer;
+  // room for one texture at full resolution and the other at its initial
+  // level
+  streamer.setMemoryBudget(residentBytes(0) + residentBytes(2));
+  StreamedTexture first{streamer};
+  StreamedTexture second{streamer};
+
+  streamer.reportUsage(first.texture, 256.0f);
+  streamer.update();
+  CORRADE_COMPARE(streamer.getResidentLevel(first.texture), 0);
+
+  // the least recently drawn texture is evicted to make room
+  streamer.reportUsage(second.texture, 256.0f);
+  streamer.update();
+  MAGNUM_VERIFY_NO_GL_ERROR();
+  CORRADE_COMPARE(streamer.getResidentLevel(first.texture), 2);
+  CORRADE_COMPARE(streamer.getResidentLevel(second.texture), 0);
+  CORRADE_COMPARE(streamer.getMemoryUsage(),
+                  residentBytes(0) + residentBytes(2));
+
+  // both drawn, only the finest level that fits is uploaded
+  streamer.reportUsage(first.texture, 256.0f);
+  streamer.reportUsage(second.texture, 256.0f);
+  streamer.update();
+  CORRADE_COMPARE(streamer.getResidentLevel(second.texture), 0);
+  CORRADE_COMPARE(streamer.getResidentLevel(first.texture), 2);
+
+  // a reduced budget brings everything back to the initial levels
+  streamer.setMemoryBudget(1);
+  streamer.update();
+  CORRADE_COMPARE(streamer.getResidentLevel(second.texture), 2);
+  CORRADE_COMPARE(streamer.getMemoryUsage(), 2 * residentBytes(2));
+}
+
+void TextureStreamerTest::evictOnlyIfEnough() {
+  TextureStreamer streamer;
+  // room for both textures at 128x128, with the full resolution of the one
+  // drawn last out of reach even by evicting the other
+  streamer.setMemoryBudget(2 * residentBytes(1));
+  StreamedTexture old{streamer};
+  StreamedTexture recent{streamer};
+
+  streamer.reportUsage(old.texture, 128.0f);
+  streamer.update();
+  CORRADE_COMPARE(streamer.getResidentLevel(old.texture), 1);
+
+  // the finest level that fits is uploaded without evicting in vain
+  streamer.reportUsage(recent.texture, Mn::Constants::inf());
+  streamer.update();
+  MAGNUM_VERIFY_NO_GL_ERROR();
+  CORRADE_COMPARE(streamer.getResidentLevel(recent.texture), 1);
+  CORRADE_COMPARE(streamer.getResidentLevel(old.texture), 1);
+  CORRADE_COMPARE(old.loadedLevels, (std::vector<int>{2, 1}));
+  CORRADE_COMPARE(streamer.getMemoryUsage(), 2 * residentBytes(1));
+}
+
+void TextureStreamerTest::disable() {
+  TextureStreamer streamer;
+  streamer.setMemoryBudget(1 << 20);
+  StreamedTexture first{streamer};
+  StreamedTexture second{streamer};
+  streamer.reportUsage(first.texture, 100.0f);
+  streamer.update();
+  CORRADE_COMPARE(streamer.getResidentLevel(first.texture), 1);
+
+  // no budget reloads every texture at full resolution and lets go of them
+  streamer.setMemoryBudget(0);
+  MAGNUM_VERIFY_NO_GL_ERROR();
+  CORRADE_COMPARE(first.texture.imageSize(0), Mn::Vector2i{256});
+  CORRADE_COMPARE(second.texture.imageSize(0), Mn::Vector2i{256});
+  CORRADE_VERIFY(!streamer.hasTexture(first.texture));
+  CORRADE_COMPARE(streamer.getResidentLevel(second.texture), ID_UNDEFINED);
+  CORRADE_COMPARE(streamer.getMemoryUsage(), 0);
+
+  // and the updates after that leave them alone
+  streamer.reportUsage(first.texture, 10.0f);
+  streamer.update();
+  CORRADE_COMPARE(first.loadedLevels, (std::vector<int>{2, 1, 0}));
+  CORRADE_COMPARE(second.loadedLevels, (std::vector<int>{2, 0}));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace gfx
+}  // namespace esp
+
+CORRADE_TEST_MAIN(esp::gfx::test::TextureStreamerTest)
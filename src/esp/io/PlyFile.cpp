@@ -0,0 +1,272 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "PlyFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace Cr = Corrade;
+
+namespace esp {
+namespace io {
+
+namespace {
+
+bool parseType(const std::string& name, PlyFile::Type& type) {
+  if (name == "char" || name == "int8") {
+    type = PlyFile::Type::Char;
+  } else if (name == "uchar" || name == "uint8") {
+    type = PlyFile::Type::UnsignedChar;
+  } else if (name == "short" || name == "int16") {
+    type = PlyFile::Type::Short;
+  } else if (name == "ushort" || name == "uint16") {
+    type = PlyFile::Type::UnsignedShort;
+  } else if (name == "int" || name == "int32") {
+    type = PlyFile::Type::Int;
+  } else if (name == "uint" || name == "uint32") {
+    type = PlyFile::Type::UnsignedInt;
+  } else if (name == "float" || name == "float32") {
+    type = PlyFile::Type::Float;
+  } else if (name == "double" || name == "float64") {
+    type = PlyFile::Type::Double;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+//! Read a list entry count, which PLY allows to be of any integer type
+std::size_t readCount(const char* data, PlyFile::Type type) {
+  switch (type) {
+    case PlyFile::Type::Char:
+    case PlyFile::Type::UnsignedChar:
+      return uint8_t(*data);
+    case PlyFile::Type::Short:
+    case PlyFile::Type::UnsignedShort: {
+      uint16_t count;
+      std::memcpy(&count, data, sizeof(count));
+      return count;
+    }
+    default: {
+      uint32_t count;
+      std::memcpy(&count, data, sizeof(count));
+      return count;
+    }
+  }
+}
+
+}  // namespace
+
+std::size_t PlyFile::typeSize(Type type) {
+  switch (type) {
+    case Type::Char:
+    case Type::UnsignedChar:
+      return 1;
+    case Type::Short:
+    case Type::UnsignedShort:
+      return 2;
+    case Type::Int:
+    case Type::UnsignedInt:
+    case Type::Float:
+      return 4;
+    case Type::Double:
+      return 8;
+  }
+  CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+}
+
+bool PlyFile::open(const std::string& filename) {
+  elements_.clear();
+  data_ = Cr::Utility::Directory::mapRead(filename);
+  if (!data_) {
+    LOG(ERROR) << "PlyFile::open: cannot map " << filename;
+    return false;
+  }
+
+  // the header is a few dozen short lines, parsed as text, the data is only
+  // ever viewed in place
+  static const char endHeader[] = "end_header";
+  const char* headerEnd = std::search(data_.begin(), data_.end(), endHeader,
+                                      endHeader + sizeof(endHeader) - 1);
+  if (headerEnd == data_.end()) {
+    LOG(ERROR) << "PlyFile::open: no end of header in " << filename;
+    return false;
+  }
+  const char* dataBegin = std::find(headerEnd, data_.end(), '\n');
+  if (dataBegin == data_.end()) {
+    LOG(ERROR) << "PlyFile::open: no data in " << filename;
+    return false;
+  }
+  ++dataBegin;
+
+  std::istringstream header{std::string{data_.data(), headerEnd}};
+  std::string line;
+  std::getline(header, line);
+  if (line.compare(0, 3, "ply") != 0) {
+    LOG(ERROR) << "PlyFile::open: " << filename << " is not a PLY file";
+    return false;
+  }
+  while (std::getline(header, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    std::istringstream ls(line);
+    std::string token;
+    ls >> token;
+    if (token.empty() || token == "comment" || token == "obj_info") {
+      continue;
+    } else if (token == "format") {
+      std::string format;
+      ls >> format;
+      if (format != "binary_little_endian") {
+        LOG(ERROR) << "PlyFile::open: " << filename
+                   << " is not a binary little endian file";
+        return false;
+      }
+    } else if (token == "element") {
+      Element element;
+      ls >> element.name >> element.count;
+      if (ls.fail()) {
+        LOG(ERROR) << "PlyFile::open: invalid element line \"" << line
+                   << "\" in " << filename;
+        return false;
+      }
+      elements_.emplace_back(std::move(element));
+    } else if (token == "property") {
+      if (elements_.empty()) {
+        LOG(ERROR) << "PlyFile::open: property before any element in "
+                   << filename;
+        return false;
+      }
+      Property property;
+      std::string type;
+      ls >> type;
+      if (type == "list") {
+        property.isList = true;
+        std::string countType;
+        ls >> countType >> type;
+        if (!parseType(countType, property.countType) ||
+            typeSize(property.countType) > 4 ||
+            property.countType == Type::Float) {
+          LOG(ERROR) << "PlyFile::open: invalid list count type " << countType
+                     << " in " << filename;
+          return false;
+        }
+      }
+      ls >> property.name;
+      if (!parseType(type, property.type) || property.name.empty()) {
+        LOG(ERROR) << "PlyFile::open: invalid property line \"" << line
+                   << "\" in " << filename;
+        return false;
+      }
+      elements_.back().properties.emplace_back(std::move(property));
+    } else {
+      LOG(ERROR) << "PlyFile::open: unexpected header line \"" << line
+                 << "\" in " << filename;
+      return false;
+    }
+  }
+
+  // lay the elements out one after the other, taking the list sizes from the
+  // first element of each kind
+  const char* elementBegin = dataBegin;
+  for (size_t iElement = 0; iElement < elements_.size(); ++iElement) {
+    Element& element = elements_[iElement];
+    const std::size_t available = data_.end() - elementBegin;
+    bool hasLists = false;
+    element.stride = 0;
+    for (Property& property : element.properties) {
+      if (property.isList) {
+        hasLists = true;
+        if (element.count == 0) {
+          // nothing to size the list from, and nothing to view either
+          property.offset = element.stride;
+          continue;
+        }
+        const std::size_t countSize = typeSize(property.countType);
+        if (element.stride + countSize > available) {
+          LOG(ERROR) << "PlyFile::open: " << filename << " is truncated";
+          return false;
+        }
+        property.listSize =
+            readCount(elementBegin + element.stride, property.countType);
+        element.stride += countSize;
+        property.offset = element.stride;
+        element.stride += property.listSize * typeSize(property.type);
+      } else {
+        property.offset = element.stride;
+        element.stride += typeSize(property.type);
+      }
+    }
+
+    std::size_t count = element.count;
+    if (element.stride && count * element.stride > available) {
+      if (iElement + 1 != elements_.size()) {
+        LOG(ERROR) << "PlyFile::open: " << filename << " is truncated";
+        return false;
+      }
+      count = available / element.stride;
+      LOG(WARNING) << "PlyFile::open: " << filename << " is truncated, only "
+                   << count << " of " << element.count << " "
+                   << element.name << " elements are read";
+    }
+
+    // the fixed layout only holds if every list has the same size
+    if (hasLists) {
+      for (const Property& property : element.properties) {
+        if (!property.isList) {
+          continue;
+        }
+        const std::size_t countOffset =
+            property.offset - typeSize(property.countType);
+        for (std::size_t i = 0; i < count; ++i) {
+          if (readCount(elementBegin + i * element.stride + countOffset,
+                        property.countType) != property.listSize) {
+            LOG(ERROR) << "PlyFile::open: list " << property.name << " of "
+                       << element.name
+                       << " elements has a varying size, which is not "
+                          "supported, in "
+                       << filename;
+            return false;
+          }
+        }
+      }
+    }
+
+    element.count = count;
+    element.data = {elementBegin, count * element.stride};
+    elementBegin += count * element.stride;
+  }
+
+  return true;
+}  // PlyFile::open
+
+const PlyFile::Element* PlyFile::element(const std::string& name) const {
+  for (const Element& element : elements_) {
+    if (element.name == name) {
+      return &element;
+    }
+  }
+  return nullptr;
+}
+
+const PlyFile::Property* PlyFile::property(
+    const std::string& elementName,
+    const std::string& propertyName) const {
+  const Element* e = element(elementName);
+  if (!e) {
+    return nullptr;
+  }
+  for (const Property& property : e->properties) {
+    if (property.name == propertyName) {
+      return &property;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace io
+}  // namespace esp
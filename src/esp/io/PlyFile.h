@@ -0,0 +1,243 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_IO_PLYFILE_H_
+#define ESP_IO_PLYFILE_H_
+
+/** @file
+ * @brief Class @ref esp::io::PlyFile
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace io {
+
+/**
+ * @brief A binary little endian PLY file, memory mapped and with its header
+ * parsed once, whose properties are read through strided views directly over
+ * the mapped file instead of being streamed and copied value by value. PLY
+ * values are packed, so the views copy each value out with @cpp memcpy @ce
+ * rather than dereferencing possibly misaligned pointers.
+ *
+ * Every element must have a fixed size, so list properties must have the same
+ * number of entries in every element, as the quads of PTex meshes or the
+ * triangles of instance meshes do.
+ */
+class PlyFile {
+ public:
+  /**
+   * @brief The type of a property, or of the entries and count of a list.
+   */
+  enum class Type : uint8_t {
+    Char,
+    UnsignedChar,
+    Short,
+    UnsignedShort,
+    Int,
+    UnsignedInt,
+    Float,
+    Double,
+  };
+
+  /**
+   * @brief A property of an element.
+   */
+  struct Property {
+    std::string name;
+    //! The type of the property, or of the list entries
+    Type type;
+    bool isList = false;
+    //! The type of the list entry count
+    Type countType = Type::UnsignedChar;
+    //! The number of list entries, the same in every element
+    std::size_t listSize = 0;
+    //! Offset of the property, or of the first list entry, in the element
+    std::size_t offset = 0;
+  };
+
+  /**
+   * @brief An element, with its data in the mapped file.
+   */
+  struct Element {
+    std::string name;
+    std::size_t count = 0;
+    std::vector<Property> properties;
+    //! Size of one element in bytes
+    std::size_t stride = 0;
+    //! The data of all @ref count elements
+    Corrade::Containers::ArrayView<const char> data;
+  };
+
+  /**
+   * @brief A strided view of possibly misaligned values of type @p T.
+   */
+  template <class T>
+  class View {
+   public:
+    /**
+     * @brief Constructor.
+     * @param data The first byte of each value.
+     */
+    explicit View(Corrade::Containers::StridedArrayView1D<const char> data)
+        : data_{data} {}
+
+    /**
+     * @brief The number of values.
+     */
+    std::size_t size() const { return data_.size(); }
+
+    /**
+     * @brief Read a value.
+     */
+    T operator[](std::size_t i) const {
+      T value;
+      std::memcpy(&value, &data_[i], sizeof(T));
+      return value;
+    }
+
+   private:
+    Corrade::Containers::StridedArrayView1D<const char> data_;
+  };
+
+  /**
+   * @brief A strided view of rows of possibly misaligned values of type
+   * @p T, one row per element.
+   */
+  template <class T>
+  class ListView {
+   public:
+    /**
+     * @brief Constructor.
+     * @param data The first byte of each value.
+     */
+    explicit ListView(Corrade::Containers::StridedArrayView2D<const char> data)
+        : data_{data} {}
+
+    /**
+     * @brief The number of rows and of values in each row.
+     */
+    Corrade::Containers::StridedArrayView2D<const char>::Size size() const {
+      return data_.size();
+    }
+
+    /**
+     * @brief View a row.
+     */
+    View<T> operator[](std::size_t i) const { return View<T>{data_[i]}; }
+
+   private:
+    Corrade::Containers::StridedArrayView2D<const char> data_;
+  };
+
+  /**
+   * @brief Map a file and parse its header.
+   * @return Whether the file is a binary little endian PLY file with fixed
+   * size elements. A file whose last element is truncated is accepted with a
+   * warning, and the element count reduced to what is there.
+   */
+  bool open(const std::string& filename);
+
+  /**
+   * @brief The elements, in file order.
+   */
+  const std::vector<Element>& elements() const { return elements_; }
+
+  /**
+   * @brief Find an element by name.
+   * @return The element, or nullptr if there is none.
+   */
+  const Element* element(const std::string& name) const;
+
+  /**
+   * @brief Find a property by element and property name.
+   * @return The property, or nullptr if there is none.
+   */
+  const Property* property(const std::string& elementName,
+                           const std::string& propertyName) const;
+
+  /**
+   * @brief View a scalar property of every element of a kind.
+   * @return The view, or @ref Corrade::Containers::NullOpt if the property
+   * does not exist, is a list, or is not stored as @p T. Signedness is not
+   * checked, so e.g. @cpp int @ce indices can be viewed as @cpp uint32_t @ce.
+   */
+  template <class T>
+  Corrade::Containers::Optional<View<T>> view(
+      const std::string& elementName,
+      const std::string& propertyName) const {
+    const Element* e = element(elementName);
+    const Property* p = property(elementName, propertyName);
+    if (!p || p->isList || !matchesType<T>(p->type)) {
+      LOG(ERROR) << "PlyFile::view: no property " << propertyName
+                 << " of the requested type in element " << elementName;
+      return Corrade::Containers::NullOpt;
+    }
+    return View<T>{Corrade::Containers::StridedArrayView1D<const char>{
+        e->data, e->data.data() + p->offset, e->count,
+        std::ptrdiff_t(e->stride)}};
+  }
+
+  /**
+   * @brief View a list property of every element of a kind, one row of
+   * @ref Property::listSize entries per element.
+   * @return The view, or @ref Corrade::Containers::NullOpt if the property
+   * does not exist, is not a list, or its entries are not stored as @p T.
+   */
+  template <class T>
+  Corrade::Containers::Optional<ListView<T>> listView(
+      const std::string& elementName,
+      const std::string& propertyName) const {
+    const Element* e = element(elementName);
+    const Property* p = property(elementName, propertyName);
+    if (!p || !p->isList || !matchesType<T>(p->type)) {
+      LOG(ERROR) << "PlyFile::listView: no list property " << propertyName
+                 << " of the requested type in element " << elementName;
+      return Corrade::Containers::NullOpt;
+    }
+    return ListView<T>{Corrade::Containers::StridedArrayView2D<const char>{
+        e->data,
+        e->data.data() + p->offset,
+        {e->count, p->listSize},
+        {std::ptrdiff_t(e->stride), std::ptrdiff_t(sizeof(T))}}};
+  }
+
+  /**
+   * @brief Size of a value of a type in bytes.
+   */
+  static std::size_t typeSize(Type type);
+
+ private:
+  template <class T>
+  static bool matchesType(Type type) {
+    return typeSize(type) == sizeof(T) &&
+           std::is_floating_point<T>::value ==
+               (type == Type::Float || type == Type::Double);
+  }
+
+  Corrade::Containers::Array<const char,
+                             Corrade::Utility::Directory::MapDeleter>
+      data_;
+  std::vector<Element> elements_;
+
+  ESP_SMART_POINTERS(PlyFile)
+};
+
+}  // namespace io
+}  // namespace esp
+
+#endif  // ESP_IO_PLYFILE_H_
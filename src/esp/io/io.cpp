@@ -3,6 +3,7 @@
 // LICENSE file in the root directory of this source tree.
 
 #include "io.h"
+#include <sys/stat.h>
 #include <fstream>
 #include <set>
 
@@ -44,6 +45,14 @@ size_t fileSize(const std::string& filename) {
   return (size <= 0 ? 0 : size);
 }
 
+int64_t modificationTime(const std::string& filename) {
+  struct stat status;
+  if (stat(filename.c_str(), &status) != 0) {
+    return 0;
+  }
+  return status.st_mtime;
+}
+
 // TODO:
 // a corner case it will fail to match the replace_extension in c++17:
 // filename = "foo"
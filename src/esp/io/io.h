@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -14,6 +15,11 @@ bool exists(const std::string& file);
 
 size_t fileSize(const std::string& file);
 
+/** @brief Time of the last modification of a file, in seconds since the
+ * epoch, or 0 if it does not exist.
+ */
+int64_t modificationTime(const std::string& file);
+
 std::string removeExtension(const std::string& file);
 
 std::string changeExtension(const std::string& file, const std::string& ext);
@@ -4,15 +4,72 @@
 
 #include "esp/io/json.h"
 
+#include <fstream>
+
 #include <rapidjson/filereadstream.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
 #include "esp/core/esp.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Cr = Corrade;
+
 namespace esp {
 namespace io {
 
+namespace {
+
+#ifndef _WIN32
+void unmapJsonBuffer(char* data, std::size_t size) {
+  munmap(data, size);
+}
+#endif
+
+//! Read a file followed by a null terminator, or return an empty buffer
+JsonBuffer readJsonBuffer(const std::string& file) {
+#ifndef _WIN32
+  const int fd = open(file.c_str(), O_RDONLY);
+  if (fd != -1) {
+    struct stat fileStat;
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    // the rest of the last page reads as zeros, one of which terminates the
+    // document; private pages are copied when parsing in situ writes to them
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size % pageSize != 0) {
+      const std::size_t size = fileStat.st_size + 1;
+      void* data =
+          mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (data != MAP_FAILED) {
+        return JsonBuffer{static_cast<char*>(data), size, unmapJsonBuffer};
+      }
+    } else {
+      close(fd);
+    }
+  }
+#endif
+
+  // empty files, files filling whole pages, or no mmap
+  std::ifstream in{file, std::ios::binary | std::ios::ate};
+  if (!in) {
+    return nullptr;
+  }
+  const std::size_t size = in.tellg();
+  JsonBuffer buffer{Cr::Containers::NoInit, size + 1};
+  in.seekg(0);
+  in.read(buffer.data(), size);
+  buffer[size] = '\0';
+  return buffer;
+}
+
+}  // namespace
+
 JsonDocument parseJsonFile(const std::string& file) {
   FILE* pFile = fopen(file.c_str(), "rb");
   char buffer[65536];
@@ -29,6 +86,24 @@ JsonDocument parseJsonFile(const std::string& file) {
   return d;
 }
 
+bool parseJsonFileInSitu(const std::string& file,
+                         JsonBuffer& buffer,
+                         JsonDocument& d) {
+  buffer = readJsonBuffer(file);
+  if (buffer.empty()) {
+    LOG(ERROR) << "Cannot read " << file;
+    return false;
+  }
+  d.ParseInsitu(buffer.data());
+
+  if (d.HasParseError()) {
+    LOG(ERROR) << "Parse error reading " << file << " Error code "
+               << d.GetParseError() << " at " << d.GetErrorOffset();
+    return false;
+  }
+  return true;
+}
+
 JsonDocument parseJsonString(const std::string& jsonString) {
   JsonDocument d;
   d.Parse(jsonString.c_str());
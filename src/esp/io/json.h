@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include <Corrade/Containers/Array.h>
 #include <Magnum/Magnum.h>
 #include <Magnum/Math/Vector3.h>
 
@@ -28,6 +29,24 @@ JsonDocument parseJsonFile(const std::string& file);
 //! Parse JSON string and return as JsonDocument object
 JsonDocument parseJsonString(const std::string& jsonString);
 
+//! Storage of the file a JsonDocument was parsed from in situ
+typedef Corrade::Containers::Array<char> JsonBuffer;
+
+/**
+ * @brief Parse JSON file in situ: the file is mapped privately into memory
+ * and the document references strings in place instead of copying them.
+ * Unlike @ref parseJsonFile, failures are logged and not thrown, so that it
+ * can be called from worker threads.
+ *
+ * @param file the file to parse
+ * @param buffer [out] the storage of the file, has to outlive @p d
+ * @param d [out] the parsed document
+ * @return whether the file could be read and parsed
+ */
+bool parseJsonFileInSitu(const std::string& file,
+                         JsonBuffer& buffer,
+                         JsonDocument& d);
+
 //! Return string representation of given JsonDocument
 std::string jsonToString(const JsonDocument& d);
 
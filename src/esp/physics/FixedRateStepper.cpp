@@ -0,0 +1,78 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "FixedRateStepper.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace esp {
+namespace physics {
+
+FixedRateStepper::FixedRateStepper(PhysicsManager::ptr physicsManager)
+    : physicsManager_(std::move(physicsManager)) {}
+
+FixedRateStepper::~FixedRateStepper() {
+  stop();
+}
+
+void FixedRateStepper::start(double realTimeFactor) {
+  if (running_) {
+    return;
+  }
+  if (realTimeFactor <= 0) {
+    LOG(ERROR) << "FixedRateStepper::start : realTimeFactor must be positive, "
+                  "not "
+               << realTimeFactor << ". Aborting.";
+    return;
+  }
+  realTimeFactor_ = realTimeFactor;
+  {
+    auto physicsLock = lock();
+    physicsManager_->setDeferSceneNodeSync(true);
+  }
+  running_ = true;
+  worker_ = std::thread(&FixedRateStepper::run, this);
+}
+
+void FixedRateStepper::stop() {
+  if (!running_) {
+    return;
+  }
+  running_ = false;
+  worker_.join();
+  physicsManager_->setDeferSceneNodeSync(false);
+}
+
+void FixedRateStepper::run() {
+  using Clock = std::chrono::steady_clock;
+  const Clock::duration tickPeriod =
+      std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{
+          physicsManager_->getTimestep() / realTimeFactor_});
+
+  Clock::time_point lastTick = Clock::now();
+  Clock::time_point nextTick = lastTick + tickPeriod;
+  while (running_) {
+    std::this_thread::sleep_until(nextTick);
+    const Clock::time_point now = Clock::now();
+    if (now - nextTick > tickPeriod) {
+      ++numLateTicks_;
+    }
+    {
+      auto physicsLock = lock();
+      // step the wall-clock time since the last tick; the physics manager
+      // bounds the substeps this may take
+      physicsManager_->stepPhysics(
+          std::chrono::duration<double>(now - lastTick).count() *
+          realTimeFactor_);
+    }
+    lastTick = now;
+    // never schedule in the past, so falling behind doesn't cause a burst of
+    // catch-up ticks
+    nextTick = std::max(nextTick + tickPeriod, now);
+  }
+}
+
+}  // namespace physics
+}  // namespace esp
@@ -0,0 +1,105 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_PHYSICS_FIXEDRATESTEPPER_H_
+#define ESP_PHYSICS_FIXEDRATESTEPPER_H_
+
+/** @file
+ * @brief Class @ref esp::physics::FixedRateStepper
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "esp/core/esp.h"
+#include "esp/physics/PhysicsManager.h"
+
+namespace esp {
+namespace physics {
+
+/**
+@brief Steps a @ref PhysicsManager from a worker thread at a fixed wall-clock
+rate, decoupled from whoever renders or queries the world.
+
+Every tick advances the world by one @ref PhysicsManager::getTimestep scaled
+by the real-time factor. If the worker falls behind, the missed time is
+requested on the next tick and bounded by @ref
+PhysicsManager::getMaxSubsteps, so a stall shows up as substep overruns
+rather than as a latency spike. Scene node updates are deferred while
+running; see @ref PhysicsManager::setDeferSceneNodeSync.
+
+The @ref PhysicsManager must only be accessed while holding the lock returned
+by @ref lock.
+*/
+class FixedRateStepper {
+ public:
+  /**
+   * @brief Constructor. Does not start stepping.
+   * @param physicsManager The physics world to step.
+   */
+  explicit FixedRateStepper(PhysicsManager::ptr physicsManager);
+
+  /** @brief Destructor stops the worker thread. */
+  ~FixedRateStepper();
+
+  /**
+   * @brief Start stepping from a worker thread. Does nothing if already
+   * running.
+   * @param realTimeFactor Simulated seconds per wall-clock second.
+   */
+  void start(double realTimeFactor = 1.0);
+
+  /**
+   * @brief Stop the worker thread after its current tick and sync scene nodes.
+   * Does nothing if not running.
+   */
+  void stop();
+
+  /** @brief Whether the worker thread is stepping. */
+  bool isRunning() const { return running_; }
+
+  /**
+   * @brief Get exclusive access to the stepped @ref PhysicsManager. The worker
+   * does not step while the returned lock is held.
+   */
+  std::unique_lock<std::mutex> lock() {
+    return std::unique_lock<std::mutex>(mutex_);
+  }
+
+  /**
+   * @brief Get the number of ticks the worker started late because the
+   * previous tick took longer than the tick period.
+   */
+  int getNumLateTicks() const { return numLateTicks_; }
+
+ private:
+  //! The worker thread loop.
+  void run();
+
+  //! The stepped physics world.
+  PhysicsManager::ptr physicsManager_;
+
+  //! Guards @ref physicsManager_ between the worker and other threads.
+  std::mutex mutex_;
+
+  //! The worker thread.
+  std::thread worker_;
+
+  //! Whether the worker thread should keep stepping.
+  std::atomic<bool> running_{false};
+
+  //! Simulated seconds per wall-clock second.
+  double realTimeFactor_ = 1.0;
+
+  //! Number of ticks started after their scheduled time.
+  std::atomic<int> numLateTicks_{0};
+
+  ESP_SMART_POINTERS(FixedRateStepper)
+};
+
+}  // namespace physics
+}  // namespace esp
+
+#endif  // ESP_PHYSICS_FIXEDRATESTEPPER_H_
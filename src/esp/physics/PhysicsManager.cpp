@@ -7,6 +7,8 @@
 
 #include <Magnum/Math/Range.h>
 
+#include <cmath>
+
 namespace esp {
 namespace physics {
 
@@ -15,6 +17,7 @@ bool PhysicsManager::initPhysics(scene::SceneNode* node) {
 
   // Copy over relevant configuration
   fixedTimeStep_ = physicsManagerAttributes_->getTimestep();
+  maxSubsteps_ = physicsManagerAttributes_->getMaxSubsteps();
 
   //! Create new scene node and set up any physics-related variables
   // Overridden by specific physics-library-based class
@@ -58,7 +61,7 @@ int PhysicsManager::addObject(const int objectLibIndex,
                               DrawableGroup* drawables,
                               scene::SceneNode* attachmentNode,
                               const Magnum::ResourceKey& lightSetup) {
-  const std::string& configHandle =
+  const std::string configHandle =
       resourceManager_.getObjectAttributesManager()->getTemplateHandleByID(
           objectLibIndex);
 
@@ -133,6 +136,8 @@ void PhysicsManager::removeObject(const int physObjectID,
   scene::SceneNode* objectNode = &existingObjects_.at(physObjectID)->node();
   scene::SceneNode* visualNode = existingObjects_.at(physObjectID)->visualNode_;
   existingObjects_.erase(physObjectID);
+  velControlObjectIDs_.erase(physObjectID);
+  deferredRigidStates_.erase(physObjectID);
   deallocateObjectID(physObjectID);
   if (deleteObjectNode) {
     delete objectNode;
@@ -183,6 +188,80 @@ bool PhysicsManager::isMeshPrimitiveValid(const assets::CollisionMeshData&) {
   return true;
 }
 
+void PhysicsManager::saveSnapshot(PhysicsWorldSnapshot& snapshot) {
+  snapshot.worldTime = worldTime_;
+  snapshot.objects.resize(existingObjects_.size());
+  std::size_t objectIndex = 0;
+  for (auto& objectItr : existingObjects_) {
+    RigidObject& object = *objectItr.second;
+    RigidObjectSnapshot& objectState = snapshot.objects[objectIndex++];
+    objectState.objectId = objectItr.first;
+    objectState.templateHandle = object.getTemplateHandle();
+    objectState.motionType = object.getMotionType();
+    objectState.rigidState = object.getRigidState();
+    objectState.linearVelocity = object.getLinearVelocity();
+    objectState.angularVelocity = object.getAngularVelocity();
+    objectState.active = object.isActive();
+  }
+}
+
+void PhysicsManager::addSubstepOverruns(int numDroppedSubsteps) {
+  if (numDroppedSubsteps <= 0) {
+    return;
+  }
+  if (numSubstepOverruns_ == 0) {
+    LOG(WARNING) << "PhysicsManager::stepPhysics : dropped "
+                 << numDroppedSubsteps << " timesteps over the "
+                 << maxSubsteps_
+                 << " max substeps per step, so simulated time is falling "
+                    "behind. Further overruns are only counted, see "
+                    "getNumSubstepOverruns.";
+  }
+  numSubstepOverruns_ += numDroppedSubsteps;
+}
+
+bool PhysicsManager::restoreSnapshot(const PhysicsWorldSnapshot& snapshot) {
+  // validate first so a failed restore leaves the world untouched
+  for (const RigidObjectSnapshot& objectState : snapshot.objects) {
+    auto objectItr = existingObjects_.find(objectState.objectId);
+    if (objectItr == existingObjects_.end()) {
+      LOG(ERROR) << "PhysicsManager::restoreSnapshot : object "
+                 << objectState.objectId
+                 << " no longer exists. Aborting restore.";
+      return false;
+    }
+    if (objectItr->second->getTemplateHandle() != objectState.templateHandle) {
+      LOG(ERROR) << "PhysicsManager::restoreSnapshot : object "
+                 << objectState.objectId << " was created from "
+                 << objectItr->second->getTemplateHandle() << ", not "
+                 << objectState.templateHandle
+                 << " as when saved. Aborting restore.";
+      return false;
+    }
+  }
+
+  for (const RigidObjectSnapshot& objectState : snapshot.objects) {
+    RigidObject& object = *existingObjects_.at(objectState.objectId);
+    // STATIC objects ignore kinematic updates and velocities, so change the
+    // motion type first unless the object is becoming STATIC
+    if (objectState.motionType != MotionType::STATIC) {
+      object.setMotionType(objectState.motionType);
+    }
+    object.setRigidState(objectState.rigidState);
+    object.setLinearVelocity(objectState.linearVelocity);
+    object.setAngularVelocity(objectState.angularVelocity);
+    if (objectState.motionType == MotionType::STATIC) {
+      object.setMotionType(MotionType::STATIC);
+    }
+    // set last, since setting velocities wakes objects
+    object.setSleeping(!objectState.active);
+  }
+  worldTime_ = snapshot.worldTime;
+
+  restoreSnapshotFinalize();
+  return true;
+}
+
 // TODO: this function should do any engine specific setting which is
 // necessary to change the timestep
 void PhysicsManager::setTimestep(double dt) {
@@ -213,21 +292,56 @@ void PhysicsManager::stepPhysics(double dt) {
   // handle in-between step times? Ideally dt is a multiple of
   // sceneMetaData_.timestep
   double targetTime = worldTime_ + dt;
+  int numSubSteps = 0;
   while (worldTime_ < targetTime) {
+    if (maxSubsteps_ > 0 && numSubSteps == maxSubsteps_) {
+      // drop the remainder rather than stalling the caller
+      addSubstepOverruns(static_cast<int>(
+          std::ceil((targetTime - worldTime_) / fixedTimeStep_)));
+      break;
+    }
+    ++numSubSteps;
     // per fixed-step operations can be added here
 
     // kinematic velocity control intergration
-    for (auto& object : existingObjects_) {
-      VelocityControl::ptr velControl = object.second->getVelocityControl();
+    // only objects which have handed out their VelocityControl can be under
+    // control, so skip the rest of the world
+    for (const int objectID : velControlObjectIDs_) {
+      RigidObject& object = *existingObjects_.at(objectID);
+      const VelocityControl::ptr& velControl = object.getVelocityControl();
       if (velControl->controllingAngVel || velControl->controllingLinVel) {
-        object.second->setRigidState(velControl->integrateTransform(
-            fixedTimeStep_, object.second->getRigidState()));
+        if (deferSceneNodeSync_) {
+          // integrate on the side so stepping never writes the scene graph
+          auto deferredState =
+              deferredRigidStates_.emplace(objectID, object.getRigidState())
+                  .first;
+          deferredState->second = velControl->integrateTransform(
+              fixedTimeStep_, deferredState->second);
+        } else {
+          object.setRigidState(velControl->integrateTransform(
+              fixedTimeStep_, object.getRigidState()));
+        }
       }
     }
     worldTime_ += fixedTimeStep_;
   }
 }
 
+void PhysicsManager::setDeferSceneNodeSync(bool defer) {
+  if (!defer) {
+    syncSceneNodes();
+  }
+  deferSceneNodeSync_ = defer;
+}
+
+void PhysicsManager::syncSceneNodes() {
+  for (const auto& deferredState : deferredRigidStates_) {
+    existingObjects_.at(deferredState.first)
+        ->setRigidState(deferredState.second);
+  }
+  deferredRigidStates_.clear();
+}
+
 //! Profile function. In BulletPhysics stationary objects are
 //! marked as inactive to speed up simulation. This function
 //! helps checking how many objects are active/inactive at any
@@ -410,6 +524,9 @@ Magnum::Vector3 PhysicsManager::getAngularVelocity(
 VelocityControl::ptr PhysicsManager::getVelocityControl(
     const int physObjectID) {
   assertIDValidity(physObjectID);
+  // once handed out the control may be modified at any time, so the object
+  // must be visited by stepPhysics from now on
+  velControlObjectIDs_.insert(physObjectID);
   return existingObjects_.at(physObjectID)->getVelocityControl();
 }
 
@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -67,6 +68,40 @@ struct RaycastResults {
   ESP_SMART_POINTERS(RaycastResults)
 };
 
+//! Holds the simulation state of one rigid object in a @ref
+//! PhysicsWorldSnapshot.
+struct RigidObjectSnapshot {
+  //! The id of the object in @ref PhysicsManager::existingObjects_.
+  int objectId;
+  //! The handle of the template the object was created from, so a restore
+  //! can tell if the id was reused by another object since the save.
+  std::string templateHandle;
+  //! The @ref MotionType of the object.
+  MotionType motionType;
+  //! The rotation and translation of the object.
+  core::RigidState rigidState;
+  //! The linear velocity of the object.
+  Magnum::Vector3 linearVelocity;
+  //! The angular velocity of the object.
+  Magnum::Vector3 angularVelocity;
+  //! Whether or not the object was actively simulated rather than sleeping.
+  bool active;
+};
+
+/**
+ * @brief Holds the simulation state of all rigid objects in a physical world.
+ * See @ref PhysicsManager::saveSnapshot and @ref
+ * PhysicsManager::restoreSnapshot.
+ */
+struct PhysicsWorldSnapshot {
+  //! The simulated world time when the snapshot was saved.
+  double worldTime = 0.0;
+  //! The state of each object existing when the snapshot was saved.
+  std::vector<RigidObjectSnapshot> objects;
+
+  ESP_SMART_POINTERS(PhysicsWorldSnapshot)
+};
+
 // TODO: repurpose to manage multiple physical worlds. Currently represents
 // exactly one world.
 
@@ -255,11 +290,74 @@ class PhysicsManager {
   //============ Simulator functions =============
 
   /** @brief Step the physical world forward in time. Time may only advance in
-   * increments of @ref fixedTimeStep_.
+   * increments of @ref fixedTimeStep_. At most @ref maxSubsteps_ increments
+   * are taken per call; the rest of dt is dropped and counted in @ref
+   * numSubstepOverruns_, with a warning logged on the first overrun.
    * @param dt The desired amount of time to advance the physical world.
    */
   virtual void stepPhysics(double dt = 0.0);
 
+  /** @brief Set the maximum number of @ref fixedTimeStep_ increments a single
+   * @ref stepPhysics call may take, bounding its latency.
+   * @param maxSubsteps The bound, or 0 to take as many increments as dt
+   * requires.
+   */
+  void setMaxSubsteps(int maxSubsteps) { maxSubsteps_ = maxSubsteps; }
+
+  /** @brief Get the maximum number of @ref fixedTimeStep_ increments a single
+   * @ref stepPhysics call may take. 0 if unbounded.
+   */
+  int getMaxSubsteps() const { return maxSubsteps_; }
+
+  /** @brief Get the total number of @ref fixedTimeStep_ increments dropped by
+   * @ref stepPhysics because a call requested more than @ref maxSubsteps_.
+   * Non-zero means simulated time fell behind the requested time.
+   */
+  int getNumSubstepOverruns() const { return numSubstepOverruns_; }
+
+  /** @brief Defer updating object @ref scene::SceneNode poses while stepping
+   * until @ref syncSceneNodes is called, so stepping never touches the scene
+   * graph and only the poses needed for a render are written. Object poses
+   * queried through this class are only current after a sync. Disabling
+   * deferral syncs immediately.
+   * @param defer Whether to defer scene node updates.
+   */
+  virtual void setDeferSceneNodeSync(bool defer);
+
+  /** @brief Whether object @ref scene::SceneNode updates are deferred. See
+   * @ref setDeferSceneNodeSync.
+   */
+  bool getDeferSceneNodeSync() const { return deferSceneNodeSync_; }
+
+  /** @brief Write the simulated poses of all objects to their @ref
+   * scene::SceneNode s if they were deferred by @ref setDeferSceneNodeSync and
+   * have changed since the last sync. In the kinematic world these are the
+   * poses integrated for objects under velocity control.
+   */
+  virtual void syncSceneNodes();
+
+  /** @brief Save the simulation state of all existing objects and the world
+   * time into a @ref PhysicsWorldSnapshot. The storage of the snapshot is
+   * reused, so repeatedly saving into the same snapshot does not allocate once
+   * it has grown to fit the world.
+   * @param snapshot The snapshot to overwrite.
+   */
+  void saveSnapshot(PhysicsWorldSnapshot& snapshot);
+
+  /** @brief Restore the simulation state saved with @ref saveSnapshot in
+   * place. Objects are not re-instanced, so every object recorded in the
+   * snapshot must still exist. Objects added after the snapshot was saved are
+   * left untouched. If no object's motion type changed since the snapshot was
+   * saved, restoring the same snapshot and stepping the same way always
+   * produces the same result. Restoring a different motion type re-adds the
+   * object to the physics world, which may change the solver order.
+   * @param snapshot The snapshot to restore.
+   * @return false if an object recorded in the snapshot no longer exists, or
+   * its id now belongs to an object created from another template, in which
+   * case nothing is modified.
+   */
+  bool restoreSnapshot(const PhysicsWorldSnapshot& snapshot);
+
   // =========== Global Setter functions ===========
 
   /** @brief Set the @ref fixedTimeStep_ of the physical world. See @ref
@@ -956,6 +1054,21 @@ class PhysicsManager {
 
   virtual bool addStageFinalize(const std::string& handle);
 
+  /**
+   * @brief Finalize @ref restoreSnapshot after all object states have been
+   * set. Overridden by instancing class to discard any simulator caches (e.g.
+   * contact points) which would otherwise carry over from before the restore.
+   */
+  virtual void restoreSnapshotFinalize() {}
+
+  /**
+   * @brief Count @ref fixedTimeStep_ increments dropped by @ref stepPhysics in
+   * @ref numSubstepOverruns_, warning on the first overrun since simulated
+   * time then falls behind the requested time.
+   * @param numDroppedSubsteps The number of increments dropped by one call.
+   */
+  void addSubstepOverruns(int numDroppedSubsteps);
+
   /** @brief Create and initialize a @ref RigidObject, assign it an ID and add
    * it to existingObjects_ map keyed with newObjectID
    * @param newObjectID valid object ID for the new object
@@ -1012,6 +1125,12 @@ class PhysicsManager {
    * check @ref existingObjects_ explicitly.*/
   int nextObjectID_ = 0;
 
+  /** @brief IDs of objects whose @ref VelocityControl has been handed out by
+   * @ref getVelocityControl. Only these objects can be under velocity control,
+   * so @ref stepPhysics visits this set instead of all @ref existingObjects_.
+   */
+  std::set<int> velControlObjectIDs_;
+
   /** @brief A list of available object IDs tracked by @ref deallocateObjectID
    * which were previously used by objects since removed from the world with
    * @ref removeObject. These IDs will be re-allocated with @ref
@@ -1033,6 +1152,23 @@ class PhysicsManager {
    * simulated with @ref stepPhysics up to this point. */
   double worldTime_ = 0.0;
 
+  /** @brief The maximum number of @ref fixedTimeStep_ increments per @ref
+   * stepPhysics call, or 0 if unbounded. */
+  int maxSubsteps_ = 0;
+
+  /** @brief The total number of @ref fixedTimeStep_ increments dropped by
+   * @ref stepPhysics due to @ref maxSubsteps_. */
+  int numSubstepOverruns_ = 0;
+
+  /** @brief Whether object scene node updates are deferred to @ref
+   * syncSceneNodes. */
+  bool deferSceneNodeSync_ = false;
+
+  /** @brief Poses integrated by kinematic velocity control while scene node
+   * updates are deferred, keyed by object id and written on @ref
+   * syncSceneNodes. */
+  std::map<int, core::RigidState> deferredRigidStates_;
+
   ESP_SMART_POINTERS(PhysicsManager)
 };
 
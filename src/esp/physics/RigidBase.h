@@ -152,6 +152,14 @@ class RigidBase : public Magnum::SceneGraph::AbstractFeature3D {
    */
   virtual void setActive() {}
 
+  /**
+   * @brief Force an object to sleep or to be actively simulated. Used to
+   * restore a saved simulation state. Kinematic objects are always active, but
+   * derived dynamics implementations may not be.
+   * @param sleeping Whether the object should sleep.
+   */
+  virtual void setSleeping(CORRADE_UNUSED bool sleeping) {}
+
   /**
    * @brief Get the @ref MotionType of the object. See @ref setMotionType.
    * @return The object's current @ref MotionType.
@@ -307,8 +315,12 @@ class RigidBase : public Magnum::SceneGraph::AbstractFeature3D {
    * @brief Set the rotation and translation of the object.
    */
   virtual void setRigidState(const core::RigidState& rigidState) {
-    setTranslation(rigidState.translation);
-    setRotation(rigidState.rotation);
+    if (objectMotionType_ != MotionType::STATIC) {
+      // set both components before a single sync with the simulator
+      node().setTranslation(rigidState.translation);
+      node().setRotation(rigidState.rotation);
+      syncPose();
+    }
   };
 
   /**
@@ -597,6 +609,12 @@ class RigidBase : public Magnum::SceneGraph::AbstractFeature3D {
     return T::create(*(static_cast<T*>(initializationAttributes_.get())));
   }
 
+  /**
+   * @brief Get the handle of the template used to initialize this object or
+   * scene.
+   */
+  const std::string& getTemplateHandle() const { return templateHandle_; }
+
   /** @brief Store whatever object attributes you want here! */
   esp::core::Configuration attributes_;
 
@@ -631,6 +649,9 @@ class RigidBase : public Magnum::SceneGraph::AbstractFeature3D {
    */
   Attrs::AbstractObjectAttributes::ptr initializationAttributes_ = nullptr;
 
+  //! Handle of the template @ref initializationAttributes_ was copied from.
+  std::string templateHandle_;
+
   //! Access for the object to its own PhysicsManager id. Scene will keep -1.
   int objectId_ = -1;
 
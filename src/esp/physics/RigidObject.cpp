@@ -22,6 +22,7 @@ bool RigidObject::initialize(const assets::ResourceManager& resMgr,
   // save a copy of the template at initialization time
   initializationAttributes_ =
       resMgr.getObjectAttributesManager()->getTemplateCopyByHandle(handle);
+  templateHandle_ = handle;
 
   return initialization_LibSpecific(resMgr);
 }  // RigidObject::initialize
@@ -19,6 +19,7 @@ bool RigidStage::initialize(const assets::ResourceManager& resMgr,
   objectMotionType_ = MotionType::STATIC;
   initializationAttributes_ =
       resMgr.getStageAttributesManager()->getTemplateCopyByHandle(handle);
+  templateHandle_ = handle;
 
   return initialization_LibSpecific(resMgr);
 }
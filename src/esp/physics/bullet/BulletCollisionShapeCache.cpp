@@ -0,0 +1,131 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "BulletCollisionShapeCache.h"
+
+#include <algorithm>
+
+#include "BulletCollision/CollisionShapes/btConvexHullShape.h"
+#include "LinearMath/btConvexHull.h"
+
+namespace esp {
+namespace physics {
+
+BulletConvexShapes::cptr BulletCollisionShapeCache::getConvexShapes(
+    const std::string& collisionAssetHandle,
+    const std::vector<assets::CollisionMeshData>& meshGroup,
+    const assets::MeshTransformNode& root,
+    bool join,
+    int vertexBudget,
+    const Magnum::Vector3& scale) {
+  const ShapeKey key{collisionAssetHandle, join, vertexBudget, scale.x(),
+                     scale.y(), scale.z()};
+  auto cachedShapes = convexShapes_.find(key);
+  if (cachedShapes != convexShapes_.end()) {
+    return cachedShapes->second;
+  }
+
+  auto shapes = BulletConvexShapes::create();
+  constructConvexShapesFromMeshes(Magnum::Matrix4{}, meshGroup, root, join,
+                                  *shapes);
+
+  // add the final shape after joining meshes
+  if (join && !shapes->hulls.empty()) {
+    shapes->hulls.back()->setMargin(0.0);
+    shapes->hulls.back()->recalcLocalAabb();
+    shapes->transforms.emplace_back(btTransform::getIdentity());
+  }
+
+  if (vertexBudget > 0) {
+    for (auto& hull : shapes->hulls) {
+      if (hull->getNumPoints() > vertexBudget) {
+        auto simplifiedHull = simplifyConvexHull(*hull, vertexBudget);
+        if (simplifiedHull != nullptr) {
+          hull = std::move(simplifiedHull);
+        }
+      }
+    }
+  }
+
+  // Apply the object scale the way btCompoundShape::setLocalScaling would.
+  // Shared hulls can't be scaled by each instance's compound, since that would
+  // compound the scaling once per instance.
+  const btVector3 bScale{scale};
+  for (std::size_t i = 0; i < shapes->hulls.size(); ++i) {
+    shapes->hulls[i]->setLocalScaling(bScale);
+    shapes->transforms[i].setOrigin(shapes->transforms[i].getOrigin() *
+                                    bScale);
+  }
+
+  convexShapes_.emplace(key, shapes);
+  return shapes;
+}  // getConvexShapes
+
+std::shared_ptr<btConvexHullShape>
+BulletCollisionShapeCache::simplifyConvexHull(const btConvexHullShape& hull,
+                                              int vertexBudget) {
+  HullDesc hullDesc(QF_DEFAULT, hull.getNumPoints(), hull.getUnscaledPoints());
+  // the hull library needs at least a tetrahedron
+  hullDesc.mMaxVertices = std::max(vertexBudget, 4);
+
+  HullLibrary hullLibrary;
+  HullResult hullResult;
+  if (hullLibrary.CreateConvexHull(hullDesc, hullResult) != QE_OK) {
+    LOG(WARNING) << "BulletCollisionShapeCache::simplifyConvexHull : Unable "
+                    "to simplify a hull of "
+                 << hull.getNumPoints() << " points, keeping it as is.";
+    return nullptr;
+  }
+
+  auto simplifiedHull = std::make_shared<btConvexHullShape>(
+      static_cast<const btScalar*>(hullResult.m_OutputVertices[0].m_floats),
+      hullResult.mNumOutputVertices, sizeof(btVector3));
+  simplifiedHull->setMargin(hull.getMargin());
+  simplifiedHull->recalcLocalAabb();
+  hullLibrary.ReleaseResult(hullResult);
+  return simplifiedHull;
+}  // simplifyConvexHull
+
+void BulletCollisionShapeCache::constructConvexShapesFromMeshes(
+    const Magnum::Matrix4& transformFromParentToWorld,
+    const std::vector<assets::CollisionMeshData>& meshGroup,
+    const assets::MeshTransformNode& node,
+    bool join,
+    BulletConvexShapes& shapes) {
+  Magnum::Matrix4 transformFromLocalToWorld =
+      transformFromParentToWorld * node.transformFromLocalToParent;
+  if (node.meshIDLocal != ID_UNDEFINED) {
+    const assets::CollisionMeshData& mesh = meshGroup[node.meshIDLocal];
+
+    if (join) {
+      // add all points to a single convex instead of compounding (more
+      // stable)
+      if (shapes.hulls.empty()) {
+        // create the convex if it does not exist
+        shapes.hulls.emplace_back(std::make_shared<btConvexHullShape>());
+      }
+
+      // add points
+      for (auto& v : mesh.positions) {
+        shapes.hulls.back()->addPoint(
+            btVector3(transformFromLocalToWorld.transformPoint(v)), false);
+      }
+    } else {
+      shapes.hulls.emplace_back(std::make_shared<btConvexHullShape>(
+          static_cast<const btScalar*>(mesh.positions.data()->data()),
+          mesh.positions.size(), sizeof(Magnum::Vector3)));
+      shapes.hulls.back()->setMargin(0.0);
+      shapes.hulls.back()->recalcLocalAabb();
+      shapes.transforms.emplace_back(btTransform{transformFromLocalToWorld});
+    }
+  }
+
+  for (auto& child : node.children) {
+    constructConvexShapesFromMeshes(transformFromLocalToWorld, meshGroup, child,
+                                    join, shapes);
+  }
+}  // constructConvexShapesFromMeshes
+
+}  // namespace physics
+}  // namespace esp
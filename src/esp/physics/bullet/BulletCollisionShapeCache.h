@@ -0,0 +1,134 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_PHYSICS_BULLET_BULLETCOLLISIONSHAPECACHE_H_
+#define ESP_PHYSICS_BULLET_BULLETCOLLISIONSHAPECACHE_H_
+
+/** @file
+ * @brief Struct @ref esp::physics::BulletConvexShapes, class @ref
+ * esp::physics::BulletCollisionShapeCache
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <Magnum/BulletIntegration/Integration.h>
+#include <btBulletDynamicsCommon.h>
+
+#include "esp/assets/CollisionMeshData.h"
+#include "esp/assets/MeshMetaData.h"
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace physics {
+
+/**
+ * @brief Convex collision shapes built from the collision mesh of one asset at
+ * one scale. Shared by all @ref BulletRigidObject instances of that asset, each
+ * of which adds the hulls to its own @ref btCompoundShape. The shapes must not
+ * be modified once built.
+ */
+struct BulletConvexShapes {
+  //! The convex hulls with the object scale already applied.
+  std::vector<std::shared_ptr<btConvexHullShape>> hulls;
+
+  //! The transform of each hull in object-local space with the object scale
+  //! already applied.
+  std::vector<btTransform> transforms;
+
+  ESP_SMART_POINTERS(BulletConvexShapes)
+};
+
+/**
+ * @brief Caches the convex collision shapes of mesh based objects keyed by
+ * collision asset handle, join setting, vertex budget and scale, so that
+ * instancing the same object template many times only builds and simplifies
+ * its @ref btConvexHullShape once.
+ */
+class BulletCollisionShapeCache {
+ public:
+  /**
+   * @brief Get the convex collision shapes for a collision asset, building and
+   * caching them on first request.
+   * @param collisionAssetHandle The handle of the collision asset.
+   * @param meshGroup Access structure for collision mesh data of the asset.
+   * @param root The root @ref MeshTransformNode of the asset.
+   * @param join Whether or not to join sub-meshes into a single convex shape,
+   * rather than creating individual convexes.
+   * @param vertexBudget The maximum number of vertices kept in each hull, see
+   * @ref simplifyConvexHull. 0 keeps every vertex.
+   * @param scale The local scaling of the object.
+   * @return The shared convex shapes.
+   */
+  BulletConvexShapes::cptr getConvexShapes(
+      const std::string& collisionAssetHandle,
+      const std::vector<assets::CollisionMeshData>& meshGroup,
+      const assets::MeshTransformNode& root,
+      bool join,
+      int vertexBudget,
+      const Magnum::Vector3& scale);
+
+  /**
+   * @brief Get the number of distinct asset and scale combinations currently
+   * cached.
+   */
+  int getNumCachedShapes() const { return convexShapes_.size(); }
+
+  /**
+   * @brief Release all cached shapes. Shapes still referenced by objects stay
+   * alive until those objects are destroyed.
+   */
+  void clear() { convexShapes_.clear(); }
+
+ private:
+  /**
+   * @brief Recursively construct unscaled @ref btConvexHullShape s from loaded
+   * mesh assets, accumulating transformations down the @ref
+   * MeshTransformNode tree.
+   * @param transformFromParentToWorld The cumulative parent-to-world
+   * transformation matrix constructed by composition down the @ref
+   * MeshTransformNode tree to the current node.
+   * @param meshGroup Access structure for collision mesh data.
+   * @param node The current @ref MeshTransformNode in the recursion.
+   * @param join Whether or not to join sub-meshes into a single convex shape.
+   * @param shapes The shapes under construction.
+   */
+  void constructConvexShapesFromMeshes(
+      const Magnum::Matrix4& transformFromParentToWorld,
+      const std::vector<assets::CollisionMeshData>& meshGroup,
+      const assets::MeshTransformNode& node,
+      bool join,
+      BulletConvexShapes& shapes);
+
+  /**
+   * @brief Reduce a convex hull to at most vertexBudget of its extreme points
+   * (and at least a tetrahedron), dropping interior points. Every contact
+   * query against a @ref btConvexHullShape is linear in its point count, so
+   * this bounds the narrowphase cost of detailed collision meshes.
+   * @param hull The hull to simplify.
+   * @param vertexBudget The maximum number of vertices to keep.
+   * @return The simplified hull, or nullptr if hull could not be simplified.
+   */
+  static std::shared_ptr<btConvexHullShape> simplifyConvexHull(
+      const btConvexHullShape& hull,
+      int vertexBudget);
+
+  //! Collision asset handle, join setting, vertex budget and scale of a cache
+  //! entry.
+  typedef std::tuple<std::string, bool, int, float, float, float> ShapeKey;
+
+  //! The cached shapes.
+  std::map<ShapeKey, BulletConvexShapes::ptr> convexShapes_;
+
+ public:
+  ESP_SMART_POINTERS(BulletCollisionShapeCache)
+};  // class BulletCollisionShapeCache
+
+}  // namespace physics
+}  // namespace esp
+
+#endif  // ESP_PHYSICS_BULLET_BULLETCOLLISIONSHAPECACHE_H_
@@ -5,6 +5,8 @@
 //#include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
 //#include "BulletCollision/Gimpact/btGImpactShape.h"
 
+#include <algorithm>
+
 #include "BulletPhysicsManager.h"
 #include "BulletRigidObject.h"
 #include "esp/assets/ResourceManager.h"
@@ -34,7 +36,7 @@ bool BulletPhysicsManager::initPhysicsFinalize() {
   bWorld_->setDebugDrawer(&debugDrawer_);
 
   // currently GLB meshes are y-up
-  bWorld_->setGravity(btVector3(physicsManagerAttributes_->getVec3("gravity")));
+  bWorld_->setGravity(btVector3(physicsManagerAttributes_->getGravity()));
 
   Corrade::Utility::Debug() << "creating staticStageObject_";
   //! Create new scene node
@@ -54,13 +56,37 @@ bool BulletPhysicsManager::addStageFinalize(const std::string& handle) {
   return sceneSuccess;
 }
 
+void BulletPhysicsManager::restoreSnapshotFinalize() {
+  btOverlappingPairCache* pairCache =
+      bWorld_->getBroadphase()->getOverlappingPairCache();
+  btCollisionObjectArray& collisionObjects = bWorld_->getCollisionObjectArray();
+  for (int i = 0; i < collisionObjects.size(); ++i) {
+    btCollisionObject* collisionObject = collisionObjects[i];
+    // manifolds are pooled by the dispatcher, so this does not free memory
+    pairCache->cleanProxyFromPairs(collisionObject->getBroadphaseHandle(),
+                                   &bDispatcher_);
+    btRigidBody* body = btRigidBody::upcast(collisionObject);
+    if (body != nullptr) {
+      body->setInterpolationWorldTransform(body->getWorldTransform());
+      body->setInterpolationLinearVelocity(body->getLinearVelocity());
+      body->setInterpolationAngularVelocity(body->getAngularVelocity());
+      body->clearForces();
+    }
+  }
+  bSolver_.reset();
+}
+
 bool BulletPhysicsManager::makeAndAddRigidObject(int newObjectID,
                                                  const std::string& handle,
                                                  scene::SceneNode* objectNode) {
   auto ptr = physics::BulletRigidObject::create_unique(
-      objectNode, newObjectID, bWorld_, collisionObjToObjIds_);
+      objectNode, newObjectID, bWorld_, collisionObjToObjIds_,
+      collisionShapeCache_);
   bool objSuccess = ptr->initialize(resourceManager_, handle);
   if (objSuccess) {
+    if (deferSceneNodeSync_) {
+      ptr->setDeferSceneNodeSync(true);
+    }
     existingObjects_.emplace(newObjectID, std::move(ptr));
   }
   return objSuccess;
@@ -102,11 +128,13 @@ bool BulletPhysicsManager::isMeshPrimitiveValid(
 
 void BulletPhysicsManager::setGravity(const Magnum::Vector3& gravity) {
   bWorld_->setGravity(btVector3(gravity));
-  // After gravity change, need to reactive all bullet objects
-  for (std::map<int, physics::RigidObject::uptr>::iterator it =
-           existingObjects_.begin();
-       it != existingObjects_.end(); ++it) {
-    it->second->setActive();
+  // After gravity change, need to reactive all dynamic bullet objects.
+  // Kinematic and static objects are unaffected by gravity and can keep
+  // sleeping.
+  for (auto& objectItr : existingObjects_) {
+    if (objectItr.second->getMotionType() == MotionType::DYNAMIC) {
+      objectItr.second->setActive();
+    }
   }
 }
 
@@ -124,43 +152,90 @@ void BulletPhysicsManager::stepPhysics(double dt) {
   }
 
   // set specified control velocities
-  for (auto& objectItr : existingObjects_) {
-    VelocityControl::ptr velControl = objectItr.second->getVelocityControl();
-    if (objectItr.second->getMotionType() == MotionType::KINEMATIC) {
+  // only objects which have handed out their VelocityControl can be under
+  // control, so resting objects are never touched here
+  for (const int objectID : velControlObjectIDs_) {
+    RigidObject& object = *existingObjects_.at(objectID);
+    const VelocityControl::ptr& velControl = object.getVelocityControl();
+    BulletRigidObject& bulletObject = static_cast<BulletRigidObject&>(object);
+    if (object.getMotionType() == MotionType::KINEMATIC) {
       // kinematic velocity control intergration
       if (velControl->controllingAngVel || velControl->controllingLinVel) {
-        objectItr.second->setRigidState(velControl->integrateTransform(
-            dt, objectItr.second->getRigidState()));
-        objectItr.second->setActive();
+        if (deferSceneNodeSync_) {
+          // move the body only, its node follows on syncSceneNodes
+          bulletObject.setSimulatedRigidState(velControl->integrateTransform(
+              dt, bulletObject.getSimulatedRigidState()));
+          sceneNodesOutOfSync_ = true;
+        } else {
+          object.setRigidState(
+              velControl->integrateTransform(dt, object.getRigidState()));
+        }
+        object.setActive();
       }
-    } else if (objectItr.second->getMotionType() == MotionType::DYNAMIC) {
+    } else if (object.getMotionType() == MotionType::DYNAMIC) {
+      // the node lags behind the body while scene node updates are deferred
+      const Magnum::Quaternion rotation =
+          deferSceneNodeSync_ ? bulletObject.getSimulatedRigidState().rotation
+                              : object.node().rotation();
       if (velControl->controllingLinVel) {
         if (velControl->linVelIsLocal) {
-          setLinearVelocity(objectItr.first,
-                            objectItr.second->node().rotation().transformVector(
-                                velControl->linVel));
+          object.setLinearVelocity(
+              rotation.transformVector(velControl->linVel));
         } else {
-          setLinearVelocity(objectItr.first, velControl->linVel);
+          object.setLinearVelocity(velControl->linVel);
         }
       }
       if (velControl->controllingAngVel) {
         if (velControl->angVelIsLocal) {
-          setAngularVelocity(
-              objectItr.first,
-              objectItr.second->node().rotation().transformVector(
-                  velControl->angVel));
+          object.setAngularVelocity(
+              rotation.transformVector(velControl->angVel));
         } else {
-          setAngularVelocity(objectItr.first, velControl->angVel);
+          object.setAngularVelocity(velControl->angVel);
         }
       }
     }
   }
 
   // ==== Physics stepforward ======
+  // NOTE: Bullet only synchronizes the motion states (and therefore the
+  // SceneNodes) of active bodies, so sleeping objects cost nothing here.
   // NOTE: worldTime_ will always be a multiple of sceneMetaData_.timestep
-  int numSubStepsTaken =
-      bWorld_->stepSimulation(dt, /*maxSubSteps*/ 10000, fixedTimeStep_);
+  const int maxSubSteps = maxSubsteps_ > 0 ? maxSubsteps_ : 10000;
+  // Bullet reports the number of substeps requested by dt, but drops the ones
+  // beyond maxSubSteps
+  const int numSubStepsRequested =
+      bWorld_->stepSimulation(dt, maxSubSteps, fixedTimeStep_);
+  const int numSubStepsTaken = std::min(numSubStepsRequested, maxSubSteps);
+  addSubstepOverruns(numSubStepsRequested - numSubStepsTaken);
   worldTime_ += numSubStepsTaken * fixedTimeStep_;
+  if (numSubStepsTaken > 0) {
+    sceneNodesOutOfSync_ = deferSceneNodeSync_;
+  }
+}
+
+void BulletPhysicsManager::setDeferSceneNodeSync(bool defer) {
+  if (defer == deferSceneNodeSync_) {
+    return;
+  }
+  if (!defer) {
+    // bring the nodes up to date before the motion states take over again
+    syncSceneNodes();
+  }
+  deferSceneNodeSync_ = defer;
+  for (auto& object : existingObjects_) {
+    static_cast<BulletRigidObject*>(object.second.get())
+        ->setDeferSceneNodeSync(defer);
+  }
+}
+
+void BulletPhysicsManager::syncSceneNodes() {
+  if (!sceneNodesOutOfSync_) {
+    return;
+  }
+  for (auto& object : existingObjects_) {
+    static_cast<BulletRigidObject*>(object.second.get())->syncSceneNode();
+  }
+  sceneNodesOutOfSync_ = false;
 }
 
 void BulletPhysicsManager::setMargin(const int physObjectID,
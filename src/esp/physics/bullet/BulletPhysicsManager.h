@@ -17,6 +17,7 @@
 #include "BulletDynamics/Featherstone/btMultiBodyConstraintSolver.h"
 #include "BulletDynamics/Featherstone/btMultiBodyDynamicsWorld.h"
 
+#include "BulletCollisionShapeCache.h"
 #include "BulletRigidObject.h"
 #include "BulletRigidStage.h"
 #include "esp/physics/PhysicsManager.h"
@@ -54,6 +55,7 @@ class BulletPhysicsManager : public PhysicsManager {
       : PhysicsManager(_resourceManager, _physicsManagerAttributes) {
     collisionObjToObjIds_ =
         std::make_shared<std::map<const btCollisionObject*, int>>();
+    collisionShapeCache_ = BulletCollisionShapeCache::create();
   };
 
   /** @brief Destructor which destructs necessary Bullet physics structures.*/
@@ -68,6 +70,19 @@ class BulletPhysicsManager : public PhysicsManager {
    */
   void stepPhysics(double dt) override;
 
+  /** @brief Defer writing simulated object poses to their scene nodes until
+   * @ref syncSceneNodes. While deferred, Bullet does not synchronize motion
+   * states, so stepping never touches the scene graph.
+   * @param defer Whether to defer scene node updates.
+   */
+  void setDeferSceneNodeSync(bool defer) override;
+
+  /** @brief Write the simulated poses of all dynamic and kinematic objects to
+   * their scene nodes if they were stepped with deferred sync since the last
+   * call.
+   */
+  void syncSceneNodes() override;
+
   /** @brief Set the gravity of the physical world.
    * @param gravity The desired gravity force of the physical world.
    */
@@ -150,6 +165,15 @@ class BulletPhysicsManager : public PhysicsManager {
    */
   const Magnum::Range3D getStageCollisionShapeAabb() const;
 
+  /**
+   * @brief Get the cache of convex collision shapes shared between instances
+   * of the same object collision asset.
+   * @return The collision shape cache.
+   */
+  const BulletCollisionShapeCache& getCollisionShapeCache() const {
+    return *collisionShapeCache_;
+  }
+
   /** @brief Render the debugging visualizations provided by @ref
    * Magnum::BulletIntegration::DebugDraw. This draws wireframes for all
    * collision objects.
@@ -202,6 +226,13 @@ class BulletPhysicsManager : public PhysicsManager {
    */
   bool addStageFinalize(const std::string& handle) override;
 
+  /**
+   * @brief Finalize a snapshot restore: discard cached contact manifolds and
+   * solver state and align the interpolation state of every body with its
+   * restored state, so stepping after a restore only depends on the snapshot.
+   */
+  void restoreSnapshotFinalize() override;
+
   /** @brief Create and initialize an @ref RigidObject and add
    * it to existingObjects_ map keyed with newObjectID
    * @param newObjectID valid object ID for the new object
@@ -232,6 +263,14 @@ class BulletPhysicsManager : public PhysicsManager {
   std::shared_ptr<std::map<const btCollisionObject*, int>>
       collisionObjToObjIds_;
 
+  //! Convex collision shapes built once per collision asset and scale and
+  //! shared by all @ref BulletRigidObject instances of it.
+  BulletCollisionShapeCache::ptr collisionShapeCache_;
+
+  //! Whether objects were stepped with deferred scene node sync since the last
+  //! @ref syncSceneNodes.
+  bool sceneNodesOutOfSync_ = false;
+
  private:
   /** @brief Check if a particular mesh can be used as a collision mesh for
    * Bullet.
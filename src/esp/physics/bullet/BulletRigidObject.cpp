@@ -34,10 +34,12 @@ BulletRigidObject::BulletRigidObject(
     int objectId,
     std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
     std::shared_ptr<std::map<const btCollisionObject*, int> >
-        collisionObjToObjIds)
+        collisionObjToObjIds,
+    BulletCollisionShapeCache::ptr collisionShapeCache)
     : BulletBase(bWorld, collisionObjToObjIds),
       RigidObject(rigidBodyNode, objectId),
-      MotionState(*rigidBodyNode) {}
+      MotionState(*rigidBodyNode),
+      collisionShapeCache_(std::move(collisionShapeCache)) {}
 
 BulletRigidObject::~BulletRigidObject() {
   if (objectMotionType_ != MotionType::STATIC) {
@@ -101,15 +103,18 @@ bool BulletRigidObject::initialization_LibSpecific(
         resMgr.getMeshMetaData(collisionAssetHandle);
 
     if (!usingBBCollisionShape_) {
-      constructBulletCompoundFromMeshes(Magnum::Matrix4{}, meshGroup,
-                                        metaData.root, joinCollisionMeshes);
-
-      // add the final object after joining meshes
-      if (joinCollisionMeshes) {
-        bObjectConvexShapes_.back()->setMargin(0.0);
-        bObjectConvexShapes_.back()->recalcLocalAabb();
-        bObjectShape_->addChildShape(btTransform::getIdentity(),
-                                     bObjectConvexShapes_.back().get());
+      // convex shapes are built once per collision asset and scale and shared
+      // by all instances, with the scale already applied
+      BulletConvexShapes::cptr convexShapes =
+          collisionShapeCache_->getConvexShapes(
+              collisionAssetHandle, meshGroup, metaData.root,
+              joinCollisionMeshes, tmpAttr->getCollisionHullVertexBudget(),
+              tmpAttr->getScale());
+      bObjectConvexShapes_ = convexShapes->hulls;
+      convexShapesAreShared_ = true;
+      for (std::size_t i = 0; i < bObjectConvexShapes_.size(); ++i) {
+        bObjectShape_->addChildShape(convexShapes->transforms[i],
+                                     bObjectConvexShapes_[i].get());
       }
     }
   }  // if using prim collider else use mesh collider
@@ -117,7 +122,10 @@ bool BulletRigidObject::initialization_LibSpecific(
   //! Set properties
   bObjectShape_->setMargin(margin);
 
-  bObjectShape_->setLocalScaling(btVector3{tmpAttr->getScale()});
+  if (bObjectConvexShapes_.empty()) {
+    // scale the compound's own children. Shared convex shapes are pre-scaled.
+    bObjectShape_->setLocalScaling(btVector3{tmpAttr->getScale()});
+  }
 
   btVector3 bInertia = btVector3(tmpAttr->getInertia());
 
@@ -224,52 +232,6 @@ BulletRigidObject::buildPrimitiveCollisionObject(int primTypeVal,
   return obj;
 }  // buildPrimitiveCollisionObject
 
-// recursively create the convex mesh shapes and add them to the compound in a
-// flat manner by accumulating transformations down the tree
-void BulletRigidObject::constructBulletCompoundFromMeshes(
-    const Magnum::Matrix4& transformFromParentToWorld,
-    const std::vector<assets::CollisionMeshData>& meshGroup,
-    const assets::MeshTransformNode& node,
-    bool join) {
-  Magnum::Matrix4 transformFromLocalToWorld =
-      transformFromParentToWorld * node.transformFromLocalToParent;
-  if (node.meshIDLocal != ID_UNDEFINED) {
-    // This node has a mesh, so add it to the compound
-
-    const assets::CollisionMeshData& mesh = meshGroup[node.meshIDLocal];
-
-    if (join) {
-      // add all points to a single convex instead of compounding (more
-      // stable)
-      if (bObjectConvexShapes_.empty()) {
-        // create the convex if it does not exist
-        bObjectConvexShapes_.emplace_back(
-            std::make_unique<btConvexHullShape>());
-      }
-
-      // add points
-      for (auto& v : mesh.positions) {
-        bObjectConvexShapes_.back()->addPoint(
-            btVector3(transformFromLocalToWorld.transformPoint(v)), false);
-      }
-    } else {
-      bObjectConvexShapes_.emplace_back(std::make_unique<btConvexHullShape>(
-          static_cast<const btScalar*>(mesh.positions.data()->data()),
-          mesh.positions.size(), sizeof(Magnum::Vector3)));
-      bObjectConvexShapes_.back()->setMargin(0.0);
-      bObjectConvexShapes_.back()->recalcLocalAabb();
-      //! Add to compound shape stucture
-      bObjectShape_->addChildShape(btTransform{transformFromLocalToWorld},
-                                   bObjectConvexShapes_.back().get());
-    }
-  }
-
-  for (auto& child : node.children) {
-    constructBulletCompoundFromMeshes(transformFromLocalToWorld, meshGroup,
-                                      child, join);
-  }
-}  // constructBulletCompoundFromMeshes
-
 void BulletRigidObject::setCollisionFromBB() {
   btVector3 dim(node().getCumulativeBB().size() / 2.0);
 
@@ -293,6 +255,37 @@ void BulletRigidObject::setCollisionFromBB() {
   }
 }  // setCollisionFromBB
 
+void BulletRigidObject::setMargin(const double margin) {
+  makeConvexShapesUnique();
+  for (std::size_t i = 0; i < bObjectConvexShapes_.size(); i++) {
+    bObjectConvexShapes_[i]->setMargin(margin);
+  }
+  bObjectShape_->setMargin(margin);
+}  // setMargin
+
+void BulletRigidObject::makeConvexShapesUnique() {
+  if (!convexShapesAreShared_) {
+    return;
+  }
+  btAlignedObjectArray<btCompoundShapeChild>& children =
+      bObjectShape_->getChildList();
+  for (auto& convexShape : bObjectConvexShapes_) {
+    auto uniqueShape = std::make_shared<btConvexHullShape>(
+        static_cast<const btScalar*>(
+            convexShape->getUnscaledPoints()->m_floats),
+        convexShape->getNumPoints(), sizeof(btVector3));
+    uniqueShape->setMargin(convexShape->getMargin());
+    uniqueShape->setLocalScaling(convexShape->getLocalScaling());
+    for (int i = 0; i < children.size(); ++i) {
+      if (children[i].m_childShape == convexShape.get()) {
+        children[i].m_childShape = uniqueShape.get();
+      }
+    }
+    convexShape = std::move(uniqueShape);
+  }
+  convexShapesAreShared_ = false;
+}  // makeConvexShapesUnique
+
 bool BulletRigidObject::setMotionType(MotionType mt) {
   if (mt == objectMotionType_) {
     return true;  // no work
@@ -370,6 +363,30 @@ void BulletRigidObject::shiftOrigin(const Magnum::Vector3& shift) {
   node().computeCumulativeBB();
 }  // shiftOrigin
 
+void BulletRigidObject::syncSceneNode() {
+  if (objectMotionType_ == MotionType::STATIC ||
+      bObjectRigidBody_->getMotionState() != nullptr) {
+    // the motion state keeps the node up to date
+    return;
+  }
+  const core::RigidState rigidState = getSimulatedRigidState();
+  node().setRotation(rigidState.rotation);
+  node().setTranslation(rigidState.translation);
+}  // syncSceneNode
+
+core::RigidState BulletRigidObject::getSimulatedRigidState() const {
+  const btTransform& worldTransform = bObjectRigidBody_->getWorldTransform();
+  return core::RigidState(Magnum::Quaternion::fromMatrix(Magnum::Matrix3{
+                              worldTransform.getBasis()}),
+                          Magnum::Vector3{worldTransform.getOrigin()});
+}  // getSimulatedRigidState
+
+void BulletRigidObject::setSimulatedRigidState(
+    const core::RigidState& rigidState) {
+  bObjectRigidBody_->setWorldTransform(btTransform(Magnum::Matrix4::from(
+      rigidState.rotation.toMatrix(), rigidState.translation)));
+}  // setSimulatedRigidState
+
 //! Synchronize Physics transformations
 //! Needed after changing the pose from Magnum side
 void BulletRigidObject::syncPose() {
@@ -22,6 +22,7 @@
 
 #include "esp/physics/RigidObject.h"
 #include "esp/physics/bullet/BulletBase.h"
+#include "esp/physics/bullet/BulletCollisionShapeCache.h"
 
 namespace esp {
 namespace physics {
@@ -42,12 +43,15 @@ class BulletRigidObject : public BulletBase,
    * @brief Constructor for a @ref BulletRigidObject.
    * @param rigidBodyNode The @ref scene::SceneNode this feature will be
    * attached to.
+   * @param collisionShapeCache Cache of convex collision shapes shared with
+   * other instances of the same collision asset.
    */
   BulletRigidObject(scene::SceneNode* rigidBodyNode,
                     int objectId,
                     std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
                     std::shared_ptr<std::map<const btCollisionObject*, int>>
-                        collisionObjToObjIds);
+                        collisionObjToObjIds,
+                    BulletCollisionShapeCache::ptr collisionShapeCache);
 
   /**
    * @brief Destructor cleans up simulation structures for the object.
@@ -73,25 +77,6 @@ class BulletRigidObject : public BulletBase,
       double halfLength);
   // const assets::AbstractPrimitiveAttributes& primAttributes);
 
-  /**
-   * @brief Recursively construct a @ref btCompoundShape for collision from
-   * loaded mesh assets. A @ref btConvexHullShape is constructed for each
-   * sub-component, transformed to object-local space and added to the compound
-   * in a flat manner for efficiency.
-   * @param transformFromParentToWorld The cumulative parent-to-world
-   * transformation matrix constructed by composition down the @ref
-   * MeshTransformNode tree to the current node.
-   * @param meshGroup Access structure for collision mesh data.
-   * @param node The current @ref MeshTransformNode in the recursion.
-   * @param join Whether or not to join sub-meshes into a single con convex
-   * shape, rather than creating individual convexes under the compound.
-   */
-  void constructBulletCompoundFromMeshes(
-      const Magnum::Matrix4& transformFromParentToWorld,
-      const std::vector<assets::CollisionMeshData>& meshGroup,
-      const assets::MeshTransformNode& node,
-      bool join);
-
   /**
    * @brief Check whether object is being actively simulated, or sleeping.
    * See @ref btCollisionObject::isActive.
@@ -105,6 +90,47 @@ class BulletRigidObject : public BulletBase,
    */
   void setActive() override { bObjectRigidBody_->activate(true); }
 
+  /**
+   * @brief Force the object to sleep or to be actively simulated, resetting
+   * its deactivation timer. See @ref btCollisionObject::forceActivationState.
+   * @param sleeping Whether the object should sleep.
+   */
+  void setSleeping(bool sleeping) override {
+    bObjectRigidBody_->forceActivationState(sleeping ? ISLAND_SLEEPING
+                                                     : ACTIVE_TAG);
+    bObjectRigidBody_->setDeactivationTime(0);
+  }
+
+  /**
+   * @brief Detach or reattach the object's motion state, so Bullet does or
+   * does not write the simulated pose to the object's @ref scene::SceneNode
+   * while stepping. Reattaching reads the node's pose back into the body, so
+   * call @ref syncSceneNode first.
+   * @param defer Whether to defer scene node updates to @ref syncSceneNode.
+   */
+  void setDeferSceneNodeSync(bool defer) {
+    bObjectRigidBody_->setMotionState(defer ? nullptr : &(btMotionState()));
+  }
+
+  /**
+   * @brief Write the simulated pose of a @ref MotionType::DYNAMIC or @ref
+   * MotionType::KINEMATIC object to its @ref scene::SceneNode if scene node
+   * updates are deferred. See @ref setDeferSceneNodeSync.
+   */
+  void syncSceneNode();
+
+  /**
+   * @brief Get the pose of the object's rigid body, which is ahead of its
+   * @ref scene::SceneNode while scene node updates are deferred.
+   */
+  core::RigidState getSimulatedRigidState() const;
+
+  /**
+   * @brief Set the pose of the object's rigid body without touching its @ref
+   * scene::SceneNode, which follows on @ref syncSceneNode.
+   */
+  void setSimulatedRigidState(const core::RigidState& rigidState);
+
   /**
    * @brief Set the @ref MotionType of the object. The object can be set to @ref
    * MotionType::STATIC, @ref MotionType::KINEMATIC or @ref MotionType::DYNAMIC.
@@ -380,15 +406,11 @@ class BulletRigidObject : public BulletBase,
   }
 
   /** @brief Set the scalar collision margin of an object. See @ref
-   * btCompoundShape::setMargin.
+   * btCompoundShape::setMargin. Convex shapes shared with other instances are
+   * copied first, so the margin only applies to this object.
    * @param margin The new scalar collision margin of the object.
    */
-  void setMargin(const double margin) override {
-    for (std::size_t i = 0; i < bObjectConvexShapes_.size(); i++) {
-      bObjectConvexShapes_[i]->setMargin(margin);
-    }
-    bObjectShape_->setMargin(margin);
-  }
+  void setMargin(const double margin) override;
 
   /** @brief Sets the object's collision shape to its bounding box.
    * Since the bounding hierarchy is not constructed when the object is
@@ -439,13 +461,28 @@ class BulletRigidObject : public BulletBase,
    * updates. See @ref btRigidBody::setWorldTransform. */
   void syncPose() override;
 
+  /**
+   * @brief Replace convex shapes shared through the @ref
+   * BulletCollisionShapeCache with private copies before they are modified.
+   */
+  void makeConvexShapesUnique();
+
  private:
   // === Physical object ===
   //! If true, the object's bounding box will be used for collision once
   //! computed
   bool usingBBCollisionShape_ = false;
-  //! Object data: Composite convex collision shape
-  std::vector<std::unique_ptr<btConvexHullShape>> bObjectConvexShapes_;
+  //! Cache of convex collision shapes shared between object instances
+  BulletCollisionShapeCache::ptr collisionShapeCache_;
+
+  //! Object data: Composite convex collision shape. Shared with other
+  //! instances of the same collision asset unless @ref
+  //! convexShapesAreShared_ is false.
+  std::vector<std::shared_ptr<btConvexHullShape>> bObjectConvexShapes_;
+
+  //! Whether @ref bObjectConvexShapes_ came from the @ref
+  //! BulletCollisionShapeCache and must be copied before modification.
+  bool convexShapesAreShared_ = false;
 
   //! list of @ref btCollisionShape for storing arbitrary collision shapes
   //! referenced within the @ref bObjectShape_.
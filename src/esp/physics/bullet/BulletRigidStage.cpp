@@ -2,6 +2,10 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
 #include <Magnum/BulletIntegration/DebugDraw.h>
 #include <Magnum/BulletIntegration/Integration.h>
 
@@ -15,6 +19,39 @@
 namespace esp {
 namespace physics {
 
+namespace {
+//! Identifies a stage collision BVH cache file and its layout version.
+constexpr char kBvhCacheMagic[8] = {'E', 'S', 'P', 'B', 'V', 'H', '0', '1'};
+
+//! Header of a stage collision BVH cache file. 16 bytes, so the serialized
+//! BVHs following it stay 16-byte aligned as Bullet requires.
+struct BvhCacheFileHeader {
+  char magic[8];
+  uint32_t numShapes;
+  uint32_t padding;
+};
+
+//! Describes the mesh a serialized BVH was built for, so a stale cache is
+//! detected. 32 bytes, followed by the BVH padded to a multiple of 16 bytes.
+struct BvhCacheEntryHeader {
+  uint32_t numTriangles;
+  uint32_t numVertices;
+  float scaling[3];
+  float margin;
+  uint32_t bvhSize;
+  uint32_t padding;
+};
+
+static_assert(sizeof(BvhCacheFileHeader) % 16 == 0,
+              "BVH cache headers must preserve 16-byte alignment");
+static_assert(sizeof(BvhCacheEntryHeader) % 16 == 0,
+              "BVH cache headers must preserve 16-byte alignment");
+
+std::size_t alignTo16(std::size_t size) {
+  return (size + 15) & ~static_cast<std::size_t>(15);
+}
+}  // namespace
+
 BulletRigidStage::BulletRigidStage(
     scene::SceneNode* rigidBodyNode,
     std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
@@ -41,6 +78,22 @@ bool BulletRigidStage::initialization_LibSpecific(
       resMgr.getMeshMetaData(collisionAssetHandle);
 
   constructBulletSceneFromMeshes(Magnum::Matrix4{}, meshGroup, metaData.root);
+
+  // build each BVH once, after margin and scaling are set, unless a valid
+  // cached copy can be loaded from disk
+  const std::string bvhCacheFilename =
+      initializationAttributes_->getCollisionBvhCacheFilename();
+  if (bvhCacheFilename.empty() || !loadStageBvhs(bvhCacheFilename)) {
+    for (auto& shape : bStageShapes_) {
+      if (!shape->getOptimizedBvh()) {
+        shape->buildOptimizedBvh();
+      }
+    }
+    if (!bvhCacheFilename.empty()) {
+      saveStageBvhs(bvhCacheFilename);
+    }
+  }
+
   for (auto& object : bStaticCollisionObjects_) {
     object->setFriction(initializationAttributes_->getFrictionCoefficient());
     object->setRestitution(
@@ -87,16 +140,16 @@ void BulletRigidStage::constructBulletSceneFromMeshes(
     //! Embed 3D mesh into bullet shape
     //! btBvhTriangleMeshShape is the most generic/slow choice
     //! which allows concavity if the object is static
+    //! The bvh is built once in initialization_LibSpecific, after margin and
+    //! scaling are set.
     std::unique_ptr<btBvhTriangleMeshShape> meshShape =
         std::make_unique<btBvhTriangleMeshShape>(indexedVertexArray.get(),
-                                                 true);
+                                                 true, false);
     meshShape->setMargin(0.04);
-    meshShape->setLocalScaling(
-        btVector3{transformFromLocalToWorld
-                      .scaling()});  // scale is a property of the shape
-
-    // re-build the bvh after setting margin
-    meshShape->buildOptimizedBvh();
+    // scale is a property of the shape. Skip the bvh rebuild of
+    // btBvhTriangleMeshShape::setLocalScaling, since there is none yet.
+    meshShape->btTriangleMeshShape::setLocalScaling(
+        btVector3{transformFromLocalToWorld.scaling()});
     std::unique_ptr<btCollisionObject> sceneCollisionObject =
         std::make_unique<btCollisionObject>();
     sceneCollisionObject->setCollisionShape(meshShape.get());
@@ -115,6 +168,115 @@ void BulletRigidStage::constructBulletSceneFromMeshes(
   }
 }  // constructBulletSceneFromMeshes
 
+bool BulletRigidStage::loadStageBvhs(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  const std::size_t fileSize = file.tellg();
+  if (fileSize < sizeof(BvhCacheFileHeader)) {
+    return false;
+  }
+  // btAlignedObjectArray storage is 16-byte aligned, as the deserialized
+  // BVHs require. The BVHs point into this buffer, so it is kept alive.
+  bStageBvhData_.resize(fileSize);
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char*>(&bStageBvhData_[0]), fileSize)) {
+    return false;
+  }
+
+  BvhCacheFileHeader fileHeader;
+  std::memcpy(&fileHeader, &bStageBvhData_[0], sizeof(fileHeader));
+  if (std::memcmp(fileHeader.magic, kBvhCacheMagic, sizeof(kBvhCacheMagic)) !=
+          0 ||
+      fileHeader.numShapes != bStageShapes_.size()) {
+    LOG(WARNING) << "BulletRigidStage::loadStageBvhs : " << filename
+                 << " does not match this stage, rebuilding collision BVHs.";
+    return false;
+  }
+
+  // validate every entry before attaching any, since an attached BVH can't be
+  // replaced
+  std::vector<std::pair<std::size_t, uint32_t>> bvhRanges;
+  std::size_t offset = sizeof(BvhCacheFileHeader);
+  for (std::size_t i = 0; i < bStageShapes_.size(); ++i) {
+    if (offset + sizeof(BvhCacheEntryHeader) > fileSize) {
+      return false;
+    }
+    BvhCacheEntryHeader entry;
+    std::memcpy(&entry, &bStageBvhData_[offset], sizeof(entry));
+    offset += sizeof(BvhCacheEntryHeader);
+
+    const btIndexedMesh& mesh = bStageArrays_[i]->getIndexedMeshArray()[0];
+    const btVector3& scaling = bStageShapes_[i]->getLocalScaling();
+    if (entry.numTriangles != static_cast<uint32_t>(mesh.m_numTriangles) ||
+        entry.numVertices != static_cast<uint32_t>(mesh.m_numVertices) ||
+        entry.scaling[0] != scaling.x() || entry.scaling[1] != scaling.y() ||
+        entry.scaling[2] != scaling.z() ||
+        entry.margin != bStageShapes_[i]->getMargin() ||
+        offset + entry.bvhSize > fileSize) {
+      LOG(WARNING) << "BulletRigidStage::loadStageBvhs : " << filename
+                   << " is stale, rebuilding collision BVHs.";
+      return false;
+    }
+    bvhRanges.emplace_back(offset, entry.bvhSize);
+    offset += alignTo16(entry.bvhSize);
+  }
+
+  for (std::size_t i = 0; i < bStageShapes_.size(); ++i) {
+    btOptimizedBvh* bvh = static_cast<btOptimizedBvh*>(
+        btOptimizedBvh::deSerializeInPlace(&bStageBvhData_[bvhRanges[i].first],
+                                           bvhRanges[i].second, false));
+    if (bvh == nullptr) {
+      LOG(WARNING) << "BulletRigidStage::loadStageBvhs : " << filename
+                   << " is corrupt, rebuilding collision BVHs.";
+      return false;
+    }
+    bStageShapes_[i]->setOptimizedBvh(bvh, bStageShapes_[i]->getLocalScaling());
+  }
+  return true;
+}  // loadStageBvhs
+
+void BulletRigidStage::saveStageBvhs(const std::string& filename) const {
+  std::ofstream file(filename, std::ios::binary);
+  if (!file) {
+    LOG(WARNING) << "BulletRigidStage::saveStageBvhs : Unable to open "
+                 << filename << " to cache collision BVHs.";
+    return;
+  }
+
+  BvhCacheFileHeader fileHeader{};
+  std::memcpy(fileHeader.magic, kBvhCacheMagic, sizeof(kBvhCacheMagic));
+  fileHeader.numShapes = bStageShapes_.size();
+  file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+
+  btAlignedObjectArray<unsigned char> buffer;
+  for (std::size_t i = 0; i < bStageShapes_.size(); ++i) {
+    const btOptimizedBvh* bvh = bStageShapes_[i]->getOptimizedBvh();
+    const btIndexedMesh& mesh = bStageArrays_[i]->getIndexedMeshArray()[0];
+    const btVector3& scaling = bStageShapes_[i]->getLocalScaling();
+
+    BvhCacheEntryHeader entry{};
+    entry.numTriangles = mesh.m_numTriangles;
+    entry.numVertices = mesh.m_numVertices;
+    entry.scaling[0] = scaling.x();
+    entry.scaling[1] = scaling.y();
+    entry.scaling[2] = scaling.z();
+    entry.margin = bStageShapes_[i]->getMargin();
+    entry.bvhSize = bvh->calculateSerializeBufferSize();
+
+    buffer.resize(alignTo16(entry.bvhSize), 0);
+    bvh->serializeInPlace(&buffer[0], entry.bvhSize, false);
+    file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    file.write(reinterpret_cast<const char*>(&buffer[0]), buffer.size());
+  }
+
+  if (!file) {
+    LOG(WARNING) << "BulletRigidStage::saveStageBvhs : Failed writing "
+                 << filename << ".";
+  }
+}  // saveStageBvhs
+
 void BulletRigidStage::setFrictionCoefficient(
     const double frictionCoefficient) {
   for (std::size_t i = 0; i < bStaticCollisionObjects_.size(); i++) {
@@ -56,6 +56,22 @@ class BulletRigidStage : public BulletBase, public RigidStage {
       const std::vector<assets::CollisionMeshData>& meshGroup,
       const assets::MeshTransformNode& node);
 
+  /**
+   * @brief Attach the BVHs of @ref bStageShapes_ from a cache file written by
+   * @ref saveStageBvhs, deserializing them in place into @ref bStageBvhData_.
+   * @param filename The cache file.
+   * @return true if every shape got its BVH from the file, false if the file
+   * is missing or doesn't match the stage's collision meshes.
+   */
+  bool loadStageBvhs(const std::string& filename);
+
+  /**
+   * @brief Serialize the BVHs of @ref bStageShapes_ into a cache file, so
+   * later loads of the stage can skip building them.
+   * @param filename The cache file.
+   */
+  void saveStageBvhs(const std::string& filename) const;
+
  public:
   /**
    * @brief Query the Aabb from bullet physics for the root compound shape of
@@ -96,6 +112,10 @@ class BulletRigidStage : public BulletBase, public RigidStage {
   //! Stage data: Bullet triangular mesh vertices
   std::vector<std::unique_ptr<btTriangleIndexVertexArray>> bStageArrays_;
 
+  //! Stage data: BVHs deserialized from the collision BVH cache file.
+  //! Referenced by, and so must outlive, @ref bStageShapes_.
+  btAlignedObjectArray<unsigned char> bStageBvhData_;
+
   //! Stage data: Bullet triangular mesh shape
   std::vector<std::unique_ptr<btBvhTriangleMeshShape>> bStageShapes_;
 
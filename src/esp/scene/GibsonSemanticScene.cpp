@@ -86,6 +86,7 @@ bool SemanticScene::
     scene.objects_[id] = std::move(object);
   }
 
+  scene.buildIndices();
   return true;
 }
 
@@ -5,14 +5,22 @@
 #include "Mp3dSemanticScene.h"
 #include "SemanticScene.h"
 
+#include <unistd.h>
 #include <algorithm>
-#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <map>
-#include <sstream>
 #include <string>
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
+
 #include "esp/io/io.h"
 
+namespace Cr = Corrade;
+
 namespace esp {
 namespace scene {
 
@@ -82,190 +90,643 @@ std::string Mp3dRegionCategory::name(const std::string& mapping) const {
   return kRegionCategoryMap.at(labelCode_);
 }
 
-bool SemanticScene::loadMp3dHouse(
-    const std::string& houseFilename,
-    SemanticScene& scene,
-    const quatf& rotation /* = quatf::FromTwoVectors(-vec3f::UnitZ(),
-                                                       geo::ESP_GRAVITY) */ ) {
-  if (!io::exists(houseFilename)) {
-    LOG(ERROR) << "Could not load file " << houseFilename;
-    return false;
-  }
+namespace {
 
-  const bool hasWorldRotation = !rotation.isApprox(quatf::Identity());
+//! The records of a house file the scene is built from, before any rotation
+struct HouseRecords {
+  struct Level {
+    int index;
+    float position[3];
+    float bbox[6];
+  };
+  struct Region {
+    int index;
+    int levelIndex;
+    char labelCode;
+    float position[3];
+    float bbox[6];
+  };
+  struct Category {
+    int index;
+    int mappingIndex;
+    int mpcat40Index;
+    std::string mappingName;
+    std::string mpcat40Name;
+  };
+  struct Object {
+    int index;
+    int regionIndex;
+    int categoryIndex;
+    //! center, first two axes and radius
+    float obb[12];
+  };
+  struct Segment {
+    int objectIndex;
+    int id;
+  };
 
-  auto getVec3f = [&](const std::vector<std::string>& tokens, int offset,
-                      bool applyRotation = true) {
-    const float x = std::stof(tokens[offset]);
-    const float y = std::stof(tokens[offset + 1]);
-    const float z = std::stof(tokens[offset + 2]);
-    vec3f p = vec3f(x, y, z);
-    if (applyRotation && hasWorldRotation) {
-      p = rotation * p;
+  std::string name;
+  std::string label;
+  //! images, panoramas, vertices, surfaces, segments, objects, categories,
+  //! regions, portals and levels
+  int counts[10];
+  float bbox[6];
+  std::vector<Level> levels;
+  std::vector<std::string> levelLabelCodes;
+  std::vector<Region> regions;
+  std::vector<Category> categories;
+  std::vector<Object> objects;
+  std::vector<Segment> segments;
+};
+
+const char* const kCountNames[]{"images",   "panoramas", "vertices",
+                                "surfaces", "segments",  "objects",
+                                "categories", "regions", "portals",
+                                "levels"};
+
+//! A whitespace separated token of a line, viewed in place
+struct Token {
+  const char* begin;
+  const char* end;
+
+  std::string str() const { return {begin, end}; }
+};
+
+//! Most tokens needed from a line, the longest lines parsed have 30
+constexpr int kMaxTokens = 32;
+
+//! Split the line starting at @p cursor, advancing it to the next line
+int tokenizeLine(const char*& cursor, const char* end, Token* tokens) {
+  int count = 0;
+  while (cursor != end && *cursor != '\n') {
+    if (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') {
+      ++cursor;
+      continue;
     }
-    return p;
-  };
+    const char* begin = cursor;
+    while (cursor != end && *cursor != ' ' && *cursor != '\t' &&
+           *cursor != '\r' && *cursor != '\n') {
+      ++cursor;
+    }
+    if (count < kMaxTokens) {
+      tokens[count++] = {begin, cursor};
+    }
+  }
+  if (cursor != end) {
+    ++cursor;
+  }
+  return count;
+}
 
-  auto getBBox = [&](const std::vector<std::string>& tokens, int offset) {
-    return box3f(getVec3f(tokens, offset),
-                 getVec3f(tokens, offset + 3).array().abs().matrix());
-  };
+bool parseInt(const Token& token, int& value) {
+  const char* c = token.begin;
+  const bool negative = c != token.end && *c == '-';
+  if (c != token.end && (*c == '-' || *c == '+')) {
+    ++c;
+  }
+  if (c == token.end) {
+    return false;
+  }
+  int result = 0;
+  for (; c != token.end; ++c) {
+    if (*c < '0' || *c > '9') {
+      return false;
+    }
+    result = result * 10 + (*c - '0');
+  }
+  value = negative ? -result : result;
+  return true;
+}
 
-  auto getOBB = [&](const std::vector<std::string>& tokens, int offset) {
-    const vec3f center = getVec3f(tokens, offset);
+//! Decimal floats as written by the house exporter, with an optional
+//! exponent, accumulated in double precision
+bool parseFloat(const Token& token, float& value) {
+  static const double kPowersOf10[]{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                    1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                    1e18, 1e19, 1e20, 1e21, 1e22};
+  const char* c = token.begin;
+  const bool negative = c != token.end && *c == '-';
+  if (c != token.end && (*c == '-' || *c == '+')) {
+    ++c;
+  }
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  int digits = 0;
+  for (; c != token.end && *c >= '0' && *c <= '9'; ++c, ++digits) {
+    // digits past what a double holds only scale the value
+    if (mantissa < (uint64_t(1) << 53) / 10) {
+      mantissa = mantissa * 10 + (*c - '0');
+    } else {
+      ++exponent;
+    }
+  }
+  if (c != token.end && *c == '.') {
+    for (++c; c != token.end && *c >= '0' && *c <= '9'; ++c, ++digits) {
+      if (mantissa < (uint64_t(1) << 53) / 10) {
+        mantissa = mantissa * 10 + (*c - '0');
+        --exponent;
+      }
+    }
+  }
+  if (digits == 0) {
+    // nan and inf never appear in house files, leave them to the library,
+    // which does not throw on anything else
+    const std::string str = token.str();
+    char* parsedEnd = nullptr;
+    value = std::strtof(str.c_str(), &parsedEnd);
+    return !str.empty() && parsedEnd == str.c_str() + str.size();
+  }
+  if (c != token.end && (*c == 'e' || *c == 'E')) {
+    int explicitExponent;
+    if (!parseInt({c + 1, token.end}, explicitExponent)) {
+      return false;
+    }
+    exponent += explicitExponent;
+    c = token.end;
+  }
+  if (c != token.end) {
+    return false;
+  }
 
-    // Don't need to apply rotation here, it'll already be added in by getVec3f
-    mat3f boxRotation;
-    boxRotation.col(0) << getVec3f(tokens, offset + 3);
-    boxRotation.col(1) << getVec3f(tokens, offset + 6);
-    boxRotation.col(2) << boxRotation.col(0).cross(boxRotation.col(1));
+  double result = double(mantissa);
+  for (; exponent > 22; exponent -= 22) {
+    result *= kPowersOf10[22];
+  }
+  for (; exponent < -22; exponent += 22) {
+    result /= kPowersOf10[22];
+  }
+  result = exponent >= 0 ? result * kPowersOf10[exponent]
+                         : result / kPowersOf10[-exponent];
+  value = float(negative ? -result : result);
+  return true;
+}
 
-    // Don't apply the world rotation here, that'll get added by boxRotation
-    const vec3f radius = getVec3f(tokens, offset + 9, /*applyRotation=*/false);
+//! Parse the ASCII house format from a memory mapped file
+bool parseHouse(const std::string& houseFilename, HouseRecords& records) {
+  const Cr::Containers::Array<const char, Cr::Utility::Directory::MapDeleter>
+      data = Cr::Utility::Directory::mapRead(houseFilename);
+  if (!data) {
+    LOG(ERROR) << "Could not load file " << houseFilename;
+    return false;
+  }
 
-    return geo::OBB(center, 2 * radius, quatf(boxRotation));
-  };
+  const char* cursor = data.begin();
+  const char* const end = data.end();
+  Token tokens[kMaxTokens];
 
-  // open stream and determine house format version
-  std::ifstream ifs = std::ifstream(houseFilename);
-  std::string header;
-  std::getline(ifs, header);
-  if (header != "ASCII 1.1") {
-    LOG(ERROR) << "Unsupported House format header " << header;
+  // determine house format version
+  const char* lineBegin = cursor;
+  int numTokens = tokenizeLine(cursor, end, tokens);
+  if (numTokens != 2 || tokens[0].str() != "ASCII" ||
+      tokens[1].str() != "1.1") {
+    LOG(ERROR) << "Unsupported House format header "
+               << std::string{lineBegin, std::find(lineBegin, end, '\n')};
     return false;
   }
 
-  scene.categories_.clear();
-  scene.levels_.clear();
-  scene.regions_.clear();
-  scene.objects_.clear();
+  auto ints = [&](int first, int count, int* values) {
+    for (int i = 0; i < count; ++i) {
+      if (!parseInt(tokens[first + i], values[i])) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto floats = [&](int first, int count, float* values) {
+    for (int i = 0; i < count; ++i) {
+      if (!parseFloat(tokens[first + i], values[i])) {
+        return false;
+      }
+    }
+    return true;
+  };
 
-  std::string line;
-  while (std::getline(ifs, line)) {
-    if (line.empty()) {
+  while (cursor != end) {
+    lineBegin = cursor;
+    numTokens = tokenizeLine(cursor, end, tokens);
+    if (numTokens == 0 || tokens[0].end - tokens[0].begin != 1) {
       continue;
     }
-    const std::vector<std::string> tokens = io::tokenize(line, " ", 0, true);
-    switch (line[0]) {
+
+    bool valid = true;
+    switch (*tokens[0].begin) {
       case 'H': {  // house
         // H name label #images #panoramas #vertices #surfaces #segments
         //   #objects #categories #regions #portals #levels  0 0 0 0 0
         //   xlo ylo zlo xhi yhi zhi  0 0 0 0 0
-        scene.name_ = tokens[1];
-        scene.label_ = tokens[2];
-        scene.elementCounts_["images"] = std::stoi(tokens[3]);
-        scene.elementCounts_["panoramas"] = std::stoi(tokens[4]);
-        scene.elementCounts_["vertices"] = std::stoi(tokens[5]);
-        scene.elementCounts_["surfaces"] = std::stoi(tokens[6]);
-        scene.elementCounts_["segments"] = std::stoi(tokens[7]);
-        scene.elementCounts_["objects"] = std::stoi(tokens[8]);
-        scene.elementCounts_["categories"] = std::stoi(tokens[9]);
-        scene.elementCounts_["regions"] = std::stoi(tokens[10]);
-        scene.elementCounts_["portals"] = std::stoi(tokens[11]);
-        scene.elementCounts_["levels"] = std::stoi(tokens[12]);
-        scene.bbox_ = getBBox(tokens, 18);
+        valid = numTokens >= 24 && ints(3, 10, records.counts) &&
+                floats(18, 6, records.bbox);
+        if (valid) {
+          records.name = tokens[1].str();
+          records.label = tokens[2].str();
+          records.levels.reserve(records.counts[9]);
+          records.levelLabelCodes.reserve(records.counts[9]);
+          records.regions.reserve(records.counts[7]);
+          records.categories.reserve(records.counts[6]);
+          records.objects.reserve(records.counts[5]);
+          records.segments.reserve(records.counts[4]);
+        }
         break;
       }
       case 'L': {  // level
         // L level_index #regions label  px py pz  xlo ylo zlo xhi yhi zhi  0 0
         //   0 0 0
-        scene.levels_.emplace_back(SemanticLevel::create());
-        auto& level = scene.levels_.back();
-        level->index_ = std::stoi(tokens[1]);
+        HouseRecords::Level level;
         // NOTE tokens[2] is number of regions in level which we don't need
-        level->labelCode_ = tokens[3];
-        level->position_ = getVec3f(tokens, 4);
-        level->bbox_ = getBBox(tokens, 7);
+        valid = numTokens >= 13 && parseInt(tokens[1], level.index) &&
+                floats(4, 3, level.position) && floats(7, 6, level.bbox);
+        if (valid) {
+          records.levels.push_back(level);
+          records.levelLabelCodes.push_back(tokens[3].str());
+        }
         break;
       }
       case 'R': {  // region
         // R region_index level_index 0 0 label  px py pz  xlo ylo zlo xhi yhi
         //   zhi height  0 0 0 0
-        scene.regions_.emplace_back(SemanticRegion::create());
-        auto& region = scene.regions_.back();
-        region->index_ = std::stoi(tokens[1]);
-        region->parentIndex_ = std::stoi(tokens[2]);
-        region->category_ = std::make_shared<Mp3dRegionCategory>(tokens[5][0]);
-        region->position_ = getVec3f(tokens, 6);
-        region->bbox_ = getBBox(tokens, 9);
-        if (region->parentIndex_ >= 0) {
-          region->level_ = scene.levels_[region->parentIndex_];
-          region->level_->regions_.push_back(region);
+        HouseRecords::Region region;
+        valid = numTokens >= 15 && parseInt(tokens[1], region.index) &&
+                parseInt(tokens[2], region.levelIndex) &&
+                floats(6, 3, region.position) && floats(9, 6, region.bbox);
+        if (valid) {
+          region.labelCode = *tokens[5].begin;
+          records.regions.push_back(region);
         }
         break;
       }
-      case 'P': {  // portal or panorama
-        // P portal_index region0_index region1_index label  xlo ylo zlo xhi
-        //   yhi zhi  0 0 0 0
-        // P name  panorama_index region_index 0  px py pz  0 0 0 0 0
-        break;
-      }
-      case 'S': {  // surface
-        // S surface_index region_index 0 label px py pz  nx ny nz  xlo ylo
-        // zlo
-        //   xhi yhi zhi  0 0 0 0 0
-        break;
-      }
-      case 'V': {  // vertex
-        // V vertex_index surface_index label  px py pz  nx ny nz  0 0 0
-        break;
-      }
-      case 'I': {  // image
-        // I image_index panorama_index  name camera_index yaw_index e00 e01
-        //   e02 e03 e10 e11 e12 e13 e20 e21 e22 e23 e30 e31 e32 e33  i00 i01
-        //   i02  i10 i11 i12 i20 i21 i22  width height  px py pz  0 0 0 0 0
-        break;
-      }
       case 'C': {  // category
         // C category_index category_mapping_index category_mapping_name
         //   mpcat40_index mpcat40_name 0 0 0 0 0
-        scene.categories_.emplace_back(std::make_shared<Mp3dObjectCategory>());
-        auto& category =
-            static_cast<Mp3dObjectCategory&>(*scene.categories_.back());
-        category.index_ = std::stoi(tokens[1]);
-        category.categoryMappingIndex_ = std::stoi(tokens[2]);
-        std::string catName = tokens[3];
-        std::replace(catName.begin(), catName.end(), '#', ' ');
-        category.categoryMappingName_ = catName;
-        category.mpcat40Index_ = std::stoi(tokens[4]);
-        category.mpcat40Name_ = tokens[5];
+        HouseRecords::Category category;
+        valid = numTokens >= 6 && parseInt(tokens[1], category.index) &&
+                parseInt(tokens[2], category.mappingIndex) &&
+                parseInt(tokens[4], category.mpcat40Index);
+        if (valid) {
+          category.mappingName = tokens[3].str();
+          std::replace(category.mappingName.begin(),
+                       category.mappingName.end(), '#', ' ');
+          category.mpcat40Name = tokens[5].str();
+          records.categories.emplace_back(std::move(category));
+        }
         break;
       }
       case 'O': {  // object
         // O object_index region_index category_index px py pz  a0x a0y a0z
         //   a1x a1y a1z  r0 r1 r2 0 0 0 0 0 0 0 0
-        scene.objects_.emplace_back(SemanticObject::create());
-        auto& object = scene.objects_.back();
-        object->index_ = std::stoi(tokens[1]);
-        object->parentIndex_ = std::stoi(tokens[2]);
-        int categoryIndex = std::stoi(tokens[3]);
-        if (categoryIndex < 0) {  // no category
-          object->category_ = std::make_shared<Mp3dObjectCategory>();
-        } else {
-          object->category_ = scene.categories_[categoryIndex];
-        }
-        object->obb_ = getOBB(tokens, 4);
-        if (object->parentIndex_ >= 0) {
-          object->region_ = scene.regions_[object->parentIndex_];
-          object->region_->objects_.push_back(object);
+        HouseRecords::Object object;
+        valid = numTokens >= 16 && parseInt(tokens[1], object.index) &&
+                parseInt(tokens[2], object.regionIndex) &&
+                parseInt(tokens[3], object.categoryIndex) &&
+                floats(4, 12, object.obb);
+        if (valid) {
+          records.objects.push_back(object);
         }
         break;
       }
       case 'E': {  // segment
         // E segment_index object_index id area px py pz xlo ylo zlo xhi yhi
         // zhi 0 0 0 0 0
-        const int objectIndex = std::stoi(tokens[2]);
-        const int segmentId = std::stoi(tokens[3]);
-        // NOTE: segmentId = regionIndex * 1000000 + segmentId
-        scene.segmentToObjectIndex_[segmentId] = objectIndex;
+        HouseRecords::Segment segment;
+        valid = numTokens >= 4 && parseInt(tokens[2], segment.objectIndex) &&
+                parseInt(tokens[3], segment.id);
+        if (valid) {
+          records.segments.push_back(segment);
+        }
         break;
       }
       default: {
+        // portals, panoramas, surfaces, vertices and images are not needed
         break;
       }
     }
+
+    if (!valid) {
+      LOG(ERROR) << "Invalid line \""
+                 << std::string{lineBegin, std::find(lineBegin, end, '\n')}
+                 << "\" in " << houseFilename;
+      return false;
+    }
+  }
+  return true;
+}  // parseHouse
+
+// the cache is a copy of the records, checked against the house file it was
+// made from
+constexpr char kCacheMagic[8]{'E', 'S', 'P', 'H', 'O', 'U', 'S', 'E'};
+constexpr uint32_t kCacheVersion = 1;
+
+struct CacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t padding;
+  uint64_t houseSize;
+  int64_t houseModificationTime;
+};
+
+class CacheWriter {
+ public:
+  template <class T>
+  void pod(const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    data_.insert(data_.end(), bytes, bytes + sizeof(T));
+  }
+  template <class T>
+  void pods(const std::vector<T>& values) {
+    pod(uint64_t(values.size()));
+    const char* bytes = reinterpret_cast<const char*>(values.data());
+    data_.insert(data_.end(), bytes, bytes + values.size() * sizeof(T));
+  }
+  void string(const std::string& value) {
+    pod(uint64_t(value.size()));
+    data_.insert(data_.end(), value.begin(), value.end());
+  }
+  const std::vector<char>& data() const { return data_; }
+
+ private:
+  std::vector<char> data_;
+};
+
+class CacheReader {
+ public:
+  explicit CacheReader(Cr::Containers::ArrayView<const char> data)
+      : data_{data} {}
+
+  template <class T>
+  bool pod(T& value) {
+    if (offset_ + sizeof(T) > data_.size()) {
+      return false;
+    }
+    std::memcpy(&value, data_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+  template <class T>
+  bool pods(std::vector<T>& values) {
+    uint64_t size;
+    if (!pod(size) || size > (data_.size() - offset_) / sizeof(T)) {
+      return false;
+    }
+    values.resize(size);
+    std::memcpy(values.data(), data_.data() + offset_, size * sizeof(T));
+    offset_ += size * sizeof(T);
+    return true;
+  }
+  bool string(std::string& value) {
+    uint64_t size;
+    if (!pod(size) || size > data_.size() - offset_) {
+      return false;
+    }
+    value.assign(data_.data() + offset_, size);
+    offset_ += size;
+    return true;
+  }
+  bool atEnd() const { return offset_ == data_.size(); }
+
+ private:
+  Cr::Containers::ArrayView<const char> data_;
+  std::size_t offset_ = 0;
+};
+
+CacheHeader makeCacheHeader(const std::string& houseFilename) {
+  CacheHeader header{};
+  std::copy(std::begin(kCacheMagic), std::end(kCacheMagic), header.magic);
+  header.version = kCacheVersion;
+  header.houseSize = io::fileSize(houseFilename);
+  header.houseModificationTime = io::modificationTime(houseFilename);
+  return header;
+}
+
+//! Read the records from a cache, if it is there and up to date
+bool readHouseCache(const std::string& cacheFilename,
+                    const std::string& houseFilename,
+                    HouseRecords& records) {
+  if (!io::exists(cacheFilename)) {
+    return false;
+  }
+  const Cr::Containers::Array<const char, Cr::Utility::Directory::MapDeleter>
+      data = Cr::Utility::Directory::mapRead(cacheFilename);
+  if (!data) {
+    return false;
+  }
+  CacheReader reader{data};
+  CacheHeader header;
+  const CacheHeader expected = makeCacheHeader(houseFilename);
+  if (!reader.pod(header) ||
+      !std::equal(std::begin(kCacheMagic), std::end(kCacheMagic),
+                  header.magic) ||
+      header.version != expected.version ||
+      header.houseSize != expected.houseSize ||
+      header.houseModificationTime != expected.houseModificationTime) {
+    VLOG(1) << "Ignoring outdated house cache " << cacheFilename;
+    return false;
+  }
+
+  uint64_t numCategories = 0;
+  bool valid = reader.string(records.name) && reader.string(records.label) &&
+               reader.pod(records.counts) && reader.pod(records.bbox) &&
+               reader.pods(records.levels) && reader.pods(records.regions) &&
+               reader.pods(records.objects) && reader.pods(records.segments) &&
+               reader.pod(numCategories);
+  records.levelLabelCodes.resize(valid ? records.levels.size() : 0);
+  for (std::string& labelCode : records.levelLabelCodes) {
+    valid = valid && reader.string(labelCode);
+  }
+  for (uint64_t i = 0; valid && i < numCategories; ++i) {
+    HouseRecords::Category category;
+    valid = reader.pod(category.index) && reader.pod(category.mappingIndex) &&
+            reader.pod(category.mpcat40Index) &&
+            reader.string(category.mappingName) &&
+            reader.string(category.mpcat40Name);
+    records.categories.emplace_back(std::move(category));
+  }
+  // the scene is built trusting the indices, negative ones meaning none
+  auto inRange = [](int index, std::size_t size) {
+    return index < int64_t(size);
+  };
+  for (const HouseRecords::Region& region : records.regions) {
+    valid = valid && inRange(region.levelIndex, records.levels.size());
+  }
+  for (const HouseRecords::Object& object : records.objects) {
+    valid = valid && inRange(object.regionIndex, records.regions.size()) &&
+            inRange(object.categoryIndex, records.categories.size());
+  }
+  if (!valid || !reader.atEnd()) {
+    LOG(WARNING) << "Ignoring corrupted house cache " << cacheFilename;
+    records = HouseRecords{};
+    return false;
+  }
+  return true;
+}  // readHouseCache
+
+void writeHouseCache(const std::string& cacheFilename,
+                     const std::string& houseFilename,
+                     const HouseRecords& records) {
+  CacheWriter writer;
+  writer.pod(makeCacheHeader(houseFilename));
+  writer.string(records.name);
+  writer.string(records.label);
+  writer.pod(records.counts);
+  writer.pod(records.bbox);
+  writer.pods(records.levels);
+  writer.pods(records.regions);
+  writer.pods(records.objects);
+  writer.pods(records.segments);
+  writer.pod(uint64_t(records.categories.size()));
+  for (const std::string& labelCode : records.levelLabelCodes) {
+    writer.string(labelCode);
+  }
+  for (const HouseRecords::Category& category : records.categories) {
+    writer.pod(category.index);
+    writer.pod(category.mappingIndex);
+    writer.pod(category.mpcat40Index);
+    writer.string(category.mappingName);
+    writer.string(category.mpcat40Name);
+  }
+
+  // written aside and renamed, so concurrent loaders never see half of it
+  const std::string tmpFilename =
+      cacheFilename + "." + std::to_string(getpid()) + ".tmp";
+  const std::vector<char>& data = writer.data();
+  if (!Cr::Utility::Directory::write(
+          tmpFilename,
+          Cr::Containers::ArrayView<const char>{data.data(), data.size()}) ||
+      std::rename(tmpFilename.c_str(), cacheFilename.c_str()) != 0) {
+    LOG(WARNING) << "Could not write house cache " << cacheFilename;
+    std::remove(tmpFilename.c_str());
+  }
+}  // writeHouseCache
+
+}  // namespace
+
+bool SemanticScene::loadMp3dHouse(
+    const std::string& houseFilename,
+    SemanticScene& scene,
+    const quatf& rotation /* = quatf::FromTwoVectors(-vec3f::UnitZ(),
+                                                       geo::ESP_GRAVITY) */,
+    bool useCache /* = false */) {
+  if (!io::exists(houseFilename)) {
+    LOG(ERROR) << "Could not load file " << houseFilename;
+    return false;
+  }
+
+  HouseRecords records{};
+  const std::string cacheFilename = houseFilename + ".cache";
+  if (!useCache || !readHouseCache(cacheFilename, houseFilename, records)) {
+    if (!parseHouse(houseFilename, records)) {
+      return false;
+    }
+    if (useCache) {
+      writeHouseCache(cacheFilename, houseFilename, records);
+    }
+  }
+
+  const bool hasWorldRotation = !rotation.isApprox(quatf::Identity());
+
+  auto getVec3f = [&](const float* values, bool applyRotation = true) {
+    vec3f p = vec3f(values[0], values[1], values[2]);
+    if (applyRotation && hasWorldRotation) {
+      p = rotation * p;
+    }
+    return p;
+  };
+
+  auto getBBox = [&](const float* values) {
+    return box3f(getVec3f(values), getVec3f(values + 3).array().abs().matrix());
+  };
+
+  auto getOBB = [&](const float* values) {
+    const vec3f center = getVec3f(values);
+
+    // Don't need to apply rotation here, it'll already be added in by getVec3f
+    mat3f boxRotation;
+    boxRotation.col(0) << getVec3f(values + 3);
+    boxRotation.col(1) << getVec3f(values + 6);
+    boxRotation.col(2) << boxRotation.col(0).cross(boxRotation.col(1));
+
+    // Don't apply the world rotation here, that'll get added by boxRotation
+    const vec3f radius = getVec3f(values + 9, /*applyRotation=*/false);
+
+    return geo::OBB(center, 2 * radius, quatf(boxRotation));
+  };
+
+  scene.categories_.clear();
+  scene.levels_.clear();
+  scene.regions_.clear();
+  scene.objects_.clear();
+
+  scene.name_ = records.name;
+  scene.label_ = records.label;
+  for (int i = 0; i < 10; ++i) {
+    scene.elementCounts_[kCountNames[i]] = records.counts[i];
+  }
+  scene.bbox_ = getBBox(records.bbox);
+
+  scene.levels_.reserve(records.levels.size());
+  for (size_t i = 0; i < records.levels.size(); ++i) {
+    const HouseRecords::Level& record = records.levels[i];
+    scene.levels_.emplace_back(SemanticLevel::create());
+    auto& level = scene.levels_.back();
+    level->index_ = record.index;
+    level->labelCode_ = records.levelLabelCodes[i];
+    level->position_ = getVec3f(record.position);
+    level->bbox_ = getBBox(record.bbox);
+  }
+
+  scene.regions_.reserve(records.regions.size());
+  for (const HouseRecords::Region& record : records.regions) {
+    scene.regions_.emplace_back(SemanticRegion::create());
+    auto& region = scene.regions_.back();
+    region->index_ = record.index;
+    region->parentIndex_ = record.levelIndex;
+    region->category_ = std::make_shared<Mp3dRegionCategory>(record.labelCode);
+    region->position_ = getVec3f(record.position);
+    region->bbox_ = getBBox(record.bbox);
+    if (region->parentIndex_ >= 0) {
+      region->level_ = scene.levels_[region->parentIndex_];
+      region->level_->regions_.push_back(region);
+    }
+  }
+
+  scene.categories_.reserve(records.categories.size());
+  for (HouseRecords::Category& record : records.categories) {
+    scene.categories_.emplace_back(std::make_shared<Mp3dObjectCategory>());
+    auto& category =
+        static_cast<Mp3dObjectCategory&>(*scene.categories_.back());
+    category.index_ = record.index;
+    category.categoryMappingIndex_ = record.mappingIndex;
+    category.categoryMappingName_ = std::move(record.mappingName);
+    category.mpcat40Index_ = record.mpcat40Index;
+    category.mpcat40Name_ = std::move(record.mpcat40Name);
+  }
+
+  scene.objects_.reserve(records.objects.size());
+  for (const HouseRecords::Object& record : records.objects) {
+    scene.objects_.emplace_back(SemanticObject::create());
+    auto& object = scene.objects_.back();
+    object->index_ = record.index;
+    object->parentIndex_ = record.regionIndex;
+    if (record.categoryIndex < 0) {  // no category
+      object->category_ = std::make_shared<Mp3dObjectCategory>();
+    } else {
+      object->category_ = scene.categories_[record.categoryIndex];
+    }
+    object->obb_ = getOBB(record.obb);
+    if (object->parentIndex_ >= 0) {
+      object->region_ = scene.regions_[object->parentIndex_];
+      object->region_->objects_.push_back(object);
+    }
+  }
+
+  // NOTE: segmentId = regionIndex * 1000000 + segmentId
+  std::vector<std::pair<int, int>> segmentObjectIndices;
+  segmentObjectIndices.reserve(records.segments.size());
+  for (const HouseRecords::Segment& record : records.segments) {
+    segmentObjectIndices.emplace_back(record.id, record.objectIndex);
   }
+  scene.setSegmentObjectIndices(segmentObjectIndices);
 
+  scene.buildIndices();
   return true;
 }
 
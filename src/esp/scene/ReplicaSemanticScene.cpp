@@ -104,6 +104,7 @@ bool SemanticScene::loadReplicaHouse(
     scene.objects_[id] = std::move(object);
   }
 
+  scene.buildIndices();
   return true;
 }
 
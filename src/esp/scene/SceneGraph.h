@@ -10,6 +10,7 @@
 #include "esp/gfx/magnum.h"
 
 #include "SceneNode.h"
+#include "TransformHierarchy.h"
 #include "esp/gfx/DrawableGroup.h"
 #include "esp/gfx/RenderCamera.h"
 
@@ -42,6 +43,12 @@ class SceneGraph {
 
   gfx::RenderCamera& getDefaultRenderCamera() { return defaultRenderCamera_; }
 
+  /**
+   * @brief Get the flattened hierarchy of the nodes under the root node,
+   * which cameras attached to them use to draw
+   */
+  TransformHierarchy& getTransformHierarchy() { return transformHierarchy_; }
+
   /* @brief check if the scene node is the root node of the scene graph.
    */
   static bool isRootNode(SceneNode& node);
@@ -125,6 +132,9 @@ class SceneGraph {
   // user can of course define her own RenderCamera for rendering
   gfx::RenderCamera defaultRenderCamera_;
 
+  // Created after, and so destroyed before, the nodes it flattens
+  TransformHierarchy transformHierarchy_{rootNode_};
+
   // ==== Drawables ====
   // for each scene node in a scene graph,
   // we create a drawable object (e.g., PTexMeshDrawable, InstanceMeshDrawable,
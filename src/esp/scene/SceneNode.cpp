@@ -3,6 +3,10 @@
 // LICENSE file in the root directory of this source tree.
 
 #include "SceneNode.h"
+
+#include <Magnum/SceneGraph/AbstractFeature.h>
+
+#include "TransformHierarchy.h"
 #include "esp/geo/geo.h"
 
 namespace Mn = Magnum;
@@ -10,13 +14,50 @@ namespace Mn = Magnum;
 namespace esp {
 namespace scene {
 
+//! Told by Magnum whenever the absolute transformation of its node changes.
+//! Magnum only tells clean objects, so nodes are cleaned whenever bounds
+//! depending on their transformation are computed.
+class SceneNode::BoundsTracker : public Mn::SceneGraph::AbstractFeature3D {
+ public:
+  explicit BoundsTracker(SceneNode& node)
+      : Mn::SceneGraph::AbstractFeature3D{node}, node_{node} {}
+
+ private:
+  void markDirty() override { node_.markTransformationDirty(); }
+
+  SceneNode& node_;
+};
+
 SceneNode::SceneNode(SceneNode& parent) {
-  setParent(&parent);
+  MagnumObject::setParent(&parent);
   setId(parent.getId());
+  addFeature<BoundsTracker>();
+  setClean();
+  boundsParent_ = &parent;
+  parent.markCumulativeBBDirty();
+  transformHierarchy_ = parent.transformHierarchy_;
+  if (transformHierarchy_ != nullptr) {
+    transformHierarchy_->markStructureDirty();
+  }
 }
 
 SceneNode::SceneNode(MagnumScene& parentNode) {
-  setParent(&parentNode);
+  MagnumObject::setParent(&parentNode);
+  addFeature<BoundsTracker>();
+  setClean();
+}
+
+SceneNode::~SceneNode() {
+  // children are deleted while this node can still be told about it
+  while (children().first() != nullptr) {
+    delete children().first();
+  }
+  if (SceneNode* parent = parentNode()) {
+    parent->markCumulativeBBDirty();
+  }
+  if (transformHierarchy_ != nullptr) {
+    transformHierarchy_->markStructureDirty();
+  }
 }
 
 SceneNode& SceneNode::createChild() {
@@ -26,26 +67,130 @@ SceneNode& SceneNode::createChild() {
   return *node;
 }
 
-//! @brief recursively compute the cumulative bounding box of this node's tree.
-const Mn::Range3D& SceneNode::computeCumulativeBB() {
-  // first copy from your precomputed mesh bb
-  cumulativeBB_ = Mn::Range3D(meshBB_);
-  auto* child = children().first();
+SceneNode* SceneNode::parentNode() const {
+  // the parent of the root node is the scene itself
+  const MagnumObject* parent = this->parent();
+  if (parent == nullptr || parent->isScene()) {
+    return nullptr;
+  }
+  return const_cast<SceneNode*>(static_cast<const SceneNode*>(parent));
+}
 
-  while (child != nullptr) {
-    SceneNode* child_node = dynamic_cast<SceneNode*>(child);
-    if (child_node != nullptr) {
-      child_node->computeCumulativeBB();
+SceneNode& SceneNode::setParent(SceneNode* parent) {
+  MagnumObject::setParent(parent);
+  updateParent();
+  return *this;
+}
 
-      Mn::Range3D transformedBB = esp::geo::getTransformedBB(
-          child_node->cumulativeBB_, child_node->transformation());
+void SceneNode::updateParent() {
+  SceneNode* parent = parentNode();
+  if (boundsParent_ == parent) {
+    return;
+  }
+  // attached elsewhere, the previous parent lost it and the new one gained it
+  if (boundsParent_ != nullptr) {
+    boundsParent_->markCumulativeBBDirty();
+  }
+  if (parent != nullptr) {
+    parent->markCumulativeBBDirty();
+  }
+  boundsParent_ = parent;
+  reattachTransformHierarchy(parent != nullptr ? parent->transformHierarchy_
+                                               : nullptr);
+}
 
-      cumulativeBB_ = Mn::Math::join(cumulativeBB_, transformedBB);
-    }
-    child = child->nextSibling();
+void SceneNode::markTransformationDirty() {
+  absoluteAABBDirty_ = true;
+  SceneNode* parent = parentNode();
+  if (boundsParent_ != parent) {
+    updateParent();
+  } else if (transformHierarchy_ != nullptr) {
+    transformHierarchy_->markDirty(*this);
   }
-  return cumulativeBB_;
+  if (parent != nullptr) {
+    parent->markCumulativeBBDirty();
+  }
+}
+
+void SceneNode::reattachTransformHierarchy(TransformHierarchy* hierarchy) {
+  if (transformHierarchy_ != nullptr) {
+    transformHierarchy_->markStructureDirty();
+  }
+  if (hierarchy != nullptr) {
+    hierarchy->markStructureDirty();
+  }
+  // the whole subtree moved, without Magnum necessarily telling it
+  preOrderTraversalWithCallback(*this, [hierarchy](SceneNode& node) {
+    node.transformHierarchy_ = hierarchy;
+    node.transformHierarchyIndex_ = ID_UNDEFINED;
+    node.absoluteAABBDirty_ = true;
+  });
 }
 
+void SceneNode::markCumulativeBBDirty() {
+  SceneNode* node = this;
+  while (node != nullptr && !node->cumulativeBBDirty_) {
+    node->cumulativeBBDirty_ = true;
+    node = node->parentNode();
+  }
+}
+
+void SceneNode::setMeshBB(Mn::Range3D meshBB) {
+  meshBB_ = std::move(meshBB);
+  hasMeshBB_ = true;
+  absoluteAABBDirty_ = true;
+  markCumulativeBBDirty();
+}
+
+const Mn::Range3D& SceneNode::getCumulativeBB() const {
+  if (!cumulativeBBDirty_) {
+    return cumulativeBB_;
+  }
+
+  // first copy from your precomputed mesh bb
+  cumulativeBB_ = meshBB_;
+  for (const MagnumObject& child : children()) {
+    auto& childNode =
+        const_cast<SceneNode&>(static_cast<const SceneNode&>(child));
+    // in case it was attached here without being told
+    childNode.updateParent();
+    const Mn::Range3D transformedBB = geo::getTransformedBB(
+        childNode.getCumulativeBB(), childNode.transformationMatrix());
+    cumulativeBB_ = Mn::Math::join(cumulativeBB_, transformedBB);
+    // so that moving the child invalidates this box again
+    childNode.setClean();
+  }
+  cumulativeBBDirty_ = false;
+  return cumulativeBB_;
+}  // SceneNode::getCumulativeBB
+
+Corrade::Containers::Optional<Mn::Range3D> SceneNode::getAbsoluteAABB() const {
+  if (aabb_) {
+    return aabb_;
+  }
+  if (!hasMeshBB_) {
+    return Corrade::Containers::NullOpt;
+  }
+  if (absoluteAABBDirty_) {
+    // reuse the flattened hierarchy when it was just updated, as for culling
+    // right after computing the transformations of the drawables
+    const int index = transformHierarchy_ != nullptr &&
+                              transformHierarchy_->isClean()
+                          ? transformHierarchy_->indexOf(*this)
+                          : ID_UNDEFINED;
+    if (index != ID_UNDEFINED) {
+      absoluteMeshBB_ = geo::getTransformedBB(
+          meshBB_, transformHierarchy_->getAbsoluteTransformation(index));
+    } else {
+      // cleaning also gets the next change of the transformation reported
+      const_cast<SceneNode&>(*this).setClean();
+      absoluteMeshBB_ =
+          geo::getTransformedBB(meshBB_, absoluteTransformationMatrix());
+    }
+    absoluteAABBDirty_ = false;
+  }
+  return absoluteMeshBB_;
+}  // SceneNode::getAbsoluteAABB
+
 }  // namespace scene
 }  // namespace esp
@@ -21,6 +21,7 @@ namespace esp {
 namespace scene {
 
 class SceneGraph;
+class TransformHierarchy;
 
 // Future types may include e.g., "LIGHT"
 enum class SceneNodeType {
@@ -39,6 +40,7 @@ class SceneNode : public MagnumObject {
   // terminate node (e.g., "MagnumScene" defined in SceneGraph) as its ancestor
   SceneNode() = delete;
   SceneNode(SceneNode& parent);
+  ~SceneNode() override;
 
   // get the type of the attached object
   SceneNodeType getType() const { return type_; }
@@ -56,6 +58,19 @@ class SceneNode : public MagnumObject {
   //! NOTE: child node inherits parent id by default
   SceneNode& createChild();
 
+  //! attach this node to another parent, or detach it with nullptr, and
+  //! update the bounds and flattened hierarchies of both trees, see
+  //! @ref updateParent
+  SceneNode& setParent(SceneNode* parent);
+
+  //! update the cumulative bounding boxes of the previous and current parents
+  //! and move the subtree to the flattened hierarchy of the current tree, if
+  //! the parent changed since the last call. Magnum only tells a node it was
+  //! reparented if its transformation was clean, so this has to be called
+  //! after setting the parent through @ref MagnumObject::setParent, as
+  //! @ref setParent and the Python parent property do
+  void updateParent();
+
   //! Returns node id
   virtual int getId() const { return id_; }
 
@@ -72,24 +87,28 @@ class SceneNode : public MagnumObject {
     return this->absoluteTransformation().translation();
   }
 
-  //! recursively compute the cumulative bounding box of the full scene graph
-  //! tree for which this node is the root
-  const Magnum::Range3D& computeCumulativeBB();
+  //! compute the cumulative bounding box of the full scene graph tree for
+  //! which this node is the root. Only the subtrees changed since the last
+  //! computation are visited, see @ref getCumulativeBB
+  const Magnum::Range3D& computeCumulativeBB() { return getCumulativeBB(); }
 
   //! return the local bounding box for meshes stored at this node
   const Magnum::Range3D& getMeshBB() const { return meshBB_; };
 
-  //! return the global bounding box for the mesh stored at this node
-  Corrade::Containers::Optional<Magnum::Range3D> getAbsoluteAABB() const {
-    return aabb_;
-  };
+  //! return the global bounding box for the mesh stored at this node: the one
+  //! set for a static mesh, else the mesh bounding box transformed by the
+  //! current absolute transformation, recomputed only when that changed.
+  //! NullOpt if no mesh bounding box was set
+  Corrade::Containers::Optional<Magnum::Range3D> getAbsoluteAABB() const;
 
   //! return the cumulative bounding box of the full scene graph tree for which
-  //! this node is the root
-  const Magnum::Range3D& getCumulativeBB() const { return cumulativeBB_; };
+  //! this node is the root, in the frame of this node. Transformation and
+  //! mesh bounding box changes mark the path to the root dirty, and only
+  //! dirty nodes are recomputed
+  const Magnum::Range3D& getCumulativeBB() const;
 
   //! set local bounding box for meshes stored at this node
-  void setMeshBB(Magnum::Range3D meshBB) { meshBB_ = std::move(meshBB); };
+  void setMeshBB(Magnum::Range3D meshBB);
 
   //! set the global bounding box for mesh stored in this node
   void setAbsoluteAABB(Magnum::Range3D aabb) { aabb_ = std::move(aabb); };
@@ -100,12 +119,37 @@ class SceneNode : public MagnumObject {
   //! set frustum plane in last frame that culls this node
   void setFrustumPlaneIndex(int index) { frustumPlaneIndex = index; };
 
+  //! return the flattened hierarchy this node mirrors its transformation
+  //! into, nullptr if none
+  TransformHierarchy* getTransformHierarchy() const {
+    return transformHierarchy_;
+  }
+
  protected:
+  class BoundsTracker;
+
+  //! the transformation of this node or of an ancestor changed, or this node
+  //! was attached to another parent while its transformation was clean
+  void markTransformationDirty();
+
+  //! mark the cumulative bounding boxes of this node and its ancestors dirty,
+  //! up to the first one already dirty
+  void markCumulativeBBDirty();
+
+  //! this node was attached to a parent in another tree, or in the same one:
+  //! move its subtree to that tree's hierarchy, or nullptr if none
+  void reattachTransformHierarchy(TransformHierarchy* hierarchy);
+
+  //! the parent as a scene node, nullptr for the root node
+  SceneNode* parentNode() const;
+
   // DO not make the following constructor public!
   // it can ONLY be called from SceneGraph class to initialize the scene graph
   friend class SceneGraph;
   SceneNode(MagnumScene& parentNode);
 
+  friend class TransformHierarchy;
+
   // the type of the attached object (e.g., sensor, agent etc.)
   SceneNodeType type_ = SceneNodeType::EMPTY;
   int id_ = ID_UNDEFINED;
@@ -116,10 +160,26 @@ class SceneNode : public MagnumObject {
 
   //! the local bounding box for meshes stored at this node
   Magnum::Range3D meshBB_;
+  bool hasMeshBB_ = false;
 
   //! the cumulative bounding box of the full scene graph tree for which this
-  //! node is the root
-  Magnum::Range3D cumulativeBB_;
+  //! node is the root, valid unless cumulativeBBDirty_
+  mutable Magnum::Range3D cumulativeBB_;
+  mutable bool cumulativeBBDirty_ = true;
+
+  //! the mesh bounding box in world space, for nodes without a static aabb_,
+  //! valid unless absoluteAABBDirty_
+  mutable Magnum::Range3D absoluteMeshBB_;
+  mutable bool absoluteAABBDirty_ = true;
+
+  //! the parent the cumulative bounding box of which this node was last
+  //! counted in, to invalidate it when the node is attached elsewhere
+  SceneNode* boundsParent_ = nullptr;
+
+  //! the flattened hierarchy of the tree this node is in, inherited from the
+  //! parent, and the index of this node in it
+  TransformHierarchy* transformHierarchy_ = nullptr;
+  int transformHierarchyIndex_ = ID_UNDEFINED;
 
   //! the global bounding box for *static* meshes stored at this node
   //  NOTE: this is different from the local bounding box meshBB_ defined above:
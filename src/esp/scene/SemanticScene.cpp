@@ -0,0 +1,119 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "SemanticScene.h"
+
+#include <algorithm>
+
+#include <Corrade/Utility/Assert.h>
+
+namespace Cr = Corrade;
+
+namespace esp {
+namespace scene {
+
+constexpr int SemanticScene::SegmentBlockSize;
+
+void SemanticScene::buildIndices() {
+  spatialIndex_.build(objects_, regions_);
+
+  objectToCategoryIndex_.assign(objects_.size(), ID_UNDEFINED);
+  for (size_t i = 0; i < objects_.size(); ++i) {
+    // some scenes leave holes in the object indices
+    if (objects_[i] != nullptr && objects_[i]->category() != nullptr) {
+      objectToCategoryIndex_[i] = objects_[i]->category()->index();
+    }
+  }
+}
+
+void SemanticScene::setSegmentObjectIndices(
+    const std::vector<std::pair<int, int>>& segmentObjectIndices) {
+  // the size of each block is one past its largest segment id
+  std::vector<int> blockSizes;
+  for (const auto& segment : segmentObjectIndices) {
+    if (segment.first < 0) {
+      LOG(WARNING) << "SemanticScene::setSegmentObjectIndices: ignoring "
+                      "negative segment id "
+                   << segment.first;
+      continue;
+    }
+    const size_t block = segment.first / SegmentBlockSize;
+    if (block >= blockSizes.size()) {
+      blockSizes.resize(block + 1, 0);
+    }
+    blockSizes[block] =
+        std::max(blockSizes[block], segment.first % SegmentBlockSize + 1);
+  }
+
+  segmentBlockOffsets_.assign(1, 0);
+  for (int blockSize : blockSizes) {
+    segmentBlockOffsets_.push_back(segmentBlockOffsets_.back() + blockSize);
+  }
+  segmentObjectIndices_.assign(segmentBlockOffsets_.back(), ID_UNDEFINED);
+  for (const auto& segment : segmentObjectIndices) {
+    if (segment.first >= 0) {
+      segmentObjectIndices_[segmentBlockOffsets_[segment.first /
+                                                 SegmentBlockSize] +
+                            segment.first % SegmentBlockSize] = segment.second;
+    }
+  }
+}  // SemanticScene::setSegmentObjectIndices
+
+std::unordered_map<int, int> SemanticScene::getSemanticIndexMap() const {
+  std::unordered_map<int, int> semanticIndexMap;
+  for (size_t block = 0; block + 1 < segmentBlockOffsets_.size(); ++block) {
+    for (int offset = segmentBlockOffsets_[block];
+         offset < segmentBlockOffsets_[block + 1]; ++offset) {
+      if (segmentObjectIndices_[offset] != ID_UNDEFINED) {
+        semanticIndexMap[block * SegmentBlockSize + offset -
+                         segmentBlockOffsets_[block]] =
+            segmentObjectIndices_[offset];
+      }
+    }
+  }
+  return semanticIndexMap;
+}
+
+void SemanticScene::semanticIndicesToObjectIndices(
+    Cr::Containers::ArrayView<const uint32_t> maskIndices,
+    Cr::Containers::ArrayView<int32_t> objectIndices) const {
+  CORRADE_ASSERT(maskIndices.size() == objectIndices.size(),
+                 "SemanticScene::semanticIndicesToObjectIndices: expected "
+                 "buffers of the same size", );
+  const size_t numBlocks = segmentBlockOffsets_.size() - 1;
+  const int* offsets = segmentBlockOffsets_.data();
+  const int* indices = segmentObjectIndices_.data();
+  const size_t size = maskIndices.size();
+  // most frames are a few objects over many pixels, and most scenes a single
+  // block of ids, so the lookups stay in cache
+  for (size_t i = 0; i < size; ++i) {
+    const uint32_t maskIndex = maskIndices[i];
+    const uint32_t block = maskIndex / SegmentBlockSize;
+    const int offset = (block < numBlocks ? offsets[block] : 0) +
+                       maskIndex % SegmentBlockSize;
+    objectIndices[i] = block < numBlocks && offset < offsets[block + 1]
+                           ? indices[offset]
+                           : ID_UNDEFINED;
+  }
+}
+
+void SemanticScene::objectIndicesToCategoryIndices(
+    Cr::Containers::ArrayView<const int32_t> objectIndices,
+    Cr::Containers::ArrayView<int32_t> categoryIndices) const {
+  CORRADE_ASSERT(objectIndices.size() == categoryIndices.size(),
+                 "SemanticScene::objectIndicesToCategoryIndices: expected "
+                 "buffers of the same size", );
+  const uint32_t numObjects = objectToCategoryIndex_.size();
+  const int* table = objectToCategoryIndex_.data();
+  const size_t size = objectIndices.size();
+  for (size_t i = 0; i < size; ++i) {
+    // negative indices wrap around past the table
+    const uint32_t objectIndex = objectIndices[i];
+    categoryIndices[i] =
+        objectIndex < numObjects ? table[objectIndex] : ID_UNDEFINED;
+  }
+}
+
+}  // namespace scene
+}  // namespace esp
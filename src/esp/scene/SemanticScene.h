@@ -8,10 +8,14 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <Corrade/Containers/ArrayView.h>
+
 #include "esp/core/esp.h"
 #include "esp/geo/OBB.h"
+#include "esp/scene/SemanticSpatialIndex.h"
 
 namespace esp {
 namespace scene {
@@ -66,20 +70,57 @@ class SemanticScene {
     return objects_;
   }
 
-  const std::unordered_map<int, int>& getSemanticIndexMap() const {
-    return segmentToObjectIndex_;
-  }
+  //! segment ids are grouped in blocks of this many, one per region
+  static constexpr int SegmentBlockSize = 1000000;
+
+  //! return the map from semantic mesh mask index to object index, built
+  //! from the dense lookup tables
+  std::unordered_map<int, int> getSemanticIndexMap() const;
 
   //! convert semantic mesh mask index to object index or ID_UNDEFINED if
   //! not mapped
   inline int semanticIndexToObjectIndex(int maskIndex) const {
-    if (segmentToObjectIndex_.count(maskIndex) > 0) {
-      return segmentToObjectIndex_.at(maskIndex);
-    } else {
+    if (maskIndex < 0) {
       return ID_UNDEFINED;
     }
+    const size_t block = maskIndex / SegmentBlockSize;
+    if (block + 1 >= segmentBlockOffsets_.size()) {
+      return ID_UNDEFINED;
+    }
+    const int offset =
+        segmentBlockOffsets_[block] + maskIndex % SegmentBlockSize;
+    return offset < segmentBlockOffsets_[block + 1]
+               ? segmentObjectIndices_[offset]
+               : ID_UNDEFINED;
   }
 
+  //! convert a buffer of semantic mesh mask indices to object indices, or
+  //! ID_UNDEFINED for those not mapped. The buffers may be the same
+  void semanticIndicesToObjectIndices(
+      Corrade::Containers::ArrayView<const uint32_t> maskIndices,
+      Corrade::Containers::ArrayView<int32_t> objectIndices) const;
+
+  //! return the category index of each object, under the default mapping,
+  //! or ID_UNDEFINED for objects without a category
+  const std::vector<int>& getObjectToCategoryIndex() const {
+    return objectToCategoryIndex_;
+  }
+
+  //! convert a buffer of object indices to category indices under the
+  //! default mapping, or ID_UNDEFINED for invalid objects and objects without
+  //! a category. The buffers may be the same
+  void objectIndicesToCategoryIndices(
+      Corrade::Containers::ArrayView<const int32_t> objectIndices,
+      Corrade::Containers::ArrayView<int32_t> categoryIndices) const;
+
+  //! return the spatial index over the objects and regions, built when the
+  //! scene is loaded
+  const SemanticSpatialIndex& spatialIndex() const { return spatialIndex_; }
+
+  //! rebuild the spatial index and the object to category lookup, needed
+  //! only after changing the objects or regions of a loaded scene
+  void buildIndices();
+
   //! load SemanticScene from a Gibson house format file
   static bool loadGibsonHouse(
       const std::string& filename,
@@ -87,12 +128,16 @@ class SemanticScene {
       const quatf& rotation = quatf::FromTwoVectors(-vec3f::UnitZ(),
                                                     geo::ESP_GRAVITY));
 
-  //! load SemanticScene from a Matterport3D House format filename
+  //! load SemanticScene from a Matterport3D House format filename. With
+  //! useCache, the parsed file is kept in a binary filename + ".cache" next
+  //! to it, read instead of the house file on later loads while the house
+  //! file is unchanged
   static bool loadMp3dHouse(
       const std::string& filename,
       SemanticScene& scene,
       const quatf& rotation = quatf::FromTwoVectors(-vec3f::UnitZ(),
-                                                    geo::ESP_GRAVITY));
+                                                    geo::ESP_GRAVITY),
+      bool useCache = false);
 
   //! load SemanticScene from a SUNCG house format file
   static bool loadReplicaHouse(
@@ -115,8 +160,19 @@ class SemanticScene {
   std::vector<std::shared_ptr<SemanticLevel>> levels_;
   std::vector<std::shared_ptr<SemanticRegion>> regions_;
   std::vector<std::shared_ptr<SemanticObject>> objects_;
-  //! map from combined region-segment id to objectIndex for semantic mesh
-  std::unordered_map<int, int> segmentToObjectIndex_;
+  //! set the object index of combined region-segment ids of the semantic
+  //! mesh, as (segment id, object index) pairs
+  void setSegmentObjectIndices(
+      const std::vector<std::pair<int, int>>& segmentObjectIndices);
+
+  //! object index of each combined region-segment id, a dense array per
+  //! block of segment ids one after the other
+  std::vector<int> segmentObjectIndices_;
+  //! offset of each block of segment ids in segmentObjectIndices_, plus the
+  //! end of the last one
+  std::vector<int> segmentBlockOffsets_{0};
+  std::vector<int> objectToCategoryIndex_;
+  SemanticSpatialIndex spatialIndex_;
 
   ESP_SMART_POINTERS(SemanticScene)
 };
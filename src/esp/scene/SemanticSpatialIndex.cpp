@@ -0,0 +1,277 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "SemanticSpatialIndex.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+#include <Magnum/EigenIntegration/Integration.h>
+#include <Magnum/Math/Intersection.h>
+#include <Magnum/Math/Range.h>
+
+#include "SemanticScene.h"
+
+namespace Mn = Magnum;
+
+namespace esp {
+namespace scene {
+
+namespace {
+
+//! Most items in a leaf, testing a few boxes beats descending further
+constexpr int LeafSize = 4;
+
+Mn::Range3D toRange(const box3f& box) {
+  return {Mn::Vector3{box.min()}, Mn::Vector3{box.max()}};
+}
+
+//! Whether an oriented box is on the inner side of every plane of a frustum
+bool obbInFrustum(const geo::OBB& obb, const Mn::Frustum& frustum) {
+  const mat3f axes = obb.rotation().toRotationMatrix();
+  const vec3f center = obb.center();
+  const vec3f halfExtents = obb.halfExtents();
+  for (const Mn::Vector4& plane : frustum) {
+    const vec3f normal{plane.x(), plane.y(), plane.z()};
+    // the extent of the box along the normal of the plane
+    const float radius =
+        std::abs(normal.dot(axes.col(0))) * halfExtents.x() +
+        std::abs(normal.dot(axes.col(1))) * halfExtents.y() +
+        std::abs(normal.dot(axes.col(2))) * halfExtents.z();
+    if (normal.dot(center) + plane.w() < -radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+void SemanticSpatialIndex::Tree::build(const std::vector<int>& indices,
+                                       const std::vector<box3f>& boxes) {
+  nodes.clear();
+  items.clear();
+  bounds.clear();
+  if (indices.empty()) {
+    return;
+  }
+
+  std::vector<vec3f> centers;
+  centers.reserve(boxes.size());
+  for (const box3f& box : boxes) {
+    centers.push_back(box.center());
+  }
+  std::vector<int> order(indices.size());
+  std::iota(order.begin(), order.end(), 0);
+  nodes.reserve(2 * indices.size() / LeafSize + 1);
+  buildRecursive(order, boxes, centers, 0, order.size());
+
+  items.reserve(order.size());
+  bounds.reserve(order.size());
+  for (int position : order) {
+    items.push_back(indices[position]);
+    bounds.push_back(boxes[position]);
+  }
+}  // SemanticSpatialIndex::Tree::build
+
+int SemanticSpatialIndex::Tree::buildRecursive(
+    std::vector<int>& order,
+    const std::vector<box3f>& boxes,
+    const std::vector<vec3f>& centers,
+    int begin,
+    int end) {
+  const int nodeIndex = nodes.size();
+  nodes.emplace_back();
+  box3f nodeBounds;
+  box3f centerBounds;
+  for (int i = begin; i < end; ++i) {
+    nodeBounds.extend(boxes[order[i]]);
+    centerBounds.extend(centers[order[i]]);
+  }
+
+  if (end - begin <= LeafSize) {
+    nodes[nodeIndex] = {nodeBounds, begin, end - begin};
+    return nodeIndex;
+  }
+
+  // median split along the axis the centers spread most over
+  int axis;
+  centerBounds.sizes().maxCoeff(&axis);
+  const int middle = (begin + end) / 2;
+  std::nth_element(order.begin() + begin, order.begin() + middle,
+                   order.begin() + end, [&](int a, int b) {
+                     return centers[a][axis] < centers[b][axis];
+                   });
+  buildRecursive(order, boxes, centers, begin, middle);
+  const int secondChild = buildRecursive(order, boxes, centers, middle, end);
+  nodes[nodeIndex] = {nodeBounds, secondChild, 0};
+  return nodeIndex;
+}  // SemanticSpatialIndex::Tree::buildRecursive
+
+template <class NodeVisitor, class ItemVisitor>
+void SemanticSpatialIndex::Tree::traverse(NodeVisitor visitNode,
+                                          ItemVisitor visitLeafItem) const {
+  if (nodes.empty()) {
+    return;
+  }
+  std::vector<int> stack{0};
+  while (!stack.empty()) {
+    const int nodeIndex = stack.back();
+    stack.pop_back();
+    const Node& node = nodes[nodeIndex];
+    if (!visitNode(node.bounds)) {
+      continue;
+    }
+    if (node.count > 0) {
+      for (int position = node.index; position < node.index + node.count;
+           ++position) {
+        visitLeafItem(position);
+      }
+    } else {
+      stack.push_back(node.index);
+      stack.push_back(nodeIndex + 1);
+    }
+  }
+}  // SemanticSpatialIndex::Tree::traverse
+
+void SemanticSpatialIndex::build(
+    const std::vector<std::shared_ptr<SemanticObject>>& objects,
+    const std::vector<std::shared_ptr<SemanticRegion>>& regions) {
+  std::vector<int> indices;
+  std::vector<box3f> boxes;
+  for (size_t i = 0; i < objects.size(); ++i) {
+    if (objects[i] == nullptr) {
+      continue;
+    }
+    const box3f box = objects[i]->aabb();
+    if (!box.isEmpty()) {
+      indices.push_back(i);
+      boxes.push_back(box);
+    }
+  }
+  objects_.build(indices, boxes);
+  objectObbs_.clear();
+  objectObbs_.reserve(objects_.items.size());
+  for (int index : objects_.items) {
+    objectObbs_.push_back(objects[index]->obb());
+  }
+
+  indices.clear();
+  boxes.clear();
+  for (size_t i = 0; i < regions.size(); ++i) {
+    if (regions[i] != nullptr && !regions[i]->aabb().isEmpty()) {
+      indices.push_back(i);
+      boxes.push_back(regions[i]->aabb());
+    }
+  }
+  regions_.build(indices, boxes);
+}  // SemanticSpatialIndex::build
+
+std::vector<int> SemanticSpatialIndex::regionsContaining(
+    const vec3f& point) const {
+  std::vector<int> found;
+  regions_.traverse(
+      [&](const box3f& bounds) { return bounds.contains(point); },
+      [&](int position) {
+        if (regions_.bounds[position].contains(point)) {
+          found.push_back(regions_.items[position]);
+        }
+      });
+  return found;
+}
+
+std::vector<int> SemanticSpatialIndex::objectsContaining(
+    const vec3f& point) const {
+  std::vector<int> found;
+  objects_.traverse(
+      [&](const box3f& bounds) { return bounds.contains(point); },
+      [&](int position) {
+        if (objectObbs_[position].contains(point)) {
+          found.push_back(objects_.items[position]);
+        }
+      });
+  return found;
+}
+
+std::vector<int> SemanticSpatialIndex::objectsWithinRadius(const vec3f& point,
+                                                           float radius) const {
+  std::vector<int> found;
+  const float squaredRadius = radius * radius;
+  objects_.traverse(
+      [&](const box3f& bounds) {
+        return bounds.squaredExteriorDistance(point) <= squaredRadius;
+      },
+      [&](int position) {
+        if (objectObbs_[position].distance(point) <= radius) {
+          found.push_back(objects_.items[position]);
+        }
+      });
+  return found;
+}
+
+std::vector<int> SemanticSpatialIndex::nearestObjects(const vec3f& point,
+                                                      int k) const {
+  if (k <= 0 || objects_.nodes.empty()) {
+    return {};
+  }
+
+  // best first: nodes by the distance to their bounds, which no item inside
+  // can be closer than, and the k closest items so far, farthest on top
+  using Entry = std::pair<float, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> nodes;
+  std::priority_queue<Entry> closest;
+  nodes.emplace(objects_.nodes[0].bounds.exteriorDistance(point), 0);
+  while (!nodes.empty()) {
+    const Entry entry = nodes.top();
+    nodes.pop();
+    if (int(closest.size()) == k && entry.first >= closest.top().first) {
+      break;
+    }
+    const Node& node = objects_.nodes[entry.second];
+    if (node.count > 0) {
+      for (int position = node.index; position < node.index + node.count;
+           ++position) {
+        const float distance = objectObbs_[position].distance(point);
+        if (int(closest.size()) < k) {
+          closest.emplace(distance, position);
+        } else if (distance < closest.top().first) {
+          closest.pop();
+          closest.emplace(distance, position);
+        }
+      }
+    } else {
+      for (int child : {entry.second + 1, node.index}) {
+        nodes.emplace(objects_.nodes[child].bounds.exteriorDistance(point),
+                      child);
+      }
+    }
+  }
+
+  std::vector<int> found(closest.size());
+  for (int i = found.size() - 1; i >= 0; --i) {
+    found[i] = objects_.items[closest.top().second];
+    closest.pop();
+  }
+  return found;
+}  // SemanticSpatialIndex::nearestObjects
+
+std::vector<int> SemanticSpatialIndex::objectsInFrustum(
+    const Mn::Frustum& frustum) const {
+  std::vector<int> found;
+  objects_.traverse(
+      [&](const box3f& bounds) {
+        return Mn::Math::Intersection::rangeFrustum(toRange(bounds), frustum);
+      },
+      [&](int position) {
+        if (obbInFrustum(objectObbs_[position], frustum)) {
+          found.push_back(objects_.items[position]);
+        }
+      });
+  return found;
+}
+
+}  // namespace scene
+}  // namespace esp
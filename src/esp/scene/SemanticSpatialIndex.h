@@ -0,0 +1,136 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_SCENE_SEMANTICSPATIALINDEX_H_
+#define ESP_SCENE_SEMANTICSPATIALINDEX_H_
+
+/** @file
+ * @brief Class @ref esp::scene::SemanticSpatialIndex
+ */
+
+#include <memory>
+#include <vector>
+
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Frustum.h>
+
+#include "esp/core/esp.h"
+#include "esp/geo/OBB.h"
+
+namespace esp {
+namespace scene {
+
+class SemanticObject;
+class SemanticRegion;
+
+/**
+ * @brief Bounding volume hierarchies over the objects and regions of a @ref
+ * SemanticScene, answering spatial queries in logarithmic rather than linear
+ * time.
+ *
+ * Objects are bounded by their oriented boxes and regions by their axis
+ * aligned ones. Queries return indices into @ref SemanticScene::objects and
+ * @ref SemanticScene::regions. The index is a snapshot: it is built once the
+ * scene is loaded and does not follow later changes.
+ */
+class SemanticSpatialIndex {
+ public:
+  /**
+   * @brief Build the index.
+   * @param objects The objects, null ones and those with an empty box being
+   * left out.
+   * @param regions The regions, null ones and those with an empty box being
+   * left out.
+   */
+  void build(const std::vector<std::shared_ptr<SemanticObject>>& objects,
+             const std::vector<std::shared_ptr<SemanticRegion>>& regions);
+
+  /**
+   * @brief Get the regions whose box contains a point.
+   */
+  std::vector<int> regionsContaining(const vec3f& point) const;
+
+  /**
+   * @brief Get the objects whose oriented box contains a point.
+   */
+  std::vector<int> objectsContaining(const vec3f& point) const;
+
+  /**
+   * @brief Get the objects whose oriented box is at most @p radius away from
+   * a point, in no particular order.
+   */
+  std::vector<int> objectsWithinRadius(const vec3f& point, float radius) const;
+
+  /**
+   * @brief Get the @p k objects whose oriented box is closest to a point,
+   * closest first. Objects containing the point are at distance 0.
+   */
+  std::vector<int> nearestObjects(const vec3f& point, int k) const;
+
+  /**
+   * @brief Get the objects whose oriented box intersects a frustum, in no
+   * particular order. The test is conservative: boxes near the corners of
+   * the frustum may be reported without intersecting it.
+   */
+  std::vector<int> objectsInFrustum(const Magnum::Frustum& frustum) const;
+
+  /**
+   * @brief Get the number of objects indexed.
+   */
+  int getNumObjects() const { return objects_.items.size(); }
+
+  /**
+   * @brief Get the number of regions indexed.
+   */
+  int getNumRegions() const { return regions_.items.size(); }
+
+ private:
+  //! A node of a hierarchy, either with two children or with items
+  struct Node {
+    box3f bounds;
+    //! First item of a leaf, or the second child of an inner node, the first
+    //! one following it
+    int index;
+    //! Number of items of a leaf, 0 for an inner node
+    int count;
+  };
+
+  //! A bounding volume hierarchy over boxes
+  struct Tree {
+    std::vector<Node> nodes;
+    //! Index in the scene of each item, in the order of the leaves
+    std::vector<int> items;
+    //! Box of each item, in the order of the leaves
+    std::vector<box3f> bounds;
+
+    //! Build over the boxes of the given scene indices, @p boxes being
+    //! parallel to @p indices
+    void build(const std::vector<int>& indices,
+               const std::vector<box3f>& boxes);
+
+    //! Call @p visitLeafItem(position) for the items of the leaves whose
+    //! bounds @p visitNode accepts
+    template <class NodeVisitor, class ItemVisitor>
+    void traverse(NodeVisitor visitNode, ItemVisitor visitLeafItem) const;
+
+   private:
+    int buildRecursive(std::vector<int>& order,
+                       const std::vector<box3f>& boxes,
+                       const std::vector<vec3f>& centers,
+                       int begin,
+                       int end);
+  };
+
+  Tree objects_;
+  //! Oriented box of each object, in the order of the leaves
+  std::vector<geo::OBB> objectObbs_;
+  Tree regions_;
+
+  ESP_SMART_POINTERS(SemanticSpatialIndex)
+};
+
+}  // namespace scene
+}  // namespace esp
+
+#endif  // ESP_SCENE_SEMANTICSPATIALINDEX_H_
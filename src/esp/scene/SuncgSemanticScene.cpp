@@ -226,6 +226,8 @@ bool SemanticScene::loadSuncgHouse(
 
     iLevel++;
   }  // for level
+
+  scene.buildIndices();
   return true;
 }
 
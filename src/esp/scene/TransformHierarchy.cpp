@@ -0,0 +1,168 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+
+#include <Magnum/SceneGraph/Drawable.h>
+
+#include "SceneNode.h"
+
+namespace Mn = Magnum;
+
+namespace esp {
+namespace scene {
+
+TransformHierarchy::TransformHierarchy(SceneNode& root) : root_{root} {
+  preOrderTraversalWithCallback(root_, [this](SceneNode& node) {
+    node.transformHierarchy_ = this;
+  });
+}
+
+TransformHierarchy::~TransformHierarchy() {
+  // nodes_ may hold deleted nodes until the next update, walk the tree instead
+  preOrderTraversalWithCallback(root_, [this](SceneNode& node) {
+    if (node.transformHierarchy_ == this) {
+      node.transformHierarchy_ = nullptr;
+      node.transformHierarchyIndex_ = ID_UNDEFINED;
+    }
+  });
+}
+
+int TransformHierarchy::indexOf(const SceneNode& node) const {
+  const int index = node.transformHierarchyIndex_;
+  // nodes moved to another tree may still carry an index into this one
+  if (node.transformHierarchy_ != this || index == ID_UNDEFINED ||
+      index >= size() || nodes_[index] != &node) {
+    return ID_UNDEFINED;
+  }
+  return index;
+}
+
+void TransformHierarchy::markDirty(const SceneNode& node) {
+  if (structureDirty_) {
+    // everything is recomputed anyway
+    return;
+  }
+  const int index = indexOf(node);
+  if (index != ID_UNDEFINED) {
+    dirtyRanges_.emplace_back(index, subtreeEnds_[index]);
+  }
+}
+
+void TransformHierarchy::rebuild() {
+  nodes_.clear();
+  parents_.clear();
+  std::vector<std::pair<SceneNode*, int>> stack{{&root_, -1}};
+  while (!stack.empty()) {
+    SceneNode* node = stack.back().first;
+    const int parent = stack.back().second;
+    stack.pop_back();
+
+    const int index = nodes_.size();
+    node->transformHierarchy_ = this;
+    node->transformHierarchyIndex_ = index;
+    nodes_.push_back(node);
+    parents_.push_back(parent);
+    for (MagnumObject& child : node->children()) {
+      stack.emplace_back(static_cast<SceneNode*>(&child), index);
+    }
+  }
+
+  // in depth-first order a subtree ends where the last of its subtrees does
+  const int numNodes = nodes_.size();
+  subtreeEnds_.resize(numNodes);
+  for (int i = 0; i < numNodes; ++i) {
+    subtreeEnds_[i] = i + 1;
+  }
+  for (int i = numNodes - 1; i > 0; --i) {
+    subtreeEnds_[parents_[i]] =
+        std::max(subtreeEnds_[parents_[i]], subtreeEnds_[i]);
+  }
+
+  localTransformations_.resize(numNodes);
+  absoluteTransformations_.resize(numNodes);
+  dirtyRanges_.assign(1, {0, numNodes});
+  structureDirty_ = false;
+}
+
+void TransformHierarchy::update() {
+  if (structureDirty_) {
+    rebuild();
+  }
+  if (dirtyRanges_.empty()) {
+    return;
+  }
+
+  // a moved node also reports all of its descendants, merge nested ranges
+  std::sort(dirtyRanges_.begin(), dirtyRanges_.end());
+  size_t numRanges = 0;
+  for (const std::pair<int, int>& range : dirtyRanges_) {
+    if (numRanges != 0 && range.first <= dirtyRanges_[numRanges - 1].second) {
+      dirtyRanges_[numRanges - 1].second =
+          std::max(dirtyRanges_[numRanges - 1].second, range.second);
+    } else {
+      dirtyRanges_[numRanges++] = range;
+    }
+  }
+  dirtyRanges_.resize(numRanges);
+
+  std::vector<std::reference_wrapper<MagnumObject>> dirtyNodes;
+  for (const std::pair<int, int>& range : dirtyRanges_) {
+    // mirror the local transformations first...
+    for (int i = range.first; i < range.second; ++i) {
+      localTransformations_[i] = nodes_[i]->transformationMatrix();
+    }
+
+    // ...then go through the arrays only, parents come before their children
+    int begin = range.first;
+    if (begin == 0) {
+      absoluteTransformations_[0] = root_.absoluteTransformationMatrix();
+      begin = 1;
+    }
+    for (int i = begin; i < range.second; ++i) {
+      absoluteTransformations_[i] =
+          absoluteTransformations_[parents_[i]] * localTransformations_[i];
+    }
+
+    for (int i = range.first; i < range.second; ++i) {
+      if (nodes_[i]->isDirty()) {
+        dirtyNodes.emplace_back(*nodes_[i]);
+      }
+    }
+  }
+  dirtyRanges_.clear();
+
+  // Magnum only reports changes of clean nodes, so that the next change gets
+  // mirrored the nodes changed since the last update are cleaned in one batch
+  if (!dirtyNodes.empty()) {
+    MagnumObject::setClean(dirtyNodes);
+  }
+}  // TransformHierarchy::update
+
+std::vector<
+    std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>, Mn::Matrix4>>
+TransformHierarchy::drawableTransformations(MagnumDrawableGroup& drawables,
+                                            const Mn::Matrix4& cameraMatrix) {
+  update();
+
+  std::vector<std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
+                        Mn::Matrix4>>
+      drawableTransforms;
+  drawableTransforms.reserve(drawables.size());
+  for (size_t i = 0; i < drawables.size(); ++i) {
+    Mn::SceneGraph::Drawable3D& drawable = drawables[i];
+    const auto& node = static_cast<const SceneNode&>(drawable.object());
+    const int index = indexOf(node);
+    drawableTransforms.emplace_back(
+        drawable, cameraMatrix * (index == ID_UNDEFINED
+                                      ? node.absoluteTransformationMatrix()
+                                      : absoluteTransformations_[index]));
+  }
+  return drawableTransforms;
+}
+
+}  // namespace scene
+}  // namespace esp
@@ -0,0 +1,156 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_SCENE_TRANSFORMHIERARCHY_H_
+#define ESP_SCENE_TRANSFORMHIERARCHY_H_
+
+/** @file
+ * @brief Class @ref esp::scene::TransformHierarchy
+ */
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/SceneGraph/SceneGraph.h>
+
+#include "esp/core/esp.h"
+#include "esp/gfx/magnum.h"
+
+namespace esp {
+namespace scene {
+
+class SceneNode;
+
+/**
+ * @brief Flattened copy of the transformations of a tree of @ref SceneNode,
+ * from which the absolute transformations of all nodes are computed in one
+ * linear pass.
+ *
+ * The nodes are stored in depth-first order, so that every node comes after
+ * its parent and the subtree of every node is a contiguous range. Nodes of
+ * the tree mirror changes into it: a moved node marks the range of its
+ * subtree dirty, and creating, deleting or reparenting a node marks the whole
+ * structure dirty. @ref update then copies the local transformations of the
+ * dirty ranges and multiplies them with the absolute transformation of their
+ * parent, which was computed earlier in the same array.
+ *
+ * The root node has to outlive the hierarchy. A @ref SceneGraph owns one for
+ * its root node, which @ref gfx::RenderCamera::draw uses.
+ */
+class TransformHierarchy {
+ public:
+  /**
+   * @brief Constructor.
+   * @param root The root of the tree. Its subtree is flattened on the first
+   * @ref update.
+   */
+  explicit TransformHierarchy(SceneNode& root);
+  ~TransformHierarchy();
+
+  TransformHierarchy(const TransformHierarchy&) = delete;
+  TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+  /**
+   * @brief Get the root node.
+   */
+  SceneNode& getRoot() const { return root_; }
+
+  /**
+   * @brief Flatten the tree again if its structure changed, then recompute
+   * the absolute transformations of the dirty ranges.
+   */
+  void update();
+
+  /**
+   * @brief Whether the absolute transformations are up to date, i.e. nothing
+   * changed since the last @ref update.
+   */
+  bool isClean() const { return !structureDirty_ && dirtyRanges_.empty(); }
+
+  /**
+   * @brief Get the number of nodes, as of the last @ref update.
+   */
+  int size() const { return nodes_.size(); }
+
+  /**
+   * @brief Get the index of a node, as of the last @ref update, or @ref
+   * ID_UNDEFINED if it was not part of the tree.
+   */
+  int indexOf(const SceneNode& node) const;
+
+  /**
+   * @brief Get the nodes in depth-first order.
+   */
+  const std::vector<SceneNode*>& getNodes() const { return nodes_; }
+
+  /**
+   * @brief Get the index of the parent of each node, -1 for the root.
+   */
+  const std::vector<int>& getParents() const { return parents_; }
+
+  /**
+   * @brief Get the absolute transformation of each node, as of the last
+   * @ref update.
+   */
+  const std::vector<Magnum::Matrix4>& getAbsoluteTransformations() const {
+    return absoluteTransformations_;
+  }
+
+  /**
+   * @brief Get the absolute transformation of the node at an index, as of the
+   * last @ref update.
+   */
+  const Magnum::Matrix4& getAbsoluteTransformation(int index) const {
+    return absoluteTransformations_[index];
+  }
+
+  /**
+   * @brief Bring the hierarchy up to date and compute the transformations of
+   * drawables relative to a camera, as Magnum's
+   * @ref Magnum::SceneGraph::Camera::drawableTransformations does.
+   * @param drawables The drawables. Those attached to nodes outside of the
+   * tree get their transformation computed by Magnum.
+   * @param cameraMatrix The inverse of the absolute transformation of the
+   * camera.
+   */
+  std::vector<std::pair<std::reference_wrapper<Magnum::SceneGraph::Drawable3D>,
+                        Magnum::Matrix4>>
+  drawableTransformations(MagnumDrawableGroup& drawables,
+                          const Magnum::Matrix4& cameraMatrix);
+
+ private:
+  friend class SceneNode;
+
+  //! Called by nodes of the tree whose transformation, or the transformation
+  //! of an ancestor, changed
+  void markDirty(const SceneNode& node);
+
+  //! Called by nodes of the tree which are created, deleted or reparented
+  void markStructureDirty() { structureDirty_ = true; }
+
+  //! Flatten the tree again, all of it is dirty afterwards
+  void rebuild();
+
+  SceneNode& root_;
+
+  std::vector<SceneNode*> nodes_;
+  std::vector<int> parents_;
+  //! One past the last node of the subtree of each node
+  std::vector<int> subtreeEnds_;
+  std::vector<Magnum::Matrix4> localTransformations_;
+  std::vector<Magnum::Matrix4> absoluteTransformations_;
+
+  //! [begin, end) ranges of nodes to recompute, may overlap
+  std::vector<std::pair<int, int>> dirtyRanges_;
+  bool structureDirty_ = true;
+
+  ESP_SMART_POINTERS(TransformHierarchy)
+};
+
+}  // namespace scene
+}  // namespace esp
+
+#endif  // ESP_SCENE_TRANSFORMHIERARCHY_H_
@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 
 #include <Corrade/Utility/Directory.h>
+#include <algorithm>
 #include <string>
 #include "esp/io/io.h"
 #include "esp/scene/SemanticScene.h"
@@ -38,6 +39,48 @@ TEST(GibsonSceneTest, Basic) {
   ASSERT_EQ(object->category()->name(""), "microwave");
 }
 
+TEST(GibsonSceneTest, SpatialIndex) {
+  SemanticScene semanticScene;
+  ASSERT_TRUE(SemanticScene::loadGibsonHouse(houseFilename, semanticScene));
+  const auto& objects = semanticScene.objects();
+  const auto& index = semanticScene.spatialIndex();
+  int numObjects = 0;
+  for (const auto& object : objects) {
+    numObjects += object != nullptr;
+  }
+  ASSERT_EQ(index.getNumObjects(), numObjects);
+
+  for (size_t i = 0; i < objects.size(); ++i) {
+    if (objects[i] == nullptr) {
+      continue;
+    }
+    const esp::vec3f center = objects[i]->obb().center();
+    const auto containing = index.objectsContaining(center);
+    EXPECT_NE(std::find(containing.begin(), containing.end(), i),
+              containing.end());
+    const auto nearest = index.nearestObjects(center, 1);
+    ASSERT_EQ(nearest.size(), 1);
+    EXPECT_EQ(objects[nearest[0]]->obb().distance(center), 0.0f);
+
+    // the same objects as a linear scan
+    const float radius = 1.0f;
+    std::vector<int> expected;
+    for (size_t j = 0; j < objects.size(); ++j) {
+      if (objects[j] && objects[j]->obb().distance(center) <= radius) {
+        expected.push_back(j);
+      }
+    }
+    auto found = index.objectsWithinRadius(center, radius);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, expected);
+  }
+
+  // everything is closer than nothing
+  EXPECT_EQ(index.nearestObjects(esp::vec3f::Zero(), numObjects + 1).size(),
+            numObjects);
+  EXPECT_TRUE(index.nearestObjects(esp::vec3f::Zero(), 0).empty());
+}
+
 const std::string gibsonSemanticFilename =
     Cr::Utility::Directory::join(SCENE_DATASETS, "gibson/Allensville.scn");
 
@@ -2,6 +2,7 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/Math/Algorithms/GramSchmidt.h>
 #include <Magnum/PixelFormat.h>
@@ -110,7 +111,12 @@ void PinholeCamera::drawObservation(sim::Simulator& sim) {
     flags |= gfx::RenderCamera::Flag::FrustumCulling;
 
   gfx::Renderer::ptr renderer = sim.getRenderer();
+  sim.getActiveSceneGraph().getDefaultRenderCamera().setLodPixelError(
+      sim.getLodPixelError());
   if (spec_->sensorType == SensorType::SEMANTIC) {
+    sim.getActiveSemanticSceneGraph()
+        .getDefaultRenderCamera()
+        .setLodPixelError(sim.getLodPixelError());
     // TODO: check sim has semantic scene graph
     renderer->draw(*this, sim.getActiveSemanticSceneGraph(), flags);
     if (&sim.getActiveSemanticSceneGraph() != &sim.getActiveSceneGraph()) {
@@ -121,7 +127,6 @@ void PinholeCamera::drawObservation(sim::Simulator& sim) {
     // SensorType is DEPTH or any other type
     renderer->draw(*this, sim.getActiveSceneGraph(), flags);
   }
-
   renderTarget().renderExit();
 }
 
@@ -141,6 +146,15 @@ void PinholeCamera::readObservation(Observation& obs) {
     renderTarget().readFrameObjectId(Magnum::MutableImageView2D{
         Magnum::PixelFormat::R32UI, renderTarget().framebufferSize(),
         obs.buffer->data});
+    if (semanticProcessor_) {
+      // the framebuffer is read bottom row first
+      const Magnum::Vector2i size = renderTarget().framebufferSize();
+      semanticProcessor_->process(
+          Corrade::Containers::StridedArrayView2D<const uint32_t>{
+              Corrade::Containers::arrayCast<const uint32_t>(obs.buffer->data),
+              {std::size_t(size.y()), std::size_t(size.x())}}
+              .flipped<0>());
+    }
   } else if (spec_->sensorType == SensorType::DEPTH) {
     renderTarget().readFrameDepth(Magnum::MutableImageView2D{
         Magnum::PixelFormat::R32F, renderTarget().framebufferSize(),
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "SemanticProcessor.h"
 #include "VisualSensor.h"
 #include "esp/core/esp.h"
 
@@ -53,6 +54,22 @@ class PinholeCamera : public VisualSensor {
   virtual Corrade::Containers::Optional<Magnum::Vector2> depthUnprojection()
       const override;
 
+  /**
+   * @brief Set the processor run on each observation of a semantic sensor,
+   * as it is read, or nullptr to run none. Ignored for other sensor types.
+   */
+  void setSemanticProcessor(SemanticProcessor::ptr semanticProcessor) {
+    semanticProcessor_ = std::move(semanticProcessor);
+  }
+
+  /**
+   * @brief Get the processor run on each observation, see @ref
+   * setSemanticProcessor.
+   */
+  SemanticProcessor::ptr getSemanticProcessor() const {
+    return semanticProcessor_;
+  }
+
  protected:
   // projection parameters
   int width_ = 640;      // canvas width
@@ -61,6 +78,8 @@ class PinholeCamera : public VisualSensor {
   float far_ = 1000.0f;  // far clipping plane
   float hfov_ = 35.0f;   // field of vision (in degrees)
 
+  SemanticProcessor::ptr semanticProcessor_ = nullptr;
+
   ESP_SMART_POINTERS(PinholeCamera)
 
   /**
@@ -0,0 +1,139 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "SemanticProcessor.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include "esp/scene/SemanticScene.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+namespace esp {
+namespace sensor {
+
+SemanticProcessor::SemanticProcessor(std::vector<int> idToClass,
+                                     int numThreads /* = 1 */)
+    : idToClass_{std::move(idToClass)},
+      numThreads_{std::max(numThreads, 1)},
+      partials_(numThreads_) {
+  for (int classIndex : idToClass_) {
+    numClasses_ = std::max(numClasses_, classIndex + 1);
+  }
+}
+
+std::vector<int> SemanticProcessor::buildIdToClassTable(
+    const scene::SemanticScene& semanticScene,
+    const std::string& mapping /* = "" */) {
+  if (mapping.empty()) {
+    return semanticScene.getObjectToCategoryIndex();
+  }
+  const auto& objects = semanticScene.objects();
+  std::vector<int> idToClass(objects.size(), ID_UNDEFINED);
+  for (size_t id = 0; id < objects.size(); ++id) {
+    // some scenes leave holes in the ids
+    if (objects[id] != nullptr && objects[id]->category() != nullptr) {
+      idToClass[id] = objects[id]->category()->index(mapping);
+    }
+  }
+  return idToClass;
+}
+
+void SemanticProcessor::process(
+    const Cr::Containers::StridedArrayView2D<const uint32_t>& ids) {
+  const int numRows = ids.size()[0];
+  const int numColumns = ids.size()[1];
+  imageSize_ = {numColumns, numRows};
+  classImage_.resize(std::size_t(numRows) * numColumns);
+
+  // few rows per thread are not worth a thread start
+  const int numThreads = std::min(numThreads_, std::max(numRows / 16, 1));
+  if (numThreads == 1) {
+    processRows(ids, 0, numRows, partials_[0]);
+  } else {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int iThread = 1; iThread < numThreads; ++iThread) {
+      threads.emplace_back([&, iThread]() {
+        processRows(ids, numRows * iThread / numThreads,
+                    numRows * (iThread + 1) / numThreads, partials_[iThread]);
+      });
+    }
+    processRows(ids, 0, numRows / numThreads, partials_[0]);
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  // merge what the threads gathered
+  classPixelCounts_ = partials_[0].classPixelCounts;
+  std::vector<Instance>& merged = partials_[0].instances;
+  for (int iThread = 1; iThread < numThreads; ++iThread) {
+    const Partial& partial = partials_[iThread];
+    for (int classIndex = 0; classIndex < numClasses_; ++classIndex) {
+      classPixelCounts_[classIndex] += partial.classPixelCounts[classIndex];
+    }
+    for (size_t id = 0; id < merged.size(); ++id) {
+      const Instance& instance = partial.instances[id];
+      if (instance.pixelCount == 0) {
+        continue;
+      }
+      Instance& mergedInstance = merged[id];
+      mergedInstance.min = Mn::Math::min(mergedInstance.min, instance.min);
+      mergedInstance.max = Mn::Math::max(mergedInstance.max, instance.max);
+      mergedInstance.pixelCount += instance.pixelCount;
+    }
+  }
+  instances_.clear();
+  for (const Instance& instance : merged) {
+    if (instance.pixelCount > 0) {
+      instances_.push_back(instance);
+    }
+  }
+}  // SemanticProcessor::process
+
+void SemanticProcessor::processRows(
+    const Cr::Containers::StridedArrayView2D<const uint32_t>& ids,
+    int rowBegin,
+    int rowEnd,
+    Partial& partial) {
+  const uint32_t numIds = idToClass_.size();
+  partial.classPixelCounts.assign(numClasses_, 0);
+  partial.instances.resize(numIds);
+  for (uint32_t id = 0; id < numIds; ++id) {
+    partial.instances[id] = {id,
+                             idToClass_[id],
+                             Mn::Vector2i{std::numeric_limits<int>::max()},
+                             Mn::Vector2i{std::numeric_limits<int>::min()},
+                             0};
+  }
+
+  const int numColumns = ids.size()[1];
+  for (int row = rowBegin; row < rowEnd; ++row) {
+    const Cr::Containers::StridedArrayView1D<const uint32_t> idRow = ids[row];
+    int* classRow = classImage_.data() + std::size_t(row) * numColumns;
+    for (int column = 0; column < numColumns; ++column) {
+      const uint32_t id = idRow[column];
+      if (id >= numIds) {
+        classRow[column] = ID_UNDEFINED;
+        continue;
+      }
+      const int classIndex = idToClass_[id];
+      classRow[column] = classIndex;
+      if (classIndex != ID_UNDEFINED) {
+        ++partial.classPixelCounts[classIndex];
+      }
+      Instance& instance = partial.instances[id];
+      instance.min = Mn::Math::min(instance.min, Mn::Vector2i{column, row});
+      instance.max = Mn::Math::max(instance.max, Mn::Vector2i{column, row});
+      ++instance.pixelCount;
+    }
+  }
+}  // SemanticProcessor::processRows
+
+}  // namespace sensor
+}  // namespace esp
@@ -0,0 +1,161 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_SENSOR_SEMANTICPROCESSOR_H_
+#define ESP_SENSOR_SEMANTICPROCESSOR_H_
+
+/** @file
+ * @brief Class @ref esp::sensor::SemanticProcessor
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Vector2.h>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace scene {
+class SemanticScene;
+}
+
+namespace sensor {
+
+/**
+ * @brief Post-processing of semantic observations, attached to a semantic
+ * sensor with @ref PinholeCamera::setSemanticProcessor or run on any id
+ * image with @ref process.
+ *
+ * In a single pass over the image, the object id of each pixel is remapped to
+ * a class index through a dense lookup table, and the pixels of each class
+ * are counted and the bounding box of each object instance grown. Rows can be
+ * split across threads.
+ */
+class SemanticProcessor {
+ public:
+  /**
+   * @brief An object instance present in the last processed image.
+   */
+  struct Instance {
+    //! The object id rendered
+    uint32_t id;
+    //! Its class index, or @ref ID_UNDEFINED if it has none
+    int classIndex;
+    //! Top left corner of its bounding box, as column and row, inclusive
+    Magnum::Vector2i min;
+    //! Bottom right corner of its bounding box, as column and row, inclusive
+    Magnum::Vector2i max;
+    //! Number of pixels it covers
+    int pixelCount;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param idToClass The class index of each object id, or @ref ID_UNDEFINED
+   * for objects without a class. Ids past the end of the table are treated
+   * as unannotated: they get no class and no instance.
+   * @param numThreads Number of threads the rows of the image are split
+   * across. 1 processes on the calling thread.
+   */
+  explicit SemanticProcessor(std::vector<int> idToClass, int numThreads = 1);
+
+  /**
+   * @brief Build the lookup table from object id to class index of a
+   * semantic scene. The ids rendered by semantic meshes are the indices of
+   * @ref scene::SemanticScene::objects.
+   * @param semanticScene The scene.
+   * @param mapping The category mapping, see @ref
+   * scene::SemanticCategory::index.
+   */
+  static std::vector<int> buildIdToClassTable(
+      const scene::SemanticScene& semanticScene,
+      const std::string& mapping = "");
+
+  /**
+   * @brief Process an image of object ids.
+   * @param ids The ids, indexed by row then column. May be flipped, i.e.
+   * have negative strides.
+   */
+  void process(const Corrade::Containers::StridedArrayView2D<const uint32_t>&
+                   ids);
+
+  /**
+   * @brief Get the number of classes, one more than the largest class index
+   * in the lookup table.
+   */
+  int getNumClasses() const { return numClasses_; }
+
+  /**
+   * @brief Get the lookup table from object id to class index.
+   */
+  const std::vector<int>& getIdToClass() const { return idToClass_; }
+
+  /**
+   * @brief Get the number of threads the rows are split across.
+   */
+  int getNumThreads() const { return numThreads_; }
+
+  /**
+   * @brief Get the size, as columns and rows, of the last processed image.
+   */
+  Magnum::Vector2i getImageSize() const { return imageSize_; }
+
+  /**
+   * @brief Get the class index of each pixel of the last processed image,
+   * row-major, or @ref ID_UNDEFINED for pixels without a class.
+   */
+  const std::vector<int>& getClassImage() const { return classImage_; }
+
+  /**
+   * @brief Get the number of pixels of each class in the last processed
+   * image.
+   */
+  const std::vector<int>& getClassPixelCounts() const {
+    return classPixelCounts_;
+  }
+
+  /**
+   * @brief Get the object instances present in the last processed image, by
+   * increasing id.
+   */
+  const std::vector<Instance>& getInstances() const { return instances_; }
+
+ private:
+  //! What one thread gathers over its rows
+  struct Partial {
+    std::vector<int> classPixelCounts;
+    //! Bounding boxes and pixel counts, indexed by id
+    std::vector<Instance> instances;
+  };
+
+  //! Process the rows [rowBegin, rowEnd) into a partial result
+  void processRows(const Corrade::Containers::StridedArrayView2D<const uint32_t>&
+                       ids,
+                   int rowBegin,
+                   int rowEnd,
+                   Partial& partial);
+
+  std::vector<int> idToClass_;
+  int numClasses_ = 0;
+  int numThreads_;
+
+  //! One per thread, kept between frames to avoid allocations
+  std::vector<Partial> partials_;
+
+  Magnum::Vector2i imageSize_;
+  std::vector<int> classImage_;
+  std::vector<int> classPixelCounts_;
+  std::vector<Instance> instances_;
+
+  ESP_SMART_POINTERS(SemanticProcessor)
+};
+
+}  // namespace sensor
+}  // namespace esp
+
+#endif  // ESP_SENSOR_SEMANTICPROCESSOR_H_
@@ -44,6 +44,8 @@ Simulator::~Simulator() {
 }
 
 void Simulator::close() {
+  // stop the worker thread before anything it steps is destroyed
+  physicsStepper_ = nullptr;
   pathfinder_ = nullptr;
   navMeshVisPrimID_ = esp::ID_UNDEFINED;
   navMeshVisNode_ = nullptr;
@@ -81,10 +83,42 @@ void Simulator::reconfigure(const SimulatorConfiguration& cfg) {
     reset();
     return;
   }
-  // otherwise set current configuration and initialize
-  // TODO can optimize to do partial re-initialization instead of from-scratch
+  const bool reloadStage =
+      activeSceneID_ == ID_UNDEFINED || !loadsSameStage(cfg, config_);
+  const bool reimportAssets =
+      activeSceneID_ != ID_UNDEFINED && !importsAssetsAlike(cfg, config_);
   config_ = cfg;
 
+  // only affect assets loaded from now on, so are safe to change any time
+  resourceManager_->compressTextures(config_.compressTextures);
+  resourceManager_->setNumImportThreads(config_.assetImportThreads);
+  resourceManager_->setUseBakedAssets(config_.useBakedAssets);
+  resourceManager_->setOptimizeMeshes(config_.optimizeMeshes);
+  // levels of detail are only generated when used, the error threshold itself
+  // is read by the sensors every frame
+  resourceManager_->setMaxNumLods(config_.lodPixelError > 0.0f ? 3 : 0);
+  resourceManager_->setMaxChunkTriangles(config_.maxMeshChunkTriangles);
+  resourceManager_->setTextureMemoryBudget(config_.textureMemoryBudget);
+  resourceManager_->setUseConservativeAbsoluteAABBs(
+      config_.conservativeAbsoluteAABBs);
+  if (reimportAssets) {
+    // the assets loaded so far don't reflect the new settings
+    resourceManager_->unloadFileAssets();
+  }
+
+  if (!reloadStage) {
+    // only agent, sensor or loader settings changed, so keep the scene
+    // graph, physics world, navmesh and semantic scene
+    seed(config_.randomSeed);
+    reset();
+    return;
+  }
+
+  // otherwise initialize the stage from scratch, the GL context, renderer,
+  // shaders and loaded assets are kept
+  // the physics world is replaced, so stop stepping it
+  physicsStepper_ = nullptr;
+
   // use physics attributes manager to get physics manager attributes
   // described by config file - this always exists to configure scene
   // attributes
@@ -160,7 +194,6 @@ void Simulator::reconfigure(const SimulatorConfiguration& cfg) {
     auto& sceneGraph = sceneManager_->getSceneGraph(activeSceneID_);
     auto& rootNode = sceneGraph.getRootNode();
     // auto& drawables = sceneGraph.getDrawables();
-    resourceManager_->compressTextures(config_.compressTextures);
 
     bool loadSuccess = false;
 
@@ -233,7 +266,10 @@ void Simulator::reconfigure(const SimulatorConfiguration& cfg) {
       if (io::exists(houseFilename)) {
         using Corrade::Utility::String::endsWith;
         if (endsWith(houseFilename, ".house")) {
-          scene::SemanticScene::loadMp3dHouse(houseFilename, *semanticScene_);
+          scene::SemanticScene::loadMp3dHouse(
+              houseFilename, *semanticScene_,
+              quatf::FromTwoVectors(-vec3f::UnitZ(), geo::ESP_GRAVITY),
+              config_.cacheSemanticScenes);
         } else if (endsWith(houseFilename, ".scn")) {
           scene::SemanticScene::loadGibsonHouse(houseFilename, *semanticScene_);
         }
@@ -251,6 +287,7 @@ void Simulator::reconfigure(const SimulatorConfiguration& cfg) {
 
 void Simulator::reset() {
   if (physicsManager_ != nullptr) {
+    auto physicsLock = lockPhysics();
     // Note: only resets time to 0 by default.
     physicsManager_->reset();
   }
@@ -281,12 +318,30 @@ scene::SceneGraph& Simulator::getActiveSemanticSceneGraph() {
   return sceneManager_->getSceneGraph(activeSemanticSceneID_);
 }
 
+void Simulator::beginFrame() {
+  // the textures drawn last frame are refined before this one is drawn
+  resourceManager_->getTextureStreamer().update();
+
+  // the worker never writes the scene graph, so once the deferred object
+  // poses are copied in under the lock, drawing can proceed without it
+  auto physicsLock = lockPhysics();
+}
+
 bool operator==(const SimulatorConfiguration& a,
                 const SimulatorConfiguration& b) {
   return a.scene == b.scene && a.defaultAgentId == b.defaultAgentId &&
          a.defaultCameraUuid == b.defaultCameraUuid &&
          a.compressTextures == b.compressTextures &&
+         a.assetImportThreads == b.assetImportThreads &&
+         a.useBakedAssets == b.useBakedAssets &&
+         a.optimizeMeshes == b.optimizeMeshes &&
+         a.lodPixelError == b.lodPixelError &&
+         a.maxMeshChunkTriangles == b.maxMeshChunkTriangles &&
+         a.textureMemoryBudget == b.textureMemoryBudget &&
+         a.conservativeAbsoluteAABBs == b.conservativeAbsoluteAABBs &&
+         a.cacheSemanticScenes == b.cacheSemanticScenes &&
          a.createRenderer == b.createRenderer &&
+         a.frustumCulling == b.frustumCulling &&
          a.enablePhysics == b.enablePhysics &&
          a.physicsConfigFile.compare(b.physicsConfigFile) == 0 &&
          a.loadSemanticMesh == b.loadSemanticMesh &&
@@ -298,6 +353,27 @@ bool operator!=(const SimulatorConfiguration& a,
   return !(a == b);
 }
 
+bool importsAssetsAlike(const SimulatorConfiguration& a,
+                        const SimulatorConfiguration& b) {
+  return a.optimizeMeshes == b.optimizeMeshes &&
+         (a.lodPixelError > 0.0f) == (b.lodPixelError > 0.0f) &&
+         a.maxMeshChunkTriangles == b.maxMeshChunkTriangles &&
+         (a.textureMemoryBudget > 0) == (b.textureMemoryBudget > 0);
+}
+
+bool loadsSameStage(const SimulatorConfiguration& a,
+                    const SimulatorConfiguration& b) {
+  return a.scene == b.scene && a.createRenderer == b.createRenderer &&
+         a.enablePhysics == b.enablePhysics &&
+         a.physicsConfigFile.compare(b.physicsConfigFile) == 0 &&
+         a.loadSemanticMesh == b.loadSemanticMesh &&
+         a.sceneLightSetup.compare(b.sceneLightSetup) == 0 &&
+         a.frustumCulling == b.frustumCulling &&
+         a.conservativeAbsoluteAABBs == b.conservativeAbsoluteAABBs &&
+         a.cacheSemanticScenes == b.cacheSemanticScenes &&
+         importsAssetsAlike(a, b);
+}
+
 // === Physics Simulator Functions ===
 
 int Simulator::addObject(int objectLibIndex,
@@ -305,6 +381,7 @@ int Simulator::addObject(int objectLibIndex,
                          const std::string& lightSetupKey,
                          int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     // TODO: change implementation to support multi-world and physics worlds
     // to own reference to a sceneGraph to avoid this.
     auto& sceneGraph_ = sceneManager_->getSceneGraph(activeSceneID_);
@@ -320,6 +397,7 @@ int Simulator::addObjectByHandle(const std::string& objectLibHandle,
                                  const std::string& lightSetupKey,
                                  int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     // TODO: change implementation to support multi-world and physics worlds
     // to own reference to a sceneGraph to avoid this.
     auto& sceneGraph_ = sceneManager_->getSceneGraph(activeSceneID_);
@@ -342,6 +420,7 @@ const Attrs::ObjectAttributes::cptr Simulator::getObjectInitializationTemplate(
 // return a list of existing objected IDs in a physical scene
 std::vector<int> Simulator::getExistingObjectIDs(const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getExistingObjectIDs();
   }
   return std::vector<int>();  // empty if no simulator exists
@@ -353,6 +432,7 @@ void Simulator::removeObject(const int objectID,
                              bool deleteVisualNode,
                              const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     physicsManager_->removeObject(objectID, deleteObjectNode, deleteVisualNode);
   }
 }
@@ -360,6 +440,7 @@ void Simulator::removeObject(const int objectID,
 esp::physics::MotionType Simulator::getObjectMotionType(const int objectID,
                                                         const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getObjectMotionType(objectID);
   }
   return esp::physics::MotionType::ERROR_MOTIONTYPE;
@@ -369,6 +450,7 @@ bool Simulator::setObjectMotionType(const esp::physics::MotionType& motionType,
                                     const int objectID,
                                     const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->setObjectMotionType(objectID, motionType);
   }
   return false;
@@ -376,8 +458,9 @@ bool Simulator::setObjectMotionType(const esp::physics::MotionType& motionType,
 
 physics::VelocityControl::ptr Simulator::getObjectVelocityControl(
     const int objectID,
-    const int sceneID) const {
+    const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getVelocityControl(objectID);
   }
   return nullptr;
@@ -388,6 +471,7 @@ void Simulator::applyTorque(const Magnum::Vector3& tau,
                             const int objectID,
                             const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     physicsManager_->applyTorque(objectID, tau);
   }
 }
@@ -397,6 +481,7 @@ void Simulator::applyForce(const Magnum::Vector3& force,
                            const int objectID,
                            const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     physicsManager_->applyForce(objectID, force, relPos);
   }
 }
@@ -404,6 +489,7 @@ void Simulator::applyForce(const Magnum::Vector3& force,
 scene::SceneNode* Simulator::getObjectSceneNode(const int objectID,
                                                 const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return &physicsManager_->getObjectSceneNode(objectID);
   }
   return nullptr;
@@ -413,6 +499,7 @@ std::vector<scene::SceneNode*> Simulator::getObjectVisualSceneNodes(
     const int objectID,
     const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getObjectVisualSceneNodes(objectID);
   }
   return std::vector<scene::SceneNode*>();
@@ -423,6 +510,7 @@ void Simulator::setTransformation(const Magnum::Matrix4& transform,
                                   const int objectID,
                                   const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     physicsManager_->setTransformation(objectID, transform);
   }
 }
@@ -430,14 +518,16 @@ void Simulator::setTransformation(const Magnum::Matrix4& transform,
 Magnum::Matrix4 Simulator::getTransformation(const int objectID,
                                              const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getTransformation(objectID);
   }
   return Magnum::Matrix4::fromDiagonal(Magnum::Vector4(1));
 }
 
 esp::core::RigidState Simulator::getRigidState(const int objectID,
-                                               const int sceneID) const {
+                                               const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getRigidState(objectID);
   }
   return esp::core::RigidState();
@@ -447,6 +537,7 @@ void Simulator::setRigidState(const esp::core::RigidState& rigidState,
                               const int objectID,
                               const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     physicsManager_->setRigidState(objectID, rigidState);
   }
 }
@@ -456,6 +547,7 @@ void Simulator::setTranslation(const Magnum::Vector3& translation,
                                const int objectID,
                                const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     physicsManager_->setTranslation(objectID, translation);
   }
 }
@@ -465,6 +557,7 @@ Magnum::Vector3 Simulator::getTranslation(const int objectID,
   // can throw if physicsManager is not initialized or either objectID/sceneID
   // is invalid
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getTranslation(objectID);
   }
   return Magnum::Vector3();
@@ -475,6 +568,7 @@ void Simulator::setRotation(const Magnum::Quaternion& rotation,
                             const int objectID,
                             const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     physicsManager_->setRotation(objectID, rotation);
   }
 }
@@ -482,6 +576,7 @@ void Simulator::setRotation(const Magnum::Quaternion& rotation,
 Magnum::Quaternion Simulator::getRotation(const int objectID,
                                           const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getRotation(objectID);
   }
   return Magnum::Quaternion();
@@ -491,6 +586,7 @@ void Simulator::setLinearVelocity(const Magnum::Vector3& linVel,
                                   const int objectID,
                                   const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->setLinearVelocity(objectID, linVel);
   }
 }
@@ -498,6 +594,7 @@ void Simulator::setLinearVelocity(const Magnum::Vector3& linVel,
 Magnum::Vector3 Simulator::getLinearVelocity(const int objectID,
                                              const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getLinearVelocity(objectID);
   }
   return Magnum::Vector3();
@@ -507,6 +604,7 @@ void Simulator::setAngularVelocity(const Magnum::Vector3& angVel,
                                    const int objectID,
                                    const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->setAngularVelocity(objectID, angVel);
   }
 }
@@ -514,6 +612,7 @@ void Simulator::setAngularVelocity(const Magnum::Vector3& angVel,
 Magnum::Vector3 Simulator::getAngularVelocity(const int objectID,
                                               const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getAngularVelocity(objectID);
   }
   return Magnum::Vector3();
@@ -521,6 +620,7 @@ Magnum::Vector3 Simulator::getAngularVelocity(const int objectID,
 
 bool Simulator::contactTest(const int objectID, const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->contactTest(objectID);
   }
   return false;
@@ -530,6 +630,7 @@ esp::physics::RaycastResults Simulator::castRay(const esp::geo::Ray& ray,
                                                 float maxDistance,
                                                 const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->castRay(ray, maxDistance);
   }
   return esp::physics::RaycastResults();
@@ -539,6 +640,7 @@ void Simulator::setObjectBBDraw(bool drawBB,
                                 const int objectID,
                                 const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     auto& sceneGraph_ = sceneManager_->getSceneGraph(activeSceneID_);
     auto& drawables = sceneGraph_.getDrawables();
     physicsManager_->setObjectBBDraw(objectID, &drawables, drawBB);
@@ -549,12 +651,14 @@ void Simulator::setObjectSemanticId(uint32_t semanticId,
                                     const int objectID,
                                     const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     physicsManager_->setSemanticId(objectID, semanticId);
   }
 }
 
 double Simulator::stepWorld(const double dt) {
-  if (physicsManager_ != nullptr) {
+  // the worker thread steps the world while async physics runs
+  if (physicsManager_ != nullptr && !isAsyncPhysicsRunning()) {
     physicsManager_->stepPhysics(dt);
   }
   return getWorldTime();
@@ -563,13 +667,80 @@ double Simulator::stepWorld(const double dt) {
 // get the simulated world time (0 if no physics enabled)
 double Simulator::getWorldTime() {
   if (physicsManager_ != nullptr) {
+    auto physicsLock = lockPhysics();
     return physicsManager_->getWorldTime();
   }
   return NO_TIME;
 }
 
+bool Simulator::startAsyncPhysics(double realTimeFactor, const int sceneID) {
+  if (!sceneHasPhysics(sceneID)) {
+    return false;
+  }
+  if (physicsStepper_ == nullptr) {
+    physicsStepper_ =
+        physics::FixedRateStepper::create_unique(physicsManager_);
+  }
+  physicsStepper_->start(realTimeFactor);
+  return physicsStepper_->isRunning();
+}
+
+void Simulator::stopAsyncPhysics() {
+  if (physicsStepper_ != nullptr) {
+    physicsStepper_->stop();
+  }
+}
+
+int Simulator::getNumPhysicsSubstepOverruns(const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
+    return physicsManager_->getNumSubstepOverruns();
+  }
+  return 0;
+}
+
+std::unique_lock<std::mutex> Simulator::lockPhysics() {
+  if (!isAsyncPhysicsRunning()) {
+    return std::unique_lock<std::mutex>();
+  }
+  auto physicsLock = physicsStepper_->lock();
+  physicsManager_->syncSceneNodes();
+  return physicsLock;
+}
+
+physics::PhysicsWorldSnapshot::ptr Simulator::savePhysicsSnapshot(
+    const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    auto snapshot = physics::PhysicsWorldSnapshot::create();
+    savePhysicsSnapshot(*snapshot, sceneID);
+    return snapshot;
+  }
+  return nullptr;
+}
+
+bool Simulator::savePhysicsSnapshot(physics::PhysicsWorldSnapshot& snapshot,
+                                    const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
+    physicsManager_->saveSnapshot(snapshot);
+    return true;
+  }
+  return false;
+}
+
+bool Simulator::restorePhysicsSnapshot(
+    const physics::PhysicsWorldSnapshot& snapshot,
+    const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
+    return physicsManager_->restoreSnapshot(snapshot);
+  }
+  return false;
+}
+
 void Simulator::setGravity(const Magnum::Vector3& gravity, const int sceneID) {
   if (sceneHasPhysics(sceneID)) {
+    auto physicsLock = lockPhysics();
     physicsManager_->setGravity(gravity);
   }
 }
@@ -597,6 +768,7 @@ bool Simulator::recomputeNavMesh(nav::PathFinder& pathfinder,
 
   // add STATIC collision objects
   if (includeStaticObjects) {
+    auto physicsLock = lockPhysics();
     for (auto objectID : physicsManager_->getExistingObjectIDs()) {
       if (physicsManager_->getObjectMotionType(objectID) ==
           physics::MotionType::STATIC) {
@@ -752,6 +924,7 @@ bool Simulator::displayObservation(int agentId, const std::string& sensorId) {
   if (ag != nullptr) {
     sensor::Sensor::ptr sensor = ag->getSensorSuite().get(sensorId);
     if (sensor != nullptr) {
+      beginFrame();
       return sensor->displayObservation(*this);
     }
   }
@@ -765,6 +938,7 @@ bool Simulator::getAgentObservation(int agentId,
   if (ag != nullptr) {
     sensor::Sensor::ptr sensor = ag->getSensorSuite().get(sensorId);
     if (sensor != nullptr) {
+      beginFrame();
       return sensor->getObservation(*this, observation);
     }
   }
@@ -779,6 +953,7 @@ int Simulator::getAgentObservations(
   if (ag != nullptr) {
     const std::map<std::string, sensor::Sensor::ptr>& sensors =
         ag->getSensorSuite().getSensors();
+    beginFrame();
     for (std::pair<std::string, sensor::Sensor::ptr> s : sensors) {
       sensor::Observation obs;
       if (s.second->getObservation(*this, obs)) {
@@ -16,6 +16,7 @@
 #include "esp/gfx/RenderTarget.h"
 #include "esp/gfx/WindowlessContext.h"
 #include "esp/nav/PathFinder.h"
+#include "esp/physics/FixedRateStepper.h"
 #include "esp/physics/PhysicsManager.h"
 #include "esp/physics/RigidObject.h"
 #include "esp/scene/SceneConfiguration.h"
@@ -49,6 +50,58 @@ struct SimulatorConfiguration {
   unsigned int randomSeed = 0;
   std::string defaultCameraUuid = "rgba_camera";
   bool compressTextures = false;
+  /**
+   * @brief Number of worker threads decoding scene and object assets during
+   * loading, see @ref assets::ResourceManager::setNumImportThreads. Every
+   * worker parses the asset file itself, so this trades memory for loading
+   * time and is off by default. Negative values pick a default from the
+   * hardware concurrency.
+   */
+  int assetImportThreads = 0;
+  /**
+   * @brief Whether to load meshes from the files baked next to them by
+   * `datatool bake_asset`, see @ref
+   * assets::ResourceManager::setUseBakedAssets.
+   */
+  bool useBakedAssets = true;
+  /**
+   * @brief Whether to reorder stage and object meshes at import for faster
+   * rendering, see @ref assets::ResourceManager::setOptimizeMeshes.
+   */
+  bool optimizeMeshes = false;
+  /**
+   * @brief Largest screen space error, in pixels, of the simplified levels of
+   * detail drawn instead of full meshes, see @ref
+   * gfx::RenderCamera::setLodPixelError. Larger values trade quality for
+   * speed, e.g. 1-2 pixels is hardly visible. 0 disables levels of detail.
+   */
+  float lodPixelError = 0.0f;
+  /**
+   * @brief Number of triangles above which stage and object meshes are split
+   * into chunks culled separately, see @ref
+   * assets::ResourceManager::setMaxChunkTriangles. 0 never splits.
+   */
+  int maxMeshChunkTriangles = 0;
+  /**
+   * @brief GPU memory budget, in bytes, of streamed stage and object
+   * textures, see @ref assets::ResourceManager::setTextureMemoryBudget.
+   * Textures are then uploaded at a low resolution and refined as they are
+   * drawn. 0 uploads every texture at full resolution.
+   */
+  std::size_t textureMemoryBudget = 0;
+  /**
+   * @brief Whether the bounding boxes used to frustum cull the stage are
+   * computed from the bounding box of each mesh rather than every vertex, see
+   * @ref assets::ResourceManager::setUseConservativeAbsoluteAABBs. Loads
+   * large stages faster, but culls less.
+   */
+  bool conservativeAbsoluteAABBs = false;
+  /**
+   * @brief Keep a binary cache next to each Matterport3D house file, loaded
+   * instead of parsing the house file again, see @ref
+   * scene::SemanticScene::loadMp3dHouse.
+   */
+  bool cacheSemanticScenes = false;
   bool createRenderer = true;
   // Whether or not the agent can slide on collisions
   bool allowSliding = true;
@@ -74,6 +127,24 @@ bool operator==(const SimulatorConfiguration& a,
 bool operator!=(const SimulatorConfiguration& a,
                 const SimulatorConfiguration& b);
 
+/**
+ * @brief Whether two configurations import assets alike, i.e. with the same
+ * mesh optimization, chunking, levels of detail and texture streaming. @ref
+ * Simulator::reconfigure imports every asset again when switching between
+ * configurations that don't.
+ */
+bool importsAssetsAlike(const SimulatorConfiguration& a,
+                        const SimulatorConfiguration& b);
+
+/**
+ * @brief Whether two configurations load the same stage, i.e. the same scene
+ * graph, physics world, navmesh and semantic scene. @ref Simulator::reconfigure
+ * switches between such configurations without reloading any of these, only
+ * applying the settings that differ.
+ */
+bool loadsSameStage(const SimulatorConfiguration& a,
+                    const SimulatorConfiguration& b);
+
 class Simulator {
  public:
   explicit Simulator(const SimulatorConfiguration& cfg);
@@ -266,7 +337,7 @@ class Simulator {
    */
   physics::VelocityControl::ptr getObjectVelocityControl(
       const int objectID,
-      const int sceneID = 0) const;
+      const int sceneID = 0);
 
   /**
    * @brief Apply torque to an object. See @ref
@@ -343,7 +414,7 @@ class Simulator {
    * @return The @ref esp::core::RigidState transform of the object.
    */
   esp::core::RigidState getRigidState(const int objectID,
-                                      const int sceneID = 0) const;
+                                      const int sceneID = 0);
 
   /**
    * @brief Set the @ref esp::core::RigidState of an object kinematically.
@@ -516,14 +587,50 @@ class Simulator {
    * animation/simulation/action/etc... Step the physical world forward in time
    * by a desired duration. Note that the actual duration of time passed by this
    * step will depend on simulation time stepping mode (todo). See @ref
-   * esp::physics::PhysicsManager::stepPhysics.
-   * @todo timestepping options?
+   * esp::physics::PhysicsManager::stepPhysics. Does not step while @ref
+   * startAsyncPhysics is in effect.
    * @param dt The desired amount of time to advance the physical world.
    * @return The new world time after stepping. See @ref
    * esp::physics::PhysicsManager::worldTime_.
    */
   double stepWorld(const double dt = 1.0 / 60.0);
 
+  /**
+   * @brief Step the physical world from a worker thread at a fixed wall-clock
+   * rate until @ref stopAsyncPhysics, decoupling stepping from rendering. See
+   * @ref esp::physics::FixedRateStepper. The worker never writes the scene
+   * graph; object scene nodes are brought up to date by @ref beginFrame and
+   * whenever an object is accessed through this class.
+   * @param realTimeFactor Simulated seconds per wall-clock second.
+   * @param sceneID !! Not used currently !! Specifies which physical scene to
+   * step.
+   * @return false if the scene has no physics.
+   */
+  bool startAsyncPhysics(double realTimeFactor = 1.0, const int sceneID = 0);
+
+  /**
+   * @brief Stop stepping started by @ref startAsyncPhysics and bring all
+   * object scene nodes up to date.
+   */
+  void stopAsyncPhysics();
+
+  /**
+   * @brief Whether the physical world is being stepped by @ref
+   * startAsyncPhysics.
+   */
+  bool isAsyncPhysicsRunning() const {
+    return physicsStepper_ != nullptr && physicsStepper_->isRunning();
+  }
+
+  /**
+   * @brief Get the number of fixed timesteps dropped because a step requested
+   * more than the configured maximum number of substeps. See @ref
+   * esp::physics::PhysicsManager::getNumSubstepOverruns.
+   * @param sceneID !! Not used currently !! Specifies which physical scene.
+   * @return The number of dropped timesteps, 0 if the scene has no physics.
+   */
+  int getNumPhysicsSubstepOverruns(const int sceneID = 0);
+
   /**
    * @brief Get the current time in the simulated world. This is always 0 if no
    * @ref esp::physics::PhysicsManager is initialized. See @ref stepWorld. See
@@ -533,6 +640,41 @@ class Simulator {
    */
   double getWorldTime();
 
+  /**
+   * @brief Save the simulation state of all objects in a physical scene. See
+   * @ref esp::physics::PhysicsManager::saveSnapshot.
+   * @param sceneID !! Not used currently !! Specifies which physical scene to
+   * save.
+   * @return The snapshot or nullptr if the scene has no physics.
+   */
+  physics::PhysicsWorldSnapshot::ptr savePhysicsSnapshot(
+      const int sceneID = 0);
+
+  /**
+   * @brief Save the simulation state of all objects in a physical scene into
+   * an existing snapshot, reusing its storage. See @ref
+   * esp::physics::PhysicsManager::saveSnapshot.
+   * @param snapshot The snapshot to overwrite.
+   * @param sceneID !! Not used currently !! Specifies which physical scene to
+   * save.
+   * @return false if the scene has no physics, in which case the snapshot is
+   * untouched.
+   */
+  bool savePhysicsSnapshot(physics::PhysicsWorldSnapshot& snapshot,
+                           const int sceneID = 0);
+
+  /**
+   * @brief Restore a physical scene to a state saved with @ref
+   * savePhysicsSnapshot without re-instancing any objects. See @ref
+   * esp::physics::PhysicsManager::restoreSnapshot.
+   * @param snapshot The snapshot to restore.
+   * @param sceneID !! Not used currently !! Specifies which physical scene to
+   * restore.
+   * @return whether or not the restore was successful.
+   */
+  bool restorePhysicsSnapshot(const physics::PhysicsWorldSnapshot& snapshot,
+                              const int sceneID = 0);
+
   /**
    * @brief Set the gravity in a physical scene.
    */
@@ -614,6 +756,23 @@ class Simulator {
    */
   bool isFrustumCullingEnabled() { return frustumCulling_; }
 
+  /**
+   * @brief Get the largest screen space error, in pixels, allowed when
+   * drawing levels of detail, see @ref SimulatorConfiguration::lodPixelError.
+   */
+  float getLodPixelError() const { return config_.lodPixelError; }
+
+  /**
+   * @brief Prepare the active scene graphs for drawing a frame. Uploads the
+   * finer texture levels drawn since the last frame, within @ref
+   * SimulatorConfiguration::textureMemoryBudget. While @ref
+   * startAsyncPhysics is in effect, copies the simulated object poses into
+   * the scene graph under the physics lock, after which the scene graph can
+   * be drawn without the lock. Called by the observation getters; call it
+   * once before drawing the scene graphs directly.
+   */
+  void beginFrame();
+
   /**
    * @brief Get a named @ref LightSetup
    */
@@ -668,6 +827,13 @@ class Simulator {
     return isValidScene(sceneID) && physicsManager_ != nullptr;
   }
 
+  /**
+   * @brief Get exclusive access to the physical world while @ref
+   * startAsyncPhysics is in effect, with object scene nodes brought up to
+   * date. The returned lock is empty otherwise.
+   */
+  std::unique_lock<std::mutex> lockPhysics();
+
   gfx::WindowlessContext::uptr context_ = nullptr;
   std::shared_ptr<gfx::Renderer> renderer_ = nullptr;
   // CANNOT make the specification of resourceManager_ above the context_!
@@ -687,6 +853,10 @@ class Simulator {
 
   std::shared_ptr<physics::PhysicsManager> physicsManager_ = nullptr;
 
+  //! Steps @ref physicsManager_ from a worker thread, see @ref
+  //! startAsyncPhysics.
+  physics::FixedRateStepper::uptr physicsStepper_ = nullptr;
+
   core::Random::ptr random_;
   SimulatorConfiguration config_;
 
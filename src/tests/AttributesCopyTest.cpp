@@ -0,0 +1,126 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "esp/assets/ResourceManager.h"
+#include "esp/assets/managers/ObjectAttributesManager.h"
+
+namespace Cr = Corrade;
+
+using esp::assets::ResourceManager;
+using esp::assets::attributes::ObjectAttributes;
+
+namespace {
+//! Allocations made by this process, counted for the benchmarks
+std::atomic<std::uint64_t> allocationCount{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++allocationCount;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace Test {
+namespace {
+
+struct AttributesCopyTest : Cr::TestSuite::Tester {
+  explicit AttributesCopyTest();
+
+  void copySharesValues();
+
+  void allocationsBegin();
+  std::uint64_t allocationsEnd();
+
+  void benchmarkTemplateCopy();
+  void benchmarkTemplateCopyEdited();
+
+  ResourceManager resourceManager_;
+  std::uint64_t allocationCountBegin_ = 0;
+};
+
+constexpr const char* TemplateHandle = "copyTestObject";
+
+AttributesCopyTest::AttributesCopyTest() {
+  addTests({&AttributesCopyTest::copySharesValues});
+
+  // clang-format off
+  addCustomBenchmarks({&AttributesCopyTest::benchmarkTemplateCopy,
+                       &AttributesCopyTest::benchmarkTemplateCopyEdited}, 10,
+                      &AttributesCopyTest::allocationsBegin,
+                      &AttributesCopyTest::allocationsEnd,
+                      BenchmarkUnits::Count);
+  // clang-format on
+
+  resourceManager_.getObjectAttributesManager()
+      ->createDefaultAttributesTemplate(TemplateHandle, true);
+}
+
+void AttributesCopyTest::allocationsBegin() {
+  allocationCountBegin_ = allocationCount;
+}
+
+std::uint64_t AttributesCopyTest::allocationsEnd() {
+  return allocationCount - allocationCountBegin_;
+}
+
+void AttributesCopyTest::copySharesValues() {
+  auto mgr = resourceManager_.getObjectAttributesManager();
+  ObjectAttributes::ptr registered = mgr->getTemplateByHandle(TemplateHandle);
+  ObjectAttributes::ptr copy = mgr->getTemplateCopyByHandle(TemplateHandle);
+  CORRADE_VERIFY(copy);
+  CORRADE_VERIFY(copy != registered);
+  CORRADE_VERIFY(copy->sharesValuesWith(*registered));
+  CORRADE_COMPARE(copy->getHandle(), TemplateHandle);
+
+  // editing the copy leaves the registered template as it was
+  const double mass = registered->getMass();
+  copy->setMass(mass + 1.0);
+  CORRADE_VERIFY(!copy->sharesValuesWith(*registered));
+  CORRADE_COMPARE(copy->getMass(), mass + 1.0);
+  CORRADE_COMPARE(registered->getMass(), mass);
+  CORRADE_VERIFY(
+      mgr->getTemplateCopyByHandle(TemplateHandle)->sharesValuesWith(
+          *registered));
+}
+
+void AttributesCopyTest::benchmarkTemplateCopy() {
+  auto mgr = resourceManager_.getObjectAttributesManager();
+
+  // what each added object does to keep its initialization attributes
+  ObjectAttributes::ptr copy;
+  CORRADE_BENCHMARK(1) { copy = mgr->getTemplateCopyByHandle(TemplateHandle); }
+  CORRADE_VERIFY(copy);
+}
+
+void AttributesCopyTest::benchmarkTemplateCopyEdited() {
+  auto mgr = resourceManager_.getObjectAttributesManager();
+
+  ObjectAttributes::ptr copy;
+  CORRADE_BENCHMARK(1) {
+    copy = mgr->getTemplateCopyByHandle(TemplateHandle);
+    copy->setMass(10.0);
+  }
+  CORRADE_COMPARE(copy->getMass(), 10.0);
+}
+
+}  // namespace
+}  // namespace Test
+
+CORRADE_TEST_MAIN(Test::AttributesCopyTest)
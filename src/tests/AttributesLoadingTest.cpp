@@ -0,0 +1,152 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "esp/assets/ResourceManager.h"
+#include "esp/assets/managers/ObjectAttributesManager.h"
+
+namespace Cr = Corrade;
+
+using esp::assets::ResourceManager;
+using esp::assets::attributes::ObjectAttributes;
+
+namespace Test {
+namespace {
+
+struct AttributesLoadingTest : Cr::TestSuite::Tester {
+  explicit AttributesLoadingTest();
+  ~AttributesLoadingTest() override;
+
+  void concurrentMatchesSequential();
+  void invalidFiles();
+
+  void benchmarkSequential();
+  void benchmarkConcurrent();
+
+  //! Write synthetic object configs until there are at least @p count
+  void writeConfigs(std::size_t count);
+
+  std::string directory_;
+  std::vector<std::string> filenames_;
+};
+
+//! Synthetic object configs for the tests, and for the benchmarks, which
+//! only write theirs when run
+constexpr std::size_t NumTestConfigs = 100;
+constexpr std::size_t NumBenchmarkConfigs = 2000;
+
+AttributesLoadingTest::AttributesLoadingTest() {
+  // clang-format off
+  addTests({&AttributesLoadingTest::concurrentMatchesSequential,
+            &AttributesLoadingTest::invalidFiles});
+
+  addBenchmarks({&AttributesLoadingTest::benchmarkSequential,
+                 &AttributesLoadingTest::benchmarkConcurrent}, 5);
+  // clang-format on
+
+  directory_ = Cr::Utility::Directory::join(Cr::Utility::Directory::tmp(),
+                                            "AttributesLoadingTest");
+  Cr::Utility::Directory::mkpath(directory_);
+  writeConfigs(NumTestConfigs);
+}
+
+AttributesLoadingTest::~AttributesLoadingTest() {
+  for (const std::string& filename : filenames_) {
+    Cr::Utility::Directory::rm(filename);
+  }
+  Cr::Utility::Directory::rm(directory_);
+}
+
+void AttributesLoadingTest::writeConfigs(std::size_t count) {
+  while (filenames_.size() < count) {
+    filenames_.push_back(Cr::Utility::Directory::join(
+        directory_,
+        std::to_string(filenames_.size()) + ".phys_properties.json"));
+    Cr::Utility::Directory::writeString(filenames_.back(),
+                                        ObjectAttributes::JSONConfigTestString);
+  }
+}
+
+void AttributesLoadingTest::concurrentMatchesSequential() {
+  const std::vector<std::string> filenames(
+      filenames_.begin(), filenames_.begin() + NumTestConfigs);
+
+  ResourceManager sequentialResourceManager;
+  auto sequentialMgr = sequentialResourceManager.getObjectAttributesManager();
+  std::vector<ObjectAttributes::ptr> expected;
+  for (const std::string& filename : filenames) {
+    expected.push_back(
+        sequentialMgr->createFileBasedAttributesTemplate(filename));
+  }
+
+  ResourceManager resourceManager;
+  auto mgr = resourceManager.getObjectAttributesManager();
+  std::vector<ObjectAttributes::ptr> actual =
+      mgr->createFileBasedAttributesTemplates(filenames, true, 4);
+
+  CORRADE_COMPARE(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    CORRADE_ITERATION(i);
+    CORRADE_VERIFY(actual[i]);
+    CORRADE_COMPARE(actual[i]->getHandle(), expected[i]->getHandle());
+    // registered in order, so with the same ids
+    CORRADE_COMPARE(actual[i]->getID(), expected[i]->getID());
+    CORRADE_COMPARE(actual[i]->getMass(), expected[i]->getMass());
+    CORRADE_COMPARE(actual[i]->getScale(), expected[i]->getScale());
+    CORRADE_COMPARE(actual[i]->getRenderAssetHandle(),
+                    expected[i]->getRenderAssetHandle());
+    CORRADE_VERIFY(mgr->getTemplateLibHasHandle(actual[i]->getHandle()));
+  }
+}
+
+void AttributesLoadingTest::invalidFiles() {
+  const std::string invalid = Cr::Utility::Directory::join(
+      directory_, "invalid.phys_properties.json");
+  Cr::Utility::Directory::writeString(invalid, "{\"mass\": ");
+
+  ResourceManager resourceManager;
+  auto mgr = resourceManager.getObjectAttributesManager();
+  const int numTemplates = mgr->getNumTemplates();
+  std::vector<ObjectAttributes::ptr> attributes =
+      mgr->createFileBasedAttributesTemplates(
+          {filenames_[0], invalid,
+           Cr::Utility::Directory::join(directory_, "missing.json")},
+          true, 2);
+  Cr::Utility::Directory::rm(invalid);
+
+  CORRADE_COMPARE(attributes.size(), 3u);
+  CORRADE_VERIFY(attributes[0]);
+  CORRADE_VERIFY(!attributes[1]);
+  CORRADE_VERIFY(!attributes[2]);
+  CORRADE_COMPARE(mgr->getNumTemplates(), numTemplates + 1);
+}
+
+void AttributesLoadingTest::benchmarkSequential() {
+  writeConfigs(NumBenchmarkConfigs);
+  ResourceManager resourceManager;
+  auto mgr = resourceManager.getObjectAttributesManager();
+
+  CORRADE_BENCHMARK(1) {
+    for (const std::string& filename : filenames_) {
+      mgr->createFileBasedAttributesTemplate(filename);
+    }
+  }
+  CORRADE_VERIFY(mgr->getTemplateLibHasHandle(filenames_.back()));
+}
+
+void AttributesLoadingTest::benchmarkConcurrent() {
+  writeConfigs(NumBenchmarkConfigs);
+  ResourceManager resourceManager;
+  auto mgr = resourceManager.getObjectAttributesManager();
+
+  CORRADE_BENCHMARK(1) { mgr->createFileBasedAttributesTemplates(filenames_); }
+  CORRADE_VERIFY(mgr->getTemplateLibHasHandle(filenames_.back()));
+}
+
+}  // namespace
+}  // namespace Test
+
+CORRADE_TEST_MAIN(Test::AttributesLoadingTest)
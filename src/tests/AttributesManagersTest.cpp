@@ -7,6 +7,7 @@
 
 #include "esp/assets/ResourceManager.h"
 #include "esp/assets/managers/AttributesManagerBase.h"
+#include "esp/assets/managers/TemplateHandleIndex.h"
 
 #include "configure.h"
 
@@ -406,6 +407,8 @@ TEST_F(AttributesManagersTest, AttributesManagers_JSONLoadTest) {
   ASSERT_EQ(stageAttr->getSemanticAssetHandle(), "testJSONSemanticAsset.glb");
   ASSERT_EQ(stageAttr->getNavmeshAssetHandle(), "testJSONNavMeshAsset.glb");
   ASSERT_EQ(stageAttr->getHouseFilename(), "testJSONHouseFileName.glb");
+  ASSERT_EQ(stageAttr->getCollisionBvhCacheFilename(),
+            "testJSONCollisionBvhCache.bvh");
 
   auto objAttr =
       testBuildAttributesFromJSONString<AttrMgrs::ObjectAttributesManager,
@@ -429,6 +432,7 @@ TEST_F(AttributesManagersTest, AttributesManagers_JSONLoadTest) {
   ASSERT_EQ(objAttr->getMass(), 9);
   ASSERT_EQ(objAttr->getBoundingBoxCollisions(), true);
   ASSERT_EQ(objAttr->getJoinCollisionMeshes(), true);
+  ASSERT_EQ(objAttr->getCollisionHullVertexBudget(), 32);
   ASSERT_EQ(objAttr->getInertia(), Magnum::Vector3(1.1, 0.9, 0.3));
   ASSERT_EQ(objAttr->getCOM(), Magnum::Vector3(0.1, 0.2, 0.3));
 
@@ -622,3 +626,84 @@ TEST_F(AttributesManagersTest, PrimitiveAssetAttributesTest) {
         dfltUVSphereAttribs, "segments", legalModValWF, &illegalModValWF);
   }
 }  // AttributesManagersTest::AsssetAttributesManagerGetAndModify test
+
+TEST_F(AttributesManagersTest, TemplateHandleIndex) {
+  AttrMgrs::TemplateHandleIndex index;
+  index.add(0, "data/objects/Chair_01.phys_properties.json");
+  index.add(1, "data/objects/chair_02.phys_properties.json");
+  index.add(2, "data/objects/table.phys_properties.json");
+  index.add(4, "cubeSolid");
+  ASSERT_EQ(index.size(), 4);
+  ASSERT_EQ(index.getHandle(2), "data/objects/table.phys_properties.json");
+  ASSERT_EQ(index.getHandle(3), "");
+
+  // case is ignored, results are ordered by ID
+  std::vector<std::string> chairs = index.getHandlesBySubstring("CHAIR", true);
+  ASSERT_EQ(chairs.size(), 2);
+  ASSERT_EQ(chairs[0], "data/objects/Chair_01.phys_properties.json");
+  // trigrams present in the wrong order do not match
+  ASSERT_EQ(index.getHandlesBySubstring("rahc", true).size(), 0);
+  // short queries, and queries excluding
+  ASSERT_EQ(index.getHandlesBySubstring("ta", true).size(), 1);
+  std::vector<std::string> others = index.getHandlesBySubstring("chair", false);
+  ASSERT_EQ(others.size(), 2);
+  ASSERT_EQ(others[1], "cubeSolid");
+  ASSERT_EQ(index.getHandlesBySubstring("", false).size(), 4);
+
+  // random samples stay within the subset
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_NE(index.getRandomHandle("chair", true).find("hair"),
+              std::string::npos);
+    ASSERT_EQ(index.getRandomHandle("chair", false).find("hair"),
+              std::string::npos);
+  }
+  ASSERT_EQ(index.getRandomHandle("sofa", true), "");
+
+  // the cached results follow changes
+  index.remove(0);
+  index.add(1, "data/objects/sofa.phys_properties.json");
+  ASSERT_EQ(index.getHandlesBySubstring("chair", true).size(), 0);
+  ASSERT_EQ(index.getRandomHandle("sofa", true),
+            "data/objects/sofa.phys_properties.json");
+  ASSERT_EQ(index.getIDs(), (std::vector<int>{1, 2, 4}));
+
+  // re-adding a handle under its own ID keeps it
+  index.add(2, index.getHandle(2));
+  ASSERT_EQ(index.getHandle(2), "data/objects/table.phys_properties.json");
+  ASSERT_EQ(index.getHandlesBySubstring("table", true).size(), 1);
+}  // AttributesManagersTest::TemplateHandleIndex
+
+/**
+ * @brief Test that the keys of attributes stored in slots are read and written
+ * the same through their getters and setters and by name.
+ */
+TEST_F(AttributesManagersTest, AttributesSlotsTest) {
+  ObjectAttributes attributes{"slotsTest"};
+  attributes.setMass(2.5);
+  attributes.setScale({1.0f, 2.0f, 3.0f});
+  ASSERT_EQ(attributes.getDouble("mass"), 2.5);
+  ASSERT_EQ(attributes.getVec3("scale"), Magnum::Vector3(1.0f, 2.0f, 3.0f));
+  ASSERT_EQ(attributes.getString("handle"), "slotsTest");
+
+  // values set by name are converted to the type of the key
+  attributes.set("mass", 3);
+  ASSERT_EQ(attributes.getMass(), 3.0);
+  attributes.setString("isVisible", "false");
+  ASSERT_FALSE(attributes.getIsVisible());
+
+  // keys not in the schema are stored by name
+  ASSERT_FALSE(attributes.hasValue("userKey"));
+  attributes.setInt("userKey", 7);
+  ASSERT_EQ(attributes.getInt("userKey"), 7);
+
+  // removed keys read as default values
+  ASSERT_TRUE(attributes.removeValue("mass"));
+  ASSERT_FALSE(attributes.hasValue("mass"));
+  ASSERT_EQ(attributes.getMass(), 0.0);
+
+  // the group holds the keys of both
+  Cr::Utility::ConfigurationGroup group = attributes.getConfigGroup();
+  ASSERT_EQ(group.value<int>("userKey"), 7);
+  ASSERT_EQ(group.value("handle"), "slotsTest");
+  ASSERT_FALSE(group.hasValue("mass"));
+}  // AttributesManagersTest::AttributesSlotsTest
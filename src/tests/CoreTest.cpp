@@ -18,3 +18,69 @@ TEST(CoreTest, ConfigurationTest) {
   EXPECT_EQ(cfg.get<int>("myInt"), 10);
   EXPECT_EQ(cfg.get<std::string>("myString"), "test");
 }
+
+TEST(CoreTest, ConfigurationCopyOnWriteTest) {
+  Configuration cfg;
+  cfg.set("myInt", 10);
+  Configuration copy = cfg;
+  EXPECT_TRUE(copy.sharesValuesWith(cfg));
+  EXPECT_EQ(copy.get<int>("myInt"), 10);
+
+  // reading or removing a missing value does not copy
+  EXPECT_FALSE(copy.hasValue("myString"));
+  EXPECT_FALSE(copy.removeValue("myString"));
+  EXPECT_TRUE(copy.sharesValuesWith(cfg));
+
+  // the first modification copies, leaving the original unchanged
+  copy.set("myInt", 20);
+  EXPECT_FALSE(copy.sharesValuesWith(cfg));
+  EXPECT_EQ(copy.get<int>("myInt"), 20);
+  EXPECT_EQ(cfg.get<int>("myInt"), 10);
+
+  // the original can be modified once no longer shared
+  Configuration other = cfg;
+  other.addStringToGroup("myStrings", "a");
+  EXPECT_EQ(other.getStringGroup("myStrings").size(), 1u);
+  EXPECT_TRUE(cfg.getStringGroup("myStrings").empty());
+  cfg.removeValue("myInt");
+  EXPECT_FALSE(cfg.hasValue("myInt"));
+  EXPECT_TRUE(other.hasValue("myInt"));
+}
+
+namespace {
+struct SchemaConfiguration : Configuration {
+  enum : int { Count, Name };
+  static const ConfigurationSchema& schema() {
+    static constexpr ConfigurationKey Keys[]{
+        {"count", ConfigurationValueType::Int},
+        {"name", ConfigurationValueType::String}};
+    static const ConfigurationSchema schema{Keys};
+    return schema;
+  }
+  SchemaConfiguration() : Configuration{schema()} {}
+
+  using Configuration::getSlot;
+  using Configuration::setSlot;
+};
+}  // namespace
+
+TEST(CoreTest, ConfigurationSchemaTest) {
+  SchemaConfiguration cfg;
+  EXPECT_FALSE(cfg.hasValue("count"));
+  cfg.setSlot(SchemaConfiguration::Count, 3);
+  EXPECT_TRUE(cfg.hasValue("count"));
+  EXPECT_EQ(cfg.get<int>("count"), 3);
+  EXPECT_EQ(cfg.getString("count"), "3");
+
+  cfg.set("name", "test");
+  EXPECT_EQ(cfg.getSlot<std::string>(SchemaConfiguration::Name), "test");
+  cfg.set("other", 1.5);
+  EXPECT_EQ(cfg.getDouble("other"), 1.5);
+
+  // slots are copied on write as well
+  SchemaConfiguration copy = cfg;
+  copy.setSlot(SchemaConfiguration::Count, 4);
+  EXPECT_EQ(cfg.getSlot<int>(SchemaConfiguration::Count), 3);
+  EXPECT_EQ(copy.getSlot<int>(SchemaConfiguration::Count), 4);
+  EXPECT_EQ(copy.getDouble("other"), 1.5);
+}
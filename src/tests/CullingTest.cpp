@@ -2,12 +2,16 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 //
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/EigenIntegration/Integration.h>
 #include <Magnum/GL/SampleQuery.h>
+#ifndef MAGNUM_TARGET_GLES
+#include <Magnum/GL/PrimitiveQuery.h>
+#endif
 #include <Magnum/Math/Frustum.h>
 #include <Magnum/Math/Intersection.h>
 #include <Magnum/Math/Range.h>
@@ -37,16 +41,29 @@ struct CullingTest : Cr::TestSuite::Tester {
   // tests
   void computeAbsoluteAABB();
   void frustumCulling();
+  void chunkedFrustumCulling();
+};
+
+const struct {
+  const char* name;
+  bool conservative;
+} ComputeAbsoluteAABBData[]{
+    {"", false},
+    // the boxes are exact for cubes, whose vertices are the box corners
+    {"conservative", true},
 };
 
 CullingTest::CullingTest() {
-  // clang-format off
-  addTests({&CullingTest::computeAbsoluteAABB,
-            &CullingTest::frustumCulling});
-  // clang-format on
+  addInstancedTests({&CullingTest::computeAbsoluteAABB},
+                    Cr::Containers::arraySize(ComputeAbsoluteAABBData));
+  addTests({&CullingTest::frustumCulling,
+            &CullingTest::chunkedFrustumCulling});
 }
 
 void CullingTest::computeAbsoluteAABB() {
+  auto&& data = ComputeAbsoluteAABBData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+
   // must create a GL context which will be used in the resource manager
   esp::gfx::WindowlessContext::uptr context_ =
       esp::gfx::WindowlessContext::create_unique(0);
@@ -54,6 +71,9 @@ void CullingTest::computeAbsoluteAABB() {
   // must declare these in this order due to avoid deallocation errors
   ResourceManager resourceManager;
   SceneManager sceneManager;
+  resourceManager.setUseConservativeAbsoluteAABBs(data.conservative);
+  CORRADE_COMPARE(resourceManager.getUseConservativeAbsoluteAABBs(),
+                  data.conservative);
   auto stageAttributesMgr = resourceManager.getStageAttributesManager();
   std::string stageFile =
       Cr::Utility::Directory::join(TEST_ASSETS, "objects/5boxes.glb");
@@ -271,6 +291,99 @@ void CullingTest::frustumCulling() {
   target->renderExit();
   CORRADE_COMPARE(numVisibleObjects, numVisibleObjectsGroundTruth);
 }
+
+void CullingTest::chunkedFrustumCulling() {
+#ifdef MAGNUM_TARGET_GLES
+  CORRADE_SKIP("Counting drawn triangles requires desktop GL.");
+#else
+  // must create a GL context which will be used in the resource manager
+  esp::gfx::WindowlessContext::uptr context_ =
+      esp::gfx::WindowlessContext::create_unique(0);
+
+  // a 200x200 plane of 2048 triangles, seen from close above its center
+  std::string stageFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "scenes/plane.glb");
+  const int maxChunkTriangles[]{0, 64};
+  Mn::UnsignedInt numDrawables[2]{}, drawnTriangles[2]{}, totalTriangles[2]{};
+  for (int iConfig = 0; iConfig != 2; ++iConfig) {
+    CORRADE_ITERATION(maxChunkTriangles[iConfig]);
+
+    // must declare these in this order due to avoid deallocation errors
+    ResourceManager resourceManager;
+    SceneManager sceneManager;
+    resourceManager.setMaxChunkTriangles(maxChunkTriangles[iConfig]);
+    auto stageAttributes =
+        resourceManager.getStageAttributesManager()->createAttributesTemplate(
+            stageFile, true);
+    int sceneID = sceneManager.initSceneGraph();
+    auto& sceneGraph = sceneManager.getSceneGraph(sceneID);
+    auto& drawables = sceneGraph.getDrawables();
+    std::vector<int> tempIDs{sceneID, esp::ID_UNDEFINED};
+    CORRADE_VERIFY(resourceManager.loadStage(stageAttributes, nullptr,
+                                             &sceneManager, tempIDs, false));
+    numDrawables[iConfig] = drawables.size();
+
+    // look at the center of the plane along its normal, whatever the stage
+    // orientation is
+    Mn::Range3D bounds;
+    for (std::size_t iDrawable = 0; iDrawable < drawables.size();
+         ++iDrawable) {
+      Cr::Containers::Optional<Mn::Range3D> aabb =
+          dynamic_cast<esp::scene::SceneNode&>(drawables[iDrawable].object())
+              .getAbsoluteAABB();
+      CORRADE_VERIFY(aabb);
+      bounds = iDrawable ? Mn::Math::join(bounds, *aabb) : *aabb;
+    }
+    const Mn::Vector3 size = bounds.size();
+    const int normalAxis =
+        size.x() < size.y() ? (size.x() < size.z() ? 0 : 2)
+                            : (size.y() < size.z() ? 1 : 2);
+    const Mn::Vector3 normal = Mn::Vector3::Axis(normalAxis);
+    const Mn::Vector3 up = Mn::Vector3::Axis((normalAxis + 1) % 3);
+
+    Mn::Vector2i frameBufferSize{800, 600};
+    esp::gfx::RenderCamera& renderCamera = sceneGraph.getDefaultRenderCamera();
+    renderCamera.setProjectionMatrix(frameBufferSize.x(), frameBufferSize.y(),
+                                     0.01f, 100.0f, 90.0f);
+    renderCamera.node().setTransformation(Mn::Matrix4::lookAt(
+        bounds.center() + 10.0f * normal, bounds.center(), up));
+    esp::gfx::RenderTarget::uptr target =
+        esp::gfx::RenderTarget::create_unique(
+            frameBufferSize, esp::gfx::calculateDepthUnprojection(
+                                 renderCamera.projectionMatrix()));
+
+    // count the triangles drawn with and without culling
+    Mn::GL::PrimitiveQuery query{
+        Mn::GL::PrimitiveQuery::Target::PrimitivesGenerated};
+    target->renderEnter();
+    query.begin();
+    renderCamera.draw(drawables, {});
+    query.end();
+    totalTriangles[iConfig] = query.result<Mn::UnsignedInt>();
+    query.begin();
+    renderCamera.draw(drawables,
+                      {esp::gfx::RenderCamera::Flag::FrustumCulling});
+    query.end();
+    drawnTriangles[iConfig] = query.result<Mn::UnsignedInt>();
+    target->renderExit();
+
+    Cr::Utility::Debug{}
+        << "max chunk triangles:" << maxChunkTriangles[iConfig]
+        << "drawables:" << numDrawables[iConfig]
+        << "drawn triangles:" << drawnTriangles[iConfig] << "culled triangles:"
+        << totalTriangles[iConfig] - drawnTriangles[iConfig];
+  }
+
+  // chunking keeps every triangle, but lets culling skip most of them
+  CORRADE_COMPARE(totalTriangles[0], 2048u);
+  CORRADE_COMPARE(totalTriangles[1], totalTriangles[0]);
+  CORRADE_COMPARE(drawnTriangles[0], totalTriangles[0]);
+  CORRADE_COMPARE_AS(numDrawables[1], numDrawables[0],
+                     Cr::TestSuite::Compare::Greater);
+  CORRADE_COMPARE_AS(drawnTriangles[1], totalTriangles[1] / 4,
+                     Cr::TestSuite::Compare::Less);
+#endif
+}
 }  // namespace
 }  // namespace Test
 
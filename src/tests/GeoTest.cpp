@@ -3,6 +3,7 @@
 // LICENSE file in the root directory of this source tree.
 
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -45,6 +46,7 @@ struct GeoTest : Cr::TestSuite::Tester {
   explicit GeoTest();
   // tests
   void aabb();
+  void transformedPointsBB();
   void obbConstruction();
   void obbFunctions();
   void coordinateFrame();
@@ -64,6 +66,7 @@ struct GeoTest : Cr::TestSuite::Tester {
 GeoTest::GeoTest() {
   // clang-format off
   addTests({&GeoTest::aabb,
+            &GeoTest::transformedPointsBB,
             &GeoTest::obbConstruction,
             &GeoTest::obbFunctions,
             &GeoTest::coordinateFrame});
@@ -116,6 +119,40 @@ void GeoTest::aabb() {
   }
 }
 
+void GeoTest::transformedPointsBB() {
+  // interleaved vertices, so the positions are a strided view, and more than
+  // one block of points
+  struct Vertex {
+    Mn::Vector3 position;
+    Mn::Vector2 textureCoordinates;
+  };
+  std::vector<Vertex> vertices(1000);
+  for (Vertex& vertex : vertices) {
+    vertex.position = {(rand() % 2000) / 100.0f - 10.0f,
+                       (rand() % 2000) / 100.0f - 10.0f,
+                       (rand() % 2000) / 100.0f - 10.0f};
+  }
+  Cr::Containers::StridedArrayView1D<const Mn::Vector3> positions{
+      Cr::Containers::arrayView(vertices), &vertices[0].position,
+      vertices.size(), sizeof(Vertex)};
+
+  for (unsigned int iTransform = 0; iTransform < 100; ++iTransform) {
+    const Mn::Matrix4& xform = xforms_[iTransform];
+    std::vector<Mn::Vector3> transformed;
+    for (const Vertex& vertex : vertices) {
+      transformed.push_back(xform.transformPoint(vertex.position));
+    }
+    Mn::Range3D aabbControl{Mn::Math::minmax(transformed)};
+    Mn::Range3D aabbTest = esp::geo::getTransformedPointsBB(positions, xform);
+
+    float eps = 1e-3f;
+    CORRADE_COMPARE_WITH(aabbTest.min(), aabbControl.min(),
+                         Cr::TestSuite::Compare::around(Mn::Vector3{eps}));
+    CORRADE_COMPARE_WITH(aabbTest.max(), aabbControl.max(),
+                         Cr::TestSuite::Compare::around(Mn::Vector3{eps}));
+  }
+}
+
 void GeoTest::obbConstruction() {
   OBB obb1;
   const vec3f center(0, 0, 0);
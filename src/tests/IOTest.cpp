@@ -3,13 +3,18 @@
 // LICENSE file in the root directory of this source tree.
 
 #include <gtest/gtest.h>
+#include <Corrade/Utility/Directory.h>
+#include <cstring>
 #include "esp/assets/attributes/ObjectAttributes.h"
 #include "esp/core/esp.h"
+#include "esp/io/PlyFile.h"
 #include "esp/io/io.h"
 #include "esp/io/json.h"
 
 #include "configure.h"
 
+namespace Cr = Corrade;
+
 using namespace esp::io;
 
 using esp::assets::attributes::AbstractObjectAttributes;
@@ -150,3 +155,86 @@ TEST(IOTest, JsonTest) {
   EXPECT_EQ(success, true);
   EXPECT_EQ(attributes->getRenderAssetHandle(), "banana.glb");
 }
+
+namespace {
+
+template <class T>
+void appendValue(std::string& data, T value) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  data.append(bytes, sizeof(T));
+}
+
+}  // namespace
+
+TEST(IOTest, PlyFileTest) {
+  std::string ply =
+      "ply\n"
+      "format binary_little_endian 1.0\n"
+      "comment two triangles\n"
+      "element vertex 4\n"
+      "property float x\n"
+      "property float y\n"
+      "property float z\n"
+      "property uchar red\n"
+      "element face 2\n"
+      "property list uchar int vertex_indices\n"
+      "property int segment_id\n"
+      "end_header\n";
+  for (int i = 0; i < 4; ++i) {
+    appendValue<float>(ply, i);
+    appendValue<float>(ply, 2 * i);
+    appendValue<float>(ply, 3 * i);
+    appendValue<uint8_t>(ply, 10 * i);
+  }
+  const int faces[2][3] = {{0, 1, 2}, {0, 2, 3}};
+  for (int i = 0; i < 2; ++i) {
+    appendValue<uint8_t>(ply, 3);
+    for (int index : faces[i]) {
+      appendValue<int32_t>(ply, index);
+    }
+    appendValue<int32_t>(ply, 7 + i);
+  }
+  const std::string plyFile =
+      Cr::Utility::Directory::join(Cr::Utility::Directory::tmp(), "test.ply");
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(plyFile, ply));
+
+  PlyFile file;
+  ASSERT_TRUE(file.open(plyFile));
+  ASSERT_EQ(file.elements().size(), 2);
+  EXPECT_EQ(file.element("vertex")->stride, 13);
+  EXPECT_EQ(file.element("face")->stride, 17);
+
+  auto y = file.view<float>("vertex", "y");
+  auto red = file.view<uint8_t>("vertex", "red");
+  ASSERT_TRUE(y && red);
+  ASSERT_EQ(y->size(), 4);
+  EXPECT_EQ((*y)[3], 6.0f);
+  EXPECT_EQ((*red)[2], 20);
+
+  auto indices = file.listView<uint32_t>("face", "vertex_indices");
+  auto segmentIds = file.view<int32_t>("face", "segment_id");
+  ASSERT_TRUE(indices && segmentIds);
+  ASSERT_EQ(indices->size()[0], 2);
+  ASSERT_EQ(indices->size()[1], 3);
+  EXPECT_EQ((*indices)[1][2], 3);
+  EXPECT_EQ((*segmentIds)[1], 8);
+
+  // wrong type, missing property, scalar viewed as a list
+  EXPECT_FALSE(file.view<float>("vertex", "red"));
+  EXPECT_FALSE(file.view<float>("vertex", "w"));
+  EXPECT_FALSE(file.listView<int32_t>("face", "segment_id"));
+
+  // a truncated last element keeps the faces that are complete
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(
+      plyFile, ply.substr(0, ply.size() - 5)));
+  ASSERT_TRUE(file.open(plyFile));
+  EXPECT_EQ(file.element("face")->count, 1);
+
+  // lists of varying size are not supported
+  ply[ply.size() - 17] = 4;
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(plyFile, ply));
+  EXPECT_FALSE(file.open(plyFile));
+
+  Cr::Utility::Directory::rm(plyFile);
+}
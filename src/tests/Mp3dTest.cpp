@@ -4,6 +4,9 @@
 
 #include <Corrade/Utility/Directory.h>
 #include <gtest/gtest.h>
+#include <utime.h>
+#include <algorithm>
+#include <iterator>
 
 #include "esp/scene/SemanticScene.h"
 
@@ -49,3 +52,105 @@ TEST(Mp3dTest, Load) {
     }
   }
 }
+
+TEST(Mp3dTest, Cache) {
+  const std::string filename =
+      Cr::Utility::Directory::join(Cr::Utility::Directory::tmp(), "test.house");
+  const std::string cacheFilename = filename + ".cache";
+  const std::string house =
+      "ASCII 1.1\n"
+      "H test house 0 0 0 0 2 1 1 1 0 1  0 0 0 0 0  -1 -1 -1 4 4 4  0 0 0 0 0\n"
+      "L 0 1 - 0 0 0  -1 -1 -1 4 4 4  0 0 0 0 0\n"
+      "R 0 0 0 0 k  1 1 1  0 0 0 2 2 2  2.5  0 0 0 0\n"
+      "P 0 0 -1 door  0 0 0 1 1 1  0 0 0 0\n"
+      "C 0 3 kitchen#table 5 table 0 0 0 0 0\n"
+      "O 0 0 0  1.5 1.25 0.5  1 0 0  0 1 0  0.5 0.25 1e-1  0 0 0 0 0 0 0 0\r\n"
+      "E 0 0 7 1.0  0 0 0  0 0 0 1 1 1  0 0 0 0 0\n"
+      "E 1 0 1000008 1.0  0 0 0  0 0 0 1 1 1  0 0 0 0 0";
+  // the cache is keyed by size and modification time, pinned here so that
+  // the house can be swapped for one the cache still matches
+  struct utimbuf modificationTime {};
+  modificationTime.modtime = 1000000;
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(filename, house));
+  ASSERT_EQ(utime(filename.c_str(), &modificationTime), 0);
+  Cr::Utility::Directory::rm(cacheFilename);
+
+  auto check = [](const SemanticScene& house) {
+    EXPECT_EQ(house.count("objects"), 1);
+    EXPECT_EQ(house.count("segments"), 2);
+    ASSERT_EQ(house.levels().size(), 1);
+    ASSERT_EQ(house.regions().size(), 1);
+    EXPECT_EQ(house.regions()[0]->category()->name(), "kitchen");
+    EXPECT_EQ(house.levels()[0]->regions().size(), 1);
+    ASSERT_EQ(house.objects().size(), 1);
+    const auto& object = house.objects()[0];
+    EXPECT_EQ(object->category()->name("raw"), "kitchen table");
+    EXPECT_EQ(object->category()->index(""), 5);
+    EXPECT_TRUE(object->obb().center().isApprox(vec3f(1.5f, 1.25f, 0.5f)));
+    EXPECT_TRUE(object->obb().sizes().isApprox(vec3f(1.0f, 0.5f, 0.2f)));
+    EXPECT_EQ(object->region(), house.regions()[0]);
+    EXPECT_EQ(house.semanticIndexToObjectIndex(7), 0);
+    EXPECT_EQ(house.semanticIndexToObjectIndex(1000008), 0);
+    EXPECT_EQ(house.semanticIndexToObjectIndex(8), ID_UNDEFINED);
+    EXPECT_EQ(house.semanticIndexToObjectIndex(2000007), ID_UNDEFINED);
+    EXPECT_EQ(house.getSemanticIndexMap().size(), 2);
+    EXPECT_EQ(house.getObjectToCategoryIndex(), std::vector<int>{5});
+  };
+
+  SemanticScene parsed;
+  ASSERT_TRUE(SemanticScene::loadMp3dHouse(filename, parsed, quatf::Identity(),
+                                           true));
+  check(parsed);
+  ASSERT_TRUE(Cr::Utility::Directory::exists(cacheFilename));
+
+  // the house file looks unchanged, so this reads the cache, which it has to
+  // as the house can no longer be parsed
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(
+      filename, std::string(house.size(), 'x')));
+  ASSERT_EQ(utime(filename.c_str(), &modificationTime), 0);
+  SemanticScene cached;
+  ASSERT_TRUE(SemanticScene::loadMp3dHouse(filename, cached, quatf::Identity(),
+                                           true));
+  check(cached);
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(filename, house));
+  ASSERT_EQ(utime(filename.c_str(), &modificationTime), 0);
+
+  // a corrupted cache falls back to parsing
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(cacheFilename, "ESPHOUSE"));
+  SemanticScene reparsed;
+  ASSERT_TRUE(SemanticScene::loadMp3dHouse(filename, reparsed,
+                                           quatf::Identity(), true));
+  check(reparsed);
+
+  // a whole frame at once
+  const uint32_t maskIndices[]{7, 8, 1000008, 0, 2000007, 0xffffffffu};
+  int32_t objectIndices[6];
+  reparsed.semanticIndicesToObjectIndices(maskIndices, objectIndices);
+  const int32_t expectedObjectIndices[]{0, -1, 0, -1, -1, -1};
+  EXPECT_TRUE(std::equal(std::begin(objectIndices), std::end(objectIndices),
+                         std::begin(expectedObjectIndices)));
+  int32_t categoryIndices[6];
+  reparsed.objectIndicesToCategoryIndices(objectIndices, categoryIndices);
+  const int32_t expectedCategoryIndices[]{5, -1, 5, -1, -1, -1};
+  EXPECT_TRUE(std::equal(std::begin(categoryIndices),
+                         std::end(categoryIndices),
+                         std::begin(expectedCategoryIndices)));
+
+  Cr::Utility::Directory::rm(cacheFilename);
+  Cr::Utility::Directory::rm(filename);
+}
+
+TEST(Mp3dTest, InvalidFloat) {
+  const std::string filename = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "invalid.house");
+  ASSERT_TRUE(Cr::Utility::Directory::writeString(
+      filename,
+      "ASCII 1.1\n"
+      "H test house 0 0 0 0 0 0 0 0 0 1  0 0 0 0 0  -1 -1 -1 4 4 4  0 0 0 0 0\n"
+      "L 0 0 - abc 0 0  -1 -1 -1 4 4 4  0 0 0 0 0\n"));
+
+  // rejected rather than thrown out of the loader
+  SemanticScene house;
+  EXPECT_FALSE(SemanticScene::loadMp3dHouse(filename, house));
+  Cr::Utility::Directory::rm(filename);
+}
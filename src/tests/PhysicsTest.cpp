@@ -4,13 +4,16 @@
 
 #include <Corrade/Utility/Directory.h>
 #include <gtest/gtest.h>
+#include <chrono>
 #include <string>
+#include <thread>
 
 #include "esp/sim/Simulator.h"
 
 #include "esp/assets/ResourceManager.h"
 #include "esp/scene/SceneManager.h"
 
+#include "esp/physics/FixedRateStepper.h"
 #include "esp/physics/PhysicsManager.h"
 #ifdef ESP_BUILD_WITH_BULLET
 #include "esp/physics/bullet/BulletPhysicsManager.h"
@@ -348,6 +351,119 @@ TEST_F(PhysicsManagerTest, BulletCompoundShapeMargins) {
     ASSERT_EQ(AabbOb2, objectGroundTruth);
   }
 }
+
+TEST_F(PhysicsManagerTest, BulletCollisionShapeCache) {
+  // test that instances of the same collision asset and scale share convex
+  // shapes, and that modifying one instance's shapes doesn't affect the others
+  LOG(INFO) << "Starting physics test: BulletCollisionShapeCache";
+
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  initScene("NONE");
+
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+    ObjectAttributes->setRenderAssetHandle(objectFile);
+    ObjectAttributes->setMargin(0.1);
+
+    auto objectAttributesManager =
+        resourceManager_.getObjectAttributesManager();
+    objectAttributesManager->registerAttributesTemplate(ObjectAttributes,
+                                                        objectFile);
+    ObjectAttributes::ptr objectTemplate =
+        objectAttributesManager->getTemplateCopyByHandle(objectFile);
+
+    auto* drawables = &sceneManager_.getSceneGraph(sceneID_).getDrawables();
+    esp::physics::BulletPhysicsManager* bPhysManager =
+        static_cast<esp::physics::BulletPhysicsManager*>(physicsManager_.get());
+
+    std::vector<int> objectIDs;
+    for (int i = 0; i < 5; ++i) {
+      objectIDs.push_back(physicsManager_->addObject(objectFile, drawables));
+    }
+    ASSERT_EQ(bPhysManager->getCollisionShapeCache().getNumCachedShapes(), 1);
+
+    // a different scale needs its own shapes
+    objectTemplate->setScale({2.0, 2.0, 2.0});
+    objectAttributesManager->registerAttributesTemplate(objectTemplate);
+    int scaledObjectId = physicsManager_->addObject(objectFile, drawables);
+    ASSERT_EQ(bPhysManager->getCollisionShapeCache().getNumCachedShapes(), 2);
+
+    Magnum::Range3D objectGroundTruth({-1.1, -1.1, -1.1}, {1.1, 1.1, 1.1});
+    Magnum::Range3D scaledGroundTruth({-2.1, -2.1, -2.1}, {2.1, 2.1, 2.1});
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(scaledObjectId),
+              scaledGroundTruth);
+
+    // changing the margin of one instance leaves the shared shapes untouched
+    physicsManager_->setMargin(objectIDs[0], 0.2);
+    ASSERT_NE(bPhysManager->getCollisionShapeAabb(objectIDs[0]),
+              objectGroundTruth);
+    for (size_t i = 1; i < objectIDs.size(); ++i) {
+      ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectIDs[i]),
+                objectGroundTruth);
+    }
+
+    // removing instances keeps the cached shapes valid for new ones
+    for (int objectId : objectIDs) {
+      physicsManager_->removeObject(objectId);
+    }
+    int newObjectId = physicsManager_->addObject(objectFile, drawables);
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(newObjectId),
+              scaledGroundTruth);
+  }
+}
+
+TEST_F(PhysicsManagerTest, BulletCollisionHullVertexBudget) {
+  // test that a collision hull vertex budget gets its own cached, simplified
+  // shapes which never grow past the full hull
+  LOG(INFO) << "Starting physics test: BulletCollisionHullVertexBudget";
+
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  initScene("NONE");
+
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+    ObjectAttributes->setRenderAssetHandle(objectFile);
+    ObjectAttributes->setMargin(0.1);
+
+    auto objectAttributesManager =
+        resourceManager_.getObjectAttributesManager();
+    objectAttributesManager->registerAttributesTemplate(ObjectAttributes,
+                                                        objectFile);
+    ObjectAttributes::ptr objectTemplate =
+        objectAttributesManager->getTemplateCopyByHandle(objectFile);
+
+    auto* drawables = &sceneManager_.getSceneGraph(sceneID_).getDrawables();
+    esp::physics::BulletPhysicsManager* bPhysManager =
+        static_cast<esp::physics::BulletPhysicsManager*>(physicsManager_.get());
+
+    int objectId = physicsManager_->addObject(objectFile, drawables);
+    ASSERT_EQ(bPhysManager->getCollisionShapeCache().getNumCachedShapes(), 1);
+    Magnum::Range3D objectGroundTruth({-1.1, -1.1, -1.1}, {1.1, 1.1, 1.1});
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectId),
+              objectGroundTruth);
+
+    objectTemplate->setCollisionHullVertexBudget(4);
+    objectAttributesManager->registerAttributesTemplate(objectTemplate);
+    int simplifiedObjectId = physicsManager_->addObject(objectFile, drawables);
+    ASSERT_EQ(bPhysManager->getCollisionShapeCache().getNumCachedShapes(), 2);
+    const Magnum::Range3D simplifiedAabb =
+        bPhysManager->getCollisionShapeAabb(simplifiedObjectId);
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_GE(simplifiedAabb.min()[i], objectGroundTruth.min()[i] - 1e-4);
+      ASSERT_LE(simplifiedAabb.max()[i], objectGroundTruth.max()[i] + 1e-4);
+    }
+
+    // the unsimplified instance keeps its full hull
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectId),
+              objectGroundTruth);
+  }
+}
 #endif
 
 TEST_F(PhysicsManagerTest, ConfigurableScaling) {
@@ -736,3 +852,256 @@ TEST_F(PhysicsManagerTest, TestMotionTypes) {
     }
   }
 }
+
+TEST_F(PhysicsManagerTest, TestVelocityControlBookkeeping) {
+  // test that only velocity controlled objects are integrated and that removed
+  // objects are no longer visited
+  LOG(INFO) << "Starting physics test: TestVelocityControlBookkeeping";
+
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  std::string stageFile =
+      Cr::Utility::Directory::join(dataDir, "test_assets/scenes/plane.glb");
+
+  initScene(stageFile);
+
+  ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+  ObjectAttributes->setRenderAssetHandle(objectFile);
+  auto objectAttributesManager = resourceManager_.getObjectAttributesManager();
+  objectAttributesManager->registerAttributesTemplate(ObjectAttributes,
+                                                      objectFile);
+
+  int controlledId = physicsManager_->addObject(objectFile, nullptr);
+  int restingId = physicsManager_->addObject(objectFile, nullptr);
+  for (int objectId : {controlledId, restingId}) {
+    physicsManager_->setObjectMotionType(objectId,
+                                         esp::physics::MotionType::KINEMATIC);
+  }
+  physicsManager_->setTranslation(restingId, Magnum::Vector3{2.0, 1.0, 0});
+
+  esp::physics::VelocityControl::ptr velControl =
+      physicsManager_->getVelocityControl(controlledId);
+  velControl->controllingLinVel = true;
+  velControl->linVel = Magnum::Vector3{1.0, 0, 0};
+
+  physicsManager_->stepPhysics(1.0);
+  ASSERT_LE((physicsManager_->getTranslation(controlledId) -
+             Magnum::Vector3{1.0, 0, 0})
+                .length(),
+            0.015);  // fairly loose due to discrete timestep
+  ASSERT_EQ(physicsManager_->getTranslation(restingId),
+            (Magnum::Vector3{2.0, 1.0, 0}));
+
+  // stepping after removing a controlled object must not visit it
+  physicsManager_->removeObject(controlledId);
+  physicsManager_->stepPhysics(1.0);
+  ASSERT_EQ(physicsManager_->getTranslation(restingId),
+            (Magnum::Vector3{2.0, 1.0, 0}));
+}
+
+TEST_F(PhysicsManagerTest, TestWorldSnapshot) {
+  // test saving and restoring the simulation state of all objects in place
+  LOG(INFO) << "Starting physics test: TestWorldSnapshot";
+
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  std::string stageFile =
+      Cr::Utility::Directory::join(dataDir, "test_assets/scenes/plane.glb");
+
+  initScene(stageFile);
+
+  ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+  ObjectAttributes->setRenderAssetHandle(objectFile);
+  ObjectAttributes->setBoundingBoxCollisions(true);
+  ObjectAttributes->setScale({0.2, 0.2, 0.2});
+  auto objectAttributesManager = resourceManager_.getObjectAttributesManager();
+  objectAttributesManager->registerAttributesTemplate(ObjectAttributes,
+                                                      objectFile);
+
+  std::vector<int> objectIds;
+  for (int o = 0; o < 3; o++) {
+    int objectId = physicsManager_->addObject(objectFile, nullptr);
+    physicsManager_->setTranslation(objectId,
+                                    Magnum::Vector3{0.05f * o, 0.5f * o + 0.5f,
+                                                    0});
+    objectIds.push_back(objectId);
+  }
+  // a kinematic object under velocity control
+  physicsManager_->setObjectMotionType(objectIds[0],
+                                       esp::physics::MotionType::KINEMATIC);
+  esp::physics::VelocityControl::ptr velControl =
+      physicsManager_->getVelocityControl(objectIds[0]);
+  velControl->controllingLinVel = true;
+  velControl->linVel = Magnum::Vector3{0.1, 0, 0};
+
+  esp::physics::PhysicsWorldSnapshot snapshot;
+  physicsManager_->saveSnapshot(snapshot);
+  ASSERT_EQ(snapshot.objects.size(), objectIds.size());
+
+  auto stepAndRecord = [&]() {
+    for (int s = 0; s < 60; s++) {
+      physicsManager_->stepPhysics(physicsManager_->getTimestep());
+    }
+    std::vector<esp::core::RigidState> states;
+    for (int objectId : objectIds) {
+      states.push_back(physicsManager_->getRigidState(objectId));
+    }
+    return states;
+  };
+
+  // first rollout from the restored state
+  ASSERT_TRUE(physicsManager_->restoreSnapshot(snapshot));
+  std::vector<esp::core::RigidState> firstRollout = stepAndRecord();
+
+  // restoring returns all objects to their saved state
+  ASSERT_TRUE(physicsManager_->restoreSnapshot(snapshot));
+  ASSERT_EQ(physicsManager_->getWorldTime(), snapshot.worldTime);
+  for (const auto& objectState : snapshot.objects) {
+    ASSERT_EQ(physicsManager_->getTranslation(objectState.objectId),
+              objectState.rigidState.translation);
+    ASSERT_EQ(physicsManager_->getObjectMotionType(objectState.objectId),
+              objectState.motionType);
+  }
+
+  // a second rollout is identical to the first
+  std::vector<esp::core::RigidState> secondRollout = stepAndRecord();
+  for (std::size_t i = 0; i < objectIds.size(); i++) {
+    ASSERT_EQ(firstRollout[i].translation, secondRollout[i].translation);
+    ASSERT_EQ(firstRollout[i].rotation, secondRollout[i].rotation);
+  }
+
+  // snapshots referencing removed objects are rejected without changes
+  Magnum::Vector3 currentPosition =
+      physicsManager_->getTranslation(objectIds[1]);
+  physicsManager_->removeObject(objectIds[2]);
+  ASSERT_FALSE(physicsManager_->restoreSnapshot(snapshot));
+  ASSERT_EQ(physicsManager_->getTranslation(objectIds[1]), currentPosition);
+
+  // as are snapshots whose ids were reused by objects of another template
+  std::string otherHandle = objectFile + "_other";
+  auto otherAttributes =
+      objectAttributesManager->getTemplateCopyByHandle(objectFile);
+  objectAttributesManager->registerAttributesTemplate(otherAttributes,
+                                                      otherHandle);
+  int reusedId = physicsManager_->addObject(otherHandle, nullptr);
+  ASSERT_EQ(reusedId, objectIds[2]);
+  ASSERT_FALSE(physicsManager_->restoreSnapshot(snapshot));
+  ASSERT_EQ(physicsManager_->getTranslation(objectIds[1]), currentPosition);
+
+  // saving again into the same snapshot records the new object
+  physicsManager_->saveSnapshot(snapshot);
+  ASSERT_EQ(snapshot.objects.size(), objectIds.size());
+  ASSERT_TRUE(physicsManager_->restoreSnapshot(snapshot));
+}
+
+TEST_F(PhysicsManagerTest, TestBoundedSubsteps) {
+  // test that a step never takes more than the maximum number of substeps and
+  // that dropped substeps are reported
+  LOG(INFO) << "Starting physics test: TestBoundedSubsteps";
+
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  initScene(objectFile);
+
+  const double timestep = physicsManager_->getTimestep();
+  physicsManager_->setMaxSubsteps(5);
+  physicsManager_->stepPhysics(10.5 * timestep);
+  ASSERT_NEAR(physicsManager_->getWorldTime(), 5 * timestep, 1e-6);
+  const int numOverruns = physicsManager_->getNumSubstepOverruns();
+  ASSERT_GT(numOverruns, 0);
+
+  // unbounded stepping takes every requested substep
+  physicsManager_->setMaxSubsteps(0);
+  physicsManager_->stepPhysics(10.5 * timestep);
+  ASSERT_GT(physicsManager_->getWorldTime(), 15 * timestep - 1e-6);
+  ASSERT_EQ(physicsManager_->getNumSubstepOverruns(), numOverruns);
+}
+
+TEST_F(PhysicsManagerTest, TestDeferredSceneNodeSync) {
+  // test that object scene nodes are only updated on sync while deferred
+  LOG(INFO) << "Starting physics test: TestDeferredSceneNodeSync";
+
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  initScene("NONE");
+
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    int objectId = physicsManager_->addObject(objectFile, nullptr);
+    const Magnum::Vector3 startPosition{0, 10.0, 0};
+    physicsManager_->setTranslation(objectId, startPosition);
+
+    physicsManager_->setDeferSceneNodeSync(true);
+    for (int s = 0; s < 30; s++) {
+      physicsManager_->stepPhysics(physicsManager_->getTimestep());
+    }
+    // the object fell, but its node wasn't touched
+    ASSERT_EQ(physicsManager_->getTranslation(objectId), startPosition);
+
+    physicsManager_->syncSceneNodes();
+    const Magnum::Vector3 syncedPosition =
+        physicsManager_->getTranslation(objectId);
+    ASSERT_LT(syncedPosition.y(), startPosition.y());
+
+    // disabling deferral keeps the synced pose and resumes eager updates
+    physicsManager_->setDeferSceneNodeSync(false);
+    ASSERT_EQ(physicsManager_->getTranslation(objectId), syncedPosition);
+    physicsManager_->stepPhysics(physicsManager_->getTimestep());
+    ASSERT_LT(physicsManager_->getTranslation(objectId).y(),
+              syncedPosition.y());
+    physicsManager_->removeObject(objectId);
+  }
+
+  // objects under kinematic velocity control are also only moved on sync
+  int kinematicId = physicsManager_->addObject(objectFile, nullptr);
+  physicsManager_->setObjectMotionType(kinematicId,
+                                       esp::physics::MotionType::KINEMATIC);
+  esp::physics::VelocityControl::ptr velControl =
+      physicsManager_->getVelocityControl(kinematicId);
+  velControl->controllingLinVel = true;
+  velControl->linVel = Magnum::Vector3{1.0, 0, 0};
+  const Magnum::Vector3 kinematicStart =
+      physicsManager_->getTranslation(kinematicId);
+
+  physicsManager_->setDeferSceneNodeSync(true);
+  for (int s = 0; s < 10; s++) {
+    physicsManager_->stepPhysics(physicsManager_->getTimestep());
+  }
+  ASSERT_EQ(physicsManager_->getTranslation(kinematicId), kinematicStart);
+  physicsManager_->syncSceneNodes();
+  ASSERT_GT(physicsManager_->getTranslation(kinematicId).x(),
+            kinematicStart.x());
+  physicsManager_->setDeferSceneNodeSync(false);
+}
+
+TEST_F(PhysicsManagerTest, TestFixedRateStepper) {
+  // test that the fixed rate stepper advances the world from a worker thread
+  LOG(INFO) << "Starting physics test: TestFixedRateStepper";
+
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  initScene("NONE");
+
+  int objectId = physicsManager_->addObject(objectFile, nullptr);
+  physicsManager_->setTranslation(objectId, Magnum::Vector3{0, 10.0, 0});
+
+  esp::physics::FixedRateStepper stepper(physicsManager_);
+  stepper.start(10.0);
+  ASSERT_TRUE(stepper.isRunning());
+  ASSERT_TRUE(physicsManager_->getDeferSceneNodeSync());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  stepper.stop();
+  ASSERT_FALSE(stepper.isRunning());
+  ASSERT_FALSE(physicsManager_->getDeferSceneNodeSync());
+  ASSERT_GT(physicsManager_->getWorldTime(), 0.0);
+
+  // stepping on the calling thread works again once stopped
+  const double worldTime = physicsManager_->getWorldTime();
+  physicsManager_->stepPhysics(physicsManager_->getTimestep());
+  ASSERT_GT(physicsManager_->getWorldTime(), worldTime);
+}
@@ -3,12 +3,25 @@
 // LICENSE file in the root directory of this source tree.
 
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/EigenIntegration/Integration.h>
+#include <Magnum/Math/FunctionsBatch.h>
 #include <Magnum/Math/Range.h>
+#include <Magnum/MeshTools/Interleave.h>
+#include <Magnum/Primitives/Cube.h>
+#include <Magnum/Primitives/Grid.h>
 #include <gtest/gtest.h>
+#include <utime.h>
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <vector>
 
+#include "esp/assets/AssetImportPool.h"
+#include "esp/assets/ImportedAsset.h"
+#include "esp/assets/MeshOptimizer.h"
 #include "esp/assets/ResourceManager.h"
 #include "esp/gfx/Renderer.h"
 #include "esp/gfx/WindowlessContext.h"
@@ -83,3 +96,344 @@ TEST(ResourceManagerTest, createJoinedCollisionMesh) {
     ASSERT_EQ(indexGroundTruth[iix], joinedBox->ibo[iix]);
   }
 }
+
+TEST(ResourceManagerTest, parallelImport) {
+  esp::gfx::WindowlessContext::uptr context_ =
+      esp::gfx::WindowlessContext::create_unique(0);
+
+  std::shared_ptr<esp::gfx::Renderer> renderer_ = esp::gfx::Renderer::create();
+
+  std::string boxesFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/5boxes.glb");
+
+  // load the same multi-mesh asset serially and with import worker threads
+  std::vector<esp::assets::MeshData::uptr> joinedMeshes;
+  for (int numImportThreads : {0, 3}) {
+    // must declare these in this order due to avoid deallocation errors
+    ResourceManager resourceManager;
+    SceneManager sceneManager_;
+    // decode from file every time
+    esp::assets::AssetCache::instance().clear();
+    resourceManager.setNumImportThreads(numImportThreads);
+    ASSERT_EQ(resourceManager.getNumImportThreads(), numImportThreads);
+
+    auto stageAttributes =
+        resourceManager.getStageAttributesManager()->createAttributesTemplate(
+            boxesFile, true);
+    int sceneID = sceneManager_.initSceneGraph();
+    std::vector<int> tempIDs{sceneID, esp::ID_UNDEFINED};
+    ASSERT_TRUE(resourceManager.loadStage(stageAttributes, nullptr,
+                                          &sceneManager_, tempIDs, false));
+
+    joinedMeshes.emplace_back(
+        resourceManager.createJoinedCollisionMesh(boxesFile));
+  }
+
+  // the meshes must be identical and in the same order
+  ASSERT_EQ(joinedMeshes[0]->vbo.size(), joinedMeshes[1]->vbo.size());
+  ASSERT_EQ(joinedMeshes[0]->ibo, joinedMeshes[1]->ibo);
+  for (size_t vix = 0; vix < joinedMeshes[0]->vbo.size(); vix++) {
+    ASSERT_EQ(Magnum::Vector3(joinedMeshes[0]->vbo[vix]),
+              Magnum::Vector3(joinedMeshes[1]->vbo[vix]));
+  }
+}
+
+TEST(ResourceManagerTest, assetCache) {
+  esp::gfx::WindowlessContext::uptr context_ =
+      esp::gfx::WindowlessContext::create_unique(0);
+
+  std::shared_ptr<esp::gfx::Renderer> renderer_ = esp::gfx::Renderer::create();
+
+  esp::assets::AssetCache& assetCache = esp::assets::AssetCache::instance();
+  assetCache.clear();
+  const std::size_t memoryBudget = assetCache.getMemoryBudget();
+  // caching is opt-in
+  assetCache.setMemoryBudget(std::size_t{1} << 30);
+
+  std::string boxFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/transform_box.glb");
+
+  // load the same asset in two resource managers, the second one must use the
+  // data decoded by the first one
+  std::vector<esp::assets::MeshData::uptr> joinedBoxes;
+  for (int iLoad = 0; iLoad < 2; ++iLoad) {
+    // must declare these in this order due to avoid deallocation errors
+    ResourceManager resourceManager;
+    SceneManager sceneManager_;
+    auto stageAttributes =
+        resourceManager.getStageAttributesManager()->createAttributesTemplate(
+            boxFile, true);
+    int sceneID = sceneManager_.initSceneGraph();
+    std::vector<int> tempIDs{sceneID, esp::ID_UNDEFINED};
+    ASSERT_TRUE(resourceManager.loadStage(stageAttributes, nullptr,
+                                          &sceneManager_, tempIDs, false));
+    ASSERT_EQ(assetCache.getNumCachedAssets(), 1);
+    joinedBoxes.emplace_back(resourceManager.createJoinedCollisionMesh(boxFile));
+  }
+  ASSERT_GT(assetCache.getMemoryUsage(), 0);
+  ASSERT_EQ(joinedBoxes[0]->ibo, joinedBoxes[1]->ibo);
+  ASSERT_EQ(joinedBoxes[0]->vbo.size(), joinedBoxes[1]->vbo.size());
+  for (size_t vix = 0; vix < joinedBoxes[0]->vbo.size(); vix++) {
+    ASSERT_EQ(Magnum::Vector3(joinedBoxes[0]->vbo[vix]),
+              Magnum::Vector3(joinedBoxes[1]->vbo[vix]));
+  }
+
+  // shrinking the budget evicts
+  assetCache.setMemoryBudget(0);
+  ASSERT_EQ(assetCache.getNumCachedAssets(), 0);
+  ASSERT_EQ(assetCache.getMemoryUsage(), 0);
+  assetCache.setMemoryBudget(memoryBudget);
+}
+
+TEST(ResourceManagerTest, bakedAsset) {
+  using esp::assets::AssetImportPool;
+  using esp::assets::ImportedAsset;
+
+#ifdef MAGNUM_BUILD_STATIC
+  AssetImportPool::ImporterManager manager{"nonexistent"};
+#else
+  AssetImportPool::ImporterManager manager;
+#endif
+  AssetImportPool::configureImporterManager(manager, "RGBA8");
+  Cr::Containers::Pointer<AssetImportPool::Importer> importer =
+      manager.loadAndInstantiate("AnySceneImporter");
+  ASSERT_TRUE(importer);
+
+  std::string boxFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/transform_box.glb");
+  ASSERT_TRUE(importer->openFile(boxFile));
+  ImportedAsset::ptr asset = ImportedAsset::createFromImporter(*importer);
+  ASSERT_NE(asset, nullptr);
+  for (int componentID = 0; componentID < asset->getNumComponents();
+       ++componentID) {
+    asset->decodeComponent(*importer, componentID);
+  }
+
+  std::string bakedFile = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "transform_box.glb.baked");
+  ASSERT_TRUE(asset->save(bakedFile, boxFile, "RGBA8"));
+
+  // a baked file is only used for the asset and Basis format it was baked for
+  ASSERT_EQ(ImportedAsset::load(bakedFile, boxFile, "Bc7RGBA"), nullptr);
+  ImportedAsset::ptr baked = ImportedAsset::load(bakedFile, boxFile, "RGBA8");
+  Cr::Utility::Directory::rm(bakedFile);
+  ASSERT_NE(baked, nullptr);
+
+  // touching the source file makes the baked file stale, even if its size
+  // didn't change
+  std::string sourceCopy = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "transform_box_copy.glb");
+  ASSERT_TRUE(Cr::Utility::Directory::copy(boxFile, sourceCopy));
+  ASSERT_TRUE(asset->save(bakedFile, sourceCopy, "RGBA8"));
+  ASSERT_NE(ImportedAsset::load(bakedFile, sourceCopy, "RGBA8"), nullptr);
+  struct utimbuf epoch {};
+  ASSERT_EQ(utime(sourceCopy.c_str(), &epoch), 0);
+  ASSERT_EQ(ImportedAsset::load(bakedFile, sourceCopy, "RGBA8"), nullptr);
+  Cr::Utility::Directory::rm(bakedFile);
+  Cr::Utility::Directory::rm(sourceCopy);
+
+  ASSERT_EQ(baked->getByteSize(), asset->getByteSize());
+  ASSERT_EQ(baked->materials.size(), asset->materials.size());
+  ASSERT_EQ(baked->textures.size(), asset->textures.size());
+  ASSERT_EQ(baked->meshes.size(), asset->meshes.size());
+  for (size_t iMesh = 0; iMesh < asset->meshes.size(); ++iMesh) {
+    ASSERT_TRUE(baked->meshes[iMesh]);
+    const Mn::Trade::MeshData& original = *asset->meshes[iMesh];
+    const Mn::Trade::MeshData& loaded = *baked->meshes[iMesh];
+    ASSERT_EQ(loaded.vertexCount(), original.vertexCount());
+    ASSERT_EQ(loaded.indexCount(), original.indexCount());
+    ASSERT_EQ(loaded.attributeCount(), original.attributeCount());
+    const auto originalPositions = original.positions3DAsArray();
+    const auto loadedPositions = loaded.positions3DAsArray();
+    for (size_t vix = 0; vix < originalPositions.size(); ++vix) {
+      ASSERT_EQ(loadedPositions[vix], originalPositions[vix]);
+    }
+    const auto originalIndices = original.indicesAsArray();
+    const auto loadedIndices = loaded.indicesAsArray();
+    for (size_t iix = 0; iix < originalIndices.size(); ++iix) {
+      ASSERT_EQ(loadedIndices[iix], originalIndices[iix]);
+    }
+  }
+
+  // the component hierarchy is restored as well
+  ASSERT_EQ(baked->root.children.size(), asset->root.children.size());
+  ASSERT_EQ(baked->root.children[0].transformFromLocalToParent,
+            asset->root.children[0].transformFromLocalToParent);
+  ASSERT_EQ(baked->root.children[0].meshIDLocal,
+            asset->root.children[0].meshIDLocal);
+}
+
+TEST(ResourceManagerTest, corruptBakedAsset) {
+  using esp::assets::ImportedAsset;
+
+  // a single non-indexed mesh with one attribute keeps the layout simple
+  ImportedAsset::ptr asset = ImportedAsset::create();
+  asset->meshes.emplace_back(Mn::Primitives::cubeSolidStrip());
+
+  std::string boxFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/transform_box.glb");
+  std::string bakedFile = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "corrupt_box.glb.baked");
+  ASSERT_TRUE(asset->save(bakedFile, boxFile, ""));
+  ASSERT_NE(ImportedAsset::load(bakedFile, boxFile, ""), nullptr);
+  const Cr::Containers::Array<char> original =
+      Cr::Utility::Directory::read(bakedFile);
+
+  // offsets past the magic, source size and time, Basis format and
+  // optimized flag
+  const std::size_t numTexturesOffset = 57;
+  const std::size_t vertexCountOffset = numTexturesOffset + 12 + 6;
+  const std::size_t vertexFormatOffset = vertexCountOffset + 12;
+  auto loadPatched = [&](std::size_t offset, std::uint32_t value) {
+    Cr::Containers::Array<char> data{Cr::Containers::NoInit, original.size()};
+    std::memcpy(data.data(), original.data(), original.size());
+    std::memcpy(data.data() + offset, &value, sizeof(value));
+    EXPECT_TRUE(Cr::Utility::Directory::write(bakedFile, data));
+    return ImportedAsset::load(bakedFile, boxFile, "");
+  };
+
+  // the unpatched value loads
+  ASSERT_NE(loadPatched(vertexFormatOffset,
+                        Mn::UnsignedInt(Mn::VertexFormat::Vector3)),
+            nullptr);
+  // a count larger than the file is rejected before allocating for it
+  ASSERT_EQ(loadPatched(numTexturesOffset, 0xffffffffu), nullptr);
+  // a vertex count overflowing the bounds check is rejected
+  ASSERT_EQ(loadPatched(vertexCountOffset, 0xffffffffu), nullptr);
+  // an unknown vertex format is rejected instead of asserting on its size
+  ASSERT_EQ(loadPatched(vertexFormatOffset, 0xffffu), nullptr);
+  Cr::Utility::Directory::rm(bakedFile);
+}
+
+TEST(ResourceManagerTest, optimizedMesh) {
+  using esp::assets::AssetImportPool;
+  using esp::assets::ImportedAsset;
+
+#ifdef MAGNUM_BUILD_STATIC
+  AssetImportPool::ImporterManager manager{"nonexistent"};
+#else
+  AssetImportPool::ImporterManager manager;
+#endif
+  AssetImportPool::configureImporterManager(manager, "RGBA8");
+  Cr::Containers::Pointer<AssetImportPool::Importer> importer =
+      manager.loadAndInstantiate("AnySceneImporter");
+  ASSERT_TRUE(importer);
+
+  std::string boxFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/transform_box.glb");
+  ASSERT_TRUE(importer->openFile(boxFile));
+  ImportedAsset::ptr asset = ImportedAsset::createFromImporter(*importer);
+  ImportedAsset::ptr optimized =
+      ImportedAsset::createFromImporter(*importer, /*optimizeMeshes=*/true);
+  ASSERT_NE(asset, nullptr);
+  ASSERT_NE(optimized, nullptr);
+  ASSERT_TRUE(optimized->meshesOptimized);
+  for (int componentID = 0; componentID < asset->getNumComponents();
+       ++componentID) {
+    asset->decodeComponent(*importer, componentID);
+    optimized->decodeComponent(*importer, componentID);
+  }
+
+  // reordering changes neither the size nor the set of triangles
+  auto sortedTriangles = [](const Mn::Trade::MeshData& mesh) {
+    const auto positions = mesh.positions3DAsArray();
+    const auto indices = mesh.indicesAsArray();
+    std::vector<std::vector<float>> triangles;
+    for (size_t iix = 0; iix + 2 < indices.size(); iix += 3) {
+      std::vector<float> triangle;
+      for (size_t corner = 0; corner < 3; ++corner) {
+        const Mn::Vector3& position = positions[indices[iix + corner]];
+        triangle.insert(triangle.end(), position.data(), position.data() + 3);
+      }
+      triangles.emplace_back(std::move(triangle));
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+  };
+  ASSERT_EQ(optimized->getByteSize(), asset->getByteSize());
+  for (size_t iMesh = 0; iMesh < asset->meshes.size(); ++iMesh) {
+    ASSERT_TRUE(optimized->meshes[iMesh]);
+    const Mn::Trade::MeshData& original = *asset->meshes[iMesh];
+    const Mn::Trade::MeshData& reordered = *optimized->meshes[iMesh];
+    ASSERT_EQ(reordered.vertexCount(), original.vertexCount());
+    ASSERT_EQ(reordered.indexType(), original.indexType());
+    ASSERT_EQ(sortedTriangles(reordered), sortedTriangles(original));
+  }
+}
+
+TEST(ResourceManagerTest, simplifiedMesh) {
+  // a 2x2 plane of 64x64 quads
+  const Mn::Trade::MeshData grid = Mn::MeshTools::interleave(
+      Mn::Primitives::grid3DSolid({63, 63}, Mn::Primitives::GridFlag::Normals));
+
+  // cells smaller than the quads keep every triangle
+  Cr::Containers::Optional<Mn::Trade::MeshData> full =
+      esp::assets::simplifyMesh(grid, 0.001f);
+  ASSERT_TRUE(full);
+  ASSERT_EQ(full->indexCount(), grid.indexCount());
+  ASSERT_EQ(full->vertexCount(), grid.vertexCount());
+
+  // cells of 4x4 quads keep roughly a sixteenth, at the cell centers, with
+  // the same attributes
+  const float cellSize = 4 * 2.0f / 64 + 0.001f;
+  Cr::Containers::Optional<Mn::Trade::MeshData> coarse =
+      esp::assets::simplifyMesh(grid, cellSize);
+  ASSERT_TRUE(coarse);
+  ASSERT_LT(coarse->indexCount(), grid.indexCount() / 8);
+  ASSERT_LT(coarse->vertexCount(), grid.vertexCount() / 8);
+  ASSERT_GT(coarse->indexCount(), 0);
+  ASSERT_EQ(coarse->attributeCount(), grid.attributeCount());
+  const auto coarsePositions = coarse->positions3DAsArray();
+  for (const Mn::Vector3& position : coarsePositions) {
+    const Mn::Vector3 cell = position / cellSize - Mn::Vector3{0.5f};
+    ASSERT_LT((cell - Mn::Math::round(cell)).dot(), 1.0e-6f);
+    ASSERT_FLOAT_EQ(position.z(), 0.5f * cellSize);
+  }
+  for (const Mn::Vector3& normal : coarse->normalsAsArray()) {
+    ASSERT_EQ(normal, Mn::Vector3::zAxis());
+  }
+
+  // chunks simplified separately meet at the points of the whole mesh
+  std::vector<Mn::Trade::MeshData> chunks =
+      esp::assets::splitMeshIntoChunks(grid, 1000);
+  ASSERT_FALSE(chunks.empty());
+  for (const Mn::Trade::MeshData& chunk : chunks) {
+    Cr::Containers::Optional<Mn::Trade::MeshData> coarseChunk =
+        esp::assets::simplifyMesh(chunk, cellSize);
+    ASSERT_TRUE(coarseChunk);
+    for (const Mn::Vector3& position : coarseChunk->positions3DAsArray()) {
+      ASSERT_NE(std::find(coarsePositions.begin(), coarsePositions.end(),
+                          position),
+                coarsePositions.end());
+    }
+  }
+
+  // only indexed triangle meshes are supported
+  ASSERT_FALSE(esp::assets::simplifyMesh(
+      Mn::MeshTools::interleave(Mn::Primitives::cubeSolidStrip()), 0.1f));
+}
+
+TEST(ResourceManagerTest, meshChunks) {
+  // a 2x2 plane of 64x64 quads, i.e. 8192 triangles
+  const Mn::Trade::MeshData grid = Mn::MeshTools::interleave(
+      Mn::Primitives::grid3DSolid({63, 63}, Mn::Primitives::GridFlag::Normals));
+
+  // small enough meshes are not split
+  ASSERT_TRUE(esp::assets::splitMeshIntoChunks(grid, 8192).empty());
+
+  std::vector<Mn::Trade::MeshData> chunks =
+      esp::assets::splitMeshIntoChunks(grid, 1000);
+  ASSERT_GE(chunks.size(), 9);
+  Mn::UnsignedInt numIndices = 0;
+  float chunkArea = 0.0f;
+  for (const Mn::Trade::MeshData& chunk : chunks) {
+    ASSERT_LE(chunk.indexCount() / 3, 1000);
+    ASSERT_EQ(chunk.attributeCount(), grid.attributeCount());
+    numIndices += chunk.indexCount();
+    // chunks are spatially compact, so their bounds barely overlap
+    const Mn::Range3D bounds = Mn::Math::minmax(chunk.positions3DAsArray());
+    chunkArea += bounds.size().xy().product();
+  }
+  ASSERT_EQ(numIndices, grid.indexCount());
+  ASSERT_LT(chunkArea, 2 * 4.0f);
+}
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include "esp/scene/SceneGraph.h"
+#include "esp/scene/SceneNode.h"
 
 using esp::gfx::DrawableGroup;
 using esp::scene::SceneGraph;
@@ -38,3 +39,69 @@ TEST_F(SceneGraphTest, DeleteDrawableGroup) {
   EXPECT_EQ(g.getDrawableGroups().size(), numInitialGroups);
   ASSERT_EQ(g.getDrawableGroup(groupName), nullptr);
 }
+
+TEST_F(SceneGraphTest, IncrementalBounds) {
+  using esp::scene::SceneNode;
+  namespace Mn = Magnum;
+  SceneNode& root = g.getRootNode();
+  SceneNode& parent = root.createChild();
+  SceneNode& child = parent.createChild();
+  child.setMeshBB({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+  child.setTranslation({5.0f, 0.0f, 0.0f});
+
+  EXPECT_EQ(root.getCumulativeBB().max(), (Mn::Vector3{6.0f, 1.0f, 1.0f}));
+  ASSERT_TRUE(child.getAbsoluteAABB());
+  EXPECT_EQ(child.getAbsoluteAABB()->min(), (Mn::Vector3{4.0f, -1.0f, -1.0f}));
+  // nodes without a mesh bounding box have no absolute one
+  EXPECT_FALSE(parent.getAbsoluteAABB());
+
+  // moving a node updates the boxes above and below it
+  parent.setTranslation({0.0f, 2.0f, 0.0f});
+  EXPECT_EQ(root.getCumulativeBB().max(), (Mn::Vector3{6.0f, 3.0f, 1.0f}));
+  EXPECT_EQ(parent.getCumulativeBB().max(), (Mn::Vector3{6.0f, 1.0f, 1.0f}));
+  EXPECT_EQ(child.getAbsoluteAABB()->min(), (Mn::Vector3{4.0f, 1.0f, -1.0f}));
+
+  child.translate({1.0f, 0.0f, 0.0f});
+  EXPECT_EQ(root.getCumulativeBB().max(), (Mn::Vector3{7.0f, 3.0f, 1.0f}));
+  EXPECT_EQ(child.getAbsoluteAABB()->min(), (Mn::Vector3{5.0f, 1.0f, -1.0f}));
+
+  // so does changing a mesh bounding box
+  child.setMeshBB({{-2.0f, -2.0f, -2.0f}, {2.0f, 2.0f, 2.0f}});
+  EXPECT_EQ(root.getCumulativeBB().max(), (Mn::Vector3{8.0f, 4.0f, 2.0f}));
+
+  // and removing a node
+  delete &child;
+  EXPECT_EQ(root.getCumulativeBB().max(), (Mn::Vector3{0.0f, 2.0f, 0.0f}));
+}
+
+TEST_F(SceneGraphTest, ReparentMovedNode) {
+  using esp::scene::SceneNode;
+  namespace Mn = Magnum;
+  SceneGraph other;
+  SceneNode& node = g.getRootNode().createChild();
+  node.setMeshBB({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+  EXPECT_EQ(g.getRootNode().getCumulativeBB().max(),
+            (Mn::Vector3{1.0f, 1.0f, 1.0f}));
+  EXPECT_EQ(other.getRootNode().getCumulativeBB().max(), Mn::Vector3{});
+
+  // a moved node is dirty, so Magnum does not tell it about a new parent,
+  // setParent does
+  node.setTranslation({5.0f, 0.0f, 0.0f});
+  node.setParent(&other.getRootNode());
+  EXPECT_EQ(other.getRootNode().getCumulativeBB().max(),
+            (Mn::Vector3{6.0f, 1.0f, 1.0f}));
+  EXPECT_EQ(g.getRootNode().getCumulativeBB().max(), Mn::Vector3{});
+  EXPECT_EQ(node.getTransformHierarchy(), &other.getTransformHierarchy());
+  ASSERT_TRUE(node.getAbsoluteAABB());
+  EXPECT_EQ(node.getAbsoluteAABB()->min(), (Mn::Vector3{4.0f, -1.0f, -1.0f}));
+
+  // Magnum's own setParent needs an explicit update, as the Python bindings
+  // do
+  node.translate({1.0f, 0.0f, 0.0f});
+  static_cast<MagnumObject&>(node).setParent(&g.getRootNode());
+  node.updateParent();
+  EXPECT_EQ(g.getRootNode().getCumulativeBB().max(),
+            (Mn::Vector3{7.0f, 1.0f, 1.0f}));
+  EXPECT_EQ(other.getRootNode().getCumulativeBB().max(), Mn::Vector3{});
+  EXPECT_EQ(node.getTransformHierarchy(), &g.getTransformHierarchy());
+}
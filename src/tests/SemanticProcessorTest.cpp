@@ -0,0 +1,115 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <gtest/gtest.h>
+
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "esp/core/esp.h"
+#include "esp/sensor/SemanticProcessor.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+using esp::sensor::SemanticProcessor;
+
+namespace {
+
+// ids 0 and 3 are unannotated, id 4 is past the table
+const uint32_t ids[]{
+    1, 1, 2, 0,  //
+    1, 1, 2, 3,  //
+    0, 2, 2, 4,  //
+};
+
+void checkResults(const SemanticProcessor& processor) {
+  EXPECT_EQ(processor.getImageSize(), (Mn::Vector2i{4, 3}));
+  const std::vector<int> expectedClassImage{
+      5, 5, 7, ID_UNDEFINED,  //
+      5, 5, 7, ID_UNDEFINED,  //
+      ID_UNDEFINED, 7, 7, ID_UNDEFINED,
+  };
+  EXPECT_EQ(processor.getClassImage(), expectedClassImage);
+
+  const std::vector<int>& counts = processor.getClassPixelCounts();
+  ASSERT_EQ(counts.size(), 8);
+  EXPECT_EQ(counts[5], 4);
+  EXPECT_EQ(counts[7], 4);
+  EXPECT_EQ(counts[0], 0);
+
+  const std::vector<SemanticProcessor::Instance>& instances =
+      processor.getInstances();
+  ASSERT_EQ(instances.size(), 4);
+  EXPECT_EQ(instances[0].id, 0);
+  EXPECT_EQ(instances[0].classIndex, ID_UNDEFINED);
+  EXPECT_EQ(instances[0].pixelCount, 2);
+  EXPECT_EQ(instances[1].id, 1);
+  EXPECT_EQ(instances[1].classIndex, 5);
+  EXPECT_EQ(instances[1].min, (Mn::Vector2i{0, 0}));
+  EXPECT_EQ(instances[1].max, (Mn::Vector2i{1, 1}));
+  EXPECT_EQ(instances[1].pixelCount, 4);
+  EXPECT_EQ(instances[2].id, 2);
+  EXPECT_EQ(instances[2].min, (Mn::Vector2i{1, 0}));
+  EXPECT_EQ(instances[2].max, (Mn::Vector2i{2, 2}));
+  EXPECT_EQ(instances[2].pixelCount, 4);
+  EXPECT_EQ(instances[3].id, 3);
+  EXPECT_EQ(instances[3].min, (Mn::Vector2i{3, 1}));
+  EXPECT_EQ(instances[3].max, (Mn::Vector2i{3, 1}));
+}
+
+}  // namespace
+
+TEST(SemanticProcessorTest, Process) {
+  SemanticProcessor processor{{ID_UNDEFINED, 5, 7, ID_UNDEFINED}};
+  EXPECT_EQ(processor.getNumClasses(), 8);
+  processor.process(Cr::Containers::StridedArrayView2D<const uint32_t>{
+      ids, {3, 4}});
+  checkResults(processor);
+
+  // a second frame reuses the scratch space
+  processor.process(Cr::Containers::StridedArrayView2D<const uint32_t>{
+      ids, {3, 4}});
+  checkResults(processor);
+}
+
+TEST(SemanticProcessorTest, Flipped) {
+  // the rows stored bottom first, as read from the framebuffer
+  const uint32_t flippedIds[]{
+      0, 2, 2, 4,  //
+      1, 1, 2, 3,  //
+      1, 1, 2, 0,  //
+  };
+  SemanticProcessor processor{{ID_UNDEFINED, 5, 7, ID_UNDEFINED}};
+  processor.process(Cr::Containers::StridedArrayView2D<const uint32_t>{
+      flippedIds, {3, 4}}
+                        .flipped<0>());
+  checkResults(processor);
+}
+
+TEST(SemanticProcessorTest, Threaded) {
+  // enough rows for each thread to get some
+  std::vector<uint32_t> tallIds;
+  for (int repeat = 0; repeat < 32; ++repeat) {
+    tallIds.insert(tallIds.end(), std::begin(ids), std::end(ids));
+  }
+  const Cr::Containers::StridedArrayView2D<const uint32_t> view{
+      Cr::Containers::arrayView(tallIds), {3 * 32, 4}};
+
+  SemanticProcessor single{{ID_UNDEFINED, 5, 7, ID_UNDEFINED}};
+  SemanticProcessor threaded{{ID_UNDEFINED, 5, 7, ID_UNDEFINED}, 4};
+  single.process(view);
+  threaded.process(view);
+
+  EXPECT_EQ(threaded.getClassImage(), single.getClassImage());
+  EXPECT_EQ(threaded.getClassPixelCounts(), single.getClassPixelCounts());
+  EXPECT_EQ(threaded.getClassPixelCounts()[5], 4 * 32);
+  ASSERT_EQ(threaded.getInstances().size(), single.getInstances().size());
+  for (size_t i = 0; i < single.getInstances().size(); ++i) {
+    EXPECT_EQ(threaded.getInstances()[i].min, single.getInstances()[i].min);
+    EXPECT_EQ(threaded.getInstances()[i].max, single.getInstances()[i].max);
+    EXPECT_EQ(threaded.getInstances()[i].pixelCount,
+              single.getInstances()[i].pixelCount);
+  }
+  EXPECT_EQ(threaded.getInstances()[1].max, (Mn::Vector2i{1, 3 * 31 + 1}));
+}
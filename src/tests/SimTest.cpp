@@ -84,6 +84,7 @@ struct SimTest : Cr::TestSuite::Tester {
 
   void basic();
   void reconfigure();
+  void reconfigureImportSettings();
   void reset();
   void getSceneRGBAObservation();
   void getSceneWithLightingRGBAObservation();
@@ -109,6 +110,7 @@ SimTest::SimTest() {
   // clang-format off
   addTests({&SimTest::basic,
             &SimTest::reconfigure,
+            &SimTest::reconfigureImportSettings,
             &SimTest::reset,
             &SimTest::getSceneRGBAObservation,
             &SimTest::getSceneWithLightingRGBAObservation,
@@ -142,6 +144,62 @@ void SimTest::reconfigure() {
   cfg2.scene.id = skokloster;
   simulator.reconfigure(cfg2);
   CORRADE_VERIFY(pathfinder != simulator.getPathFinder());
+
+  // settings that don't affect the stage keep it loaded
+  pathfinder = simulator.getPathFinder();
+  SimulatorConfiguration cfg3 = cfg2;
+  cfg3.defaultCameraUuid = "depth_camera";
+  cfg3.compressTextures = !cfg2.compressTextures;
+  CORRADE_VERIFY(cfg3 != cfg2);
+  CORRADE_VERIFY(loadsSameStage(cfg3, cfg2));
+  simulator.reconfigure(cfg3);
+  CORRADE_VERIFY(pathfinder == simulator.getPathFinder());
+}
+
+void SimTest::reconfigureImportSettings() {
+  // exposes the resource manager to check which assets were imported
+  struct InspectedSimulator : Simulator {
+    using Simulator::Simulator;
+    const ResourceManager& resourceManager() const {
+      return *resourceManager_;
+    }
+  };
+
+  SimulatorConfiguration cfg;
+  cfg.scene.id = vangogh;
+  InspectedSimulator simulator(cfg);
+  const int firstMeshIndex =
+      simulator.resourceManager().getMeshMetaData(vangogh).meshIndex.first;
+
+  // reconfiguring with the same import settings reuses the imported stage
+  SimulatorConfiguration cfg2 = cfg;
+  cfg2.frustumCulling = !cfg.frustumCulling;
+  CORRADE_VERIFY(importsAssetsAlike(cfg2, cfg));
+  simulator.reconfigure(cfg2);
+  CORRADE_COMPARE(
+      simulator.resourceManager().getMeshMetaData(vangogh).meshIndex.first,
+      firstMeshIndex);
+
+  // enabling levels of detail imports the stage again to generate them
+  SimulatorConfiguration cfg3 = cfg2;
+  cfg3.lodPixelError = 1.0f;
+  CORRADE_VERIFY(!importsAssetsAlike(cfg3, cfg2));
+  CORRADE_VERIFY(!loadsSameStage(cfg3, cfg2));
+  simulator.reconfigure(cfg3);
+  CORRADE_VERIFY(
+      simulator.resourceManager().getMeshMetaData(vangogh).meshIndex.first !=
+      firstMeshIndex);
+
+  // loader settings alone are applied while keeping the stage
+  SimulatorConfiguration cfg4 = cfg3;
+  cfg4.assetImportThreads = 2;
+  cfg4.useBakedAssets = !cfg3.useBakedAssets;
+  CORRADE_VERIFY(cfg4 != cfg3);
+  CORRADE_VERIFY(loadsSameStage(cfg4, cfg3));
+  simulator.reconfigure(cfg4);
+  CORRADE_COMPARE(simulator.resourceManager().getNumImportThreads(), 2);
+  CORRADE_COMPARE(simulator.resourceManager().getUseBakedAssets(),
+                  cfg4.useBakedAssets);
 }
 
 void SimTest::reset() {
@@ -0,0 +1,270 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/SceneGraph/Drawable.h>
+
+#include "esp/scene/SceneGraph.h"
+#include "esp/scene/TransformHierarchy.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+using Mn::Math::Literals::operator""_degf;
+using esp::scene::SceneGraph;
+using esp::scene::SceneNode;
+using esp::scene::TransformHierarchy;
+
+namespace Test {
+namespace {
+
+struct TransformHierarchyTest : Cr::TestSuite::Tester {
+  explicit TransformHierarchyTest();
+
+  void absoluteTransformations();
+  void structureChanges();
+  void drawableTransformations();
+
+  void benchmarkMagnum();
+  void benchmarkFlattened();
+  void benchmarkFlattenedMoving();
+};
+
+TransformHierarchyTest::TransformHierarchyTest() {
+  // clang-format off
+  addTests({&TransformHierarchyTest::absoluteTransformations,
+            &TransformHierarchyTest::structureChanges,
+            &TransformHierarchyTest::drawableTransformations});
+
+  addBenchmarks({&TransformHierarchyTest::benchmarkMagnum,
+                 &TransformHierarchyTest::benchmarkFlattened,
+                 &TransformHierarchyTest::benchmarkFlattenedMoving}, 50);
+  // clang-format on
+}
+
+struct NoopDrawable : Mn::SceneGraph::Drawable3D {
+  using Mn::SceneGraph::Drawable3D::Drawable3D;
+  void draw(const Mn::Matrix4&, Mn::SceneGraph::Camera3D&) override {}
+};
+
+//! Compare the flattened absolute transformations to Magnum's
+void compareToMagnum(const TransformHierarchy& hierarchy) {
+  for (int i = 0; i != hierarchy.size(); ++i) {
+    CORRADE_ITERATION(i);
+    CORRADE_COMPARE(hierarchy.getAbsoluteTransformation(i),
+                    hierarchy.getNodes()[i]->absoluteTransformationMatrix());
+  }
+}
+
+void TransformHierarchyTest::absoluteTransformations() {
+  SceneGraph g;
+  SceneNode& root = g.getRootNode();
+  SceneNode& a = root.createChild();
+  SceneNode& b = a.createChild();
+  SceneNode& c = root.createChild();
+  a.setTranslation({1.0f, 0.0f, 0.0f});
+  b.setTranslation({0.0f, 2.0f, 0.0f});
+  c.rotateY(90.0_degf);
+
+  TransformHierarchy& hierarchy = g.getTransformHierarchy();
+  CORRADE_VERIFY(!hierarchy.isClean());
+  hierarchy.update();
+  CORRADE_VERIFY(hierarchy.isClean());
+  // the root, the default camera node and the three above
+  CORRADE_COMPARE(hierarchy.size(), 5);
+  CORRADE_COMPARE(hierarchy.indexOf(root), 0);
+  CORRADE_COMPARE(hierarchy.getParents()[0], -1);
+  CORRADE_COMPARE(hierarchy.getParents()[hierarchy.indexOf(b)],
+                  hierarchy.indexOf(a));
+  CORRADE_COMPARE(
+      hierarchy.getAbsoluteTransformation(hierarchy.indexOf(b)).translation(),
+      (Mn::Vector3{1.0f, 2.0f, 0.0f}));
+  compareToMagnum(hierarchy);
+
+  // moving a node only dirties its subtree
+  a.translate({0.0f, 0.0f, 3.0f});
+  CORRADE_VERIFY(!hierarchy.isClean());
+  hierarchy.update();
+  CORRADE_COMPARE(
+      hierarchy.getAbsoluteTransformation(hierarchy.indexOf(b)).translation(),
+      (Mn::Vector3{1.0f, 2.0f, 3.0f}));
+  compareToMagnum(hierarchy);
+
+  // and the next change is mirrored as well
+  b.translate({0.0f, 1.0f, 0.0f});
+  c.translate({0.0f, 0.0f, 1.0f});
+  hierarchy.update();
+  CORRADE_COMPARE(
+      hierarchy.getAbsoluteTransformation(hierarchy.indexOf(b)).translation(),
+      (Mn::Vector3{1.0f, 3.0f, 3.0f}));
+  compareToMagnum(hierarchy);
+}
+
+void TransformHierarchyTest::structureChanges() {
+  SceneGraph g;
+  SceneNode& root = g.getRootNode();
+  SceneNode& a = root.createChild();
+  a.setTranslation({1.0f, 0.0f, 0.0f});
+  TransformHierarchy& hierarchy = g.getTransformHierarchy();
+  hierarchy.update();
+  const int initialSize = hierarchy.size();
+
+  SceneNode& b = a.createChild();
+  b.setTranslation({0.0f, 1.0f, 0.0f});
+  CORRADE_VERIFY(!hierarchy.isClean());
+  CORRADE_COMPARE(b.getTransformHierarchy(), &hierarchy);
+  hierarchy.update();
+  CORRADE_COMPARE(hierarchy.size(), initialSize + 1);
+  CORRADE_COMPARE(
+      hierarchy.getAbsoluteTransformation(hierarchy.indexOf(b)).translation(),
+      (Mn::Vector3{1.0f, 1.0f, 0.0f}));
+
+  delete &b;
+  hierarchy.update();
+  CORRADE_COMPARE(hierarchy.size(), initialSize);
+  compareToMagnum(hierarchy);
+
+  // nodes of another tree are not part of it
+  SceneGraph other;
+  SceneNode& foreign = other.getRootNode().createChild();
+  CORRADE_COMPARE(hierarchy.indexOf(foreign), esp::ID_UNDEFINED);
+
+  // a node moved since the last update is dirty, so Magnum does not tell it
+  // about a new parent, setParent does
+  SceneNode& c = a.createChild();
+  SceneNode& d = root.createChild();
+  d.setTranslation({0.0f, 5.0f, 0.0f});
+  hierarchy.update();
+  c.translate({0.0f, 0.0f, 1.0f});
+  c.setParent(&d);
+  CORRADE_VERIFY(!hierarchy.isClean());
+  hierarchy.update();
+  CORRADE_COMPARE(hierarchy.getParents()[hierarchy.indexOf(c)],
+                  hierarchy.indexOf(d));
+  CORRADE_COMPARE(
+      hierarchy.getAbsoluteTransformation(hierarchy.indexOf(c)).translation(),
+      (Mn::Vector3{0.0f, 5.0f, 1.0f}));
+  compareToMagnum(hierarchy);
+
+  // and the same into another tree
+  c.translate({0.0f, 0.0f, 1.0f});
+  c.setParent(&foreign);
+  CORRADE_COMPARE(c.getTransformHierarchy(), &other.getTransformHierarchy());
+  hierarchy.update();
+  CORRADE_COMPARE(hierarchy.indexOf(c), esp::ID_UNDEFINED);
+  compareToMagnum(hierarchy);
+  other.getTransformHierarchy().update();
+  CORRADE_COMPARE(other.getTransformHierarchy().getParents()
+                      [other.getTransformHierarchy().indexOf(c)],
+                  other.getTransformHierarchy().indexOf(foreign));
+  compareToMagnum(other.getTransformHierarchy());
+}
+
+void TransformHierarchyTest::drawableTransformations() {
+  SceneGraph g;
+  SceneNode& root = g.getRootNode();
+  MagnumDrawableGroup drawables;
+  for (int i = 0; i != 10; ++i) {
+    SceneNode& node = root.createChild();
+    node.setTranslation({float(i), 0.0f, 0.0f});
+    node.rotateX(Mn::Deg(10.0f * i));
+    new NoopDrawable{node.createChild(), &drawables};
+  }
+  esp::gfx::RenderCamera& camera = g.getDefaultRenderCamera();
+  camera.node().setTranslation({0.0f, 0.0f, 5.0f});
+
+  const auto expected = camera.drawableTransformations(drawables);
+  const auto actual = g.getTransformHierarchy().drawableTransformations(
+      drawables, camera.cameraMatrix());
+  CORRADE_COMPARE(actual.size(), expected.size());
+  for (size_t i = 0; i != actual.size(); ++i) {
+    CORRADE_ITERATION(i);
+    CORRADE_COMPARE(&actual[i].first.get(), &expected[i].first.get());
+    CORRADE_COMPARE(actual[i].second, expected[i].second);
+  }
+}
+
+//! 10 groups of 10 objects of 100 parts, each part drawable
+constexpr int NumGroups = 10;
+constexpr int NumObjects = 10;
+constexpr int NumParts = 100;
+
+void populate(SceneGraph& g, MagnumDrawableGroup& drawables) {
+  for (int iGroup = 0; iGroup != NumGroups; ++iGroup) {
+    SceneNode& group = g.getRootNode().createChild();
+    group.setTranslation({float(iGroup), 0.0f, 0.0f});
+    for (int iObject = 0; iObject != NumObjects; ++iObject) {
+      SceneNode& object = group.createChild();
+      object.setTranslation({0.0f, float(iObject), 0.0f});
+      object.rotateY(Mn::Deg(float(iObject)));
+      for (int iPart = 0; iPart != NumParts; ++iPart) {
+        SceneNode& part = object.createChild();
+        part.setTranslation({0.0f, 0.0f, 0.01f * iPart});
+        new NoopDrawable{part, &drawables};
+      }
+    }
+  }
+}
+
+void TransformHierarchyTest::benchmarkMagnum() {
+  SceneGraph g;
+  MagnumDrawableGroup drawables;
+  populate(g, drawables);
+  esp::gfx::RenderCamera& camera = g.getDefaultRenderCamera();
+
+  std::size_t count = 0;
+  CORRADE_BENCHMARK(10) {
+    count += camera.drawableTransformations(drawables).size();
+  }
+  CORRADE_COMPARE(count, 10u * NumGroups * NumObjects * NumParts);
+}
+
+void TransformHierarchyTest::benchmarkFlattened() {
+  SceneGraph g;
+  MagnumDrawableGroup drawables;
+  populate(g, drawables);
+  esp::gfx::RenderCamera& camera = g.getDefaultRenderCamera();
+  TransformHierarchy& hierarchy = g.getTransformHierarchy();
+  hierarchy.update();
+
+  std::size_t count = 0;
+  CORRADE_BENCHMARK(10) {
+    count += hierarchy.drawableTransformations(drawables, camera.cameraMatrix())
+                 .size();
+  }
+  CORRADE_COMPARE(count, 10u * NumGroups * NumObjects * NumParts);
+}
+
+void TransformHierarchyTest::benchmarkFlattenedMoving() {
+  SceneGraph g;
+  MagnumDrawableGroup drawables;
+  populate(g, drawables);
+  esp::gfx::RenderCamera& camera = g.getDefaultRenderCamera();
+  TransformHierarchy& hierarchy = g.getTransformHierarchy();
+  hierarchy.update();
+
+  // one object of each group moves every frame, as physics would move them
+  std::vector<SceneNode*> moving;
+  for (MagnumObject& group : g.getRootNode().children()) {
+    if (group.children().first() != nullptr) {
+      moving.push_back(static_cast<SceneNode*>(group.children().first()));
+    }
+  }
+
+  std::size_t count = 0;
+  CORRADE_BENCHMARK(10) {
+    for (SceneNode* node : moving) {
+      node->translate({0.0f, 0.0f, 0.001f});
+    }
+    count += hierarchy.drawableTransformations(drawables, camera.cameraMatrix())
+                 .size();
+  }
+  CORRADE_COMPARE(count, 10u * NumGroups * NumObjects * NumParts);
+}
+
+}  // namespace
+}  // namespace Test
+
+CORRADE_TEST_MAIN(Test::TransformHierarchyTest)
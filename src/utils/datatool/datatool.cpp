@@ -2,15 +2,22 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/Manager.h>
+
 #include "SceneLoader.h"
 
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tiny_obj_loader.h>
 
+#include "esp/assets/AssetImportPool.h"
+#include "esp/assets/ImportedAsset.h"
 #include "esp/assets/Mp3dInstanceMeshData.h"
 #include "esp/core/esp.h"
 #include "esp/nav/PathFinder.h"
@@ -130,7 +137,7 @@ int createMp3dSemanticMesh(const std::string& plyFile,
     LOG(ERROR) << "Failed loading MP3D house file " << houseFile;
     return 1;
   }
-  const std::unordered_map<int, int>& objectIdMap =
+  const std::unordered_map<int, int> objectIdMap =
       semanticScene.getSemanticIndexMap();
 
   Mp3dInstanceMeshData mp3dMesh;
@@ -141,7 +148,7 @@ int createMp3dSemanticMesh(const std::string& plyFile,
   }
 
   success =
-      mp3dMesh.saveSemMeshPLY(semMeshFile, semanticScene.getSemanticIndexMap());
+      mp3dMesh.saveSemMeshPLY(semMeshFile, objectIdMap);
   if (!success) {
     LOG(ERROR) << "Failed saving MP3D semantic mesh PLY " << plyFile;
     return 1;
@@ -150,6 +157,53 @@ int createMp3dSemanticMesh(const std::string& plyFile,
   return 0;
 }
 
+int bakeAsset(const std::string& assetFile,
+              const std::string& bakedFile,
+              const std::string& basisFormat) {
+#ifdef MAGNUM_BUILD_STATIC
+  // avoid using plugins that might depend on different library versions
+  AssetImportPool::ImporterManager manager{"nonexistent"};
+#else
+  AssetImportPool::ImporterManager manager;
+#endif
+  // decode exactly the way the simulator would for this GPU format
+  AssetImportPool::configureImporterManager(manager, basisFormat);
+  Corrade::Containers::Pointer<AssetImportPool::Importer> importer =
+      manager.loadAndInstantiate("AnySceneImporter");
+  if (!importer || !importer->openFile(assetFile)) {
+    LOG(ERROR) << "Failed to open " << assetFile;
+    return 1;
+  }
+  // reordering is free at load time and never hurts rendering, so baked
+  // meshes are always optimized
+  ImportedAsset::ptr asset =
+      ImportedAsset::createFromImporter(*importer, /*optimizeMeshes=*/true);
+  if (!asset) {
+    LOG(ERROR) << "Failed to load the hierarchy of " << assetFile;
+    return 1;
+  }
+
+  const int numThreads =
+      std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+  AssetImportPool pool{numThreads};
+  for (int iThread = 0; iThread < pool.getNumThreads(); ++iThread) {
+    AssetImportPool::configureImporterManager(pool.getImporterManager(iThread),
+                                              basisFormat);
+  }
+  pool.run(
+      *importer, assetFile, asset->getNumComponents(),
+      [&](AssetImportPool::Importer& workerImporter, int componentID) {
+        asset->decodeComponent(workerImporter, componentID);
+      },
+      [](int) {});
+
+  if (!asset->save(bakedFile, assetFile, basisFormat)) {
+    LOG(ERROR) << "Failed to save baked asset " << bakedFile;
+    return 2;
+  }
+  return 0;
+}
+
 int main(int argc, char** argv) {
   if (argc < 4) {
     std::cout << "Usage: datatool task input_file output_file" << std::endl;
@@ -174,6 +228,13 @@ int main(int argc, char** argv) {
       return 64;
     }
     createGibsonSemanticMesh(argv[2], argv[3], argv[4]);
+  } else if (task == "bake_asset") {
+    // the simulator picks up <input_asset>.baked, for the Basis format it
+    // transcodes to on its GPU (Astc4x4RGBA, Bc7RGBA, Bc3RGBA, Etc2RGBA, ...)
+    const std::string basisFormat = argc < 5 ? "Bc7RGBA" : argv[4];
+    if (bakeAsset(argv[2], argv[3], basisFormat) != 0) {
+      return 1;
+    }
   } else {
     LOG(ERROR) << "Unrecognized task " << task;
     return 1;
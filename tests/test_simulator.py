@@ -162,3 +162,52 @@ def test_object_template_editing(sim):
     # test adding a new object
     object_id = sim.add_object(template_ids[0])
     assert object_id != -1
+
+
+def test_reconfigure_sensors_keeps_stage(sim):
+    cfg_settings = examples.settings.default_sim_settings.copy()
+    cfg_settings["scene"] = "data/scene_datasets/habitat-test-scenes/van-gogh-room.glb"
+    sim.reconfigure(examples.settings.make_cfg(cfg_settings))
+    agent = sim.get_agent(0)
+    pathfinder = sim.pathfinder
+
+    # only the sensors change, so the stage, agents and navmesh are kept
+    cfg_settings["width"] = cfg_settings["height"] = 32
+    hab_cfg = examples.settings.make_cfg(cfg_settings)
+    assert sim.config.sim_cfg.loads_same_stage(hab_cfg.sim_cfg)
+    sim.reconfigure(hab_cfg)
+    assert sim.get_agent(0) is agent
+    assert sim.pathfinder is pathfinder
+    obs = sim.get_sensor_observations()
+    assert obs["color_sensor"].shape[:2] == (32, 32)
+
+    # a different scene is loaded from scratch
+    cfg_settings["scene"] = "data/scene_datasets/habitat-test-scenes/skokloster-castle.glb"
+    hab_cfg = examples.settings.make_cfg(cfg_settings)
+    assert not sim.config.sim_cfg.loads_same_stage(hab_cfg.sim_cfg)
+    sim.reconfigure(hab_cfg)
+    assert sim.get_agent(0) is not agent
+
+
+
+def test_reconfigure_agent_count_keeps_stage(sim):
+    cfg_settings = examples.settings.default_sim_settings.copy()
+    cfg_settings["scene"] = "data/scene_datasets/habitat-test-scenes/van-gogh-room.glb"
+    hab_cfg = examples.settings.make_cfg(cfg_settings)
+    sim.reconfigure(hab_cfg)
+    pathfinder = sim.pathfinder
+    old_agent_node = sim.get_agent(0).scene_node
+
+    # a second agent recreates the agents, but keeps the stage
+    two_agents_cfg = habitat_sim.Configuration(
+        hab_cfg.sim_cfg, [hab_cfg.agents[0], habitat_sim.AgentConfiguration()]
+    )
+    assert sim.config.sim_cfg.loads_same_stage(two_agents_cfg.sim_cfg)
+    sim.reconfigure(two_agents_cfg)
+    assert len(sim.agents) == 2
+    assert sim.pathfinder is pathfinder
+
+    # the old agent node was removed from the kept scene graph
+    assert old_agent_node.parent is None
+    obs = sim.get_sensor_observations()
+    assert "color_sensor" in obs